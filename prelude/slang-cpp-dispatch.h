@@ -0,0 +1,306 @@
+#ifndef SLANG_PRELUDE_CPP_DISPATCH_H
+#define SLANG_PRELUDE_CPP_DISPATCH_H
+
+#include "slang-cpp-types.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+namespace SLANG_PRELUDE_NAMESPACE {
+#endif
+
+/* Runs the group range entry point of a compute kernel (the entry point with the same name as in the source, that takes
+a ComputeVaryingInput) across multiple threads.
+
+The groups of a dispatch are numbered linearly (x varying fastest) and split into 'chunks' of grain size groups. Each thread
+starts with an equal share of the chunks. A thread takes chunks from the front of its own share, and when its share is
+exhausted steals half of what remains from the back of another thread's share. Each chunk is executed with as few calls to
+the kernel as possible - one per row of groups along x.
+
+The kernel is called concurrently, so it must not write to the same memory from different groups (other than via atomics).
+Uses of groupshared memory are safe, as each call runs complete groups. */
+class ComputeDispatchThreadPool
+{
+public:
+        /// Execute groups [0, groupCount) of func. Returns when all of the groups have completed.
+        /// grainSize is the number of groups in each chunk, 0 chooses a size based on the number of threads.
+        /// The calling thread executes groups too. Only one dispatch can be in progress at a time.
+    void dispatch(ComputeFunc func, const uint3& groupCount, void* uniformEntryPointParams, void* uniformState, uint32_t grainSize = 0)
+    {
+        const uint64_t totalGroupCount = uint64_t(groupCount.x) * groupCount.y * groupCount.z;
+        if (totalGroupCount == 0)
+        {
+            return;
+        }
+
+        const uint32_t threadCount = uint32_t(m_shares.size());
+        if (grainSize == 0)
+        {
+            // Aim for several chunks per thread, so there is something to steal when threads run at different speeds
+            const uint64_t autoGrainSize = totalGroupCount / (uint64_t(threadCount) * 8);
+            grainSize = autoGrainSize ? uint32_t(autoGrainSize < 0xffffffff ? autoGrainSize : 0xffffffff) : 1;
+        }
+        // The chunk index has to fit in 32 bits
+        while ((totalGroupCount + grainSize - 1) / grainSize > 0xffffffff)
+        {
+            grainSize *= 2;
+        }
+
+        const uint32_t chunkCount = uint32_t((totalGroupCount + grainSize - 1) / grainSize);
+
+        m_job.func = func;
+        m_job.groupCount = groupCount;
+        m_job.totalGroupCount = totalGroupCount;
+        m_job.grainSize = grainSize;
+        m_job.uniformEntryPointParams = uniformEntryPointParams;
+        m_job.uniformState = uniformState;
+
+        if (threadCount == 1 || chunkCount == 1)
+        {
+            _executeGroups(0, totalGroupCount);
+            return;
+        }
+
+        // Split the chunks evenly between the threads
+        for (uint32_t i = 0; i < threadCount; ++i)
+        {
+            const uint32_t begin = uint32_t(uint64_t(chunkCount) * i / threadCount);
+            const uint32_t end = uint32_t(uint64_t(chunkCount) * (i + 1) / threadCount);
+            m_shares[i].range.store(_makeRange(begin, end), std::memory_order_relaxed);
+        }
+
+        // Start the workers
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_activeWorkerCount = threadCount - 1;
+            m_jobIndex++;
+        }
+        m_startCondition.notify_all();
+
+        // The calling thread is thread 0
+        _executeShare(0);
+
+        // Wait for the workers to complete
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_doneCondition.wait(lock, [this]() { return m_activeWorkerCount == 0; });
+        }
+    }
+
+        /// The number of threads that execute a dispatch, including the calling thread
+    int getThreadCount() const { return int(m_shares.size()); }
+
+        /// threadCount is the total number of threads including the thread calling dispatch. 0 means use the number of
+        /// hardware threads.
+    explicit ComputeDispatchThreadPool(int threadCount = 0)
+    {
+        if (threadCount <= 0)
+        {
+            threadCount = int(std::thread::hardware_concurrency());
+            threadCount = (threadCount > 0) ? threadCount : 1;
+        }
+
+        m_shares = std::vector<Share>(size_t(threadCount));
+        for (int i = 1; i < threadCount; ++i)
+        {
+            m_threads.push_back(std::thread(&ComputeDispatchThreadPool::_workerMain, this, uint32_t(i)));
+        }
+    }
+    ~ComputeDispatchThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isQuitting = true;
+        }
+        m_startCondition.notify_all();
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+private:
+    ComputeDispatchThreadPool(const ComputeDispatchThreadPool&) = delete;
+    void operator=(const ComputeDispatchThreadPool&) = delete;
+
+        /// The range of chunks owned by a thread, [begin, end) packed as begin in the low 32 bits, end in the high.
+        /// Padded so that different threads' shares are unlikely to be on the same cache line.
+    struct Share
+    {
+        Share() : range(0) {}
+
+        std::atomic<uint64_t> range;
+        char padding[64 - sizeof(std::atomic<uint64_t>)];
+    };
+
+    struct Job
+    {
+        ComputeFunc func;
+        uint3 groupCount;
+        uint64_t totalGroupCount;
+        uint32_t grainSize;
+        void* uniformEntryPointParams;
+        void* uniformState;
+    };
+
+    static uint64_t _makeRange(uint32_t begin, uint32_t end) { return (uint64_t(end) << 32) | begin; }
+
+        /// Take the chunk at the front of the share. Returns false if the share is empty.
+    static bool _takeChunk(Share& share, uint32_t& outChunk)
+    {
+        uint64_t range = share.range.load(std::memory_order_acquire);
+        for (;;)
+        {
+            const uint32_t begin = uint32_t(range);
+            const uint32_t end = uint32_t(range >> 32);
+            if (begin >= end)
+            {
+                return false;
+            }
+            if (share.range.compare_exchange_weak(range, _makeRange(begin + 1, end), std::memory_order_acq_rel))
+            {
+                outChunk = begin;
+                return true;
+            }
+        }
+    }
+
+        /// Take half of the remaining chunks (rounded up) from the back of the share. Returns false if the share is empty.
+    static bool _stealChunks(Share& share, uint32_t& outBegin, uint32_t& outEnd)
+    {
+        uint64_t range = share.range.load(std::memory_order_acquire);
+        for (;;)
+        {
+            const uint32_t begin = uint32_t(range);
+            const uint32_t end = uint32_t(range >> 32);
+            if (begin >= end)
+            {
+                return false;
+            }
+            const uint32_t newEnd = end - (end - begin + 1) / 2;
+            if (share.range.compare_exchange_weak(range, _makeRange(begin, newEnd), std::memory_order_acq_rel))
+            {
+                outBegin = newEnd;
+                outEnd = end;
+                return true;
+            }
+        }
+    }
+
+        /// Execute the groups with linear indices [start, end)
+    void _executeGroups(uint64_t start, uint64_t end) const
+    {
+        const Job& job = m_job;
+        while (start < end)
+        {
+            const uint32_t x = uint32_t(start % job.groupCount.x);
+            const uint64_t yz = start / job.groupCount.x;
+            const uint32_t y = uint32_t(yz % job.groupCount.y);
+            const uint32_t z = uint32_t(yz / job.groupCount.y);
+
+            // Run to the end of the row, or the end of the range
+            uint64_t rowEnd = start + (job.groupCount.x - x);
+            rowEnd = (rowEnd < end) ? rowEnd : end;
+
+            ComputeVaryingInput varyingInput;
+            varyingInput.startGroupID = { x, y, z };
+            varyingInput.endGroupID = { uint32_t(x + (rowEnd - start)), y + 1, z + 1 };
+            job.func(&varyingInput, job.uniformEntryPointParams, job.uniformState);
+
+            start = rowEnd;
+        }
+    }
+
+    void _executeChunk(uint32_t chunk) const
+    {
+        const uint64_t start = uint64_t(chunk) * m_job.grainSize;
+        const uint64_t end = start + m_job.grainSize;
+        _executeGroups(start, (end < m_job.totalGroupCount) ? end : m_job.totalGroupCount);
+    }
+
+        /// Execute the thread's share, and then steal from others until there is nothing left to steal
+    void _executeShare(uint32_t threadIndex)
+    {
+        const uint32_t threadCount = uint32_t(m_shares.size());
+        Share& share = m_shares[threadIndex];
+        for (;;)
+        {
+            uint32_t chunk;
+            while (_takeChunk(share, chunk))
+            {
+                _executeChunk(chunk);
+            }
+
+            // Look for a victim, starting with the next thread along so that thieves are spread out
+            bool hasStolen = false;
+            for (uint32_t i = 1; i < threadCount && !hasStolen; ++i)
+            {
+                uint32_t begin, end;
+                if (_stealChunks(m_shares[(threadIndex + i) % threadCount], begin, end))
+                {
+                    // Execute the first stolen chunk, and make the rest available to be stolen in turn.
+                    // Only this thread adds to its own share, and it's empty, so a store is enough.
+                    share.range.store(_makeRange(begin + 1, end), std::memory_order_release);
+                    _executeChunk(begin);
+                    hasStolen = true;
+                }
+            }
+
+            // If nothing could be stolen, all of the chunks are either complete or being executed by another thread
+            if (!hasStolen)
+            {
+                return;
+            }
+        }
+    }
+
+    void _workerMain(uint32_t threadIndex)
+    {
+        uint64_t jobIndex = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_startCondition.wait(lock, [&]() { return m_isQuitting || m_jobIndex != jobIndex; });
+                if (m_isQuitting)
+                {
+                    return;
+                }
+                jobIndex = m_jobIndex;
+            }
+
+            _executeShare(threadIndex);
+
+            bool isLast;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                isLast = (--m_activeWorkerCount == 0);
+            }
+            if (isLast)
+            {
+                m_doneCondition.notify_one();
+            }
+        }
+    }
+
+    Job m_job;
+    std::vector<Share> m_shares;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_startCondition;
+    std::condition_variable m_doneCondition;
+    uint64_t m_jobIndex = 0;
+    uint32_t m_activeWorkerCount = 0;
+    bool m_isQuitting = false;
+};
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+}
+#endif
+
+#endif
@@ -32,6 +32,27 @@
 
 #define SLANG_PRELUDE_EXPORT SLANG_PRELUDE_EXTERN_C SLANG_PRELUDE_SHARED_LIB_EXPORT
 
+// Used in the code output for compute entry points with -cpu-group-as-lanes, where the threads of a group
+// are the iterations ('lanes') of a loop that the compiler can vectorize.
+// SLANG_PRELUDE_LANES_LOOP is placed before the loop, and says the iterations are independent.
+#if defined(_MSC_VER)
+#   define SLANG_PRELUDE_FORCE_INLINE __forceinline
+#   define SLANG_PRELUDE_ASSUME(x) __assume(x)
+#   define SLANG_PRELUDE_LANES_LOOP __pragma(loop(ivdep))
+#elif defined(__clang__)
+#   define SLANG_PRELUDE_FORCE_INLINE inline __attribute__((always_inline))
+#   define SLANG_PRELUDE_ASSUME(x) __builtin_assume(x)
+#   define SLANG_PRELUDE_LANES_LOOP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#   define SLANG_PRELUDE_FORCE_INLINE inline __attribute__((always_inline))
+#   define SLANG_PRELUDE_ASSUME(x) do { if (!(x)) __builtin_unreachable(); } while (0)
+#   define SLANG_PRELUDE_LANES_LOOP _Pragma("GCC ivdep")
+#else
+#   define SLANG_PRELUDE_FORCE_INLINE inline
+#   define SLANG_PRELUDE_ASSUME(x)
+#   define SLANG_PRELUDE_LANES_LOOP
+#endif
+
 #ifndef SLANG_INFINITY
 #   define SLANG_INFINITY   INFINITY
 #endif
@@ -39,6 +60,21 @@
 #include "slang-cpp-types.h"
 #include "slang-cpp-scalar-intrinsics.h"
 
+// Vector and matrix intrinsics, which use SIMD where available. Define SLANG_PRELUDE_ENABLE_SIMD as 0 to disable.
+#include "slang-cpp-vector-intrinsics.h"
+
+// Host code that includes the prelude can define this to have ComputeDispatchThreadPool, which runs
+// a compute entry point across multiple threads.
+#ifdef SLANG_PRELUDE_ENABLE_COMPUTE_DISPATCH
+#   include "slang-cpp-dispatch.h"
+#endif
+
+// Host code that includes the prelude can define this to have TiledTexture, a CPU texture implementation
+// with mip maps and filtered sampling that can be bound to texture parameters.
+#ifdef SLANG_PRELUDE_ENABLE_TEXTURE
+#   include "slang-cpp-texture.h"
+#endif
+
 // TODO(JS): Hack! Output C++ code from slang can copy uninitialized variables. 
 #if defined(_MSC_VER)
 #   pragma warning(disable : 4700)
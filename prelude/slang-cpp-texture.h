@@ -0,0 +1,580 @@
+#ifndef SLANG_PRELUDE_CPP_TEXTURE_H
+#define SLANG_PRELUDE_CPP_TEXTURE_H
+
+#include "slang-cpp-types.h"
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include <vector>
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+namespace SLANG_PRELUDE_NAMESPACE {
+#endif
+
+enum class TextureFilterMode : uint8_t
+{
+    Point,
+    Linear,
+};
+
+enum class TextureAddressMode : uint8_t
+{
+    Wrap,
+    Mirror,
+    Clamp,
+    Border,
+    MirrorOnce,
+};
+
+/* The prelude only declares ISamplerState, so what a SamplerState points to is up to the host. This defines it as the
+description of how to sample, which is what TiledTexture uses. A SamplerState with a null state samples with the D3D
+default sampler - trilinear filtering and clamp addressing. */
+struct ISamplerState
+{
+    TextureFilterMode minFilter = TextureFilterMode::Linear;
+    TextureFilterMode magFilter = TextureFilterMode::Linear;
+    TextureFilterMode mipFilter = TextureFilterMode::Linear;
+
+    TextureAddressMode addressU = TextureAddressMode::Clamp;
+    TextureAddressMode addressV = TextureAddressMode::Clamp;
+    TextureAddressMode addressW = TextureAddressMode::Clamp;
+
+    float mipLODBias = 0.0f;
+    float minLOD = -FLT_MAX;
+    float maxLOD = FLT_MAX;
+    float borderColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+};
+
+/* A read only texture with a mip chain, that implements ITexture, so can be bound to Texture1D/2D/3D/Cube (and arrays)
+parameters of a kernel. Texels are CHANNEL_COUNT floats.
+
+Each mip level of each array element (or cube face) is stored in tiles - 64 texels for 1D, 8x8 for 2D and cube faces,
+and 4x4x4 for 3D - with the texels of a tile in Morton order. Texels close in 2D/3D are then usually close in memory,
+so the texels read by a filtered sample are mostly in the same cache line, whatever the direction of access.
+
+Sampling supports point and linear filtering (per min, mag and mip filter, so bilinear and trilinear) and all of the
+address modes. Sample has no derivatives to calculate a level of detail from, so samples level 0 (plus the sampler
+bias). Cube maps are sampled without filtering across face edges.
+
+Usage:
+
+```
+TiledTexture<4> texture(dims);                      // dims.numberOfLevels of 0 means the full mip chain
+texture.setLevelData(0, 0, data);                   // Set the top level of the first array element
+texture.generateMips();                             // Calculate the other levels from the top level
+Texture2D<float4> param = { &texture };             // Ready to be passed to a kernel
+```
+*/
+template <int CHANNEL_COUNT>
+class TiledTexture : public ITexture
+{
+public:
+    typedef TiledTexture ThisType;
+
+    // ITexture
+    virtual TextureDimensions GetDimensions(int mipLevel = -1) override
+    {
+        TextureDimensions dims = m_dims;
+        if (mipLevel > 0 && mipLevel < int(m_dims.numberOfLevels))
+        {
+            const Level& level = m_levels[mipLevel];
+            dims.width = (m_dims.width > 0) ? level.size[0] : 0;
+            dims.height = (m_dims.height > 0) ? level.size[1] : 0;
+            dims.depth = (m_dims.depth > 0) ? level.size[2] : 0;
+        }
+        return dims;
+    }
+    virtual void Load(const int* loc, void* out) override
+    {
+        // loc holds the texel coordinates, then the array index for arrays, and then the mip level
+        float* dst = (float*)out;
+        const int mipLevel = loc[m_locCount];
+        const int slice = m_isArray ? loc[m_dimCount] : 0;
+        if (mipLevel < 0 || mipLevel >= int(m_dims.numberOfLevels) || slice < 0 || slice >= m_sliceCount)
+        {
+            _setZero(dst);
+            return;
+        }
+        const Level& level = m_levels[mipLevel];
+        int coords[3] = { 0, 0, 0 };
+        for (int i = 0; i < m_dimCount; ++i)
+        {
+            coords[i] = loc[i];
+            if (coords[i] < 0 || coords[i] >= level.size[i])
+            {
+                _setZero(dst);
+                return;
+            }
+        }
+        _copyTexel(getTexel(mipLevel, slice, coords[0], coords[1], coords[2]), dst);
+    }
+    virtual void Sample(SamplerState samplerState, const float* loc, void* out) override
+    {
+        const ISamplerState& sampler = _getSampler(samplerState);
+        _sample(sampler, loc, _calcLOD(sampler, 0.0f), (float*)out);
+    }
+    virtual void SampleLevel(SamplerState samplerState, const float* loc, float level, void* out) override
+    {
+        const ISamplerState& sampler = _getSampler(samplerState);
+        _sample(sampler, loc, _calcLOD(sampler, level), (float*)out);
+    }
+    virtual void Sample4(SamplerState samplerState, const float* locs, size_t locStride, void* out, size_t outStride) override
+    {
+        const ISamplerState& sampler = _getSampler(samplerState);
+        const float lod = _calcLOD(sampler, 0.0f);
+        for (int i = 0; i < 4; ++i)
+        {
+            _sample(sampler, (const float*)((const char*)locs + locStride * i), lod, (float*)((char*)out + outStride * i));
+        }
+    }
+    virtual void SampleLevel4(SamplerState samplerState, const float* locs, size_t locStride, const float* levels, void* out, size_t outStride) override
+    {
+        const ISamplerState& sampler = _getSampler(samplerState);
+        for (int i = 0; i < 4; ++i)
+        {
+            _sample(sampler, (const float*)((const char*)locs + locStride * i), _calcLOD(sampler, levels[i]), (float*)((char*)out + outStride * i));
+        }
+    }
+
+        /// The number of array elements, times 6 for cube maps
+    int getSliceCount() const { return m_sliceCount; }
+        /// Get the size of a mip level along a dimension
+    int getLevelSize(int mipLevel, int dimIndex) const { return m_levels[mipLevel].size[dimIndex]; }
+
+        /// Get a texel. For cube maps slice is (arrayIndex * 6 + face).
+    float* getTexel(int mipLevel, int slice, int x, int y = 0, int z = 0)
+    {
+        const Level& level = m_levels[mipLevel];
+        const size_t tileIndex = size_t(x >> m_tileShift[0]) + level.tileCount[0] * (size_t(y >> m_tileShift[1]) + level.tileCount[1] * size_t(z >> m_tileShift[2]));
+        const size_t texelIndex = level.offset + level.sliceSize * slice + (tileIndex << m_tileTexelShift) +
+            m_mortonX[x & m_tileMask[0]] + m_mortonY[y & m_tileMask[1]] + m_mortonZ[z & m_tileMask[2]];
+        return &m_data[texelIndex * CHANNEL_COUNT];
+    }
+    const float* getTexel(int mipLevel, int slice, int x, int y = 0, int z = 0) const { return const_cast<ThisType*>(this)->getTexel(mipLevel, slice, x, y, z); }
+
+    void setTexel(int mipLevel, int slice, int x, int y, int z, const float* value) { _copyTexel(value, getTexel(mipLevel, slice, x, y, z)); }
+
+        /// Set all of the texels of a level of a slice from data, which holds texels in x then y then z order
+    void setLevelData(int mipLevel, int slice, const float* data)
+    {
+        const Level& level = m_levels[mipLevel];
+        for (int z = 0; z < level.size[2]; ++z)
+        {
+            for (int y = 0; y < level.size[1]; ++y)
+            {
+                for (int x = 0; x < level.size[0]; ++x)
+                {
+                    setTexel(mipLevel, slice, x, y, z, data);
+                    data += CHANNEL_COUNT;
+                }
+            }
+        }
+    }
+
+        /// Set every texel of every level to value
+    void fill(const float* value)
+    {
+        const size_t texelCount = m_data.size() / CHANNEL_COUNT;
+        for (size_t i = 0; i < texelCount; ++i)
+        {
+            _copyTexel(value, &m_data[i * CHANNEL_COUNT]);
+        }
+    }
+
+        /// Calculate the levels below the top level of every slice, by averaging the 2, 4 or 8 texels of the level above
+    void generateMips()
+    {
+        for (int mipLevel = 1; mipLevel < int(m_dims.numberOfLevels); ++mipLevel)
+        {
+            const Level& level = m_levels[mipLevel];
+            const Level& srcLevel = m_levels[mipLevel - 1];
+
+            // A dimension that didn't halve (because it is already 1) only has one texel to average along it
+            int srcCount[3];
+            for (int i = 0; i < 3; ++i)
+            {
+                srcCount[i] = (srcLevel.size[i] > level.size[i]) ? 2 : 1;
+            }
+            const float scale = 1.0f / float(srcCount[0] * srcCount[1] * srcCount[2]);
+
+            for (int slice = 0; slice < m_sliceCount; ++slice)
+            {
+                for (int z = 0; z < level.size[2]; ++z)
+                for (int y = 0; y < level.size[1]; ++y)
+                for (int x = 0; x < level.size[0]; ++x)
+                {
+                    float sum[CHANNEL_COUNT] = {};
+                    for (int k = 0; k < srcCount[2]; ++k)
+                    for (int j = 0; j < srcCount[1]; ++j)
+                    for (int i = 0; i < srcCount[0]; ++i)
+                    {
+                        const float* src = getTexel(mipLevel - 1, slice, x * srcCount[0] + i, y * srcCount[1] + j, z * srcCount[2] + k);
+                        for (int c = 0; c < CHANNEL_COUNT; ++c)
+                        {
+                            sum[c] += src[c];
+                        }
+                    }
+                    float* dst = getTexel(mipLevel, slice, x, y, z);
+                    for (int c = 0; c < CHANNEL_COUNT; ++c)
+                    {
+                        dst[c] = sum[c] * scale;
+                    }
+                }
+            }
+        }
+    }
+
+        /// Ctor. The contents are initially all zero. If dims.numberOfLevels is 0 the texture has the full mip chain.
+    TiledTexture(const TextureDimensions& dims)
+    {
+        m_dims = dims;
+
+        const auto baseShape = (dims.shape & SLANG_RESOURCE_BASE_SHAPE_MASK);
+        int tileShift[3] = { 0, 0, 0 };
+        switch (baseShape)
+        {
+            case SLANG_TEXTURE_1D:      m_dimCount = 1; tileShift[0] = 6; break;
+            case SLANG_TEXTURE_3D:      m_dimCount = 3; tileShift[0] = tileShift[1] = tileShift[2] = 2; break;
+            default:                    m_dimCount = 2; tileShift[0] = tileShift[1] = 3; break;
+        }
+        m_isCube = (baseShape == SLANG_TEXTURE_CUBE);
+        m_isArray = (dims.shape & SLANG_TEXTURE_ARRAY_FLAG) != 0;
+        // A cube location is a direction, so has 3 components
+        m_locCount = (m_isCube ? 3 : m_dimCount) + (m_isArray ? 1 : 0);
+
+        m_arrayCount = m_isArray ? int(dims.arrayElementCount > 0 ? dims.arrayElementCount : 1) : 1;
+        m_sliceCount = m_arrayCount * (m_isCube ? 6 : 1);
+
+        const int maxLevelCount = dims.calcMaxMIPLevels();
+        if (m_dims.numberOfLevels == 0 || int(m_dims.numberOfLevels) > maxLevelCount)
+        {
+            m_dims.numberOfLevels = uint32_t(maxLevelCount);
+        }
+
+        // The Morton order within a tile interleaves the bits of the coordinates, taking a bit from each dimension
+        // in turn, skipping dimensions that have run out of bits
+        int mortonBit = 0;
+        for (int bit = 0; bit < 6; ++bit)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                if (bit < tileShift[i])
+                {
+                    uint32_t* morton = (i == 0) ? m_mortonX : ((i == 1) ? m_mortonY : m_mortonZ);
+                    for (int coord = 0; coord < (1 << tileShift[i]); ++coord)
+                    {
+                        if (coord & (1 << bit))
+                        {
+                            morton[coord] |= uint32_t(1) << mortonBit;
+                        }
+                    }
+                    mortonBit++;
+                }
+            }
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            m_tileShift[i] = tileShift[i];
+            m_tileMask[i] = (1 << tileShift[i]) - 1;
+        }
+        m_tileTexelShift = mortonBit;
+
+        const uint32_t topSize[3] = { dims.width, dims.height, dims.depth };
+        size_t offset = 0;
+        m_levels.resize(m_dims.numberOfLevels);
+        for (int mipLevel = 0; mipLevel < int(m_dims.numberOfLevels); ++mipLevel)
+        {
+            Level& level = m_levels[mipLevel];
+            size_t tileCount = 1;
+            for (int i = 0; i < 3; ++i)
+            {
+                const uint32_t size = (i < m_dimCount && topSize[i] > 0) ? (topSize[i] >> mipLevel) : 1;
+                level.size[i] = int(size > 0 ? size : 1);
+                level.sizeFloat[i] = float(level.size[i]);
+                level.tileCount[i] = (size_t(level.size[i]) + m_tileMask[i]) >> m_tileShift[i];
+                tileCount *= level.tileCount[i];
+            }
+            level.sliceSize = tileCount << m_tileTexelShift;
+            level.offset = offset;
+            offset += level.sliceSize * m_sliceCount;
+        }
+        m_data.resize(offset * CHANNEL_COUNT);
+    }
+
+protected:
+    struct Level
+    {
+        int size[3];
+        float sizeFloat[3];
+        size_t tileCount[3];
+        size_t sliceSize;                       ///< In texels (including unused texels in partial tiles)
+        size_t offset;                          ///< In texels
+    };
+
+    static void _copyTexel(const float* src, float* dst)
+    {
+        for (int c = 0; c < CHANNEL_COUNT; ++c)
+        {
+            dst[c] = src[c];
+        }
+    }
+    static void _setZero(float* dst)
+    {
+        for (int c = 0; c < CHANNEL_COUNT; ++c)
+        {
+            dst[c] = 0.0f;
+        }
+    }
+
+    static const ISamplerState& _getSampler(SamplerState samplerState)
+    {
+        static const ISamplerState defaultSampler;
+        return samplerState.state ? *samplerState.state : defaultSampler;
+    }
+
+    float _calcLOD(const ISamplerState& sampler, float level) const
+    {
+        float lod = level + sampler.mipLODBias;
+        lod = (lod < sampler.minLOD) ? sampler.minLOD : lod;
+        lod = (lod > sampler.maxLOD) ? sampler.maxLOD : lod;
+        return lod;
+    }
+
+        /// Apply an address mode to an integer texel coordinate. Returns -1 if the coordinate is for the border.
+    static int _applyAddressMode(TextureAddressMode mode, int coord, int size)
+    {
+        if (coord >= 0 && coord < size)
+        {
+            return coord;
+        }
+        switch (mode)
+        {
+            case TextureAddressMode::Wrap:
+            {
+                const int r = coord % size;
+                return (r < 0) ? r + size : r;
+            }
+            case TextureAddressMode::Mirror:
+            {
+                int r = coord % (size * 2);
+                r = (r < 0) ? r + size * 2 : r;
+                return (r < size) ? r : (size * 2 - 1 - r);
+            }
+            case TextureAddressMode::MirrorOnce:
+            {
+                coord = (coord < 0) ? (-1 - coord) : coord;
+                return (coord < size) ? coord : size - 1;
+            }
+            case TextureAddressMode::Border:
+            {
+                return -1;
+            }
+            default:
+            {
+                return (coord < 0) ? 0 : size - 1;
+            }
+        }
+    }
+
+        /// Limit a texel location to a range that is safe to convert to int, without changing the texels it addresses.
+        /// NaN is treated as 0.
+    static float _calcSafeTexelLoc(TextureAddressMode mode, float texelLoc, int size)
+    {
+        const float period = float(size * 2);
+        if ((mode == TextureAddressMode::Wrap || mode == TextureAddressMode::Mirror) && fabsf(texelLoc) > period)
+        {
+            // Both repeat every 2 * size texels. fmodf is exact, so the fraction is kept.
+            texelLoc = fmodf(texelLoc, period);
+        }
+        // Otherwise all locations more than a texel beyond an edge address the same texels. This is written
+        // such that NaN (including from fmodf of an infinity), for which all comparisons are false, gives 0.
+        const float limit = period + 2.0f;
+        if (!(fabsf(texelLoc) <= limit))
+        {
+            return (texelLoc > 0.0f) ? limit : ((texelLoc < 0.0f) ? -limit : 0.0f);
+        }
+        return texelLoc;
+    }
+
+        /// Convert a cube map direction into a face, and the location on the face
+    static int _calcCubeFace(const float* dir, float outLoc[2])
+    {
+        const float x = dir[0], y = dir[1], z = dir[2];
+        const float ax = fabsf(x), ay = fabsf(y), az = fabsf(z);
+        int face;
+        float sc, tc, ma;
+        if (ax >= ay && ax >= az)
+        {
+            face = (x >= 0.0f) ? 0 : 1;
+            sc = (x >= 0.0f) ? -z : z;
+            tc = -y;
+            ma = ax;
+        }
+        else if (ay >= az)
+        {
+            face = (y >= 0.0f) ? 2 : 3;
+            sc = x;
+            tc = (y >= 0.0f) ? z : -z;
+            ma = ay;
+        }
+        else
+        {
+            face = (z >= 0.0f) ? 4 : 5;
+            sc = (z >= 0.0f) ? x : -x;
+            tc = -y;
+            ma = az;
+        }
+        const float scale = (ma > 0.0f) ? 0.5f / ma : 0.0f;
+        outLoc[0] = sc * scale + 0.5f;
+        outLoc[1] = tc * scale + 0.5f;
+        return face;
+    }
+
+        /// Sample a single level of a slice, accumulating weight times the result into out
+    template <int DIM_COUNT>
+    void _sampleLevel(const ISamplerState& sampler, TextureFilterMode filter, int mipLevel, int slice, const float* loc, float weight, float* out)
+    {
+        const Level& level = m_levels[mipLevel];
+        const TextureAddressMode addressModes[3] = { sampler.addressU, sampler.addressV, sampler.addressW };
+
+        // For each dimension, the two texel coordinates and the weight of the second one. Point sampling
+        // only uses the first.
+        int coords[3][2] = {};
+        float fracs[3] = {};
+        for (int i = 0; i < DIM_COUNT; ++i)
+        {
+            const float texelLoc = _calcSafeTexelLoc(addressModes[i], loc[i] * level.sizeFloat[i], level.size[i]);
+            if (filter == TextureFilterMode::Linear)
+            {
+                const float t = texelLoc - 0.5f;
+                const float base = floorf(t);
+                const int coord = int(base);
+                fracs[i] = t - base;
+                coords[i][0] = _applyAddressMode(addressModes[i], coord, level.size[i]);
+                coords[i][1] = _applyAddressMode(addressModes[i], coord + 1, level.size[i]);
+            }
+            else
+            {
+                coords[i][0] = _applyAddressMode(addressModes[i], int(floorf(texelLoc)), level.size[i]);
+            }
+        }
+
+        const int cornerCount = (filter == TextureFilterMode::Linear) ? (1 << DIM_COUNT) : 1;
+        for (int corner = 0; corner < cornerCount; ++corner)
+        {
+            float cornerWeight = weight;
+            int texelCoords[3] = { 0, 0, 0 };
+            bool isBorder = false;
+            for (int i = 0; i < DIM_COUNT; ++i)
+            {
+                const int side = (corner >> i) & 1;
+                if (filter == TextureFilterMode::Linear)
+                {
+                    cornerWeight *= side ? fracs[i] : (1.0f - fracs[i]);
+                }
+                texelCoords[i] = coords[i][side];
+                isBorder = isBorder || texelCoords[i] < 0;
+            }
+            if (cornerWeight == 0.0f)
+            {
+                continue;
+            }
+            const float* texel = isBorder ? sampler.borderColor : getTexel(mipLevel, slice, texelCoords[0], texelCoords[1], texelCoords[2]);
+            for (int c = 0; c < CHANNEL_COUNT; ++c)
+            {
+                out[c] += cornerWeight * texel[c];
+            }
+        }
+    }
+
+    template <int DIM_COUNT>
+    void _sampleSlice(const ISamplerState& sampler, const float* loc, int slice, float lod, float* out)
+    {
+        _setZero(out);
+
+        // A lod of 0 or less is magnification, which only uses the top level. A NaN lod is treated as 0.
+        const bool isMagnified = !(lod > 0.0f);
+        if (isMagnified || m_dims.numberOfLevels <= 1)
+        {
+            _sampleLevel<DIM_COUNT>(sampler, isMagnified ? sampler.magFilter : sampler.minFilter, 0, slice, loc, 1.0f, out);
+            return;
+        }
+
+        const float maxLevel = float(m_dims.numberOfLevels - 1);
+        lod = (lod > maxLevel) ? maxLevel : lod;
+
+        if (sampler.mipFilter == TextureFilterMode::Linear)
+        {
+            const int level0 = int(lod);
+            const float frac = lod - float(level0);
+            _sampleLevel<DIM_COUNT>(sampler, sampler.minFilter, level0, slice, loc, 1.0f - frac, out);
+            if (frac > 0.0f)
+            {
+                _sampleLevel<DIM_COUNT>(sampler, sampler.minFilter, level0 + 1, slice, loc, frac, out);
+            }
+        }
+        else
+        {
+            _sampleLevel<DIM_COUNT>(sampler, sampler.minFilter, int(lod + 0.5f), slice, loc, 1.0f, out);
+        }
+    }
+
+    void _sample(const ISamplerState& sampler, const float* loc, float lod, float* out)
+    {
+        int slice = 0;
+        if (m_isArray)
+        {
+            // The array index is rounded to the nearest element and clamped. It's clamped before conversion to int, as
+            // converting an out of range value is undefined. NaN, for which comparisons are false, gives 0.
+            const float arrayIndex = floorf(loc[m_locCount - 1] + 0.5f);
+            const float maxArrayIndex = float(m_arrayCount - 1);
+            slice = (arrayIndex > 0.0f) ? int((arrayIndex < maxArrayIndex) ? arrayIndex : maxArrayIndex) : 0;
+        }
+
+        if (m_isCube)
+        {
+            float faceLoc[2];
+            const int face = _calcCubeFace(loc, faceLoc);
+            // Don't wrap or mirror onto the wrong part of the face
+            ISamplerState faceSampler(sampler);
+            faceSampler.addressU = faceSampler.addressV = TextureAddressMode::Clamp;
+            _sampleSlice<2>(faceSampler, faceLoc, slice * 6 + face, lod, out);
+            return;
+        }
+
+        switch (m_dimCount)
+        {
+            case 1:     _sampleSlice<1>(sampler, loc, slice, lod, out); break;
+            case 2:     _sampleSlice<2>(sampler, loc, slice, lod, out); break;
+            default:    _sampleSlice<3>(sampler, loc, slice, lod, out); break;
+        }
+    }
+
+    TextureDimensions m_dims;
+    int m_dimCount;                             ///< The number of dimensions of a slice (1, 2 or 3)
+    int m_locCount;                             ///< The number of components in a sample location
+    bool m_isCube;
+    bool m_isArray;
+    int m_arrayCount;
+    int m_sliceCount;
+
+    int m_tileShift[3];                         ///< log2 of the size of a tile in each dimension
+    int m_tileMask[3];
+    int m_tileTexelShift;                       ///< log2 of the number of texels in a tile
+
+    // The offset of a texel within a tile, for the low bits of each coordinate
+    uint32_t m_mortonX[64] = {};
+    uint32_t m_mortonY[64] = {};
+    uint32_t m_mortonZ[64] = {};
+
+    std::vector<Level> m_levels;
+    std::vector<float> m_data;
+};
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+}
+#endif
+
+#endif
@@ -449,6 +449,23 @@ struct ITexture
     virtual void Load(const int* v, void* out) = 0;
     virtual void Sample(SamplerState samplerState, const float* loc, void* out) = 0;
     virtual void SampleLevel(SamplerState samplerState, const float* loc, float level, void* out) = 0;
+
+        /// Sample at 4 locations. locStride and outStride are the sizes in bytes of a location and of a result.
+        /// Implementations can override these to avoid a virtual call per sample.
+    virtual void Sample4(SamplerState samplerState, const float* locs, size_t locStride, void* out, size_t outStride)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            Sample(samplerState, (const float*)((const char*)locs + locStride * i), (char*)out + outStride * i);
+        }
+    }
+    virtual void SampleLevel4(SamplerState samplerState, const float* locs, size_t locStride, const float* levels, void* out, size_t outStride)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            SampleLevel(samplerState, (const float*)((const char*)locs + locStride * i), levels[i], (char*)out + outStride * i);
+        }
+    }
 };
 
 template <typename T>
@@ -473,6 +490,8 @@ struct Texture1D
     T Load(const int2& loc) const { T out; texture->Load(&loc.x, &out); return out; }
     T Sample(SamplerState samplerState, float loc) const { T out; texture->Sample(samplerState, &loc, &out); return out; }
     T SampleLevel(SamplerState samplerState, float loc, float level) { T out; texture->SampleLevel(samplerState, &loc, level, &out); return out; }
+    void Sample4(SamplerState samplerState, const float locs[4], T out[4]) const { texture->Sample4(samplerState, locs, sizeof(float), out, sizeof(T)); }
+    void SampleLevel4(SamplerState samplerState, const float locs[4], const float levels[4], T out[4]) const { texture->SampleLevel4(samplerState, locs, sizeof(float), levels, out, sizeof(T)); }
     
     ITexture* texture;              
 };
@@ -510,6 +529,8 @@ struct Texture2D
     T Load(const int3& loc) const { T out; texture->Load(&loc.x, &out); return out; }
     T Sample(SamplerState samplerState, const float2& loc) const { T out; texture->Sample(samplerState, &loc.x, &out); return out; }
     T SampleLevel(SamplerState samplerState, const float2& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out); return out; }
+    void Sample4(SamplerState samplerState, const float2 locs[4], T out[4]) const { texture->Sample4(samplerState, &locs[0].x, sizeof(float2), out, sizeof(T)); }
+    void SampleLevel4(SamplerState samplerState, const float2 locs[4], const float levels[4], T out[4]) const { texture->SampleLevel4(samplerState, &locs[0].x, sizeof(float2), levels, out, sizeof(T)); }
     
     ITexture* texture;              
 };
@@ -551,6 +572,8 @@ struct Texture3D
     T Load(const int4& loc) const { T out; texture->Load(&loc.x, &out); return out; }
     T Sample(SamplerState samplerState, const float3& loc) const { T out; texture->Sample(samplerState, &loc.x, &out); return out; }
     T SampleLevel(SamplerState samplerState, const float3& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out); return out; }
+    void Sample4(SamplerState samplerState, const float3 locs[4], T out[4]) const { texture->Sample4(samplerState, &locs[0].x, sizeof(float3), out, sizeof(T)); }
+    void SampleLevel4(SamplerState samplerState, const float3 locs[4], const float levels[4], T out[4]) const { texture->SampleLevel4(samplerState, &locs[0].x, sizeof(float3), levels, out, sizeof(T)); }
     
     ITexture* texture;              
 };
@@ -587,6 +610,8 @@ struct TextureCube
     
     T Sample(SamplerState samplerState, const float3& loc) const { T out; texture->Sample(samplerState, &loc.x, &out); return out; }
     T SampleLevel(SamplerState samplerState, const float3& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out); return out; }
+    void Sample4(SamplerState samplerState, const float3 locs[4], T out[4]) const { texture->Sample4(samplerState, &locs[0].x, sizeof(float3), out, sizeof(T)); }
+    void SampleLevel4(SamplerState samplerState, const float3 locs[4], const float levels[4], T out[4]) const { texture->SampleLevel4(samplerState, &locs[0].x, sizeof(float3), levels, out, sizeof(T)); }
     
     ITexture* texture;              
 };
@@ -614,6 +639,8 @@ struct Texture1DArray
     T Load(const int3& loc) const { T out; texture->Load(&loc.x, &out); return out; }
     T Sample(SamplerState samplerState, const float2& loc) const { T out; texture->Sample(samplerState, &loc.x, &out); return out; }
     T SampleLevel(SamplerState samplerState, const float2& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out); return out; }
+    void Sample4(SamplerState samplerState, const float2 locs[4], T out[4]) const { texture->Sample4(samplerState, &locs[0].x, sizeof(float2), out, sizeof(T)); }
+    void SampleLevel4(SamplerState samplerState, const float2 locs[4], const float levels[4], T out[4]) const { texture->SampleLevel4(samplerState, &locs[0].x, sizeof(float2), levels, out, sizeof(T)); }
     
     ITexture* texture;              
 };
@@ -656,6 +683,8 @@ struct Texture2DArray
     T Load(const int4& loc) const { T out; texture->Load(&loc.x, &out); return out; }
     T Sample(SamplerState samplerState, const float3& loc) const { T out; texture->Sample(samplerState, &loc.x, &out); return out; }
     T SampleLevel(SamplerState samplerState, const float3& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out); return out; }
+    void Sample4(SamplerState samplerState, const float3 locs[4], T out[4]) const { texture->Sample4(samplerState, &locs[0].x, sizeof(float3), out, sizeof(T)); }
+    void SampleLevel4(SamplerState samplerState, const float3 locs[4], const float levels[4], T out[4]) const { texture->SampleLevel4(samplerState, &locs[0].x, sizeof(float3), levels, out, sizeof(T)); }
     
     ITexture* texture;              
 };
@@ -697,6 +726,8 @@ struct TextureCubeArray
     
     T Sample(SamplerState samplerState, const float4& loc) const { T out; texture->Sample(samplerState, &loc.x, &out); return out; }
     T SampleLevel(SamplerState samplerState, const float4& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out); return out; }
+    void Sample4(SamplerState samplerState, const float4 locs[4], T out[4]) const { texture->Sample4(samplerState, &locs[0].x, sizeof(float4), out, sizeof(T)); }
+    void SampleLevel4(SamplerState samplerState, const float4 locs[4], const float levels[4], T out[4]) const { texture->SampleLevel4(samplerState, &locs[0].x, sizeof(float4), levels, out, sizeof(T)); }
     
     ITexture* texture;              
 };
@@ -0,0 +1,396 @@
+#ifndef SLANG_PRELUDE_VECTOR_INTRINSICS_H
+#define SLANG_PRELUDE_VECTOR_INTRINSICS_H
+
+/* Vector and matrix intrinsics for the C++ target.
+
+The stdlib maps `dot`, `normalize`, `lerp`, `rsqrt` and `mul` on vectors and matrices to the `slang_` functions
+below, and the C++ emitter implements vector +, -, * and / through the `slang_vector_` functions.
+
+The templates work for any Vector/Matrix. When SIMD is enabled there are also SSE overloads (and AVX where the
+compiler targets it) for the common 32 bit types - float3, float4, float4x4, int4 and uint4 - which overload
+resolution picks in preference to the templates. The SIMD versions perform the same operations in the same order
+as the templates, so enabling SIMD changes performance but not results.
+
+SIMD is enabled by default when compiling for x86 with SSE2 (which includes all x86-64 targets). Define
+SLANG_PRELUDE_ENABLE_SIMD as 0 before including the prelude to only use the templates. */
+
+#if !defined(SLANG_PRELUDE_ENABLE_SIMD) || SLANG_PRELUDE_ENABLE_SIMD
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define SLANG_PRELUDE_SIMD_SSE 1
+#       include <emmintrin.h>
+#   endif
+#   if SLANG_PRELUDE_SIMD_SSE && (defined(__SSE4_1__) || defined(__AVX__))
+#       define SLANG_PRELUDE_SIMD_SSE4_1 1
+#       include <smmintrin.h>
+#   endif
+#   if SLANG_PRELUDE_SIMD_SSE && defined(__AVX__)
+#       define SLANG_PRELUDE_SIMD_AVX 1
+#       include <immintrin.h>
+#   endif
+#endif
+
+#ifndef SLANG_FORCE_INLINE
+#    define SLANG_FORCE_INLINE inline
+#endif
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+namespace SLANG_PRELUDE_NAMESPACE {
+#endif
+
+// ----------------------------- Scalar -----------------------------------------
+
+// Overloads so the templates can be written independent of the floating point type
+
+SLANG_FORCE_INLINE float slang_sqrt(float f) { return F32_sqrt(f); }
+SLANG_FORCE_INLINE double slang_sqrt(double f) { return F64_sqrt(f); }
+
+SLANG_FORCE_INLINE float slang_rsqrt(float f) { return F32_rsqrt(f); }
+SLANG_FORCE_INLINE double slang_rsqrt(double f) { return F64_rsqrt(f); }
+
+// ----------------------------- Templates -----------------------------------------
+
+// The elements of a Vector are contiguous, so can be accessed through a pointer to the first element
+
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_vector_add(Vector<T, N> a, Vector<T, N> b)
+{
+    Vector<T, N> r;
+    for (int i = 0; i < N; ++i) (&r.x)[i] = (&a.x)[i] + (&b.x)[i];
+    return r;
+}
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_vector_add(Vector<T, N> a, T b)
+{
+    Vector<T, N> r;
+    for (int i = 0; i < N; ++i) (&r.x)[i] = (&a.x)[i] + b;
+    return r;
+}
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_vector_add(T a, Vector<T, N> b)
+{
+    Vector<T, N> r;
+    for (int i = 0; i < N; ++i) (&r.x)[i] = a + (&b.x)[i];
+    return r;
+}
+
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_vector_sub(Vector<T, N> a, Vector<T, N> b)
+{
+    Vector<T, N> r;
+    for (int i = 0; i < N; ++i) (&r.x)[i] = (&a.x)[i] - (&b.x)[i];
+    return r;
+}
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_vector_sub(Vector<T, N> a, T b)
+{
+    Vector<T, N> r;
+    for (int i = 0; i < N; ++i) (&r.x)[i] = (&a.x)[i] - b;
+    return r;
+}
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_vector_sub(T a, Vector<T, N> b)
+{
+    Vector<T, N> r;
+    for (int i = 0; i < N; ++i) (&r.x)[i] = a - (&b.x)[i];
+    return r;
+}
+
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_vector_mul(Vector<T, N> a, Vector<T, N> b)
+{
+    Vector<T, N> r;
+    for (int i = 0; i < N; ++i) (&r.x)[i] = (&a.x)[i] * (&b.x)[i];
+    return r;
+}
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_vector_mul(Vector<T, N> a, T b)
+{
+    Vector<T, N> r;
+    for (int i = 0; i < N; ++i) (&r.x)[i] = (&a.x)[i] * b;
+    return r;
+}
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_vector_mul(T a, Vector<T, N> b)
+{
+    Vector<T, N> r;
+    for (int i = 0; i < N; ++i) (&r.x)[i] = a * (&b.x)[i];
+    return r;
+}
+
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_vector_div(Vector<T, N> a, Vector<T, N> b)
+{
+    Vector<T, N> r;
+    for (int i = 0; i < N; ++i) (&r.x)[i] = (&a.x)[i] / (&b.x)[i];
+    return r;
+}
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_vector_div(Vector<T, N> a, T b)
+{
+    Vector<T, N> r;
+    for (int i = 0; i < N; ++i) (&r.x)[i] = (&a.x)[i] / b;
+    return r;
+}
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_vector_div(T a, Vector<T, N> b)
+{
+    Vector<T, N> r;
+    for (int i = 0; i < N; ++i) (&r.x)[i] = a / (&b.x)[i];
+    return r;
+}
+
+template <typename T, int N>
+SLANG_FORCE_INLINE T slang_dot(Vector<T, N> a, Vector<T, N> b)
+{
+    T r = a.x * b.x;
+    for (int i = 1; i < N; ++i) r += (&a.x)[i] * (&b.x)[i];
+    return r;
+}
+
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_normalize(Vector<T, N> a)
+{
+    return slang_vector_div(a, slang_sqrt(slang_dot(a, a)));
+}
+
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_rsqrt(Vector<T, N> a)
+{
+    Vector<T, N> r;
+    for (int i = 0; i < N; ++i) (&r.x)[i] = slang_rsqrt((&a.x)[i]);
+    return r;
+}
+
+template <typename T, int N>
+SLANG_FORCE_INLINE Vector<T, N> slang_lerp(Vector<T, N> a, Vector<T, N> b, Vector<T, N> s)
+{
+    Vector<T, N> r;
+    for (int i = 0; i < N; ++i) (&r.x)[i] = (&a.x)[i] * (T(1) - (&s.x)[i]) + (&b.x)[i] * (&s.x)[i];
+    return r;
+}
+
+// mul follows the HLSL convention: a vector on the left is a row vector, a vector on the right is a column vector
+
+template <typename T, int R, int C>
+SLANG_FORCE_INLINE Vector<T, C> slang_mul(Vector<T, R> a, Matrix<T, R, C> b)
+{
+    Vector<T, C> r = slang_vector_mul(a.x, b.rows[0]);
+    for (int i = 1; i < R; ++i) r = slang_vector_add(r, slang_vector_mul((&a.x)[i], b.rows[i]));
+    return r;
+}
+
+template <typename T, int R, int C>
+SLANG_FORCE_INLINE Vector<T, R> slang_mul(Matrix<T, R, C> a, Vector<T, C> b)
+{
+    Vector<T, R> r;
+    for (int i = 0; i < R; ++i) (&r.x)[i] = slang_dot(a.rows[i], b);
+    return r;
+}
+
+template <typename T, int R, int N, int C>
+SLANG_FORCE_INLINE Matrix<T, R, C> slang_mul(Matrix<T, R, N> a, Matrix<T, N, C> b)
+{
+    Matrix<T, R, C> r;
+    for (int i = 0; i < R; ++i) r.rows[i] = slang_mul(a.rows[i], b);
+    return r;
+}
+
+#if SLANG_PRELUDE_SIMD_SSE
+
+// ----------------------------- SSE float -----------------------------------------
+
+SLANG_FORCE_INLINE __m128 slang_simd_load(const Vector<float, 4>& v) { return _mm_loadu_ps(&v.x); }
+SLANG_FORCE_INLINE __m128 slang_simd_load(const Vector<float, 3>& v) { return _mm_setr_ps(v.x, v.y, v.z, 0.0f); }
+
+SLANG_FORCE_INLINE Vector<float, 4> slang_simd_storeFloat4(__m128 v)
+{
+    Vector<float, 4> r;
+    _mm_storeu_ps(&r.x, v);
+    return r;
+}
+SLANG_FORCE_INLINE Vector<float, 3> slang_simd_storeFloat3(__m128 v)
+{
+    float elements[4];
+    _mm_storeu_ps(elements, v);
+    return Vector<float, 3>{ elements[0], elements[1], elements[2] };
+}
+
+    /// Sums the first COUNT lanes from first to last, so the result matches adding the elements in a loop
+template <int COUNT>
+SLANG_FORCE_INLINE float slang_simd_sum(__m128 v)
+{
+    __m128 r = _mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+    r = _mm_add_ss(r, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)));
+    if (COUNT > 3)
+    {
+        r = _mm_add_ss(r, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+    return _mm_cvtss_f32(r);
+}
+
+SLANG_FORCE_INLINE Vector<float, 4> slang_vector_add(Vector<float, 4> a, Vector<float, 4> b) { return slang_simd_storeFloat4(_mm_add_ps(slang_simd_load(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<float, 4> slang_vector_add(Vector<float, 4> a, float b) { return slang_simd_storeFloat4(_mm_add_ps(slang_simd_load(a), _mm_set1_ps(b))); }
+SLANG_FORCE_INLINE Vector<float, 4> slang_vector_add(float a, Vector<float, 4> b) { return slang_simd_storeFloat4(_mm_add_ps(_mm_set1_ps(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<float, 3> slang_vector_add(Vector<float, 3> a, Vector<float, 3> b) { return slang_simd_storeFloat3(_mm_add_ps(slang_simd_load(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<float, 3> slang_vector_add(Vector<float, 3> a, float b) { return slang_simd_storeFloat3(_mm_add_ps(slang_simd_load(a), _mm_set1_ps(b))); }
+SLANG_FORCE_INLINE Vector<float, 3> slang_vector_add(float a, Vector<float, 3> b) { return slang_simd_storeFloat3(_mm_add_ps(_mm_set1_ps(a), slang_simd_load(b))); }
+
+SLANG_FORCE_INLINE Vector<float, 4> slang_vector_sub(Vector<float, 4> a, Vector<float, 4> b) { return slang_simd_storeFloat4(_mm_sub_ps(slang_simd_load(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<float, 4> slang_vector_sub(Vector<float, 4> a, float b) { return slang_simd_storeFloat4(_mm_sub_ps(slang_simd_load(a), _mm_set1_ps(b))); }
+SLANG_FORCE_INLINE Vector<float, 4> slang_vector_sub(float a, Vector<float, 4> b) { return slang_simd_storeFloat4(_mm_sub_ps(_mm_set1_ps(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<float, 3> slang_vector_sub(Vector<float, 3> a, Vector<float, 3> b) { return slang_simd_storeFloat3(_mm_sub_ps(slang_simd_load(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<float, 3> slang_vector_sub(Vector<float, 3> a, float b) { return slang_simd_storeFloat3(_mm_sub_ps(slang_simd_load(a), _mm_set1_ps(b))); }
+SLANG_FORCE_INLINE Vector<float, 3> slang_vector_sub(float a, Vector<float, 3> b) { return slang_simd_storeFloat3(_mm_sub_ps(_mm_set1_ps(a), slang_simd_load(b))); }
+
+SLANG_FORCE_INLINE Vector<float, 4> slang_vector_mul(Vector<float, 4> a, Vector<float, 4> b) { return slang_simd_storeFloat4(_mm_mul_ps(slang_simd_load(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<float, 4> slang_vector_mul(Vector<float, 4> a, float b) { return slang_simd_storeFloat4(_mm_mul_ps(slang_simd_load(a), _mm_set1_ps(b))); }
+SLANG_FORCE_INLINE Vector<float, 4> slang_vector_mul(float a, Vector<float, 4> b) { return slang_simd_storeFloat4(_mm_mul_ps(_mm_set1_ps(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<float, 3> slang_vector_mul(Vector<float, 3> a, Vector<float, 3> b) { return slang_simd_storeFloat3(_mm_mul_ps(slang_simd_load(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<float, 3> slang_vector_mul(Vector<float, 3> a, float b) { return slang_simd_storeFloat3(_mm_mul_ps(slang_simd_load(a), _mm_set1_ps(b))); }
+SLANG_FORCE_INLINE Vector<float, 3> slang_vector_mul(float a, Vector<float, 3> b) { return slang_simd_storeFloat3(_mm_mul_ps(_mm_set1_ps(a), slang_simd_load(b))); }
+
+SLANG_FORCE_INLINE Vector<float, 4> slang_vector_div(Vector<float, 4> a, Vector<float, 4> b) { return slang_simd_storeFloat4(_mm_div_ps(slang_simd_load(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<float, 4> slang_vector_div(Vector<float, 4> a, float b) { return slang_simd_storeFloat4(_mm_div_ps(slang_simd_load(a), _mm_set1_ps(b))); }
+SLANG_FORCE_INLINE Vector<float, 4> slang_vector_div(float a, Vector<float, 4> b) { return slang_simd_storeFloat4(_mm_div_ps(_mm_set1_ps(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<float, 3> slang_vector_div(Vector<float, 3> a, Vector<float, 3> b) { return slang_simd_storeFloat3(_mm_div_ps(slang_simd_load(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<float, 3> slang_vector_div(Vector<float, 3> a, float b) { return slang_simd_storeFloat3(_mm_div_ps(slang_simd_load(a), _mm_set1_ps(b))); }
+SLANG_FORCE_INLINE Vector<float, 3> slang_vector_div(float a, Vector<float, 3> b) { return slang_simd_storeFloat3(_mm_div_ps(_mm_set1_ps(a), slang_simd_load(b))); }
+
+SLANG_FORCE_INLINE float slang_dot(Vector<float, 4> a, Vector<float, 4> b)
+{
+    return slang_simd_sum<4>(_mm_mul_ps(slang_simd_load(a), slang_simd_load(b)));
+}
+SLANG_FORCE_INLINE float slang_dot(Vector<float, 3> a, Vector<float, 3> b)
+{
+    return slang_simd_sum<3>(_mm_mul_ps(slang_simd_load(a), slang_simd_load(b)));
+}
+
+SLANG_FORCE_INLINE Vector<float, 4> slang_normalize(Vector<float, 4> a)
+{
+    const __m128 v = slang_simd_load(a);
+    const __m128 lengthSquared = _mm_set1_ps(slang_simd_sum<4>(_mm_mul_ps(v, v)));
+    return slang_simd_storeFloat4(_mm_div_ps(v, _mm_sqrt_ps(lengthSquared)));
+}
+SLANG_FORCE_INLINE Vector<float, 3> slang_normalize(Vector<float, 3> a)
+{
+    const __m128 v = slang_simd_load(a);
+    const __m128 lengthSquared = _mm_set1_ps(slang_simd_sum<3>(_mm_mul_ps(v, v)));
+    return slang_simd_storeFloat3(_mm_div_ps(v, _mm_sqrt_ps(lengthSquared)));
+}
+
+// Uses a full precision divide and square root rather than _mm_rsqrt_ps, which is only an approximation
+SLANG_FORCE_INLINE Vector<float, 4> slang_rsqrt(Vector<float, 4> a)
+{
+    return slang_simd_storeFloat4(_mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(slang_simd_load(a))));
+}
+SLANG_FORCE_INLINE Vector<float, 3> slang_rsqrt(Vector<float, 3> a)
+{
+    return slang_simd_storeFloat3(_mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(slang_simd_load(a))));
+}
+
+SLANG_FORCE_INLINE __m128 slang_simd_lerp(__m128 a, __m128 b, __m128 s)
+{
+    return _mm_add_ps(_mm_mul_ps(a, _mm_sub_ps(_mm_set1_ps(1.0f), s)), _mm_mul_ps(b, s));
+}
+SLANG_FORCE_INLINE Vector<float, 4> slang_lerp(Vector<float, 4> a, Vector<float, 4> b, Vector<float, 4> s)
+{
+    return slang_simd_storeFloat4(slang_simd_lerp(slang_simd_load(a), slang_simd_load(b), slang_simd_load(s)));
+}
+SLANG_FORCE_INLINE Vector<float, 3> slang_lerp(Vector<float, 3> a, Vector<float, 3> b, Vector<float, 3> s)
+{
+    return slang_simd_storeFloat3(slang_simd_lerp(slang_simd_load(a), slang_simd_load(b), slang_simd_load(s)));
+}
+
+    /// Row vector a multiplied by the matrix whose rows are in rows
+SLANG_FORCE_INLINE __m128 slang_simd_mulRows4(__m128 a, const Vector<float, 4>* rows)
+{
+    __m128 r = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), slang_simd_load(rows[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), slang_simd_load(rows[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), slang_simd_load(rows[2])));
+    return _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), slang_simd_load(rows[3])));
+}
+
+SLANG_FORCE_INLINE Vector<float, 4> slang_mul(Vector<float, 4> a, Matrix<float, 4, 4> b)
+{
+    return slang_simd_storeFloat4(slang_simd_mulRows4(slang_simd_load(a), b.rows));
+}
+
+SLANG_FORCE_INLINE Vector<float, 4> slang_mul(Matrix<float, 4, 4> a, Vector<float, 4> b)
+{
+    // Each result element is the dot product of a row with b. Transposing a means the four dot products
+    // are computed at once, with the products summed in the same order as slang_dot.
+    __m128 row0 = slang_simd_load(a.rows[0]);
+    __m128 row1 = slang_simd_load(a.rows[1]);
+    __m128 row2 = slang_simd_load(a.rows[2]);
+    __m128 row3 = slang_simd_load(a.rows[3]);
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+    const __m128 v = slang_simd_load(b);
+    __m128 r = _mm_mul_ps(row0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+    r = _mm_add_ps(r, _mm_mul_ps(row1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+    r = _mm_add_ps(r, _mm_mul_ps(row2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+    r = _mm_add_ps(r, _mm_mul_ps(row3, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+    return slang_simd_storeFloat4(r);
+}
+
+SLANG_FORCE_INLINE Matrix<float, 4, 4> slang_mul(Matrix<float, 4, 4> a, Matrix<float, 4, 4> b)
+{
+    Matrix<float, 4, 4> r;
+#if SLANG_PRELUDE_SIMD_AVX
+    // Two rows of the result at a time, with each row of b in both halves of a register
+    for (int i = 0; i < 4; i += 2)
+    {
+        const float* a0 = &a.rows[i].x;
+        const float* a1 = &a.rows[i + 1].x;
+
+        __m256 acc = _mm256_mul_ps(_mm256_setr_ps(a0[0], a0[0], a0[0], a0[0], a1[0], a1[0], a1[0], a1[0]), _mm256_broadcast_ps((const __m128*)&b.rows[0].x));
+        for (int k = 1; k < 4; ++k)
+        {
+            const __m256 s = _mm256_setr_ps(a0[k], a0[k], a0[k], a0[k], a1[k], a1[k], a1[k], a1[k]);
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(s, _mm256_broadcast_ps((const __m128*)&b.rows[k].x)));
+        }
+        _mm256_storeu_ps(&r.rows[i].x, acc);
+    }
+#else
+    for (int i = 0; i < 4; ++i)
+    {
+        _mm_storeu_ps(&r.rows[i].x, slang_simd_mulRows4(slang_simd_load(a.rows[i]), b.rows));
+    }
+#endif
+    return r;
+}
+
+// ----------------------------- SSE int -----------------------------------------
+
+// The same bit operations implement signed and unsigned wrap around arithmetic
+
+SLANG_FORCE_INLINE __m128i slang_simd_load(const Vector<int32_t, 4>& v) { return _mm_loadu_si128((const __m128i*)&v.x); }
+SLANG_FORCE_INLINE __m128i slang_simd_load(const Vector<uint32_t, 4>& v) { return _mm_loadu_si128((const __m128i*)&v.x); }
+
+template <typename T>
+SLANG_FORCE_INLINE Vector<T, 4> slang_simd_storeInt4(__m128i v)
+{
+    Vector<T, 4> r;
+    _mm_storeu_si128((__m128i*)&r.x, v);
+    return r;
+}
+
+SLANG_FORCE_INLINE Vector<int32_t, 4> slang_vector_add(Vector<int32_t, 4> a, Vector<int32_t, 4> b) { return slang_simd_storeInt4<int32_t>(_mm_add_epi32(slang_simd_load(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<uint32_t, 4> slang_vector_add(Vector<uint32_t, 4> a, Vector<uint32_t, 4> b) { return slang_simd_storeInt4<uint32_t>(_mm_add_epi32(slang_simd_load(a), slang_simd_load(b))); }
+
+SLANG_FORCE_INLINE Vector<int32_t, 4> slang_vector_sub(Vector<int32_t, 4> a, Vector<int32_t, 4> b) { return slang_simd_storeInt4<int32_t>(_mm_sub_epi32(slang_simd_load(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<uint32_t, 4> slang_vector_sub(Vector<uint32_t, 4> a, Vector<uint32_t, 4> b) { return slang_simd_storeInt4<uint32_t>(_mm_sub_epi32(slang_simd_load(a), slang_simd_load(b))); }
+
+// SSE2 has no 32 bit multiply that keeps the low bits, so without SSE4.1 the templates are used
+#if SLANG_PRELUDE_SIMD_SSE4_1
+SLANG_FORCE_INLINE Vector<int32_t, 4> slang_vector_mul(Vector<int32_t, 4> a, Vector<int32_t, 4> b) { return slang_simd_storeInt4<int32_t>(_mm_mullo_epi32(slang_simd_load(a), slang_simd_load(b))); }
+SLANG_FORCE_INLINE Vector<uint32_t, 4> slang_vector_mul(Vector<uint32_t, 4> a, Vector<uint32_t, 4> b) { return slang_simd_storeInt4<uint32_t>(_mm_mullo_epi32(slang_simd_load(a), slang_simd_load(b))); }
+#endif
+
+#endif // SLANG_PRELUDE_SIMD_SSE
+
+#ifdef SLANG_PRELUDE_NAMESPACE
+}
+#endif
+
+#endif
@@ -259,7 +259,7 @@ workspace "slang"
         defines { "NDEBUG" }
             
     filter { "system:linux" }
-        linkoptions{  "-Wl,-rpath,'$$ORIGIN',--no-as-needed", "-ldl"}
+        linkoptions{  "-Wl,-rpath,'$$ORIGIN',--no-as-needed", "-ldl", "-pthread"}
             
 function dump(o)
     if type(o) == 'table' then
@@ -609,7 +609,26 @@ extern "C"
            in the input source or specified via the `spAddEntryPoint` function in a
            single output module (library/source file).
         */
-        SLANG_TARGET_FLAG_GENERATE_WHOLE_PROGRAM = 1 << 8
+        SLANG_TARGET_FLAG_GENERATE_WHOLE_PROGRAM = 1 << 8,
+
+        /* When generating C++ for a compute entry point, emit the function that runs a
+           thread group such that the threads of the group are the lanes of a loop the
+           downstream compiler can vectorize.
+        */
+        SLANG_TARGET_FLAG_CPU_GROUP_AS_LANES = 1 << 9,
+
+        /* Remove instructions that recompute a value already computed on every path
+           to them (global value numbering). This is always done at optimization
+           level SLANG_OPTIMIZATION_LEVEL_HIGH and above.
+        */
+        SLANG_TARGET_FLAG_GLOBAL_VALUE_NUMBERING = 1 << 10,
+
+        /* Move loop invariant instructions out of loops, and unroll `[unroll]` loops
+           that run a number of iterations known at compile time. This is always done
+           for the C/C++ and CUDA targets at optimization level SLANG_OPTIMIZATION_LEVEL_HIGH
+           and above.
+        */
+        SLANG_TARGET_FLAG_LOOP_OPTIMIZATIONS = 1 << 11
     };
 
     /*!
@@ -710,6 +729,41 @@ extern "C"
         SLANG_OPTIMIZATION_LEVEL_MAXIMAL,   /**< Include optimizations that may take a very long time, or may involve severe space-vs-speed tradeoffs */
     };
 
+    /*!
+    @brief Flags to control the instrumentation of a compile request */
+    typedef unsigned int SlangInstrumentationFlags;
+    enum
+    {
+        /* Time each phase of compilation and each IR pass, and count compiler events */
+        SLANG_INSTRUMENTATION_FLAG_ENABLE   = 1 << 0,
+
+        /* Also record each phase and pass as an event, so that a trace can be obtained */
+        SLANG_INSTRUMENTATION_FLAG_TRACE    = 1 << 1,
+
+        /* Also count the IR instructions before and after each IR pass, to record the change in size each pass makes.
+        This visits the whole IR module for each pass, so makes compilation slower. */
+        SLANG_INSTRUMENTATION_FLAG_IR_SIZE  = 1 << 2,
+    };
+
+    typedef unsigned int SlangInstrumentationEntryKind;
+    enum
+    {
+        SLANG_INSTRUMENTATION_ENTRY_KIND_PHASE,     /**< Time attributed to a phase (excluding nested phases), and the number of times it was entered */
+        SLANG_INSTRUMENTATION_ENTRY_KIND_PASS,      /**< Total time of an IR pass (including passes it runs), and the number of times it ran */
+        SLANG_INSTRUMENTATION_ENTRY_KIND_COUNTER,   /**< The value of a counter, such as the number of IR instructions created */
+    };
+
+    /*!
+    @brief A measurement made by the instrumentation of a compile request */
+    struct SlangInstrumentationEntry
+    {
+        const char*                     name;       /**< For example "parse", "eliminate-dead-code" or "ir-insts-created" */
+        SlangInstrumentationEntryKind   kind;
+        double                          seconds;    /**< Zero for counters */
+        SlangUInt                       count;
+        SlangInt                        irInstDelta; /**< For passes with SLANG_INSTRUMENTATION_FLAG_IR_SIZE set, the total change in the number of IR instructions. Otherwise zero. */
+    };
+
     /** A result code for a Slang API operation.
 
     This type is generally compatible with the Windows API `HRESULT` type. In particular, negative values indicate
@@ -1582,6 +1636,31 @@ extern "C"
     SLANG_API SlangResult spEnableReproCapture(
         SlangCompileRequest* request);
 
+    /*! @see slang::ICompileRequest::setInstrumentationFlags */
+    SLANG_API void spSetInstrumentationFlags(
+        SlangCompileRequest*        request,
+        SlangInstrumentationFlags   flags);
+
+    /*! @see slang::ICompileRequest::getInstrumentationEntryCount */
+    SLANG_API SlangInt spGetInstrumentationEntryCount(
+        SlangCompileRequest*        request);
+
+    /*! @see slang::ICompileRequest::getInstrumentationEntry */
+    SLANG_API SlangResult spGetInstrumentationEntry(
+        SlangCompileRequest*        request,
+        SlangInt                    index,
+        SlangInstrumentationEntry*  outEntry);
+
+    /*! @see slang::ICompileRequest::getInstrumentationTrace */
+    SLANG_API SlangResult spGetInstrumentationTrace(
+        SlangCompileRequest*        request,
+        ISlangBlob**                outBlob);
+
+    /*! @see slang::ICompileRequest::setModuleCachePath */
+    SLANG_API void spSetModuleCachePath(
+        SlangCompileRequest*        request,
+        const char*                 path);
+
 
     /** Extract contents of a repro.
 
@@ -2976,9 +3055,14 @@ namespace slang
         multiple sessions, in order to amortize startups costs (in current
         Slang this is mostly the cost of loading the Slang standard library).
 
-        The global session is currently *not* thread-safe and objects created from
-        a single global session should only be used from a single thread at
-        a time.
+        Once it has been configured (the standard library loaded, builtins added,
+        downstream compiler paths and preludes set etc), the global session can be
+        used from multiple threads at the same time. In particular `createSession`
+        and `createCompileRequest` can be called concurrently, and the sessions and
+        compile requests created can be used concurrently with each other.
+
+        Each session or compile request (and the objects created from it) should
+        only be used from a single thread at a time.
         */
     struct IGlobalSession : public ISlangUnknown
     {
@@ -3130,6 +3214,7 @@ namespace slang
         virtual SLANG_NO_THROW SlangResult SLANG_MCALL compileStdLib() = 0;
 
             /** Load the StdLib. Currently loads modules from the file system. 
+            The IR of the stdlib modules is only read when a compilation first needs it.
             @param stdLib Start address of the serialized stdlib
             @param stdLibSizeInBytes The size in bytes of the serialized stdlib
 
@@ -3704,6 +3789,55 @@ namespace slang
         virtual SLANG_NO_THROW SlangResult SLANG_MCALL getProgramWithEntryPoints(
             slang::IComponentType** outProgram) = 0;
 
+            /** Set flags to control the instrumentation of compilation, see SlangInstrumentationFlags.
+
+            Instrumentation records the time spent in each phase of compilation (preprocessing, parsing, checking,
+            lowering to IR, linking and optimization, emitting, downstream compilation) and in each IR pass, and counts
+            events such as the IR instructions created. The results are for the most recent compile.
+
+            @param flags            Pass 0 (the default) to disable instrumentation.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL setInstrumentationFlags(
+            SlangInstrumentationFlags   flags) = 0;
+
+            /** Get the number of entries measured by instrumentation. Zero if instrumentation is not enabled. */
+        virtual SLANG_NO_THROW SlangInt SLANG_MCALL getInstrumentationEntryCount() = 0;
+
+            /** Get an entry measured by instrumentation.
+
+            The name of the entry remains valid for the lifetime of the request.
+
+            @param index            The index of the entry, less than getInstrumentationEntryCount.
+            @param outEntry         Is set to the entry
+            @returns                A `SlangResult` to indicate success or failure.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getInstrumentationEntry(
+            SlangInt                    index,
+            SlangInstrumentationEntry*  outEntry) = 0;
+
+            /** Get the phases and passes of the most recent compile as Chrome trace event JSON.
+
+            The result can be viewed with chrome://tracing or https://ui.perfetto.dev.
+            Requires SLANG_INSTRUMENTATION_FLAG_TRACE to have been set before compiling.
+
+            @param outBlob          Is set to a blob holding the JSON text
+            @returns                A `SlangResult` to indicate success or failure. SLANG_E_NOT_AVAILABLE if there is no trace.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getInstrumentationTrace(
+            ISlangBlob**                outBlob) = 0;
+
+            /** Set a directory to cache checked imported modules in.
+
+            A module that is imported is stored in the cache after it has been checked. When a later request imports
+            the same module, and none of the files it depends on have changed, it is read from the cache rather than
+            being checked again. The directory can be shared between requests, and between processes.
+
+            @param path             The directory to hold the cache. It is created if it doesn't exist. Pass nullptr
+                                    (the default) to not cache modules.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL setModuleCachePath(
+            const char*                 path) = 0;
+
     };
 
     #define SLANG_UUID_ICompileRequest { 0x96d33993, 0x317c, 0x4db5, { 0xaf, 0xd8, 0x66, 0x6e, 0xe7, 0x72, 0x48, 0xe2 } };
@@ -0,0 +1,114 @@
+#include "slang-chunked-string.h"
+
+#include "slang-math.h"
+
+#include <string.h>
+
+namespace Slang {
+
+void ChunkedString::append(const String& text)
+{
+    // Empty chunks would only make iterating slower
+    if (text.getLength() > 0)
+    {
+        m_chunks.add(text);
+        m_length += text.getLength();
+    }
+}
+
+void ChunkedString::append(const UnownedStringSlice& text)
+{
+    if (text.getLength() > 0)
+    {
+        append(String(text));
+    }
+}
+
+void ChunkedString::append(const ThisType& rhs)
+{
+    m_chunks.addRange(rhs.m_chunks);
+    m_length += rhs.m_length;
+}
+
+ChunkedString ChunkedString::getSuffix(Index startIndex) const
+{
+    SLANG_ASSERT(startIndex >= 0 && startIndex <= m_length);
+
+    ThisType suffix;
+    for (const auto& chunk : m_chunks)
+    {
+        const Index chunkLength = chunk.getLength();
+        if (startIndex >= chunkLength)
+        {
+            startIndex -= chunkLength;
+        }
+        else if (startIndex > 0)
+        {
+            // Only the part of the chunk that straddles startIndex has to be copied
+            suffix.append(chunk.getUnownedSlice().tail(startIndex));
+            startIndex = 0;
+        }
+        else
+        {
+            suffix.append(chunk);
+        }
+    }
+    return suffix;
+}
+
+bool ChunkedString::startsWith(const UnownedStringSlice& prefix) const
+{
+    if (prefix.getLength() > m_length)
+    {
+        return false;
+    }
+
+    const char* cur = prefix.begin();
+    const char* end = prefix.end();
+    for (const auto& chunk : m_chunks)
+    {
+        if (cur == end)
+        {
+            break;
+        }
+        const Index compareLength = Math::Min(chunk.getLength(), Index(end - cur));
+        if (::memcmp(chunk.getBuffer(), cur, compareLength) != 0)
+        {
+            return false;
+        }
+        cur += compareLength;
+    }
+    return true;
+}
+
+String ChunkedString::toString() const
+{
+    switch (m_chunks.getCount())
+    {
+        case 0:     return String();
+        case 1:     return m_chunks[0];
+        default:    break;
+    }
+
+    StringBuilder builder(m_length + 1);
+    for (const auto& chunk : m_chunks)
+    {
+        builder << chunk;
+    }
+    return builder.ProduceString();
+}
+
+SlangResult ChunkedString::writeTo(Stream* stream) const
+{
+    for (const auto& chunk : m_chunks)
+    {
+        const size_t size = size_t(chunk.getLength());
+        if (stream->write(chunk.getBuffer(), size) != size)
+        {
+            return SLANG_FAIL;
+        }
+    }
+    return SLANG_OK;
+}
+
+} // namespace Slang
@@ -0,0 +1,67 @@
+#ifndef SLANG_CORE_CHUNKED_STRING_H
+#define SLANG_CORE_CHUNKED_STRING_H
+
+#include "slang-string.h"
+#include "slang-list.h"
+#include "slang-stream.h"
+
+namespace Slang {
+
+/* A string held as a sequence of chunks, each of which is a String.
+
+Appending a String adds it as a chunk, sharing its representation, so nothing that is already held is ever copied or
+reallocated. This makes it suitable for large text that is produced in pieces, and consumed in order - such as
+generated source that is written to a file for a downstream compiler. The text can be written out chunk by chunk
+with writeTo, and only needs to be made contiguous (with toString) when a consumer requires it.
+
+The chunks are Strings, which are reference counted atomically and copied on write, so a ChunkedString can be passed
+to (and read on) another thread while its chunks are still shared. */
+class ChunkedString
+{
+public:
+    typedef ChunkedString ThisType;
+
+        /// Append a string as a chunk. The string's contents are shared, not copied.
+    void append(const String& text);
+        /// Append a copy of the slice
+    void append(const UnownedStringSlice& text);
+        /// Append all of the chunks of rhs
+    void append(const ThisType& rhs);
+
+        /// Get the total length in chars
+    Index getLength() const { return m_length; }
+
+        /// Get the chunks
+    const List<String>& getChunks() const { return m_chunks; }
+
+        /// Get the text from startIndex onwards. Chunks wholly after startIndex are shared.
+    ThisType getSuffix(Index startIndex) const;
+
+        /// True if the text starts with prefix
+    bool startsWith(const UnownedStringSlice& prefix) const;
+
+        /// Get the text as a single string. If there is only a single chunk it is returned without a copy.
+    String toString() const;
+
+        /// Write the text to the stream, chunk by chunk
+    SlangResult writeTo(Stream* stream) const;
+
+        /// Remove all of the text
+    void clear() { m_chunks.clear(); m_length = 0; }
+
+    bool operator==(const UnownedStringSlice& rhs) const { return m_length == rhs.getLength() && startsWith(rhs); }
+    bool operator!=(const UnownedStringSlice& rhs) const { return !(*this == rhs); }
+
+        /// Ctor
+    ChunkedString() {}
+    ChunkedString(const String& text) { append(text); }
+    ChunkedString(const char* text) { append(String(text)); }
+
+protected:
+    List<String> m_chunks;
+    Index m_length = 0;
+};
+
+} // namespace Slang
+
+#endif // SLANG_CORE_CHUNKED_STRING_H
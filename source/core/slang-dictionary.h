@@ -9,6 +9,21 @@
 #include "slang-math.h"
 #include "slang-hash.h"
 
+#include <string.h>
+
+#if (SLANG_PROCESSOR_X86 || SLANG_PROCESSOR_X86_64) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#	define SLANG_DICTIONARY_USE_SSE2 1
+#else
+#	define SLANG_DICTIONARY_USE_SSE2 0
+#endif
+
+#if SLANG_DICTIONARY_USE_SSE2
+#	include <emmintrin.h>
+#endif
+#if SLANG_VC
+#	include <intrin.h>
+#endif
+
 namespace Slang
 {
 	template<typename TKey, typename TValue>
@@ -75,49 +90,146 @@ namespace Slang
 
 	const float MaxLoadFactor = 0.7f;
 
+	// Every slot of a Dictionary has a control byte, held in an array separate from the slots.
+	// A full slot's control byte holds 7 bits of the key's hash (so the high bit is clear),
+	// which allows most non-matching slots to be rejected without looking at the key.
+	//
+	// Probing examines a 'group' of consecutive control bytes at a time. With SSE2 a group is
+	// 16 bytes matched with a couple of instructions, otherwise it is 8 bytes matched with
+	// integer (SWAR) operations.
+	struct DictionaryControl
+	{
+		enum : uint8_t
+		{
+			kEmpty = 0x80,
+			kDeleted = 0xfe,
+		};
+		static bool isFull(uint8_t control) { return (control & 0x80) == 0; }
+	};
+
+#if SLANG_DICTIONARY_USE_SSE2
+	struct DictionaryControlGroup
+	{
+		enum { kWidth = 16 };
+			/// Has bit i set if control byte i matched
+		typedef uint32_t Mask;
+
+			/// Mask of the bytes that hold h2
+		SLANG_FORCE_INLINE Mask match(uint8_t h2) const { return Mask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(char(h2)), m_controls))); }
+			/// Mask of the empty bytes
+		SLANG_FORCE_INLINE Mask matchEmpty() const { return match(DictionaryControl::kEmpty); }
+			/// Mask of the empty or deleted bytes (ie the ones with the high bit set)
+		SLANG_FORCE_INLINE Mask matchEmptyOrDeleted() const { return Mask(_mm_movemask_epi8(m_controls)); }
+
+			/// Get the index of the lowest byte in a non zero mask
+		SLANG_FORCE_INLINE static int getLowestIndex(Mask mask)
+		{
+			SLANG_ASSERT(mask);
+#	if SLANG_VC
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return int(index);
+#	else
+			return __builtin_ctz(mask);
+#	endif
+		}
+
+		SLANG_FORCE_INLINE explicit DictionaryControlGroup(const uint8_t* controls) { m_controls = _mm_loadu_si128((const __m128i*)controls); }
+
+		__m128i m_controls;
+	};
+#else
+	struct DictionaryControlGroup
+	{
+		enum { kWidth = 8 };
+			/// Has the high bit of byte i set if control byte i matched
+		typedef uint64_t Mask;
+
+			/// Mask of the bytes that hold h2. Can produce a false positive for a byte above a real match, but
+			/// that is harmless as any match is confirmed by comparing the key.
+		SLANG_FORCE_INLINE Mask match(uint8_t h2) const
+		{
+			const uint64_t bytes = m_controls ^ (kLsbs * h2);
+			return (bytes - kLsbs) & ~bytes & kMsbs;
+		}
+			/// Mask of the empty bytes. Empty is the only control with the high bit set, and bit 1 clear.
+		SLANG_FORCE_INLINE Mask matchEmpty() const { return m_controls & (~m_controls << 6) & kMsbs; }
+			/// Mask of the empty or deleted bytes (ie the ones with the high bit set)
+		SLANG_FORCE_INLINE Mask matchEmptyOrDeleted() const { return m_controls & kMsbs; }
+
+			/// Get the index of the lowest byte in a non zero mask
+		SLANG_FORCE_INLINE static int getLowestIndex(Mask mask)
+		{
+			SLANG_ASSERT(mask);
+			int index = 0;
+			uint32_t bits = uint32_t(mask);
+			if (bits == 0)
+			{
+				bits = uint32_t(mask >> 32);
+				index = 4;
+			}
+#	if SLANG_VC
+			unsigned long bitIndex;
+			_BitScanForward(&bitIndex, bits);
+			return index + int(bitIndex >> 3);
+#	else
+			return index + (__builtin_ctz(bits) >> 3);
+#	endif
+		}
+
+		SLANG_FORCE_INLINE explicit DictionaryControlGroup(const uint8_t* controls)
+		{
+			// NOTE! Assumes a little endian target, so that byte i of the group is byte i of m_controls
+			::memcpy(&m_controls, controls, sizeof(m_controls));
+		}
+
+		static const uint64_t kLsbs = 0x0101010101010101ull;
+		static const uint64_t kMsbs = 0x8080808080808080ull;
+
+		uint64_t m_controls;
+	};
+#endif
+
 	template<typename TKey, typename TValue>
 	class Dictionary
 	{
 		friend class Iterator;
 		friend class ItemProxy;
 	private:
-		inline int GetProbeOffset(int /*probeId*/) const
-		{
-			// linear probing
-			return 1;
-		}
-	private:
+		typedef DictionaryControlGroup Group;
+
 		int bucketSizeMinusOne;
 		int _count;
-		UIntSet marks;
+		int deletedCount;
+			/// One control byte per slot, followed by a copy of the first Group::kWidth control bytes,
+			/// so that a group can be loaded from any slot without wrapping around.
+		uint8_t* controls;
 		KeyValuePair<TKey, TValue>* hashMap;
 		void Free()
 		{
 			if (hashMap)
 				delete[] hashMap;
 			hashMap = 0;
+			if (controls)
+				delete[] controls;
+			controls = 0;
 		}
-		inline bool IsDeleted(int pos) const
+		inline int GetControlCount() const
 		{
-			return marks.contains((pos << 1) + 1);
+			return bucketSizeMinusOne + 1 + Group::kWidth;
 		}
-		inline bool IsEmpty(int pos) const
+		inline bool IsFull(int pos) const
 		{
-			return !marks.contains((pos << 1));
+			return DictionaryControl::isFull(controls[pos]);
 		}
-		inline void SetDeleted(int pos, bool val)
+		inline void SetControl(int pos, uint8_t control)
 		{
-			if (val)
-				marks.add((pos << 1) + 1);
-			else
-				marks.remove((pos << 1) + 1);
-		}
-		inline void SetEmpty(int pos, bool val)
-		{
-			if (val)
-				marks.remove((pos << 1));
-			else
-				marks.add((pos << 1));
+			controls[pos] = control;
+			// Keep the copy at the end in sync
+			if (pos < Group::kWidth)
+			{
+				controls[bucketSizeMinusOne + 1 + pos] = control;
+			}
 		}
 		struct FindPositionResult
 		{
@@ -135,56 +247,121 @@ namespace Slang
 			}
 
 		};
-        template<typename KeyType>
-		inline int GetHashPos(KeyType& key) const
-        {
-            SLANG_ASSERT(bucketSizeMinusOne > 0);
-            const unsigned int hash = (unsigned int)getHashCode(key);
-            return (hash * 2654435761u) % (unsigned int)(bucketSizeMinusOne);
+			/// The bits of the hash are spread across all 64 bits, the top 7 bits are used as 'h2' - the bits stored
+			/// in the control byte, the rest are used to find the first slot to probe.
+		template<typename KeyType>
+		static inline uint64_t GetHash(const KeyType& key)
+		{
+			return uint64_t((unsigned int)getHashCode(const_cast<KeyType&>(key))) * 0x9e3779b97f4a7c15ull;
 		}
-        template<typename KeyType>
-		FindPositionResult FindPosition(const KeyType& key) const
+		static inline uint8_t GetH2(uint64_t hash)
+		{
+			return uint8_t(hash >> 57);
+		}
+		inline int GetHashPos(uint64_t hash) const
+		{
+			SLANG_ASSERT(bucketSizeMinusOne > 0);
+			return int(uint32_t(hash >> 25)) & bucketSizeMinusOne;
+		}
+			/// Find the position of key, or -1 if it isn't in the dictionary
+		template<typename KeyType>
+		int FindObjectPosition(const KeyType& key) const
+		{
+			const uint64_t hash = GetHash(key);
+			const uint8_t h2 = GetH2(hash);
+
+			int hashPos = GetHashPos(hash);
+			for (int step = 0; step <= bucketSizeMinusOne; step += Group::kWidth)
+			{
+				const Group group(controls + hashPos);
+				for (auto mask = group.match(h2); mask; mask &= mask - 1)
+				{
+					const int pos = (hashPos + Group::getLowestIndex(mask)) & bucketSizeMinusOne;
+					if (hashMap[pos].Key == key)
+					{
+						return pos;
+					}
+				}
+				if (group.matchEmpty())
+				{
+					return -1;
+				}
+				hashPos = (hashPos + step + Group::kWidth) & bucketSizeMinusOne;
+			}
+			return -1;
+		}
+			/// Find the position of key, or if it isn't in the dictionary the position to insert it. hash must be GetHash(key).
+		template<typename KeyType>
+		FindPositionResult FindPosition(const KeyType& key, uint64_t hash) const
 		{
-			int hashPos = GetHashPos(const_cast<KeyType&>(key));
+			const uint8_t h2 = GetH2(hash);
+
+			int hashPos = GetHashPos(hash);
 			int insertPos = -1;
-			int numProbes = 0;
-			while (numProbes <= bucketSizeMinusOne)
+
+			// Triangular probing over groups visits every group once the step reaches the bucket count
+			for (int step = 0; step <= bucketSizeMinusOne; step += Group::kWidth)
 			{
-				if (IsEmpty(hashPos))
+				const Group group(controls + hashPos);
+				for (auto mask = group.match(h2); mask; mask &= mask - 1)
 				{
-					if (insertPos == -1)
-						return FindPositionResult(-1, hashPos);
-					else
-						return FindPositionResult(-1, insertPos);
+					const int pos = (hashPos + Group::getLowestIndex(mask)) & bucketSizeMinusOne;
+					if (hashMap[pos].Key == key)
+					{
+						return FindPositionResult(pos, -1);
+					}
 				}
-				else if (IsDeleted(hashPos))
+				if (insertPos == -1)
 				{
-					if (insertPos == -1)
-						insertPos = hashPos;
+					if (const auto mask = group.matchEmptyOrDeleted())
+					{
+						insertPos = (hashPos + Group::getLowestIndex(mask)) & bucketSizeMinusOne;
+					}
 				}
-				else if (hashMap[hashPos].Key == key)
+				// If there is an empty slot, the key would have been placed before it, so it isn't in the dictionary
+				if (group.matchEmpty())
 				{
-					return FindPositionResult(hashPos, -1);
+					return FindPositionResult(-1, insertPos);
 				}
-				numProbes++;
-				hashPos = (hashPos + GetProbeOffset(numProbes)) & bucketSizeMinusOne;
+				hashPos = (hashPos + step + Group::kWidth) & bucketSizeMinusOne;
 			}
 			if (insertPos != -1)
 				return FindPositionResult(-1, insertPos);
 			throw InvalidOperationException("Hash map is full. This indicates an error in Key::Equal or Key::getHashCode.");
 		}
-		TValue & _Insert(KeyValuePair<TKey, TValue>&& kvPair, int pos)
+		TValue & _Insert(KeyValuePair<TKey, TValue>&& kvPair, int pos, uint8_t h2)
 		{
 			hashMap[pos] = _Move(kvPair);
-			SetEmpty(pos, false);
-			SetDeleted(pos, false);
+			if (controls[pos] == DictionaryControl::kDeleted)
+				deletedCount--;
+			SetControl(pos, h2);
 			return hashMap[pos].Value;
+		}
+			/// Add a key known not to be in the dictionary, to a dictionary with no deleted entries
+		void _AddUnique(KeyValuePair<TKey, TValue>&& kvPair)
+		{
+			const uint64_t hash = GetHash(kvPair.Key);
+			int hashPos = GetHashPos(hash);
+			for (int step = 0; ; step += Group::kWidth)
+			{
+				if (const auto mask = Group(controls + hashPos).matchEmpty())
+				{
+					const int pos = (hashPos + Group::getLowestIndex(mask)) & bucketSizeMinusOne;
+					hashMap[pos] = _Move(kvPair);
+					SetControl(pos, GetH2(hash));
+					_count++;
+					return;
+				}
+				hashPos = (hashPos + step + Group::kWidth) & bucketSizeMinusOne;
+			}
 		}
 		void Rehash()
 		{
-			if (bucketSizeMinusOne == -1 || _count >= int(MaxLoadFactor * bucketSizeMinusOne))
+			const int bucketCount = bucketSizeMinusOne + 1;
+			if (bucketSizeMinusOne == -1 || _count + deletedCount >= int(MaxLoadFactor * bucketCount))
 			{
-				int newSize = (bucketSizeMinusOne + 1) * 2;
+				// If the load is mostly deleted entries, rebuilding at the same size is enough
+				int newSize = (_count * 2 >= int(MaxLoadFactor * bucketCount)) ? bucketCount * 2 : bucketCount;
 				if (newSize == 0)
 				{
 					newSize = 16;
@@ -192,12 +369,13 @@ namespace Slang
 				Dictionary<TKey, TValue> newDict;
 				newDict.bucketSizeMinusOne = newSize - 1;
 				newDict.hashMap = new KeyValuePair<TKey, TValue>[newSize];
-				newDict.marks.resizeAndClear(newSize * 2);
+				newDict.controls = new uint8_t[newDict.GetControlCount()];
+				::memset(newDict.controls, DictionaryControl::kEmpty, newDict.GetControlCount());
 				if (hashMap)
 				{
 					for (auto & kvPair : *this)
 					{
-						newDict.Add(_Move(kvPair));
+						newDict._AddUnique(_Move(kvPair));
 					}
 				}
 				*this = _Move(newDict);
@@ -207,13 +385,14 @@ namespace Slang
 		bool AddIfNotExists(KeyValuePair<TKey, TValue>&& kvPair)
 		{
 			Rehash();
-			auto pos = FindPosition(kvPair.Key);
+			const uint64_t hash = GetHash(kvPair.Key);
+			auto pos = FindPosition(kvPair.Key, hash);
 			if (pos.ObjectPosition != -1)
 				return false;
 			else if (pos.InsertionPosition != -1)
 			{
 				_count++;
-				_Insert(_Move(kvPair), pos.InsertionPosition);
+				_Insert(_Move(kvPair), pos.InsertionPosition, GetH2(hash));
 				return true;
 			}
 			else
@@ -227,13 +406,14 @@ namespace Slang
 		TValue& Set(KeyValuePair<TKey, TValue>&& kvPair)
 		{
 			Rehash();
-			auto pos = FindPosition(kvPair.Key);
+			const uint64_t hash = GetHash(kvPair.Key);
+			auto pos = FindPosition(kvPair.Key, hash);
 			if (pos.ObjectPosition != -1)
-				return _Insert(_Move(kvPair), pos.ObjectPosition);
+				return _Insert(_Move(kvPair), pos.ObjectPosition, GetH2(hash));
 			else if (pos.InsertionPosition != -1)
 			{
 				_count++;
-				return _Insert(_Move(kvPair), pos.InsertionPosition);
+				return _Insert(_Move(kvPair), pos.InsertionPosition, GetH2(hash));
 			}
 			else
 				throw InvalidOperationException("Inconsistent find result returned. This is a bug in Dictionary implementation.");
@@ -258,7 +438,7 @@ namespace Slang
 				if (pos > dict->bucketSizeMinusOne)
 					return *this;
 				pos++;
-				while (pos <= dict->bucketSizeMinusOne && (dict->IsDeleted(pos) || dict->IsEmpty(pos)))
+				while (pos <= dict->bucketSizeMinusOne && !dict->IsFull(pos))
 				{
 					pos++;
 				}
@@ -295,7 +475,7 @@ namespace Slang
 			int pos = 0;
 			while (pos < bucketSizeMinusOne + 1)
 			{
-				if (IsEmpty(pos) || IsDeleted(pos))
+				if (!IsFull(pos))
 					pos++;
 				else
 					break;
@@ -327,24 +507,28 @@ namespace Slang
 		{
 			if (_count == 0)
 				return;
-			auto pos = FindPosition(key);
-			if (pos.ObjectPosition != -1)
+			const int pos = FindObjectPosition(key);
+			if (pos != -1)
 			{
-				SetDeleted(pos.ObjectPosition, true);
+				SetControl(pos, DictionaryControl::kDeleted);
+				deletedCount++;
 				_count--;
 			}
 		}
 		void Clear()
 		{
 			_count = 0;
+			deletedCount = 0;
 
-			marks.clear();
+			if (controls)
+				::memset(controls, DictionaryControl::kEmpty, GetControlCount());
 		}
 
         TValue* TryGetValueOrAdd(const TKey& key, const TValue& value)
         {
             Rehash();
-            auto pos = FindPosition(key);
+            const uint64_t hash = GetHash(key);
+            auto pos = FindPosition(key, hash);
             if (pos.ObjectPosition != -1)
             {
                 return &hashMap[pos.ObjectPosition].Value;
@@ -354,7 +538,7 @@ namespace Slang
                 // Make pair
                 KeyValuePair<TKey, TValue> kvPair(_Move(key), _Move(value));
                 _count++;
-                _Insert(_Move(kvPair), pos.InsertionPosition);
+                _Insert(_Move(kvPair), pos.InsertionPosition, GetH2(hash));
                 return nullptr;
             }
             else
@@ -362,11 +546,12 @@ namespace Slang
         }
 
             /// This differs from TryGetValueOrAdd, in that it always returns the Value held in the Dictionary.
-            /// If there isn't already an entry for 'key', a value is added with defaultValue. 
+            /// If there isn't already an entry for 'key', a value is added with defaultValue.
         TValue& GetOrAddValue(const TKey& key, const TValue& defaultValue)
         {
             Rehash();
-            auto pos = FindPosition(key);
+            const uint64_t hash = GetHash(key);
+            auto pos = FindPosition(key, hash);
             if (pos.ObjectPosition != -1)
             {
                 return hashMap[pos.ObjectPosition].Value;
@@ -376,7 +561,7 @@ namespace Slang
                 // Make pair
                 KeyValuePair<TKey, TValue> kvPair(_Move(key), _Move(defaultValue));
                 _count++;
-                return _Insert(_Move(kvPair), pos.InsertionPosition);
+                return _Insert(_Move(kvPair), pos.InsertionPosition, GetH2(hash));
             }
             else
                 throw InvalidOperationException("Inconsistent find result returned. This is a bug in Dictionary implementation.");
@@ -387,18 +572,17 @@ namespace Slang
 		{
 			if (bucketSizeMinusOne == -1)
 				return false;
-			auto pos = FindPosition(key);
-			return pos.ObjectPosition != -1;
+			return FindObjectPosition(key) != -1;
 		}
         template<typename KeyType>
 		bool TryGetValue(const KeyType& key, TValue& value) const
 		{
 			if (bucketSizeMinusOne == -1)
 				return false;
-			auto pos = FindPosition(key);
-			if (pos.ObjectPosition != -1)
+			const int pos = FindObjectPosition(key);
+			if (pos != -1)
 			{
-				value = hashMap[pos.ObjectPosition].Value;
+				value = hashMap[pos].Value;
 				return true;
 			}
 			return false;
@@ -408,10 +592,10 @@ namespace Slang
 		{
 			if (bucketSizeMinusOne == -1)
 				return nullptr;
-			auto pos = FindPosition(key);
-			if (pos.ObjectPosition != -1)
+			const int pos = FindObjectPosition(key);
+			if (pos != -1)
 			{
-				return &hashMap[pos.ObjectPosition].Value;
+				return &hashMap[pos].Value;
 			}
 			return nullptr;
 		}
@@ -434,10 +618,12 @@ namespace Slang
 			}
 			TValue & GetValue() const
 			{
-				auto pos = dict->FindPosition(key);
-				if (pos.ObjectPosition != -1)
+				if (dict->bucketSizeMinusOne == -1)
+					throw KeyNotFoundException("The key does not exists in dictionary.");
+				const int pos = dict->FindObjectPosition(key);
+				if (pos != -1)
 				{
-					return dict->hashMap[pos.ObjectPosition].Value;
+					return dict->hashMap[pos].Value;
 				}
 				else
 					throw KeyNotFoundException("The key does not exists in dictionary.");
@@ -483,20 +669,23 @@ namespace Slang
 		{
 			bucketSizeMinusOne = -1;
 			_count = 0;
+			deletedCount = 0;
+			controls = nullptr;
 			hashMap = nullptr;
 		}
 		template<typename Arg, typename... Args>
 		Dictionary(Arg arg, Args... args)
+			: bucketSizeMinusOne(-1), _count(0), deletedCount(0), controls(nullptr), hashMap(nullptr)
 		{
 			Init(arg, args...);
 		}
 		Dictionary(const Dictionary<TKey, TValue>& other)
-			: bucketSizeMinusOne(-1), _count(0), hashMap(nullptr)
+			: bucketSizeMinusOne(-1), _count(0), deletedCount(0), controls(nullptr), hashMap(nullptr)
 		{
 			*this = other;
 		}
 		Dictionary(Dictionary<TKey, TValue>&& other)
-			: bucketSizeMinusOne(-1), _count(0), hashMap(nullptr)
+			: bucketSizeMinusOne(-1), _count(0), deletedCount(0), controls(nullptr), hashMap(nullptr)
 		{
 			*this = (_Move(other));
 		}
@@ -507,10 +696,15 @@ namespace Slang
 			Free();
 			bucketSizeMinusOne = other.bucketSizeMinusOne;
 			_count = other._count;
-			hashMap = new KeyValuePair<TKey, TValue>[other.bucketSizeMinusOne + 1];
-			marks = other.marks;
-			for (int i = 0; i <= bucketSizeMinusOne; i++)
-				hashMap[i] = other.hashMap[i];
+			deletedCount = other.deletedCount;
+			if (other.hashMap)
+			{
+				hashMap = new KeyValuePair<TKey, TValue>[other.bucketSizeMinusOne + 1];
+				controls = new uint8_t[other.GetControlCount()];
+				::memcpy(controls, other.controls, other.GetControlCount());
+				for (int i = 0; i <= bucketSizeMinusOne; i++)
+					hashMap[i] = other.hashMap[i];
+			}
 			return *this;
 		}
 		Dictionary<TKey, TValue> & operator = (Dictionary<TKey, TValue>&& other)
@@ -520,10 +714,13 @@ namespace Slang
 			Free();
 			bucketSizeMinusOne = other.bucketSizeMinusOne;
 			_count = other._count;
+			deletedCount = other.deletedCount;
 			hashMap = other.hashMap;
-			marks = _Move(other.marks);
+			controls = other.controls;
 			other.hashMap = 0;
+			other.controls = 0;
 			other._count = 0;
+			other.deletedCount = 0;
 			other.bucketSizeMinusOne = -1;
 			return *this;
 		}
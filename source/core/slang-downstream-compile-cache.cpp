@@ -0,0 +1,220 @@
+// slang-downstream-compile-cache.cpp
+#include "slang-downstream-compile-cache.h"
+
+#include "slang-blob.h"
+#include "slang-hash.h"
+#include "slang-io.h"
+#include "slang-platform.h"
+
+namespace Slang
+{
+
+// Bump if the layout of the key (or of entries) changes, so that old entries can never be hit
+static const char kCacheVersionText[] = "slang-downstream-compile-cache 2";
+
+DownstreamCompileCache::DownstreamCompileCache(const String& directoryPath):
+    m_directoryPath(directoryPath),
+    m_hitCount(0),
+    m_missCount(0)
+{
+    SlangPathType pathType;
+    if (SLANG_FAILED(Path::getPathType(directoryPath, &pathType)))
+    {
+        Path::createDirectory(directoryPath);
+    }
+}
+
+static void _appendLengthPrefixed(const UnownedStringSlice& text, StringBuilder& out)
+{
+    // Prefixing with the length means there is no way for one field to be confused with the next
+    out << text.getLength() << ":" << text << "\n";
+}
+
+/* static */SlangResult DownstreamCompileCache::calcKey(const DownstreamCompiler::Desc& desc, const CompileOptions& options, StringBuilder& outKey)
+{
+    outKey << kCacheVersionText << "\n";
+
+    outKey << "compiler: " << Index(desc.type) << " " << desc.majorVersion << "." << desc.minorVersion << "\n";
+
+    outKey << "optimizationLevel: " << Index(options.optimizationLevel) << "\n";
+    outKey << "debugInfoType: " << Index(options.debugInfoType) << "\n";
+    outKey << "targetType: " << Index(options.targetType) << "\n";
+    outKey << "sourceLanguage: " << Index(options.sourceLanguage) << "\n";
+    outKey << "floatingPointMode: " << Index(options.floatingPointMode) << "\n";
+    outKey << "pipelineType: " << Index(options.pipelineType) << "\n";
+    outKey << "flags: " << UInt(options.flags) << "\n";
+    outKey << "platform: " << Index(options.platform) << "\n";
+
+    for (const auto& define : options.defines)
+    {
+        outKey << "define: ";
+        _appendLengthPrefixed(define.nameWithSig.getUnownedSlice(), outKey);
+        outKey << "value: ";
+        _appendLengthPrefixed(define.value.getUnownedSlice(), outKey);
+    }
+
+    for (const auto& includePath : options.includePaths)
+    {
+        outKey << "includePath: ";
+        _appendLengthPrefixed(includePath.getUnownedSlice(), outKey);
+    }
+
+    for (const auto& forceIncludePath : options.forceIncludePaths)
+    {
+        ScopedAllocation contents;
+        SLANG_RETURN_ON_FAIL(File::readAllBytes(forceIncludePath, contents));
+
+        outKey << "forceInclude: ";
+        _appendLengthPrefixed(forceIncludePath.getUnownedSlice(), outKey);
+        _appendLengthPrefixed(UnownedStringSlice((const char*)contents.getData(), contents.getSizeInBytes()), outKey);
+    }
+
+    for (const auto& libraryPath : options.libraryPaths)
+    {
+        outKey << "libraryPath: ";
+        _appendLengthPrefixed(libraryPath.getUnownedSlice(), outKey);
+    }
+
+    for (const auto& capabilityVersion : options.requiredCapabilityVersions)
+    {
+        outKey << "capability: " << Index(capabilityVersion.kind) << " ";
+        capabilityVersion.version.append(outKey);
+        outKey << "\n";
+    }
+
+    // The path is used in diagnostics and #line directives, so it can change the output
+    outKey << "sourceContentsPath: ";
+    _appendLengthPrefixed(options.sourceContentsPath.getUnownedSlice(), outKey);
+
+    // The prelude is compiled as if it was at the start of the source. Whether it is precompiled (and where) doesn't
+    // change the output.
+    outKey << "preludeContents: ";
+    _appendLengthPrefixed(options.preludeContents.getUnownedSlice(), outKey);
+
+    // Appended a chunk at a time, so the source doesn't have to be made contiguous
+    outKey << "sourceContents: " << options.sourceContents.getLength() << ":";
+    for (const auto& chunk : options.sourceContents.getChunks())
+    {
+        outKey << chunk;
+    }
+    outKey << "\n";
+
+    for (const auto& sourceFile : options.sourceFiles)
+    {
+        ScopedAllocation contents;
+        SLANG_RETURN_ON_FAIL(File::readAllBytes(sourceFile, contents));
+
+        outKey << "sourceFile: ";
+        _appendLengthPrefixed(sourceFile.getUnownedSlice(), outKey);
+        _appendLengthPrefixed(UnownedStringSlice((const char*)contents.getData(), contents.getSizeInBytes()), outKey);
+    }
+
+    return SLANG_OK;
+}
+
+SlangResult DownstreamCompileCache::_findResult(const UnownedStringSlice& key, const String& productPath, const String& keyPath, const CompileOptions& options, RefPtr<DownstreamCompileResult>& outResult)
+{
+    // The key is written after the product, so if the key is there, the product is too
+    ScopedAllocation storedKey;
+    SLANG_RETURN_ON_FAIL(File::readAllBytes(keyPath, storedKey));
+
+    if (UnownedStringSlice((const char*)storedKey.getData(), storedKey.getSizeInBytes()) != key)
+    {
+        // Hash collision
+        return SLANG_E_NOT_FOUND;
+    }
+
+    // Only compilations without diagnostics are stored
+    DownstreamDiagnostics diagnostics;
+    diagnostics.result = SLANG_OK;
+
+    if (options.targetType == DownstreamCompiler::TargetType::SharedLibrary)
+    {
+        // Use the product in place, so that it can be loaded as a host callable shared library.
+        // There are no temporary files - the product is owned by the cache.
+        outResult = new CommandLineDownstreamCompileResult(diagnostics, productPath, nullptr);
+        return SLANG_OK;
+    }
+
+    ScopedAllocation product;
+    SLANG_RETURN_ON_FAIL(File::readAllBytes(productPath, product));
+
+    ComPtr<ISlangBlob> blob(RawBlob::moveCreate(product));
+    outResult = new BlobDownstreamCompileResult(diagnostics, blob);
+    return SLANG_OK;
+}
+
+void DownstreamCompileCache::_addResult(const UnownedStringSlice& key, const String& productPath, const String& keyPath, DownstreamCompileResult* result)
+{
+    const auto& diagnostics = result->getDiagnostics();
+    if (SLANG_FAILED(diagnostics.result) || diagnostics.diagnostics.getCount() > 0 || diagnostics.rawDiagnostics.getLength() > 0)
+    {
+        return;
+    }
+
+    ComPtr<ISlangBlob> blob;
+    if (SLANG_FAILED(result->getBinary(blob)) || !blob)
+    {
+        return;
+    }
+
+    // The product must be complete before the key appears, as the key is used to detect an entry
+    if (SLANG_SUCCEEDED(File::writeAllBytesAndRename(productPath, blob->getBufferPointer(), blob->getBufferSize())))
+    {
+        File::writeAllBytesAndRename(keyPath, key.begin(), key.getLength());
+    }
+}
+
+SlangResult DownstreamCompileCache::compile(DownstreamCompiler* compiler, const CompileOptions& options, RefPtr<DownstreamCompileResult>& outResult)
+{
+    // If an output path is specified, the caller expects the product to be there, so we can't use the cache
+    if (options.modulePath.getLength())
+    {
+        return compiler->compile(options, outResult);
+    }
+
+    StringBuilder key;
+    if (SLANG_FAILED(calcKey(compiler->getDesc(), options, key)))
+    {
+        return compiler->compile(options, outResult);
+    }
+
+    StringBuilder entryName;
+    entryName << String(UInt64(getStableHashCode64(key.getBuffer(), key.getLength())), 16);
+
+    String productPath;
+    {
+        StringBuilder builder;
+        Path::combineIntoBuilder(m_directoryPath.getUnownedSlice(), entryName.getUnownedSlice(), builder);
+        if (options.targetType == DownstreamCompiler::TargetType::SharedLibrary)
+        {
+            productPath = SharedLibrary::calcPlatformPath(builder.getUnownedSlice());
+        }
+        else
+        {
+            builder << ".bin";
+            productPath = builder.ProduceString();
+        }
+    }
+    String keyPath;
+    {
+        StringBuilder builder;
+        Path::combineIntoBuilder(m_directoryPath.getUnownedSlice(), entryName.getUnownedSlice(), builder);
+        builder << ".key";
+        keyPath = builder.ProduceString();
+    }
+
+    if (File::exists(keyPath) && SLANG_SUCCEEDED(_findResult(key.getUnownedSlice(), productPath, keyPath, options, outResult)))
+    {
+        m_hitCount++;
+        return SLANG_OK;
+    }
+
+    m_missCount++;
+
+    SLANG_RETURN_ON_FAIL(compiler->compile(options, outResult));
+    _addResult(key.getUnownedSlice(), productPath, keyPath, outResult);
+    return SLANG_OK;
+}
+
+}
@@ -0,0 +1,65 @@
+#ifndef SLANG_DOWNSTREAM_COMPILE_CACHE_H
+#define SLANG_DOWNSTREAM_COMPILE_CACHE_H
+
+#include "slang-downstream-compiler.h"
+
+#include <atomic>
+
+namespace Slang
+{
+
+/* A persistent, content addressed cache of downstream compiler products, held in a directory on the file system.
+
+The key for a compilation is made from the compiler desc (type and version), all of the CompileOptions and the
+source being compiled (the sourceContents, and the contents of any sourceFiles). When a compile with an identical
+key has been performed before, the stored product (binary, executable or shared library) is returned without
+invoking the downstream compiler.
+
+Entries are named by a hash of the key. The full key is stored alongside each product, and checked on lookup, so
+a hash collision can only produce a miss, never a wrong result.
+
+Only compilations that succeed with no diagnostics at all are stored, so a hit never has to reproduce diagnostics.
+
+NOTE! The contents of files reached by #include from the source are *not* part of the key (forceIncludePaths are).
+Generated code passes the prelude as part of the source (embedded, or as preludeContents) so is unaffected, but if
+compiled source includes external headers that change, the cache directory should be cleared.
+
+Multiple threads (and processes) can use the same cache directory at the same time. Entries are written to a
+temporary file and then renamed into place, so a reader never sees a partially written entry. */
+class DownstreamCompileCache : public RefObject
+{
+public:
+    typedef DownstreamCompiler::CompileOptions CompileOptions;
+
+        /// Compile using compiler, or find a previous identical compilation in the cache.
+        /// Can be called from multiple threads at the same time.
+    SlangResult compile(DownstreamCompiler* compiler, const CompileOptions& options, RefPtr<DownstreamCompileResult>& outResult);
+
+        /// Calculate the key for a compilation. Returns an error if the key can't be determined (for example
+        /// if a source file can't be read), in which case the compilation can't be cached.
+    static SlangResult calcKey(const DownstreamCompiler::Desc& desc, const CompileOptions& options, StringBuilder& outKey);
+
+        /// Get the directory that holds the cache
+    const String& getDirectoryPath() const { return m_directoryPath; }
+
+        /// The number of compilations found in the cache
+    Index getHitCount() const { return m_hitCount.load(); }
+        /// The number of compilations that were not found in the cache
+    Index getMissCount() const { return m_missCount.load(); }
+
+        /// Ctor. The directory will be created if it doesn't exist.
+    DownstreamCompileCache(const String& directoryPath);
+
+protected:
+    SlangResult _findResult(const UnownedStringSlice& key, const String& productPath, const String& keyPath, const CompileOptions& options, RefPtr<DownstreamCompileResult>& outResult);
+    void _addResult(const UnownedStringSlice& key, const String& productPath, const String& keyPath, DownstreamCompileResult* result);
+
+    String m_directoryPath;
+
+    std::atomic<Index> m_hitCount;
+    std::atomic<Index> m_missCount;
+};
+
+}
+
+#endif
@@ -287,6 +287,25 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
 
     CompileOptions options(inOptions);
 
+    if (options.preludeContents.getLength())
+    {
+        SLANG_ASSERT(options.sourceContents.getLength());
+
+        String preludeHeaderPath;
+        if (SLANG_SUCCEEDED(getPrecompiledPrelude(options, preludeHeaderPath)))
+        {
+            // The prelude has to come before any other forced include, as it would have if it was in the source
+            options.forceIncludePaths.insert(0, preludeHeaderPath);
+        }
+        else
+        {
+            ChunkedString sourceContents(options.preludeContents);
+            sourceContents.append(options.sourceContents);
+            options.sourceContents = sourceContents;
+        }
+        options.preludeContents = String();
+    }
+
     // Find all the files that will be produced
     RefPtr<TemporaryFileSet> productFileSet(new TemporaryFileSet);
     
@@ -322,12 +341,13 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
                 compileSourcePath.append(".cpp");
             }
 
-            // Write it out
+            // Write it out. It's written a chunk at a time, so the source is never made contiguous.
             try
             {
                 productFileSet->add(compileSourcePath);
 
-                File::writeAllText(compileSourcePath, options.sourceContents);
+                FileStream stream(compileSourcePath, FileMode::Create, FileAccess::Write, FileShare::ReadWrite);
+                SLANG_RETURN_ON_FAIL(options.sourceContents.writeTo(&stream));
             }
             catch (...)
             {
@@ -339,7 +359,7 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
         }
 
         // There is no source contents
-        options.sourceContents = String();
+        options.sourceContents.clear();
         options.sourceContentsPath = String();
     }
 
@@ -3,6 +3,7 @@
 
 #include "slang-common.h"
 #include "slang-string.h"
+#include "slang-chunked-string.h"
 
 #include "slang-process-util.h"
 
@@ -271,13 +272,26 @@ public:
         List<Define> defines;
 
             /// The contents of the source to compile. This can be empty is sourceFiles is set.
-            /// If the compiler is a commandLine file this source will be written to a temporary file.
-        String sourceContents;
+            /// If the compiler is a commandLine file this source will be written to a temporary file (a chunk at a time,
+            /// so large generated source is never made contiguous).
+        ChunkedString sourceContents;
             /// 'Path' that the contents originated from. NOTE! This is for reporting only and doesn't have to exist on file system
         String sourceContentsPath;
 
+            /// Source that is compiled before sourceContents (which must be set), as if it was at its start.
+            /// Typically a large prelude that is identical across compilations. A compiler that supports precompiled
+            /// headers can compile it once and reuse the result (see CommandLineDownstreamCompiler::getPrecompiledPrelude),
+            /// otherwise it is just prepended to sourceContents.
+        String preludeContents;
+            /// If set precompiled preludes are stored in (and reused from) this directory, so they can be shared between
+            /// processes. If not set they are held in temporary files for the lifetime of the compiler.
+        String precompiledPreludeDirectory;
+
             /// The names/paths of source to compile. This can be empty if sourceContents is set.
-        List<String> sourceFiles;           
+        List<String> sourceFiles;
+
+            /// Headers that are included before anything else in each source file
+        List<String> forceIncludePaths;
 
         List<String> includePaths;
         List<String> libraryPaths;
@@ -381,6 +395,12 @@ public:
     virtual SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine) = 0;
     virtual SlangResult parseOutput(const ExecuteResult& exeResult, DownstreamDiagnostics& output) = 0;
 
+        /// Get the path to a header holding options.preludeContents that has been precompiled for options, such that
+        /// adding it to the forceIncludePaths of options compiles the prelude from the precompiled header.
+        /// Returns SLANG_E_NOT_AVAILABLE if the compiler can't precompile the prelude, in which case it is compiled
+        /// as part of the source. Can be called from multiple threads at the same time.
+    virtual SlangResult getPrecompiledPrelude(const CompileOptions& options, String& outHeaderPath) { SLANG_UNUSED(options); SLANG_UNUSED(outHeaderPath); return SLANG_E_NOT_AVAILABLE; }
+
     CommandLineDownstreamCompiler(const Desc& desc, const String& exeName) :
         Super(desc)
     {
@@ -4,10 +4,14 @@
 #include "slang-common.h"
 #include "../../slang-com-helper.h"
 #include "slang-string-util.h"
+#include "slang-hash.h"
 
 #include "slang-io.h"
+#include "slang-platform.h"
 #include "slang-shared-library.h"
 
+#include <atomic>
+
 namespace Slang
 {
 
@@ -419,11 +423,8 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
     return SLANG_OK;
 }
 
-/* static */SlangResult GCCDownstreamCompilerUtil::calcArgs(const CompileOptions& options, CommandLine& cmdLine)
+/* static */SlangResult GCCDownstreamCompilerUtil::calcCompileArgs(const CompileOptions& options, CommandLine& cmdLine)
 {
-    SLANG_ASSERT(options.sourceContents.getLength() == 0);
-    SLANG_ASSERT(options.modulePath.getLength());
-
     PlatformKind platformKind = (options.platform == PlatformKind::Unknown) ? PlatformUtil::getPlatformKind() : options.platform;
         
     if (options.sourceLanguage == SLANG_SOURCE_LANGUAGE_CPP)
@@ -501,6 +502,46 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
         }
     }
 
+    if (options.targetType == TargetType::SharedLibrary && PlatformUtil::isFamily(PlatformFamily::Unix, platformKind))
+    {
+        // Position independent
+        cmdLine.addArg("-fPIC");
+    }
+
+    // Add defines
+    for (const auto& define : options.defines)
+    {
+        StringBuilder builder;
+
+        builder << "-D";
+        builder << define.nameWithSig;
+        if (define.value.getLength())
+        {
+            builder << "=" << define.value;
+        }
+
+        cmdLine.addArg(builder);
+    }
+
+    // Add includes
+    for (const auto& include : options.includePaths)
+    {
+        cmdLine.addArg("-I");
+        cmdLine.addArg(include);
+    }
+
+    return SLANG_OK;
+}
+
+/* static */SlangResult GCCDownstreamCompilerUtil::calcArgs(const CompileOptions& options, CommandLine& cmdLine)
+{
+    SLANG_ASSERT(options.sourceContents.getLength() == 0);
+    SLANG_ASSERT(options.modulePath.getLength());
+
+    PlatformKind platformKind = (options.platform == PlatformKind::Unknown) ? PlatformUtil::getPlatformKind() : options.platform;
+
+    SLANG_RETURN_ON_FAIL(calcCompileArgs(options, cmdLine));
+
     StringBuilder moduleFilePath;
     calcModuleFilePath(options, moduleFilePath);
 
@@ -513,12 +554,6 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
         {
             // Shared library
             cmdLine.addArg("-shared");
-
-            if (PlatformUtil::isFamily(PlatformFamily::Unix, platformKind))
-            {
-                // Position independent
-                cmdLine.addArg("-fPIC");
-            }
             break;
         }
         case TargetType::Executable:
@@ -534,26 +569,11 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
         default: break;
     }
 
-    // Add defines
-    for (const auto& define : options.defines)
+    // Add forced includes. If there is a precompiled header alongside one (with the .gch or .pch extension) it will be used.
+    for (const auto& forceInclude : options.forceIncludePaths)
     {
-        StringBuilder builder;
-
-        builder << "-D";
-        builder << define.nameWithSig;
-        if (define.value.getLength())
-        {
-            builder << "=" << define.value;
-        }
-
-        cmdLine.addArg(builder);
-    }
-
-    // Add includes
-    for (const auto& include : options.includePaths)
-    {
-        cmdLine.addArg("-I");
-        cmdLine.addArg(include);
+        cmdLine.addArg("-include");
+        cmdLine.addArg(forceInclude);
     }
 
     // Link options
@@ -601,6 +621,27 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
     return SLANG_OK;
 }
 
+/* static */void GCCDownstreamCompilerUtil::calcPrecompiledHeaderPath(const DownstreamCompiler::Desc& desc, const UnownedStringSlice& headerPath, StringBuilder& outPath)
+{
+    // When a header is included, gcc looks for a precompiled version with .gch appended to its path, and clang with .pch
+    outPath << headerPath << ((desc.type == SLANG_PASS_THROUGH_CLANG) ? ".pch" : ".gch");
+}
+
+/* static */SlangResult GCCDownstreamCompilerUtil::calcPrecompiledHeaderArgs(const CompileOptions& options, const String& headerPath, const String& precompiledHeaderPath, CommandLine& cmdLine)
+{
+    // A precompiled header is only valid for compilations with the same compile args, so they are used as is
+    SLANG_RETURN_ON_FAIL(calcCompileArgs(options, cmdLine));
+
+    cmdLine.addArg("-x");
+    cmdLine.addArg((options.sourceLanguage == SLANG_SOURCE_LANGUAGE_C) ? "c-header" : "c++-header");
+    cmdLine.addArg(headerPath);
+
+    cmdLine.addArg("-o");
+    cmdLine.addArg(precompiledHeaderPath);
+
+    return SLANG_OK;
+}
+
 /* static */SlangResult GCCDownstreamCompilerUtil::createCompiler(const String& path, const String& inExeName, RefPtr<DownstreamCompiler>& outCompiler)
 {
     String exeName(inExeName);
@@ -642,4 +683,160 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
     return SLANG_OK;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! GCCDownstreamCompiler !!!!!!!!!!!!!!!!!!!!!!!!*/
+
+GCCDownstreamCompiler::GCCDownstreamCompiler(const Desc& desc):
+    Super(desc),
+    m_temporaryFiles(new TemporaryFileSet)
+{
+}
+
+SlangResult GCCDownstreamCompiler::getPrecompiledPrelude(const CompileOptions& options, String& outHeaderPath)
+{
+    CommandLine compileArgs;
+    SLANG_RETURN_ON_FAIL(Util::calcCompileArgs(options, compileArgs));
+
+    // The key holds everything that the precompiled header depends on. As that includes all of the compile
+    // args, a precompiled header is only ever used by compilations it is valid for.
+    StringBuilder key;
+    key << "slang-precompiled-prelude 1\n";
+    m_desc.appendAsText(key);
+    key << "\nsourceLanguage: " << Index(options.sourceLanguage) << "\n";
+    for (const auto& arg : compileArgs.m_args)
+    {
+        key << "arg: " << arg.value.getLength() << ":" << arg.value << "\n";
+    }
+    key << "prelude: " << options.preludeContents.getLength() << ":" << options.preludeContents;
+
+    // Only one thread at a time creates precompiled headers, so that each is only created once
+    std::lock_guard<std::mutex> lock(m_precompiledPreludeMutex);
+
+    String headerPath;
+    if (const String* foundHeaderPath = m_precompiledPreludeHeaderPaths.TryGetValue(key))
+    {
+        headerPath = *foundHeaderPath;
+    }
+    else
+    {
+        // A failure is recorded as an empty path, so it isn't attempted again
+        if (SLANG_FAILED(_createPrecompiledPrelude(options, key.getUnownedSlice(), headerPath)))
+        {
+            headerPath = String();
+        }
+        m_precompiledPreludeHeaderPaths.Add(String(key.getUnownedSlice()), headerPath);
+    }
+
+    if (headerPath.getLength() == 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    outHeaderPath = headerPath;
+    return SLANG_OK;
+}
+
+SlangResult GCCDownstreamCompiler::_precompilePrelude(const CompileOptions& options, const String& headerPath, const String& precompiledHeaderPath)
+{
+    SLANG_RETURN_ON_FAIL(File::writeAllBytes(headerPath, options.preludeContents.getBuffer(), options.preludeContents.getLength()));
+
+    CommandLine cmdLine(m_cmdLine);
+    SLANG_RETURN_ON_FAIL(Util::calcPrecompiledHeaderArgs(options, headerPath, precompiledHeaderPath, cmdLine));
+
+    ExecuteResult exeRes;
+    SLANG_RETURN_ON_FAIL(ProcessUtil::execute(cmdLine, exeRes));
+    return (exeRes.resultCode == 0 && File::exists(precompiledHeaderPath)) ? SLANG_OK : SLANG_FAIL;
+}
+
+SlangResult GCCDownstreamCompiler::_createPrecompiledPrelude(const CompileOptions& options, const UnownedStringSlice& key, String& outHeaderPath)
+{
+    // If there is a directory, look for a precompiled header made previously (perhaps by another process), else make one there.
+    //
+    // The precompiled header is made from a header at the path it is used from, as compilers (such as clang) record the
+    // path of the header and check it when the precompiled header is used. For the same reason a header must never be
+    // replaced, so each one made has a unique name. The key file is written last (and atomically), and names the header
+    // to use, so an entry is only ever found complete.
+    const String& directoryPath = options.precompiledPreludeDirectory;
+    if (directoryPath.getLength())
+    {
+        StringBuilder entryName;
+        entryName << "slang-prelude-" << String(UInt64(getStableHashCode64(key.begin(), key.getLength())), 16);
+
+        StringBuilder builder;
+        Path::combineIntoBuilder(directoryPath.getUnownedSlice(), entryName.getUnownedSlice(), builder);
+        builder << ".key";
+        const String keyPath = builder;
+
+        // The key file holds the header's file name on the first line, followed by the key
+        ScopedAllocation storedKey;
+        if (File::exists(keyPath) && SLANG_SUCCEEDED(File::readAllBytes(keyPath, storedKey)))
+        {
+            const UnownedStringSlice storedContents((const char*)storedKey.getData(), storedKey.getSizeInBytes());
+            const Index lineEndIndex = storedContents.indexOf('\n');
+            if (lineEndIndex > 0 && UnownedStringSlice(storedContents.begin() + lineEndIndex + 1, storedContents.end()) == key)
+            {
+                const String headerPath = Path::combine(directoryPath, String(storedContents.head(lineEndIndex)));
+
+                builder.Clear();
+                Util::calcPrecompiledHeaderPath(m_desc, headerPath.getUnownedSlice(), builder);
+                if (File::exists(headerPath) && File::exists(builder))
+                {
+                    outHeaderPath = headerPath;
+                    return SLANG_OK;
+                }
+            }
+        }
+
+        // The process id makes the name unique between processes, the counter between compilers in this process
+        static std::atomic<uint64_t> s_headerCounter(0);
+
+        StringBuilder headerFileName;
+        headerFileName << entryName << "-" << String(UInt64(PlatformUtil::getProcessId()), 16) << "-" << String(UInt64(s_headerCounter++), 16) << ".h";
+
+        const String headerPath = Path::combine(directoryPath, headerFileName);
+        builder.Clear();
+        Util::calcPrecompiledHeaderPath(m_desc, headerPath.getUnownedSlice(), builder);
+        const String precompiledHeaderPath = builder;
+
+        if (SLANG_SUCCEEDED(_precompilePrelude(options, headerPath, precompiledHeaderPath)))
+        {
+            // If the key can't be written, the entry can still be used by this compiler
+            builder.Clear();
+            builder << headerFileName << "\n" << key;
+            File::writeAllBytesAndRename(keyPath, builder.getBuffer(), size_t(builder.getLength()));
+
+            outHeaderPath = headerPath;
+            return SLANG_OK;
+        }
+
+        // Try again with temporary files
+        File::remove(headerPath);
+        File::remove(precompiledHeaderPath);
+    }
+
+    // Precompile into temporary files, which are removed when the compiler is destroyed
+    String basePath;
+    SLANG_RETURN_ON_FAIL(File::generateTemporary(UnownedStringSlice::fromLiteral("slang-prelude"), basePath));
+    m_temporaryFiles->add(basePath);
+
+    String headerPath;
+    {
+        StringBuilder builder;
+        builder << basePath << ".h";
+        headerPath = builder;
+    }
+    String precompiledHeaderPath;
+    {
+        StringBuilder builder;
+        Util::calcPrecompiledHeaderPath(m_desc, headerPath.getUnownedSlice(), builder);
+        precompiledHeaderPath = builder;
+    }
+    m_temporaryFiles->add(headerPath);
+    m_temporaryFiles->add(precompiledHeaderPath);
+
+    SLANG_RETURN_ON_FAIL(_precompilePrelude(options, headerPath, precompiledHeaderPath));
+
+    outHeaderPath = headerPath;
+    return SLANG_OK;
+}
+
 }
@@ -2,6 +2,9 @@
 #define SLANG_GCC_COMPILER_UTIL_H
 
 #include "slang-downstream-compiler.h"
+#include "slang-dictionary.h"
+
+#include <mutex>
 
 namespace Slang
 {
@@ -18,6 +21,14 @@ struct GCCDownstreamCompilerUtil : public DownstreamCompilerBaseUtil
         /// Calculate gcc family compilers (including clang) cmdLine arguments from options
     static SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine);
 
+        /// Calculate the arguments that control how source is compiled (as opposed to what is compiled, and what is produced)
+    static SlangResult calcCompileArgs(const CompileOptions& options, CommandLine& cmdLine);
+
+        /// Calculate the arguments to precompile the header at headerPath, for use by compilations with options
+    static SlangResult calcPrecompiledHeaderArgs(const CompileOptions& options, const String& headerPath, const String& precompiledHeaderPath, CommandLine& cmdLine);
+        /// Calculate the path the compiler looks for a precompiled version of the header at headerPath
+    static void calcPrecompiledHeaderPath(const DownstreamCompiler::Desc& desc, const UnownedStringSlice& headerPath, StringBuilder& outPath);
+
         /// Parse ExecuteResult into Output
     static SlangResult parseOutput(const ExecuteResult& exeRes, DownstreamDiagnostics& outOutput);
 
@@ -47,8 +58,20 @@ public:
     virtual SlangResult parseOutput(const ExecuteResult& exeResult, DownstreamDiagnostics& output) SLANG_OVERRIDE { return Util::parseOutput(exeResult, output); }
     virtual SlangResult calcModuleFilePath(const CompileOptions& options, StringBuilder& outPath) SLANG_OVERRIDE { return Util::calcModuleFilePath(options, outPath); }
     virtual SlangResult calcCompileProducts(const CompileOptions& options, ProductFlags flags,  List<String>& outPaths) SLANG_OVERRIDE { return Util::calcCompileProducts(options, flags, outPaths); }
+    virtual SlangResult getPrecompiledPrelude(const CompileOptions& options, String& outHeaderPath) SLANG_OVERRIDE;
+
+    GCCDownstreamCompiler(const Desc& desc);
+
+protected:
+    SlangResult _createPrecompiledPrelude(const CompileOptions& options, const UnownedStringSlice& key, String& outHeaderPath);
+        /// Write the prelude to headerPath, and precompile it to precompiledHeaderPath
+    SlangResult _precompilePrelude(const CompileOptions& options, const String& headerPath, const String& precompiledHeaderPath);
 
-    GCCDownstreamCompiler(const Desc& desc):Super(desc) {}
+    std::mutex m_precompiledPreludeMutex;
+        /// Maps the key of a precompiled prelude to its header path (or an empty path if it couldn't be created)
+    Dictionary<String, String> m_precompiledPreludeHeaderPaths;
+        /// Holds precompiled preludes that aren't stored in a directory
+    RefPtr<TemporaryFileSet> m_temporaryFiles;
 };
 
 }
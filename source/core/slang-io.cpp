@@ -4,6 +4,7 @@
 #include "../../slang-com-helper.h"
 
 #include "slang-string-util.h"
+#include "slang-platform.h"
 
 #ifndef __STDC__
 #   define __STDC__ 1
@@ -28,6 +29,11 @@
 #   include <sys/stat.h>
 #endif
 
+#if defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#endif
+
 #if SLANG_APPLE_FAMILY
 #   include <mach-o/dyld.h>
 #endif
@@ -36,6 +42,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <atomic>
+
 namespace Slang
 {
 
@@ -909,6 +917,149 @@ namespace Slang
         return SLANG_OK;
     }
     
+    SlangResult File::writeAllBytesAndRename(const String& path, const void* data, size_t size)
+    {
+        // The process id makes the temporary name unique between processes, the counter between threads
+        static std::atomic<uint64_t> s_tempCounter(0);
+
+        String tempPath;
+        {
+            StringBuilder builder;
+            builder << path << "-" << String(UInt64(PlatformUtil::getProcessId()), 16) << "-" << String(UInt64(s_tempCounter++), 16) << ".tmp";
+            tempPath = builder.ProduceString();
+        }
+
+        SLANG_RETURN_ON_FAIL(writeAllBytes(tempPath, data, size));
+
+        if (::rename(tempPath.getBuffer(), path.getBuffer()) != 0)
+        {
+            // Can fail on some platforms if the target already exists - in which case another writer has
+            // got there first.
+            remove(tempPath);
+            return exists(path) ? SLANG_OK : SLANG_FAIL;
+        }
+        return SLANG_OK;
+    }
+
+    /* A blob whose contents are a read only mapping of a file. The mapping is removed when the blob is destroyed. */
+    class MemoryMappedFileBlob : public BlobBase
+    {
+    public:
+        // ISlangBlob
+        SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE { return m_data; }
+        SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return m_sizeInBytes; }
+
+        MemoryMappedFileBlob(void* data, size_t sizeInBytes):
+            m_data(data),
+            m_sizeInBytes(sizeInBytes)
+        {
+        }
+
+        ~MemoryMappedFileBlob()
+        {
+#ifdef _WIN32
+            ::UnmapViewOfFile(m_data);
+#elif defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+            ::munmap(m_data, m_sizeInBytes);
+#endif
+        }
+
+    protected:
+        void* m_data;
+        size_t m_sizeInBytes;
+    };
+
+    /* static */SlangResult File::mapAllBytes(const String& path, size_t minSizeInBytes, ComPtr<ISlangBlob>& outBlob)
+    {
+#ifdef _WIN32
+        // https://docs.microsoft.com/en-us/windows/win32/memory/creating-a-file-view
+        HANDLE fileHandle = ::CreateFileW(path.toWString(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            return SLANG_E_CANNOT_OPEN;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!::GetFileSizeEx(fileHandle, &fileSize))
+        {
+            ::CloseHandle(fileHandle);
+            return SLANG_FAIL;
+        }
+        if (UInt64(fileSize.QuadPart) > UInt64(~size_t(0)))
+        {
+            // It's too large to fit in memory.
+            ::CloseHandle(fileHandle);
+            return SLANG_FAIL;
+        }
+        const size_t sizeInBytes = size_t(fileSize.QuadPart);
+        if (sizeInBytes == 0 || sizeInBytes < minSizeInBytes)
+        {
+            ::CloseHandle(fileHandle);
+            return SLANG_E_NOT_AVAILABLE;
+        }
+
+        // The view keeps the mapping (and the file) open, so the handles can be closed once it's created
+        HANDLE mappingHandle = ::CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        ::CloseHandle(fileHandle);
+        if (!mappingHandle)
+        {
+            return SLANG_FAIL;
+        }
+        void* data = ::MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        ::CloseHandle(mappingHandle);
+        if (!data)
+        {
+            return SLANG_FAIL;
+        }
+
+        outBlob = ComPtr<ISlangBlob>(new MemoryMappedFileBlob(data, sizeInBytes));
+        return SLANG_OK;
+#elif defined(__linux__) || defined(__CYGWIN__) || SLANG_APPLE_FAMILY
+        // https://man7.org/linux/man-pages/man2/mmap.2.html
+        const int fd = ::open(path.getBuffer(), O_RDONLY);
+        if (fd < 0)
+        {
+            return SLANG_E_CANNOT_OPEN;
+        }
+
+        struct stat statVar;
+        if (::fstat(fd, &statVar) != 0 || !S_ISREG(statVar.st_mode))
+        {
+            ::close(fd);
+            return SLANG_FAIL;
+        }
+        if (UInt64(statVar.st_size) > UInt64(~size_t(0)))
+        {
+            // It's too large to fit in memory.
+            ::close(fd);
+            return SLANG_FAIL;
+        }
+        const size_t sizeInBytes = size_t(statVar.st_size);
+        if (sizeInBytes == 0 || sizeInBytes < minSizeInBytes)
+        {
+            ::close(fd);
+            return SLANG_E_NOT_AVAILABLE;
+        }
+
+        // The mapping keeps the file open, so the descriptor can be closed once it's created
+        void* data = ::mmap(nullptr, sizeInBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            return SLANG_FAIL;
+        }
+
+        outBlob = ComPtr<ISlangBlob>(new MemoryMappedFileBlob(data, sizeInBytes));
+        return SLANG_OK;
+#else
+        SLANG_UNUSED(path);
+        SLANG_UNUSED(minSizeInBytes);
+        SLANG_UNUSED(outBlob);
+        return SLANG_E_NOT_IMPLEMENTED;
+#endif
+    }
+
     void File::writeAllText(const Slang::String& fileName, const Slang::String& text)
     {
         StreamWriter writer(new FileStream(fileName, FileMode::Create));
@@ -18,10 +18,21 @@ namespace Slang
 
         static List<unsigned char> readAllBytes(const String& fileName);
         static SlangResult readAllBytes(const String& fileName, ScopedAllocation& out);
+            /// Map the contents of fileName into memory (read only), returning a blob that owns the mapping.
+            /// The contents aren't copied, and the pages can be shared (through the OS page cache) with other
+            /// processes that read the same file.
+            /// Files smaller than minSizeInBytes (and empty files, which can't be mapped) aren't mapped, and
+            /// SLANG_E_NOT_AVAILABLE is returned, so the caller can read them instead. Returns
+            /// SLANG_E_NOT_IMPLEMENTED on targets that don't support memory mapping.
+        static SlangResult mapAllBytes(const String& fileName, size_t minSizeInBytes, ComPtr<ISlangBlob>& outBlob);
 
         static void writeAllText(const String& fileName, const String& text);
 
         static SlangResult writeAllBytes(const String& fileName, const void* data, size_t size);
+            /// Write to a temporary file in the same directory and then rename it to fileName, so another thread or
+            /// process can never see a partially written file. If fileName is replaced by another writer at the same
+            /// time, one of the writes wins.
+        static SlangResult writeAllBytesAndRename(const String& fileName, const void* data, size_t size);
         
         static SlangResult remove(const String& fileName);
 
@@ -404,8 +404,11 @@ SlangResult NVRTCDownstreamCompiler::compile(const CompileOptions& options, RefP
 
     SLANG_ASSERT(headers.getCount() == headerIncludeNames.getCount());
 
+    // nvrtc needs the source as a single string
+    const String sourceContents = options.sourceContents.toString();
+
     nvrtcProgram program = nullptr;
-    nvrtcResult res = m_nvrtcCreateProgram(&program, options.sourceContents.getBuffer(), options.sourceContentsPath.getBuffer(),
+    nvrtcResult res = m_nvrtcCreateProgram(&program, sourceContents.getBuffer(), options.sourceContentsPath.getBuffer(),
         (int) headers.getCount(),
         headers.getBuffer(),
         headerIncludeNames.getBuffer());
@@ -16,6 +16,7 @@
 #else
 	#include "slang-string.h"
 	#include <dlfcn.h>
+	#include <unistd.h>
 #endif
 
 namespace Slang
@@ -104,6 +105,11 @@ SLANG_COMPILE_TIME_ASSERT(E_OUTOFMEMORY == SLANG_E_OUT_OF_MEMORY);
     return SLANG_FAIL;
 }
 
+/* static */uint64_t PlatformUtil::getProcessId()
+{
+    return uint64_t(::GetCurrentProcessId());
+}
+
 /* static */SlangResult SharedLibrary::loadWithPlatformPath(char const* platformFileName, SharedLibrary::Handle& handleOut)
 {
     handleOut = nullptr;
@@ -167,6 +173,11 @@ SLANG_COMPILE_TIME_ASSERT(E_OUTOFMEMORY == SLANG_E_OUT_OF_MEMORY);
     return SLANG_E_NOT_IMPLEMENTED;
 }
 
+/* static */uint64_t PlatformUtil::getProcessId()
+{
+    return uint64_t(::getpid());
+}
+
 /* static */SlangResult SharedLibrary::loadWithPlatformPath(char const* platformFileName, Handle& handleOut)
 {
     handleOut = nullptr;
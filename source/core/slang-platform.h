@@ -136,6 +136,9 @@ namespace Slang
             /// Get the path to this instance (the path to the dll/executable/shared library the call is in)
             /// NOTE! This is not supported on all platforms, and will return SLANG_E_NOT_IMPLEMENTED in that scenario
         static SlangResult getInstancePath(StringBuilder& out);
+
+            /// Get an identifier for the current process, unique amongst the processes running on the system
+        static uint64_t getProcessId();
     };
 
 #ifndef _MSC_VER
@@ -7,13 +7,19 @@
 
 #include "../../slang.h"
 
+#include <atomic>
+
 namespace Slang
 {
     // Base class for all reference-counted objects
+    //
+    // The reference count is atomic, so that objects can be shared between threads - for example
+    // the stdlib modules, scopes and names held by a global session are shared by all of the
+    // sessions and compile requests created from it, which may be used on different threads.
     class RefObject
     {
     private:
-        UInt referenceCount;
+        std::atomic<UInt> referenceCount;
 
     public:
         RefObject()
@@ -24,41 +30,45 @@ namespace Slang
             : referenceCount(0)
         {}
 
-        RefObject& operator=(const RefObject& rhs) = default;
+            /// Assignment doesn't change the reference count of either object
+        RefObject& operator=(const RefObject&) { return *this; }
 
         virtual ~RefObject()
         {}
 
         UInt addReference()
         {
-            return ++referenceCount;
+            // Taking a reference doesn't need to order any other memory accesses
+            return referenceCount.fetch_add(1, std::memory_order_relaxed) + 1;
         }
 
         UInt decreaseReference()
         {
-            return --referenceCount;
+            return referenceCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
         }
 
         UInt releaseReference()
         {
-            SLANG_ASSERT(referenceCount != 0);
-            if(--referenceCount == 0)
+            SLANG_ASSERT(referenceCount.load(std::memory_order_relaxed) != 0);
+            // Release/acquire makes all writes made through other references visible before the delete
+            const UInt count = referenceCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+            if (count == 0)
             {
                 delete this;
-                return 0;
             }
-            return referenceCount;
+            return count;
         }
 
         bool isUniquelyReferenced()
         {
-            SLANG_ASSERT(referenceCount != 0);
-            return referenceCount == 1;
+            const UInt count = referenceCount.load(std::memory_order_acquire);
+            SLANG_ASSERT(count != 0);
+            return count == 1;
         }
 
         UInt debugGetReferenceCount()
         {
-            return referenceCount;
+            return referenceCount.load(std::memory_order_relaxed);
         }
     };
 
@@ -0,0 +1,128 @@
+#include "slang-thread-pool.h"
+
+namespace Slang {
+
+/* static */Index ThreadPool::getHardwareThreadCount()
+{
+    // Can return 0 if the value is not computable
+    const unsigned int count = std::thread::hardware_concurrency();
+    return count ? Index(count) : 1;
+}
+
+ThreadPool::ThreadPool(Index threadCount):
+    m_nextIndex(0)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = getHardwareThreadCount();
+    }
+
+    // The calling thread takes part in executing work, so we need one less worker
+    const Index workerCount = threadCount - 1;
+    m_threads.setCount(workerCount);
+    for (Index i = 0; i < workerCount; ++i)
+    {
+        m_threads[i] = std::thread(&ThreadPool::_workerMain, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_startCondition.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::_runItems()
+{
+    for (;;)
+    {
+        const Index index = m_nextIndex.fetch_add(1);
+        if (index >= m_count)
+        {
+            return;
+        }
+        m_func(m_context, index);
+    }
+}
+
+void ThreadPool::_workerMain()
+{
+    uint64_t seenGeneration = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_startCondition.wait(lock, [&]() { return m_isShuttingDown || m_batchGeneration != seenGeneration; });
+            if (m_isShuttingDown)
+            {
+                return;
+            }
+            seenGeneration = m_batchGeneration;
+        }
+
+        _runItems();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busyWorkerCount == 0)
+            {
+                m_doneCondition.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::parallelFor(Index count, Func func, void* context)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    // If there is only a single item, or no workers, there is nothing to be gained from waking anything up
+    if (count == 1 || m_threads.getCount() == 0)
+    {
+        for (Index i = 0; i < count; ++i)
+        {
+            func(context, i);
+        }
+        return;
+    }
+
+    // No worker is running, so it's safe to set up the batch without holding the lock.
+    // The lock taken below makes the writes visible to the workers.
+    m_func = func;
+    m_context = context;
+    m_count = count;
+    m_nextIndex.store(0);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_busyWorkerCount = m_threads.getCount();
+        m_batchGeneration++;
+    }
+    m_startCondition.notify_all();
+
+    // Take part in the work
+    _runItems();
+
+    // Wait for every worker to finish, so the batch state can be safely reused
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCondition.wait(lock, [&]() { return m_busyWorkerCount == 0; });
+    }
+
+    m_func = nullptr;
+    m_context = nullptr;
+    m_count = 0;
+}
+
+} // namespace Slang
@@ -0,0 +1,74 @@
+#ifndef SLANG_CORE_THREAD_POOL_H
+#define SLANG_CORE_THREAD_POOL_H
+
+#include "slang-common.h"
+#include "slang-list.h"
+#include "slang-smart-pointer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Slang {
+
+/* A fixed size pool of worker threads, used to run 'parallel for' style batches of independent work items.
+
+The thread calling `parallelFor` takes part in executing the batch, and the call only returns once every item has
+completed. Items are handed out one index at a time from a shared counter, so the order in which items run (and the
+thread they run on) is *not* defined. Code that needs deterministic output should write results into storage indexed
+by the item index, and combine them in index order after `parallelFor` returns.
+
+NOTE! Work items must not throw. Reference counting is atomic, so items can share reference counted objects
+(including `String`), but any other access to shared objects needs to be synchronized by the items. */
+class ThreadPool : public RefObject
+{
+public:
+    typedef void(*Func)(void* context, Index index);
+
+        /// Run func(context, i) for every i in [0, count). Blocks until all have completed.
+    void parallelFor(Index count, Func func, void* context);
+
+        /// Run f(i) for every i in [0, count). Blocks until all have completed.
+    template <typename F>
+    void parallelFor(Index count, F& f) { parallelFor(count, &_invoke<F>, (void*)&f); }
+
+        /// The number of threads that execute work - includes the calling thread
+    Index getThreadCount() const { return m_threads.getCount() + 1; }
+
+        /// Returns the number of hardware threads available, or 1 if it can't be determined
+    static Index getHardwareThreadCount();
+
+        /// Ctor. threadCount is the total number of threads that take part in executing work, including the calling thread.
+        /// If threadCount is <= 0, getHardwareThreadCount() is used.
+    explicit ThreadPool(Index threadCount);
+        /// Dtor
+    ~ThreadPool();
+
+protected:
+    template <typename F>
+    static void _invoke(void* context, Index index) { (*(F*)context)(index); }
+
+    void _workerMain();
+    void _runItems();
+
+    List<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_startCondition;       ///< Signalled when a batch starts (or on shutdown)
+    std::condition_variable m_doneCondition;        ///< Signalled when the last worker finishes a batch
+
+    uint64_t m_batchGeneration = 0;                 ///< Incremented for each batch, guarded by m_mutex
+    Index m_busyWorkerCount = 0;                    ///< Workers that have yet to finish the current batch, guarded by m_mutex
+    bool m_isShuttingDown = false;                  ///< Guarded by m_mutex
+
+    // State of the current batch. Only written by the thread calling parallelFor whilst no workers are running.
+    Func m_func = nullptr;
+    void* m_context = nullptr;
+    Index m_count = 0;
+    std::atomic<Index> m_nextIndex;
+};
+
+}
+
+#endif
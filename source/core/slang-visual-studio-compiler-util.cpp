@@ -237,6 +237,13 @@ namespace Slang
         cmdLine.addArg(include);
     }
 
+    // Add forced includes
+    for (const auto& forceInclude : options.forceIncludePaths)
+    {
+        cmdLine.addArg("/FI");
+        cmdLine.addArg(forceInclude);
+    }
+
     // https://docs.microsoft.com/en-us/cpp/build/reference/eh-exception-handling-model?view=vs-2019
     // /Eha - Specifies the model of exception handling. (a, s, c, r are options)
 
@@ -9,6 +9,7 @@
 
 //#include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <poll.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -17,8 +18,32 @@
 
 #include <time.h>
 
+#include <mutex>
+
 namespace Slang {
 
+#if !SLANG_LINUX_FAMILY
+// Without pipe2, making a pipe close-on-exec takes a separate call, so a fork on another thread in between would
+// inherit the pipe. Creating pipes and forking in execute are serialized with this mutex to close that window.
+static std::mutex s_pipeForkMutex;
+#endif
+
+// Create a pipe with both ends close-on-exec
+static int _createPipe(int fds[2])
+{
+#if SLANG_LINUX_FAMILY
+    return pipe2(fds, O_CLOEXEC);
+#else
+    if (pipe(fds) == -1)
+    {
+        return -1;
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return 0;
+#endif
+}
+
 
 /* static */UnownedStringSlice ProcessUtil::getExecutableSuffix()
 {
@@ -105,19 +130,34 @@ namespace Slang {
     int stdoutPipe[2];
     int stderrPipe[2];
 
-    if (pipe(stdoutPipe) == -1)
+    // If processes are executed from multiple threads at the same time, we don't want the pipes to be
+    // inherited by other child processes, as that would stop end-of-file being seen until they exit.
+    // So the pipes are created close-on-exec. The dup2 of the write ends into the child's stdout/stderr
+    // clears the flag, so the child still works.
+#if !SLANG_LINUX_FAMILY
+    std::unique_lock<std::mutex> pipeForkLock(s_pipeForkMutex);
+#endif
+
+    if (_createPipe(stdoutPipe) == -1)
     {
         fprintf(stderr, "error: `pipe` failed\n");
         return SLANG_FAIL;
     }
 
-    if (pipe(stderrPipe) == -1)
+    if (_createPipe(stderrPipe) == -1)
     {
         fprintf(stderr, "error: `pipe` failed\n");
         return SLANG_FAIL;
     }
 
     pid_t childProcessID = fork();
+
+#if !SLANG_LINUX_FAMILY
+    if (childProcessID != 0)
+    {
+        pipeForkLock.unlock();
+    }
+#endif
     if (childProcessID == -1)
     {
         fprintf(stderr, "error: `fork` failed\n");
@@ -139,9 +179,14 @@ namespace Slang {
 
         execvp(argPtrs[0], (char* const*)&argPtrs[0]);
 
-        // If we get here, then `exec` failed
-        fprintf(stderr, "error: `exec` failed\n");
-        return SLANG_FAIL;
+        // If we get here, then `exec` failed. The child must exit here rather than return, as returning would
+        // carry on running the parent's code (and could block on locks that were held by the parent when it forked).
+        // The parent sees the failure through the exit code. Only async-signal-safe functions can be used after
+        // forking a multi-threaded process, so the message is written with write rather than fprintf.
+        static const char message[] = "error: `exec` failed\n";
+        const ssize_t writeResult = write(STDERR_FILENO, message, sizeof(message) - 1);
+        SLANG_UNUSED(writeResult);
+        _exit(127);
     }
     else
     {
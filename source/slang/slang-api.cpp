@@ -612,6 +612,46 @@ SLANG_API SlangResult spEnableReproCapture(
     return request->enableReproCapture();
 }
 
+SLANG_API void spSetInstrumentationFlags(
+    slang::ICompileRequest*     request,
+    SlangInstrumentationFlags   flags)
+{
+    SLANG_ASSERT(request);
+    request->setInstrumentationFlags(flags);
+}
+
+SLANG_API SlangInt spGetInstrumentationEntryCount(
+    slang::ICompileRequest*     request)
+{
+    SLANG_ASSERT(request);
+    return request->getInstrumentationEntryCount();
+}
+
+SLANG_API SlangResult spGetInstrumentationEntry(
+    slang::ICompileRequest*     request,
+    SlangInt                    index,
+    SlangInstrumentationEntry*  outEntry)
+{
+    SLANG_ASSERT(request);
+    return request->getInstrumentationEntry(index, outEntry);
+}
+
+SLANG_API SlangResult spGetInstrumentationTrace(
+    slang::ICompileRequest*     request,
+    ISlangBlob**                outBlob)
+{
+    SLANG_ASSERT(request);
+    return request->getInstrumentationTrace(outBlob);
+}
+
+SLANG_API void spSetModuleCachePath(
+    slang::ICompileRequest*     request,
+    const char*                 path)
+{
+    SLANG_ASSERT(request);
+    request->setModuleCachePath(path);
+}
+
 SLANG_API SlangResult spCompileRequest_getProgram(
     slang::ICompileRequest*    request,
     slang::IComponentType** outProgram)
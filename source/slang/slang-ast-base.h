@@ -9,6 +9,8 @@
 
 #include "slang-serialize-reflection.h"
 
+#include <atomic>
+
 // This file defines the primary base classes for the hierarchy of
 // AST nodes and related objects. For example, this is where the
 // basic `Decl`, `Stmt`, `Expr`, `type`, etc. definitions come from.
@@ -161,9 +163,11 @@ protected:
     bool equalsImpl(Type* type);
     Type* createCanonicalType();
 
-    Type* canonicalType = nullptr;
-
     SLANG_UNREFLECTED
+
+        /// Created lazily, and may be read without a lock by other threads, so is published with release/acquire
+    std::atomic<Type*> canonicalType{nullptr};
+
     ASTBuilder* m_astBuilder = nullptr;
 };
 
@@ -8,7 +8,8 @@ namespace Slang {
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! SharedASTBuilder !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
-SharedASTBuilder::SharedASTBuilder()
+SharedASTBuilder::SharedASTBuilder():
+    m_id(1)
 {    
 }
 
@@ -42,7 +43,7 @@ void SharedASTBuilder::init(Session* session)
         if (info)
         {
             m_sliceToTypeMap.Add(UnownedStringSlice(info->m_name), info);
-            Name* name = m_namePool->getName(String(info->m_name));
+            Name* name = m_namePool->getName(UnownedStringSlice(info->m_name));
             m_nameToTypeMap.Add(name, info);
         }
     }
@@ -110,6 +111,22 @@ Type* SharedASTBuilder::getDynamicType()
     return m_dynamicType;
 }
 
+void SharedASTBuilder::initLazyTypes()
+{
+    if (findMagicDecl("StringType"))
+    {
+        getStringType();
+    }
+    if (findMagicDecl("EnumTypeType"))
+    {
+        getEnumTypeType();
+    }
+    if (findMagicDecl("DynamicType"))
+    {
+        getDynamicType();
+    }
+}
+
 SharedASTBuilder::~SharedASTBuilder()
 {
     // Release built in types..
@@ -145,7 +162,10 @@ void SharedASTBuilder::registerMagicDecl(Decl* decl, MagicTypeModifier* modifier
 
 Decl* SharedASTBuilder::findMagicDecl(const String& name)
 {
-    return m_magicDecls[name].GetValue();
+    // Don't use [] as that would add an entry if not found
+    Decl* decl = nullptr;
+    m_magicDecls.TryGetValue(name, decl);
+    return decl;
 }
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! ASTBuilder !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
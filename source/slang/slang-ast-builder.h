@@ -10,6 +10,9 @@
 #include "../core/slang-type-traits.h"
 #include "../core/slang-memory-arena.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace Slang
 {
 
@@ -34,9 +37,19 @@ public:
     const ReflectClassInfo* findClassInfo(const UnownedStringSlice& slice);
     SyntaxClass<NodeBase> findSyntaxClass(const UnownedStringSlice& slice);
 
-        // Look up a magic declaration by its name
+        // Look up a magic declaration by its name. Returns nullptr if not found.
     Decl* findMagicDecl(String const& name);
 
+        /// Create the string, enum type type and dynamic types (if their magic decls have been registered) so
+        /// later uses don't create them lazily. Called once builtin modules are loaded.
+    void initLazyTypes();
+
+        /// Guards values that are computed on first use and cached on AST nodes (such as canonical types).
+        /// Nodes from builtin modules are shared by every linkage created from a session, which may be used
+        /// from multiple threads, and computing such a value can allocate from the node's ASTBuilder.
+        /// It is recursive because computing a value often requires computing the same value for other nodes.
+    std::recursive_mutex& getLazyNodeMutex() { return m_lazyNodeMutex; }
+
         /// A name pool that can be used for lookup for findClassInfo etc. It is the same pool as the Session.
     NamePool* getNamePool() { return m_namePool; }
 
@@ -79,7 +92,9 @@ protected:
     ASTBuilder* m_astBuilder = nullptr;
     Session* m_session = nullptr;
 
-    Index m_id = 1;
+    std::atomic<Index> m_id;
+
+    std::recursive_mutex m_lazyNodeMutex;
 };
 
 class ASTBuilder : public RefObject
@@ -64,15 +64,22 @@ Val* Type::_substituteImplOverride(ASTBuilder* astBuilder, SubstitutionSet subst
 Type* Type::getCanonicalType()
 {
     Type* et = const_cast<Type*>(this);
-    if (!et->canonicalType)
-    {
-        // TODO(tfoley): worry about thread safety here?
-        auto canType = et->createCanonicalType();
-        et->canonicalType = canType;
 
-        SLANG_ASSERT(et->canonicalType);
+    // The acquire pairs with the release below, so a canonical type seen without the lock is complete
+    Type* canType = et->canonicalType.load(std::memory_order_acquire);
+    if (!canType)
+    {
+        // The type may be shared between threads (if it's from a builtin module), so creation is serialized.
+        std::lock_guard<std::recursive_mutex> lock(getASTBuilder()->getSharedASTBuilder()->getLazyNodeMutex());
+        canType = et->canonicalType.load(std::memory_order_relaxed);
+        if (!canType)
+        {
+            canType = et->createCanonicalType();
+            SLANG_ASSERT(canType);
+            et->canonicalType.store(canType, std::memory_order_release);
+        }
     }
-    return et->canonicalType;
+    return canType;
 }
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! OverloadGroupType !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -349,11 +356,19 @@ IntVal* MatrixExpressionType::getColumnCount()
 
 Type* MatrixExpressionType::getRowType()
 {
-    if (!rowType)
+    Type* vectorType = rowType.load(std::memory_order_acquire);
+    if (!vectorType)
     {
-        rowType = m_astBuilder->getVectorType(getElementType(), getColumnCount());
+        // As with canonical types, the matrix type may be shared between threads
+        std::lock_guard<std::recursive_mutex> lock(m_astBuilder->getSharedASTBuilder()->getLazyNodeMutex());
+        vectorType = rowType.load(std::memory_order_relaxed);
+        if (!vectorType)
+        {
+            vectorType = m_astBuilder->getVectorType(getElementType(), getColumnCount());
+            rowType.store(vectorType, std::memory_order_release);
+        }
     }
-    return rowType;
+    return vectorType;
 }
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! ArrayExpressionType !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -933,7 +948,7 @@ Val* ThisType::_substituteImplOverride(ASTBuilder* astBuilder, SubstitutionSet s
 
     (*ioDiff)++;
 
-    ThisType* substType = m_astBuilder->create<ThisType>();
+    ThisType* substType = astBuilder->create<ThisType>();
     substType->interfaceDeclRef = substInterfaceDeclRef;
     return substType;
 }
@@ -1025,7 +1040,7 @@ Val* AndType::_substituteImplOverride(ASTBuilder* astBuilder, SubstitutionSet su
 
     (*ioDiff)++;
 
-    AndType* substType = m_astBuilder->create<AndType>();
+    AndType* substType = astBuilder->create<AndType>();
     substType->left = substLeft;
     substType->right = substRight;
     return substType;
@@ -457,7 +457,9 @@ class MatrixExpressionType : public ArithmeticExpressionType
     BasicExpressionType* _getScalarTypeOverride();
 
 private:
-    Type* rowType = nullptr;
+    SLANG_UNREFLECTED
+        /// As with Type::canonicalType, created lazily and published with release/acquire
+    std::atomic<Type*> rowType{nullptr};
 };
 
 // The built-in `String` type
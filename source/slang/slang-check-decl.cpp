@@ -4903,6 +4903,12 @@ namespace Slang
         //
         m_candidateExtensionListsBuilt = false;
         m_mapTypeDeclToCandidateExtensions.Clear();
+
+        // The new extension could also make a type conform to an interface
+        // that it didn't before, so a call resolved earlier might now
+        // resolve to a different (more specialized) overload.
+        //
+        m_moduleTypeCheckingCache.resolvedInvokeCache.Clear();
     }
 
     void SharedSemanticsContext::_addCandidateExtensionsFromModule(ModuleDecl* moduleDecl)
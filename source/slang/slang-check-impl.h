@@ -34,6 +34,9 @@ namespace Slang
         return BasicTypeKey((uint8_t(baseType) << 4) | ((uint8_t(dim1) - 1) << 2) | (uint8_t(dim2) - 1));
     }
 
+    // Vectors and matrices of more than 4 elements along a dimension don't fit in a key
+    SLANG_FORCE_INLINE bool isValidBasicTypeKeyDim(IntegerLiteralValue dim) { return dim > 0 && dim <= 4; }
+
     inline BasicTypeKey makeBasicTypeKey(Type* typeIn)
     {
         if (auto basicType = as<BasicExpressionType>(typeIn))
@@ -45,7 +48,8 @@ namespace Slang
             if (auto elemCount = as<ConstantIntVal>(vectorType->elementCount))
             {
                 auto elemBasicType = as<BasicExpressionType>(vectorType->elementType);
-                return makeBasicTypeKey(elemBasicType->baseType, elemCount->value);
+                if (elemBasicType && isValidBasicTypeKeyDim(elemCount->value))
+                    return makeBasicTypeKey(elemBasicType->baseType, elemCount->value);
             }
         }
         else if (auto matrixType = as<MatrixExpressionType>(typeIn))
@@ -55,7 +59,8 @@ namespace Slang
                 if (auto elemCount2 = as<ConstantIntVal>(matrixType->getColumnCount()))
                 {
                     auto elemBasicType = as<BasicExpressionType>(matrixType->getElementType());
-                    return makeBasicTypeKey(elemBasicType->baseType, elemCount1->value, elemCount2->value);
+                    if (elemBasicType && isValidBasicTypeKeyDim(elemCount1->value) && isValidBasicTypeKeyDim(elemCount2->value))
+                        return makeBasicTypeKey(elemBasicType->baseType, elemCount1->value, elemCount2->value);
                 }
             }
         }
@@ -196,6 +201,119 @@ namespace Slang
         Dictionary<BasicTypeKeyPair, ConversionCost> conversionCostCache;
     };
 
+        /// Identifies a group of overloaded declarations (as found by a lookup) by the declarations in it
+    struct OverloadGroupKey
+    {
+        List<Decl*> decls;
+        HashCode hashCode = 0;
+
+        void addDecl(Decl* decl)
+        {
+            decls.add(decl);
+            hashCode = combineHash(hashCode, Slang::getHashCode(decl));
+        }
+
+        bool operator==(const OverloadGroupKey& rhs) const
+        {
+            if (hashCode != rhs.hashCode || decls.getCount() != rhs.decls.getCount())
+                return false;
+            for (Index i = 0; i < decls.getCount(); ++i)
+            {
+                if (decls[i] != rhs.decls[i])
+                    return false;
+            }
+            return true;
+        }
+        HashCode getHashCode() const { return hashCode; }
+    };
+
+        /// An index of the items of an overload group by the number of arguments they accept.
+        ///
+        /// Overload resolution only needs to check the items that accept the number of arguments
+        /// at a call site, as any other item can't be a better candidate than one that does. The items
+        /// of the stdlib's intrinsics (and of types with many initializers) usually take a few
+        /// different numbers of parameters, so most of them are skipped.
+        ///
+    struct OverloadGroupIndex : public RefObject
+    {
+            /// The range of argument counts accepted by each item of the group, in lookup order.
+            /// Items that aren't callables (such as a type, whose initializers are looked up when
+            /// it is called) accept any number of arguments.
+        struct ItemArity
+        {
+            UInt required = 0;
+            UInt allowed = ~UInt(0);
+        };
+        List<ItemArity> itemArities;
+
+            /// Get the indices of the items that accept `argCount` arguments, in lookup order.
+            /// The indices are copied out, as checking the items can add to the index.
+        void getItemsForArgCount(UInt argCount, List<Index>& outItems)
+        {
+            if (auto items = m_itemsByArgCount.TryGetValue(argCount))
+            {
+                outItems = *items;
+                return;
+            }
+
+            outItems.clear();
+            for (Index i = 0; i < itemArities.getCount(); ++i)
+            {
+                auto const& arity = itemArities[i];
+                if (argCount >= arity.required && argCount <= arity.allowed)
+                    outItems.add(i);
+            }
+            m_itemsByArgCount.Add(argCount, outItems);
+        }
+
+    protected:
+        Dictionary<UInt, List<Index>> m_itemsByArgCount;
+    };
+
+        /// A call to an overload group with arguments of basic types, used to look up the overload
+        /// the call resolved to
+    struct ResolvedInvokeKey
+    {
+        enum { kMaxArgCount = 4 };
+
+        OverloadGroupIndex* group = nullptr;
+        Index argCount = 0;
+        BasicTypeKey args[kMaxArgCount];
+
+        bool operator==(const ResolvedInvokeKey& rhs) const
+        {
+            if (group != rhs.group || argCount != rhs.argCount)
+                return false;
+            for (Index i = 0; i < argCount; ++i)
+            {
+                if (args[i] != rhs.args[i])
+                    return false;
+            }
+            return true;
+        }
+        HashCode getHashCode() const
+        {
+            HashCode hash = Slang::getHashCode(group);
+            for (Index i = 0; i < argCount; ++i)
+                hash = combineHash(hash, HashCode(args[i]));
+            return hash;
+        }
+    };
+
+        /// Caches used while checking a single module.
+        ///
+        /// Unlike the results in `TypeCheckingCache` (which is shared by the whole `Linkage`), these
+        /// depend on the declarations and extensions visible from the module being checked.
+    struct ModuleTypeCheckingCache
+    {
+            /// The index of each overload group called from the module
+        Dictionary<OverloadGroupKey, RefPtr<OverloadGroupIndex>> overloadGroupIndices;
+
+            /// The candidate that calls of an overload group of global functions resolved to, for
+            /// arguments of each combination of basic types
+        Dictionary<ResolvedInvokeKey, OverloadCandidate> resolvedInvokeCache;
+    };
+
         /// Shared state for a semantics-checking session.
     struct SharedSemanticsContext
     {
@@ -244,6 +362,11 @@ namespace Slang
             return m_module;
         }
 
+        ModuleTypeCheckingCache* getModuleTypeCheckingCache()
+        {
+            return &m_moduleTypeCheckingCache;
+        }
+
             /// Get the list of extension declarations that appear to apply to `decl` in this context
         List<ExtensionDecl*> const& getCandidateExtensionsForTypeDecl(AggTypeDecl* decl);
 
@@ -257,6 +380,9 @@ namespace Slang
             /// Is the `m_mapTypeDeclToCandidateExtensions` dictionary valid and up to date?
         bool m_candidateExtensionListsBuilt = false;
 
+            /// Caches of results that depend on what is visible from `m_module`
+        ModuleTypeCheckingCache m_moduleTypeCheckingCache;
+
             /// Add candidate extensions declared in `moduleDecl` to `m_mapTypeDeclToCandidateExtensions`
         void _addCandidateExtensionsFromModule(ModuleDecl* moduleDecl);
     };
@@ -1412,6 +1538,10 @@ namespace Slang
             LookupResultItem		item,
             OverloadResolveContext&	context);
 
+            /// Get the index of the items of the overload group `result` (which must be overloaded)
+        OverloadGroupIndex* getOverloadGroupIndex(
+            LookupResult const&     result);
+
         void AddOverloadCandidates(
             LookupResult const&     result,
             OverloadResolveContext&	context);
@@ -1439,6 +1569,13 @@ namespace Slang
         String getCallSignatureString(
             OverloadResolveContext&     context);
 
+            /// Make the key that a call of `funcExpr` is memoized with in the `ResolvedInvokeCache`.
+            /// Returns false if the call can't be memoized.
+        bool _makeResolvedInvokeKey(
+            Expr*                   funcExpr,
+            OverloadResolveContext& context,
+            ResolvedInvokeKey&      outKey);
+
         Expr* ResolveInvoke(InvokeExpr * expr);
 
         void AddGenericOverloadCandidate(
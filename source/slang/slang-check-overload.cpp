@@ -861,6 +861,8 @@ namespace Slang
         OverloadResolveContext& context,
         OverloadCandidate&		candidate)
     {
+        CompileInstrumentation::addCount(CompileCounter::OverloadCandidates);
+
         // Filter our existing candidates, to remove any that are worse than our new one
 
         bool keepThisCandidate = true; // should this candidate be kept?
@@ -1198,12 +1200,118 @@ namespace Slang
         }
     }
 
+    OverloadGroupIndex* SemanticsVisitor::getOverloadGroupIndex(
+        LookupResult const&     result)
+    {
+        SLANG_ASSERT(result.isOverloaded());
+
+        OverloadGroupKey key;
+        for(auto const& item : result.items)
+        {
+            key.addDecl(item.declRef.getDecl());
+        }
+
+        auto moduleCache = getShared()->getModuleTypeCheckingCache();
+        if(auto existing = moduleCache->overloadGroupIndices.TryGetValue(key))
+        {
+            return *existing;
+        }
+
+        // The number of arguments an item accepts only depends on its
+        // declaration, so the index doesn't need to look at any substitutions.
+        // A generic is called through its inner declaration, once its generic
+        // arguments have been inferred.
+        //
+        RefPtr<OverloadGroupIndex> index = new OverloadGroupIndex();
+        for(auto const& item : result.items)
+        {
+            Decl* decl = item.declRef.getDecl();
+            if(auto genericDecl = as<GenericDecl>(decl))
+            {
+                decl = genericDecl->inner;
+            }
+
+            OverloadGroupIndex::ItemArity arity;
+            if(auto callableDecl = as<CallableDecl>(decl))
+            {
+                ParamCounts paramCounts = CountParameters(getParameters(makeDeclRef(callableDecl)));
+                arity.required = paramCounts.required;
+                arity.allowed = paramCounts.allowed;
+            }
+            index->itemArities.add(arity);
+        }
+
+        moduleCache->overloadGroupIndices.Add(key, index);
+        return index;
+    }
+
+    static OverloadCandidate::Status _getBestCandidateStatus(
+        SemanticsVisitor::OverloadResolveContext& context)
+    {
+        if(context.bestCandidate)
+            return context.bestCandidate->status;
+        if(context.bestCandidates.getCount())
+            return context.bestCandidates[0].status;
+        return OverloadCandidate::Status::GenericArgumentInferenceFailed;
+    }
+
     void SemanticsVisitor::AddOverloadCandidates(
         LookupResult const&     result,
         OverloadResolveContext&	context)
     {
         if(result.isOverloaded())
         {
+            // An item that doesn't accept the number of arguments at the
+            // call site can't get past the arity check, so it can only be
+            // chosen if no candidate at all gets past it. We use the
+            // index of the group to only check the items that accept
+            // the arguments, which for the stdlib's intrinsics (and the
+            // initializers of its vector and matrix types) skips most of them.
+            //
+            List<Index> itemIndices;
+            getOverloadGroupIndex(result)->getItemsForArgCount(context.getArgCount(), itemIndices);
+
+            Index skippedCount = result.items.getCount() - itemIndices.getCount();
+            if(skippedCount == 0)
+            {
+                for(auto item : result.items)
+                {
+                    AddDeclRefOverloadCandidates(item, context);
+                }
+                return;
+            }
+
+            // If none of the candidates gets past the arity check, the items we
+            // skipped are needed to pick the candidate to report errors for, so
+            // we keep the state of `context` to start over from.
+            //
+            OverloadCandidate savedBestCandidate;
+            bool hadBestCandidate = context.bestCandidate != nullptr;
+            if(hadBestCandidate)
+            {
+                savedBestCandidate = *context.bestCandidate;
+            }
+            List<OverloadCandidate> savedBestCandidates = context.bestCandidates;
+
+            for(auto itemIndex : itemIndices)
+            {
+                AddDeclRefOverloadCandidates(result.items[itemIndex], context);
+            }
+
+            if(_getBestCandidateStatus(context) >= OverloadCandidate::Status::ArityChecked)
+            {
+                CompileInstrumentation::addCount(CompileCounter::OverloadCandidatesSkipped, skippedCount);
+                return;
+            }
+
+            context.bestCandidate = nullptr;
+            if(hadBestCandidate)
+            {
+                context.bestCandidateStorage = savedBestCandidate;
+                context.bestCandidate = &context.bestCandidateStorage;
+            }
+            context.bestCandidates = savedBestCandidates;
+
             for(auto item : result.items)
             {
                 AddDeclRefOverloadCandidates(item, context);
@@ -1475,6 +1583,44 @@ namespace Slang
         return argsListBuilder.ProduceString();
     }
 
+    bool SemanticsVisitor::_makeResolvedInvokeKey(
+        Expr*                   funcExpr,
+        OverloadResolveContext& context,
+        ResolvedInvokeKey&      outKey)
+    {
+        // Only calls of an overload group found by an unqualified lookup
+        // are memoized. Items found as members (or through a base type)
+        // carry the substitutions and breadcrumbs of the expression they
+        // were looked up in, which are not part of the key.
+        //
+        auto overloadedExpr = as<OverloadedExpr>(funcExpr);
+        if (!overloadedExpr || overloadedExpr->base)
+            return false;
+
+        auto const& lookupResult = overloadedExpr->lookupResult2;
+        if (!lookupResult.isOverloaded())
+            return false;
+        for (auto const& item : lookupResult.items)
+        {
+            if (item.breadcrumbs || item.declRef.substitutions.substitutions)
+                return false;
+        }
+
+        Index argCount = context.getArgCount();
+        if (argCount > ResolvedInvokeKey::kMaxArgCount)
+            return false;
+        for (Index i = 0; i < argCount; ++i)
+        {
+            BasicTypeKey argKey = makeBasicTypeKey(context.getArg(i)->type.type);
+            if (argKey == BasicTypeKey::Invalid)
+                return false;
+            outKey.args[i] = argKey;
+        }
+        outKey.argCount = argCount;
+        outKey.group = getOverloadGroupIndex(lookupResult);
+        return true;
+    }
+
     Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr * expr)
     {
         OverloadResolveContext context;
@@ -1558,6 +1704,32 @@ namespace Slang
         // that `(T) expr` and `T(expr)` continue to be semantically
         // equivalent in (almost) all cases.
 
+        // Calls of the stdlib's global functions (such as `lerp` or `mul`) with
+        // arguments of basic types are common, and resolve to the same overload
+        // at every call site with the same argument types. We memoize the
+        // candidate that was chosen, so that later calls only need to check it.
+        //
+        // Operators are left to the operator overload cache, as whether
+        // they resolve also depends on their fixity.
+        //
+        bool shouldAddToInvokeCache = false;
+        ResolvedInvokeKey invokeKey;
+        ModuleTypeCheckingCache* moduleTypeCheckingCache = getShared()->getModuleTypeCheckingCache();
+        if (!context.bestCandidate && !as<OperatorExpr>(expr) && _makeResolvedInvokeKey(funcExpr, context, invokeKey))
+        {
+            OverloadCandidate candidate;
+            if (moduleTypeCheckingCache->resolvedInvokeCache.TryGetValue(invokeKey, candidate))
+            {
+                CompileInstrumentation::addCount(CompileCounter::ResolvedInvokeCacheHits);
+                context.bestCandidateStorage = candidate;
+                context.bestCandidate = &context.bestCandidateStorage;
+            }
+            else
+            {
+                shouldAddToInvokeCache = true;
+            }
+        }
+
         if (!context.bestCandidate)
         {
             AddOverloadCandidates(funcExpr, context);
@@ -1671,6 +1843,8 @@ namespace Slang
             // the user the most help we can.
             if (shouldAddToCache)
                 typeCheckingCache->resolvedOperatorOverloadCache[key] = *context.bestCandidate;
+            if (shouldAddToInvokeCache && context.bestCandidate->status == OverloadCandidate::Status::Applicable)
+                moduleTypeCheckingCache->resolvedInvokeCache[invokeKey] = *context.bestCandidate;
             return CompleteOverloadCandidate(context, *context.bestCandidate);
         }
         else
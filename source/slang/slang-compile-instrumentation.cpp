@@ -0,0 +1,234 @@
+// slang-compile-instrumentation.cpp
+#include "slang-compile-instrumentation.h"
+
+#include "../core/slang-process-util.h"
+
+namespace Slang {
+
+/* static */thread_local CompileInstrumentation* CompileInstrumentation::s_current = nullptr;
+
+void CompileInstrumentation::_accumulate()
+{
+    const uint64_t tick = ProcessUtil::getClockTick();
+    m_phases[Index(m_currentPhase)].ticks += tick - m_startTick;
+    m_startTick = tick;
+}
+
+void CompileInstrumentation::_setPhase(CompilePhase phase)
+{
+    _accumulate();
+    m_phases[Index(phase)].enterCount++;
+    m_currentPhase = phase;
+}
+
+Index CompileInstrumentation::_beginTraceEvent(const char* name, const char* category, uint64_t tick)
+{
+    TraceEvent event;
+    event.name = name;
+    event.category = category;
+    event.startTick = tick;
+    event.endTick = tick;
+    event.irInstDelta = 0;
+
+    const Index index = m_traceEvents.getCount();
+    m_traceEvents.add(event);
+    return index;
+}
+
+void CompileInstrumentation::_enterPhase(CompilePhase phase, PhaseScope& scope)
+{
+    scope.m_previousPhase = m_currentPhase;
+    scope.m_previousCurrent = s_current;
+    s_current = this;
+
+    _setPhase(phase);
+
+    // Other is the time outside of all phases, so isn't an event
+    if ((m_flags & Flag::Trace) && phase != CompilePhase::Other)
+    {
+        scope.m_traceEventIndex = _beginTraceEvent(getPhaseName(phase).begin(), "phase", m_startTick);
+    }
+}
+
+void CompileInstrumentation::_leavePhase(PhaseScope& scope)
+{
+    // Time up to here belongs to the phase being left. Returning to the previous phase is not a new enter.
+    _accumulate();
+    m_currentPhase = scope.m_previousPhase;
+
+    if (scope.m_traceEventIndex >= 0)
+    {
+        m_traceEvents[scope.m_traceEventIndex].endTick = m_startTick;
+    }
+
+    s_current = scope.m_previousCurrent;
+}
+
+void CompileInstrumentation::_enterPass(const char* name, PassScope& scope)
+{
+    // Passes are few, and are identified by a literal, so a linear search is fine
+    Index passIndex = -1;
+    for (Index i = 0; i < m_passes.getCount(); ++i)
+    {
+        const char* passName = m_passes[i].name;
+        if (passName == name || ::strcmp(passName, name) == 0)
+        {
+            passIndex = i;
+            break;
+        }
+    }
+    if (passIndex < 0)
+    {
+        PassInfo pass;
+        pass.name = name;
+        pass.ticks = 0;
+        pass.runCount = 0;
+        pass.irInstDelta = 0;
+
+        passIndex = m_passes.getCount();
+        m_passes.add(pass);
+    }
+
+    m_passes[passIndex].runCount++;
+
+    scope.m_passIndex = passIndex;
+    scope.m_startTick = ProcessUtil::getClockTick();
+
+    if (m_flags & Flag::Trace)
+    {
+        scope.m_traceEventIndex = _beginTraceEvent(m_passes[passIndex].name, "pass", scope.m_startTick);
+    }
+}
+
+void CompileInstrumentation::_leavePass(PassScope& scope)
+{
+    const uint64_t tick = ProcessUtil::getClockTick();
+    m_passes[scope.m_passIndex].ticks += tick - scope.m_startTick;
+
+    if (scope.m_traceEventIndex >= 0)
+    {
+        m_traceEvents[scope.m_traceEventIndex].endTick = tick;
+    }
+}
+
+void CompileInstrumentation::addPassIRInstDelta(const PassScope& scope, Index delta)
+{
+    m_passes[scope.m_passIndex].irInstDelta += delta;
+
+    if (scope.m_traceEventIndex >= 0)
+    {
+        m_traceEvents[scope.m_traceEventIndex].irInstDelta += delta;
+    }
+}
+
+void CompileInstrumentation::update()
+{
+    _accumulate();
+}
+
+void CompileInstrumentation::reset()
+{
+    for (auto& phaseInfo : m_phases)
+    {
+        phaseInfo.ticks = 0;
+        phaseInfo.enterCount = 0;
+    }
+    for (auto& count : m_counts)
+    {
+        count = 0;
+    }
+    m_passes.clear();
+    m_traceEvents.clear();
+
+    m_currentPhase = CompilePhase::Other;
+    m_startTick = ProcessUtil::getClockTick();
+    m_resetTick = m_startTick;
+}
+
+double CompileInstrumentation::getSeconds(CompilePhase phase) const
+{
+    return double(m_phases[Index(phase)].ticks) / double(ProcessUtil::getClockFrequency());
+}
+
+double CompileInstrumentation::getPassSeconds(const PassInfo& pass) const
+{
+    return double(pass.ticks) / double(ProcessUtil::getClockFrequency());
+}
+
+void CompileInstrumentation::writeTrace(StringBuilder& out) const
+{
+    // Times in the trace event format are in microseconds
+    const double ticksToMicroseconds = 1000000.0 / double(ProcessUtil::getClockFrequency());
+
+    out << "{\n";
+    out << "\"displayTimeUnit\": \"ms\",\n";
+    out << "\"traceEvents\": [\n";
+    for (Index i = 0; i < m_traceEvents.getCount(); ++i)
+    {
+        const TraceEvent& event = m_traceEvents[i];
+
+        out << "{\"name\": \"" << event.name << "\", \"cat\": \"" << event.category << "\", \"ph\": \"X\", ";
+        out << "\"ts\": ";
+        out.append(double(event.startTick - m_resetTick) * ticksToMicroseconds, "%.3f");
+        out << ", \"dur\": ";
+        out.append(double(event.endTick - event.startTick) * ticksToMicroseconds, "%.3f");
+        out << ", \"pid\": 1, \"tid\": 1";
+        if ((m_flags & Flag::IRSize) && ::strcmp(event.category, "pass") == 0)
+        {
+            out << ", \"args\": {\"irInstDelta\": " << event.irInstDelta << "}";
+        }
+        out << "}";
+        out << ((i + 1 < m_traceEvents.getCount()) ? ",\n" : "\n");
+    }
+    out << "],\n";
+
+    out << "\"otherData\": {";
+    for (Index i = 0; i < Index(CompileCounter::CountOf); ++i)
+    {
+        out << (i ? ", " : "") << "\"" << getCounterName(CompileCounter(i)) << "\": " << m_counts[i];
+    }
+    out << "}\n";
+    out << "}\n";
+}
+
+/* static */UnownedStringSlice CompileInstrumentation::getPhaseName(CompilePhase phase)
+{
+    switch (phase)
+    {
+        case CompilePhase::Other:               return UnownedStringSlice::fromLiteral("other");
+        case CompilePhase::Preprocess:          return UnownedStringSlice::fromLiteral("preprocess");
+        case CompilePhase::Parse:               return UnownedStringSlice::fromLiteral("parse");
+        case CompilePhase::Check:               return UnownedStringSlice::fromLiteral("check");
+        case CompilePhase::LowerToIR:           return UnownedStringSlice::fromLiteral("lower-to-ir");
+        case CompilePhase::LinkAndOptimize:     return UnownedStringSlice::fromLiteral("link-and-optimize");
+        case CompilePhase::Emit:                return UnownedStringSlice::fromLiteral("emit");
+        case CompilePhase::DownstreamCompile:   return UnownedStringSlice::fromLiteral("downstream-compile");
+        default: break;
+    }
+    return UnownedStringSlice();
+}
+
+/* static */UnownedStringSlice CompileInstrumentation::getCounterName(CompileCounter counter)
+{
+    switch (counter)
+    {
+        case CompileCounter::IRInstsCreated:        return UnownedStringSlice::fromLiteral("ir-insts-created");
+        case CompileCounter::Specializations:       return UnownedStringSlice::fromLiteral("specializations");
+        case CompileCounter::OverloadCandidates:    return UnownedStringSlice::fromLiteral("overload-candidates");
+        case CompileCounter::ModuleCacheHits:       return UnownedStringSlice::fromLiteral("module-cache-hits");
+        case CompileCounter::ModuleCacheMisses:     return UnownedStringSlice::fromLiteral("module-cache-misses");
+        case CompileCounter::IncludeGuardSkips:     return UnownedStringSlice::fromLiteral("include-guard-skips");
+        case CompileCounter::TokenCacheHits:        return UnownedStringSlice::fromLiteral("token-cache-hits");
+        case CompileCounter::InlinedCallSites:      return UnownedStringSlice::fromLiteral("inlined-call-sites");
+        case CompileCounter::ValueNumberedInsts:    return UnownedStringSlice::fromLiteral("value-numbered-insts");
+        case CompileCounter::LoopInvariantInstsMoved: return UnownedStringSlice::fromLiteral("loop-invariant-insts-moved");
+        case CompileCounter::UnrolledLoops:         return UnownedStringSlice::fromLiteral("unrolled-loops");
+        case CompileCounter::OverloadCandidatesSkipped: return UnownedStringSlice::fromLiteral("overload-candidates-skipped");
+        case CompileCounter::ResolvedInvokeCacheHits:   return UnownedStringSlice::fromLiteral("resolved-invoke-cache-hits");
+        case CompileCounter::LazyIRGlobalsRead:         return UnownedStringSlice::fromLiteral("lazy-ir-globals-read");
+        default: break;
+    }
+    return UnownedStringSlice();
+}
+
+} // namespace Slang
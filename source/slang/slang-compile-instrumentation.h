@@ -0,0 +1,228 @@
+// slang-compile-instrumentation.h
+#ifndef SLANG_COMPILE_INSTRUMENTATION_H
+#define SLANG_COMPILE_INSTRUMENTATION_H
+
+#include "../core/slang-basic.h"
+
+namespace Slang {
+
+/* The phases of compilation that time is attributed to */
+enum class CompilePhase : uint8_t
+{
+    Other,                  ///< Time not within any of the other phases
+    Preprocess,
+    Parse,
+    Check,                  ///< Semantic checking
+    LowerToIR,
+    LinkAndOptimize,        ///< Linking, specialization, legalization and optimization of the IR for a target
+    Emit,                   ///< Emitting target source or SPIR-V from the linked IR
+    DownstreamCompile,      ///< Compiling emitted code with a downstream compiler (dxc, gcc etc)
+    CountOf,
+};
+
+/* Events that are counted during compilation */
+enum class CompileCounter : uint8_t
+{
+    IRInstsCreated,         ///< IR instructions (including types and constants) created
+    Specializations,        ///< Generics and functions taking existential arguments specialized in the IR
+    OverloadCandidates,     ///< Candidates considered during overload resolution
+    ModuleCacheHits,        ///< Imported modules read from the ModuleCache
+    ModuleCacheMisses,      ///< Imported modules checked because they weren't in the ModuleCache (or had changed)
+    IncludeGuardSkips,      ///< `#include`s skipped because the file's include guard macro was defined
+    TokenCacheHits,         ///< `#include`d files whose tokens were read from the PreprocessorTokenCache rather than lexed
+    InlinedCallSites,       ///< Call sites inlined by performCostModelInlining
+    ValueNumberedInsts,     ///< Instructions replaced by an equivalent dominating instruction by applyGlobalValueNumbering
+    LoopInvariantInstsMoved,///< Instructions moved out of loops by LoopInvariantCodeMotionPass
+    UnrolledLoops,          ///< Loops unrolled by UnrollLoopsPass
+    OverloadCandidatesSkipped,  ///< Overload candidates skipped because an OverloadGroupIndex showed they take a different number of arguments
+    ResolvedInvokeCacheHits,    ///< Calls whose overload was found in the ResolvedInvokeCache rather than by overload resolution
+    LazyIRGlobalsRead,          ///< Module level IR instructions (with their children) read from libraries by IRSerialLazyModule
+    CountOf,
+};
+
+/* Records where the time goes within a compilation.
+
+Time is accumulated for each CompilePhase. Phases nest - for example checking an `import` will parse the imported
+module. Time is only attributed to the innermost phase, so the times of all of the phases add up to the total time.
+
+Within a phase the IR passes run in linkAndOptimizeIR are timed individually by name. The time of a pass includes any
+passes it runs itself.
+
+Counters are attributed to the instrumentation of the innermost PhaseScope active on the calling thread, so code that
+has no access to the Linkage (such as IR instruction creation) can count via addCount. When no instrumentation is
+active addCount is a single thread local load and test.
+
+If tracing is enabled each phase and pass is also recorded as an event, and can be written as Chrome trace event
+JSON (as read by chrome://tracing and https://ui.perfetto.dev).
+
+Instrumentation is set on a Linkage, and when none is set the scopes do nothing. Instrumentation is not thread safe,
+so the scopes of one instrumentation must not be entered concurrently. */
+class CompileInstrumentation : public RefObject
+{
+public:
+    typedef uint32_t Flags;
+    struct Flag
+    {
+        enum Enum : Flags
+        {
+            Trace = 0x1,            ///< Record an event for each phase and pass, see writeTrace
+            IRSize = 0x2,           ///< Record the change in the number of IR instructions made by each pass run by an IRPassManager
+        };
+    };
+
+        /// Enters a phase for the lifetime of the scope. instrumentation can be nullptr.
+    struct PhaseScope
+    {
+        PhaseScope(CompileInstrumentation* instrumentation, CompilePhase phase):
+            m_instrumentation(instrumentation)
+        {
+            if (instrumentation)
+            {
+                instrumentation->_enterPhase(phase, *this);
+            }
+        }
+        ~PhaseScope()
+        {
+            if (m_instrumentation)
+            {
+                m_instrumentation->_leavePhase(*this);
+            }
+        }
+
+        CompileInstrumentation* m_instrumentation;
+        CompileInstrumentation* m_previousCurrent = nullptr;
+        CompilePhase m_previousPhase = CompilePhase::Other;
+        Index m_traceEventIndex = -1;
+    };
+
+        /// Times the pass named name for the lifetime of the scope. name must remain in scope as long as the
+        /// instrumentation (typically it is a literal). instrumentation can be nullptr.
+    struct PassScope
+    {
+        PassScope(CompileInstrumentation* instrumentation, const char* name):
+            m_instrumentation(instrumentation)
+        {
+            if (instrumentation)
+            {
+                instrumentation->_enterPass(name, *this);
+            }
+        }
+        ~PassScope() { end(); }
+
+            /// Stop timing the pass before the end of the scope
+        void end()
+        {
+            if (m_instrumentation)
+            {
+                m_instrumentation->_leavePass(*this);
+                m_instrumentation = nullptr;
+            }
+        }
+
+        CompileInstrumentation* m_instrumentation;
+        Index m_passIndex = -1;
+        Index m_traceEventIndex = -1;
+        uint64_t m_startTick = 0;
+    };
+
+    struct PassInfo
+    {
+        const char* name;
+        uint64_t ticks;
+        Index runCount;
+        Index irInstDelta;      ///< The total change in the number of IR instructions, if Flag::IRSize is set
+    };
+
+        /// Add count to counter of the instrumentation active on this thread (if there is one)
+    static void addCount(CompileCounter counter, uint64_t count = 1)
+    {
+        if (CompileInstrumentation* instrumentation = s_current)
+        {
+            instrumentation->m_counts[Index(counter)] += count;
+        }
+    }
+
+        /// Get the instrumentation of the innermost PhaseScope on this thread, or nullptr if there isn't one
+    static CompileInstrumentation* getCurrent() { return s_current; }
+
+        /// Get the phase currently being executed
+    CompilePhase getCurrentPhase() const { return m_currentPhase; }
+
+        /// Get the total time spent in phase. Time since the last phase change is only included after update.
+    double getSeconds(CompilePhase phase) const;
+        /// Get the number of times phase has been entered
+    Index getEnterCount(CompilePhase phase) const { return m_phases[Index(phase)].enterCount; }
+
+        /// Get the value of a counter
+    uint64_t getCount(CompileCounter counter) const { return m_counts[Index(counter)]; }
+
+        /// Get the passes that have been run, in the order each first ran
+    const List<PassInfo>& getPasses() const { return m_passes; }
+        /// Get the total time spent in a pass
+    double getPassSeconds(const PassInfo& pass) const;
+        /// Add to the change in the number of IR instructions made by the pass of scope
+    void addPassIRInstDelta(const PassScope& scope, Index delta);
+
+        /// Attribute the time since the last phase change to the current phase
+    void update();
+
+        /// Zero all of the times, counters and events, and start timing in the Other phase
+    void reset();
+
+    Flags getFlags() const { return m_flags; }
+    void setFlags(Flags flags) { m_flags = flags; }
+
+        /// Write the recorded events as Chrome trace event JSON. The counters are written as metadata.
+        /// Only has events if Flag::Trace was set before they took place.
+    void writeTrace(StringBuilder& out) const;
+
+        /// Get the name of a phase, for example "lower-to-ir"
+    static UnownedStringSlice getPhaseName(CompilePhase phase);
+        /// Get the name of a counter, for example "ir-insts-created"
+    static UnownedStringSlice getCounterName(CompileCounter counter);
+
+    CompileInstrumentation() { reset(); }
+
+protected:
+    struct PhaseInfo
+    {
+        uint64_t ticks;
+        Index enterCount;
+    };
+
+    struct TraceEvent
+    {
+        const char* name;
+        const char* category;
+        uint64_t startTick;
+        uint64_t endTick;
+        Index irInstDelta;
+    };
+
+    void _enterPhase(CompilePhase phase, PhaseScope& scope);
+    void _leavePhase(PhaseScope& scope);
+    void _enterPass(const char* name, PassScope& scope);
+    void _leavePass(PassScope& scope);
+
+    void _setPhase(CompilePhase phase);
+    void _accumulate();
+    Index _beginTraceEvent(const char* name, const char* category, uint64_t tick);
+
+    Flags m_flags = 0;
+
+    CompilePhase m_currentPhase;
+    uint64_t m_startTick;
+    uint64_t m_resetTick;
+    PhaseInfo m_phases[Index(CompilePhase::CountOf)];
+
+    uint64_t m_counts[Index(CompileCounter::CountOf)];
+
+    List<PassInfo> m_passes;
+    List<TraceEvent> m_traceEvents;
+
+    static thread_local CompileInstrumentation* s_current;
+};
+
+} // namespace Slang
+
+#endif
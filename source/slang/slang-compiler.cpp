@@ -7,6 +7,7 @@
 #include "../core/slang-hex-dump-util.h"
 #include "../core/slang-riff.h"
 #include "../core/slang-type-text-util.h"
+#include "../core/slang-thread-pool.h"
 
 #include "slang-check.h"
 #include "slang-compiler.h"
@@ -926,7 +927,7 @@ namespace Slang
         SourceResult source;
         SLANG_RETURN_ON_FAIL(emitEntryPointSource(compileRequest, entryPointIndex, targetReq, CodeGenTarget::HLSL, endToEndReq, source));
 
-        const auto& hlslCode = source.source;
+        const String hlslCode = source.source.toString();
         maybeDumpIntermediate(compileRequest, hlslCode.getBuffer(), CodeGenTarget::HLSL);
 
         auto entryPoint = program->getEntryPoint(entryPointIndex);
@@ -1163,6 +1164,8 @@ SlangResult dissassembleDXILUsingDXC(
         request.optimizationLevel = (unsigned)linkage->optimizationLevel;
         request.debugInfoType = (unsigned)linkage->debugInfoLevel;
 
+        CompileInstrumentation::PhaseScope phaseScope(linkage->getInstrumentation(), CompilePhase::DownstreamCompile);
+
         int err = 1;
         if (glslang_compile_1_1)
         {
@@ -1219,15 +1222,28 @@ SlangResult dissassembleDXILUsingDXC(
         return SLANG_OK;
     }
 
-    SlangResult emitWithDownstreamForEntryPoints(
+        /// Everything needed to invoke a downstream compiler on some entry points.
+        ///
+        /// Setting up a job (which includes emitting the source) and reporting its results must
+        /// happen on the thread driving the compile. Invoking the downstream compiler only touches
+        /// the job, so can happen elsewhere - for example on a worker thread.
+    struct DownstreamCompileJob
+    {
+        DownstreamCompiler* compiler = nullptr;
+        DownstreamCompileCache* cache = nullptr;        ///< If set, the compile is performed via the cache
+        DownstreamCompiler::CompileOptions options;
+
+        SlangResult compileResult = SLANG_FAIL;
+        RefPtr<DownstreamCompileResult> downstreamResult;
+    };
+
+    static SlangResult _prepareDownstreamCompile(
         BackEndCompileRequest*  slangRequest,
         const List<Int>&        entryPointIndices,
         TargetRequest*          targetReq,
         EndToEndCompileRequest* endToEndReq,
-        RefPtr<DownstreamCompileResult>& outResult)
+        DownstreamCompileJob&   outJob)
     {
-        outResult.setNull();
-
         auto sink = slangRequest->getSink();
 
         auto session = slangRequest->getSession();
@@ -1286,7 +1302,7 @@ SlangResult dissassembleDXILUsingDXC(
         List<String> includePaths;
 
         typedef DownstreamCompiler::CompileOptions CompileOptions;
-        CompileOptions options;
+        CompileOptions& options = outJob.options;
 
         /* This is more convoluted than the other scenarios, because when we invoke C/C++ compiler we would ideally like
         to use the original file. We want to do this because we want includes relative to the source file to work, and
@@ -1352,7 +1368,7 @@ SlangResult dissassembleDXILUsingDXC(
                 {
                     options.sourceContentsPath = pathInfo.foundPath;
                 }
-                options.sourceContents = sourceFile->getContent();
+                options.sourceContents.append(sourceFile->getContent());
             }
             else
             {
@@ -1380,9 +1396,30 @@ SlangResult dissassembleDXILUsingDXC(
                 }
             }
 
-            options.sourceContents = source.source;
+            const bool isCOrCPP = (sourceLanguage == SourceLanguage::C || sourceLanguage == SourceLanguage::CPP);
+            if (slangRequest->usePrecompiledPrelude && isCOrCPP && source.prelude.getLength())
+            {
+                // Pass the prelude separately, so the downstream compiler can precompile it once for all compilations
+                const Index preludeLength = source.prelude.getLength();
+                SLANG_ASSERT(source.source.startsWith(source.prelude.getUnownedSlice()));
+
+                options.preludeContents = source.prelude;
+                options.sourceContents = source.source.getSuffix(preludeLength);
+
+                if (auto cache = slangRequest->downstreamCompileCache)
+                {
+                    options.precompiledPreludeDirectory = cache->getDirectoryPath();
+                }
+            }
+            else
+            {
+                options.sourceContents = source.source;
+            }
             
-            maybeDumpIntermediate(slangRequest, options.sourceContents.getBuffer(), sourceTarget);
+            if (slangRequest->shouldDumpIntermediates)
+            {
+                maybeDumpIntermediate(slangRequest, source.source.toString().getBuffer(), sourceTarget);
+            }
         }
 
         // Set the source type
@@ -1513,10 +1550,31 @@ SlangResult dissassembleDXILUsingDXC(
             }
         }
 
-        // Compile
-        RefPtr<DownstreamCompileResult> downstreamCompileResult;
-        SLANG_RETURN_ON_FAIL(compiler->compile(options, downstreamCompileResult));
-        
+        outJob.compiler = compiler;
+        outJob.cache = slangRequest->downstreamCompileCache;
+        return SLANG_OK;
+    }
+
+    static void _invokeDownstreamCompile(DownstreamCompileJob& job)
+    {
+        job.compileResult = job.cache ?
+            job.cache->compile(job.compiler, job.options, job.downstreamResult) :
+            job.compiler->compile(job.options, job.downstreamResult);
+    }
+
+    static SlangResult _reportDownstreamCompileResult(
+        BackEndCompileRequest*              slangRequest,
+        DownstreamCompileJob&               job,
+        RefPtr<DownstreamCompileResult>&    outResult)
+    {
+        outResult.setNull();
+
+        auto sink = slangRequest->getSink();
+        auto compiler = job.compiler;
+
+        SLANG_RETURN_ON_FAIL(job.compileResult);
+        RefPtr<DownstreamCompileResult> downstreamCompileResult = job.downstreamResult;
+
         const auto& diagnostics = downstreamCompileResult->getDiagnostics();
 
         {
@@ -1581,6 +1639,26 @@ SlangResult dissassembleDXILUsingDXC(
         return SLANG_OK;
     }
 
+    SlangResult emitWithDownstreamForEntryPoints(
+        BackEndCompileRequest*  slangRequest,
+        const List<Int>&        entryPointIndices,
+        TargetRequest*          targetReq,
+        EndToEndCompileRequest* endToEndReq,
+        RefPtr<DownstreamCompileResult>& outResult)
+    {
+        outResult.setNull();
+
+        DownstreamCompileJob job;
+        SLANG_RETURN_ON_FAIL(_prepareDownstreamCompile(slangRequest, entryPointIndices, targetReq, endToEndReq, job));
+
+        {
+            CompileInstrumentation::PhaseScope phaseScope(slangRequest->getLinkage()->getInstrumentation(), CompilePhase::DownstreamCompile);
+            _invokeDownstreamCompile(job);
+        }
+
+        return _reportDownstreamCompileResult(slangRequest, job, outResult);
+    }
+
     SlangResult emitSPIRVForEntryPointsDirectly(
         BackEndCompileRequest*  compileRequest,
         const List<Int>&        entryPointIndices,
@@ -1601,7 +1679,7 @@ SlangResult dissassembleDXILUsingDXC(
 
         SLANG_RETURN_ON_FAIL(emitEntryPointsSource(slangRequest, entryPointIndices, targetReq, CodeGenTarget::GLSL, endToEndReq, source));
 
-        const auto& rawGLSL = source.source;
+        const String rawGLSL = source.source.toString();
 
         maybeDumpIntermediate(slangRequest, rawGLSL.getBuffer(), CodeGenTarget::GLSL);
 
@@ -1754,7 +1832,7 @@ SlangResult dissassembleDXILUsingDXC(
                     return result;
                 }
 
-                const auto& code = source.source;
+                const String code = source.source.toString();
                 maybeDumpIntermediate(compileRequest, code.getBuffer(), target);
                 result = CompileResult(code);
             }
@@ -2316,6 +2394,19 @@ SlangResult dissassembleDXILUsingDXC(
             nullptr);
     }
 
+    void TargetProgram::_setWholeProgramResult(CompileResult const& result)
+    {
+        m_entryPointResults.setCount(m_program->getEntryPointCount());
+        m_wholeProgramResult = result;
+    }
+
+    void TargetProgram::_setEntryPointResult(Int entryPointIndex, CompileResult const& result)
+    {
+        if(entryPointIndex >= m_entryPointResults.getCount())
+            m_entryPointResults.setCount(entryPointIndex+1);
+        m_entryPointResults[entryPointIndex] = result;
+    }
+
     void generateOutputForTarget(
         BackEndCompileRequest*  compileReq,
         TargetRequest*          targetReq,
@@ -2431,6 +2522,137 @@ SlangResult dissassembleDXILUsingDXC(
     }
 
 
+        /// True if code for `target` is produced by passing emitted source to a downstream
+        /// compiler through `emitWithDownstreamForEntryPoints`.
+    static bool _isDownstreamCompiledTarget(CodeGenTarget target)
+    {
+        switch (target)
+        {
+            case CodeGenTarget::PTX:
+            case CodeGenTarget::HostCallable:
+            case CodeGenTarget::SharedLibrary:
+            case CodeGenTarget::Executable:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+        /// Code generation for a whole program or single entry point on a downstream compiled target
+    struct ParallelCodeGenItem
+    {
+        TargetProgram*          targetProgram = nullptr;
+            /// The entry point to generate code for, or -1 for the whole program
+        Int                     entryPointIndex = -1;
+        SlangResult             prepareResult = SLANG_FAIL;
+        DownstreamCompileJob    job;
+    };
+
+        /// Generate output for all targets, invoking downstream compilers (such as for the
+        /// C++ and CUDA targets) on multiple threads.
+        ///
+        /// Linking, optimizing and emitting source still happens serially on this thread, in the
+        /// same (target, entry point) order as `generateOutputForTarget`. Only the downstream
+        /// compiles - which typically dominate back end time, and touch no shared state - run
+        /// in parallel. Their diagnostics and results are reported once they have all completed,
+        /// again in (target, entry point) order, so output is deterministic.
+    static void _generateOutputInParallel(
+        BackEndCompileRequest*  compileRequest,
+        EndToEndCompileRequest* endToEndReq)
+    {
+        auto linkage = compileRequest->getLinkage();
+        auto program = compileRequest->getProgram();
+        const Index entryPointCount = program->getEntryPointCount();
+
+        List<ParallelCodeGenItem> items;
+        for (auto targetReq : linkage->targets)
+        {
+            if (!_isDownstreamCompiledTarget(targetReq->getTarget()))
+            {
+                generateOutputForTarget(compileRequest, targetReq, endToEndReq);
+                continue;
+            }
+
+            auto targetProgram = program->getTargetProgram(targetReq);
+
+            List<Int> entryPointIndices;
+            if (targetReq->isWholeProgramRequest())
+            {
+                for (Index ii = 0; ii < entryPointCount; ++ii)
+                    entryPointIndices.add(ii);
+
+                ParallelCodeGenItem item;
+                item.targetProgram = targetProgram;
+                item.prepareResult = _prepareDownstreamCompile(compileRequest, entryPointIndices, targetReq, endToEndReq, item.job);
+                items.add(item);
+            }
+            else
+            {
+                for (Index ii = 0; ii < entryPointCount; ++ii)
+                {
+                    entryPointIndices.clear();
+                    entryPointIndices.add(ii);
+
+                    ParallelCodeGenItem item;
+                    item.targetProgram = targetProgram;
+                    item.entryPointIndex = ii;
+                    item.prepareResult = _prepareDownstreamCompile(compileRequest, entryPointIndices, targetReq, endToEndReq, item.job);
+                    items.add(item);
+                }
+            }
+        }
+
+        List<DownstreamCompileJob*> jobs;
+        for (auto& item : items)
+        {
+            if (SLANG_SUCCEEDED(item.prepareResult))
+            {
+                jobs.add(&item.job);
+            }
+        }
+
+        {
+            RefPtr<ThreadPool> threadPool = new ThreadPool(compileRequest->parallelCodeGenThreadCount);
+
+            auto invoke = [&](Index index)
+            {
+                DownstreamCompileJob& job = *jobs[index];
+                try
+                {
+                    _invokeDownstreamCompile(job);
+                }
+                catch (...)
+                {
+                    // Must not propagate out of a worker thread
+                    job.compileResult = SLANG_FAIL;
+                }
+            };
+            threadPool->parallelFor(jobs.getCount(), invoke);
+        }
+
+        for (auto& item : items)
+        {
+            CompileResult result;
+
+            RefPtr<DownstreamCompileResult> downstreamResult;
+            if (SLANG_SUCCEEDED(item.prepareResult) &&
+                SLANG_SUCCEEDED(_reportDownstreamCompileResult(compileRequest, item.job, downstreamResult)))
+            {
+                maybeDumpIntermediate(compileRequest, downstreamResult, item.targetProgram->getTargetReq()->getTarget());
+                result = CompileResult(downstreamResult);
+            }
+
+            if (item.entryPointIndex < 0)
+            {
+                item.targetProgram->_setWholeProgramResult(result);
+            }
+            else
+            {
+                item.targetProgram->_setEntryPointResult(item.entryPointIndex, result);
+            }
+        }
+    }
+
     static void _generateOutput(
         BackEndCompileRequest* compileRequest,
         EndToEndCompileRequest* endToEndReq)
@@ -2467,6 +2689,12 @@ SlangResult dissassembleDXILUsingDXC(
         }
 
 
+        if (compileRequest->parallelCodeGenThreadCount != 1)
+        {
+            _generateOutputInParallel(compileRequest, endToEndReq);
+            return;
+        }
+
         // Go through the code-generation targets that the user
         // has specified, and generate code for each of them.
         //
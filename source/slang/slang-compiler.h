@@ -5,11 +5,13 @@
 #include "../core/slang-shared-library.h"
 
 #include "../core/slang-downstream-compiler.h"
+#include "../core/slang-downstream-compile-cache.h"
 #include "../core/slang-archive-file-system.h"
 
 #include "../../slang-com-ptr.h"
 
 #include "slang-capability.h"
+#include "slang-compile-instrumentation.h"
 #include "slang-diagnostics.h"
 #include "slang-name.h"
 #include "slang-preprocessor.h"
@@ -24,6 +26,9 @@
 
 #include "../../slang.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace Slang
 {
     struct PathInfo;
@@ -130,6 +135,7 @@ namespace Slang
 
     class Linkage;
     class Module;
+    class ModuleCache;
     class FrontEndCompileRequest;
     class BackEndCompileRequest;
     class EndToEndCompileRequest;
@@ -851,6 +857,30 @@ namespace Slang
 
     class SourceFile;
 
+        /// Produces the IR for a module when it is first needed. Used for modules read from a serialized
+        /// form (such as the stdlib), so that the cost of reading IR is only paid if it's used.
+    class IRModuleLoader : public RefObject
+    {
+    public:
+        virtual SlangResult loadIRModule(RefPtr<IRModule>& outIRModule) = 0;
+    };
+
+        /// An IR module that is read from a serialized form a global value at a time, as values are looked up by linking.
+        /// Used for libraries, where a link typically only uses a small part of the module.
+    class IRLazyModule : public RefObject
+    {
+    public:
+            /// Get the module holding the global values read so far
+        virtual IRModule* getIRModule() = 0;
+            /// Read the global values with mangledName, and everything they reference. There can be more than one
+            /// value with a name, for example where there are definitions specialized for different targets.
+        virtual SlangResult readGlobalValues(const UnownedStringSlice& mangledName) = 0;
+            /// Read the global values linking includes whether or not they are referenced (such as those marked [public])
+        virtual SlangResult readRootGlobalValues() = 0;
+            /// Add the global values with linkage read since the previous call to outValues
+        virtual void takeReadGlobalValues(List<IRInst*>& outValues) = 0;
+    };
+
         /// A module of code that has been compiled through the front-end
         ///
         /// A module comprises all the code from one translation unit (which
@@ -933,7 +963,14 @@ namespace Slang
         ModuleDecl* getModuleDecl() { return m_moduleDecl; }
 
             /// The the IR for the module (if it has been generated)
-        IRModule* getIRModule() { return m_irModule; }
+        IRModule* getIRModule()
+        {
+            if (m_isIRModuleLoadPending.load(std::memory_order_acquire))
+            {
+                _loadIRModule();
+            }
+            return m_irModule;
+        }
 
             /// Get the list of other modules this module depends on
         List<Module*> const& getModuleDependencyList() { return m_moduleDependencyList.getModuleList(); }
@@ -958,6 +995,14 @@ namespace Slang
             /// This should only be called once, during creation of the module.
             ///
         void setIRModule(IRModule* irModule) { m_irModule = irModule; }
+            /// Set the IR for this module to be produced by loader when it is first needed.
+            /// Replaces a previous setIRModule.
+        void setIRModuleLoader(IRModuleLoader* loader)
+        {
+            m_irModule.setNull();
+            m_irModuleLoader = loader;
+            m_isIRModuleLoadPending.store(loader != nullptr, std::memory_order_release);
+        }
 
         Index getEntryPointCount() SLANG_OVERRIDE { return 0; }
         RefPtr<EntryPoint> getEntryPoint(Index index) SLANG_OVERRIDE { SLANG_UNUSED(index); return nullptr; }
@@ -979,6 +1024,16 @@ namespace Slang
             /// If not found returns nullptr.
         NodeBase* findExportFromMangledName(const UnownedStringSlice& slice);
 
+            /// Get the count of exported symbols. The symbols are found if they haven't been already.
+        Index getExportSymbolCount();
+            /// Get the exported symbol at index, and its mangled name
+        NodeBase* getExportSymbol(Index index, UnownedStringSlice& outMangledName);
+            /// Add an exported symbol, rather than having the exports found by mangling the name of every decl.
+            /// Used when reading a module that was serialized along with its exports.
+            /// Must be called for all of the exports, before any lookup. If a mangled name is added more than
+            /// once, the first symbol is used.
+        void addExportSymbol(const UnownedStringSlice& mangledName, NodeBase* symbol);
+
             /// Get the ASTBuilder
         ASTBuilder* getASTBuilder() { return m_astBuilder; }
 
@@ -993,6 +1048,9 @@ namespace Slang
             ///
         void _collectShaderParams();
 
+            /// Add an entry point for each function in the module with a `[shader(...)]` attribute
+        void _discoverEntryPoints(DiagnosticSink* sink);
+
         class ModuleSpecializationInfo : public SpecializationInfo
         {
         public:
@@ -1011,6 +1069,8 @@ namespace Slang
         List<RefPtr<EntryPoint>> const& getEntryPoints() { return m_entryPoints; }
         void _addEntryPoint(EntryPoint* entryPoint);
         void _processFindDeclsExportSymbolsRec(Decl* decl);
+        void _findExportSymbols();
+        void _loadIRModule();
 
     protected:
         void acceptVisitor(ComponentTypeVisitor* visitor, SpecializationInfo* specializationInfo) SLANG_OVERRIDE;
@@ -1026,6 +1086,11 @@ namespace Slang
 
         // The IR for the module
         RefPtr<IRModule> m_irModule = nullptr;
+        // If set, m_irModule is produced by the loader when first needed
+        RefPtr<IRModuleLoader> m_irModuleLoader;
+        // Set whilst there is a loader that hasn't been run. Builtin modules are shared between threads, so
+        // this can be tested without a lock.
+        std::atomic<bool> m_isIRModuleLoadPending{false};
 
         List<ShaderParamInfo> m_shaderParams;
         SpecializationParams m_specializationParams;
@@ -1357,6 +1422,16 @@ namespace Slang
         /// Set if fileSystemExt is a cache file system
         RefPtr<CacheFileSystem> m_cacheFileSystem;
 
+        /// If set, records the time spent in each phase and pass of compilation, and counts compiler events
+        RefPtr<CompileInstrumentation> m_instrumentation;
+
+        /// If set, imported modules are stored in and read from the cache
+        RefPtr<ModuleCache> m_moduleCache;
+
+        /// The tokens of files `#include`d by the translation units and modules of the linkage
+        RefPtr<PreprocessorTokenCache> m_preprocessorTokenCache;
+        PreprocessorTokenCache* getPreprocessorTokenCache() { return m_preprocessorTokenCache; }
+
         ISlangFileSystemExt* getFileSystemExt() { return m_fileSystemExt; }
         CacheFileSystem* getCacheFileSystem() const { return m_cacheFileSystem; }
 
@@ -1419,6 +1494,16 @@ namespace Slang
             m_sourceManager = sourceManager;
         }
 
+            /// Set the instrumentation that records where time goes in compilations with the linkage.
+            /// Can be nullptr (the default) to not instrument compilation.
+        void setInstrumentation(CompileInstrumentation* instrumentation) { m_instrumentation = instrumentation; }
+        CompileInstrumentation* getInstrumentation() const { return m_instrumentation; }
+
+            /// Set the cache that checked imported modules are stored in, so that they can be reused by later
+            /// linkages without being checked again. Can be nullptr (the default) for no caching.
+        void setModuleCache(ModuleCache* moduleCache);
+        ModuleCache* getModuleCache() const { return m_moduleCache; }
+
         void setRequireCacheFileSystem(bool requireCacheFileSystem);
 
         void setFileSystem(ISlangFileSystem* fileSystem);
@@ -1438,6 +1523,8 @@ namespace Slang
 
         // Modules that have been read in with the -r option
         List<RefPtr<IRModule>> m_libModules;
+        // Modules that have been read in with the -r option, whose global values are read as linking needs them
+        List<RefPtr<IRLazyModule>> m_lazyLibModules;
 
         void _stopRetainingParentSession()
         {
@@ -1768,6 +1855,11 @@ namespace Slang
             BackEndCompileRequest*  backEndRequest,
             EndToEndCompileRequest* endToEndRequest);
 
+            /// Internal: set results generated outside of `_createWholeProgramResult`
+            /// and `_createEntryPointResult`, such as by parallel code generation.
+        void _setWholeProgramResult(CompileResult const& result);
+        void _setEntryPointResult(Int entryPointIndex, CompileResult const& result);
+
         RefPtr<IRModule> getOrCreateIRModuleForLayout(DiagnosticSink* sink);
 
         RefPtr<IRModule> getExistingIRModuleForLayout()
@@ -1832,6 +1924,17 @@ namespace Slang
         // If true will disable generating dynamic dispatch code.
         bool disableDynamicDispatch = false;
 
+            /// The number of threads used to invoke downstream compilers (such as for C++ and CUDA targets).
+            /// 1 (the default) does all work on the calling thread. 0 uses a thread per hardware thread.
+        Index parallelCodeGenThreadCount = 1;
+
+            /// If set, downstream compiler products are looked up in (and added to) this on disk cache
+        RefPtr<DownstreamCompileCache> downstreamCompileCache;
+
+            /// If true the prelude of C/C++ source is passed to the downstream compiler separately, so that compilers
+            /// that support it can precompile it once (and store it in the downstreamCompileCache directory, if set)
+        bool usePrecompiledPrelude = false;
+
         String m_dumpIntermediatePrefix;
 
     private:
@@ -1918,6 +2021,11 @@ namespace Slang
         virtual SLANG_NO_THROW void SLANG_MCALL setCommandLineCompilerMode() SLANG_OVERRIDE;
         virtual SLANG_NO_THROW SlangResult SLANG_MCALL addTargetCapability(SlangInt targetIndex, SlangCapabilityID capability) SLANG_OVERRIDE;
         virtual SLANG_NO_THROW SlangResult SLANG_MCALL getProgramWithEntryPoints(slang::IComponentType** outProgram) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW void SLANG_MCALL setInstrumentationFlags(SlangInstrumentationFlags flags) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW SlangInt SLANG_MCALL getInstrumentationEntryCount() SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getInstrumentationEntry(SlangInt index, SlangInstrumentationEntry* outEntry) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getInstrumentationTrace(ISlangBlob** outBlob) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW void SLANG_MCALL setModuleCachePath(const char* path) SLANG_OVERRIDE;
 
 
         EndToEndCompileRequest(
@@ -1957,6 +2065,9 @@ namespace Slang
             /// If set, if a compilation failure occurs will attempt to save off a dump repro with a unique name
         bool m_dumpReproOnError = false;
 
+            /// If set, the Chrome trace event JSON of the compilation is written to this path
+        String m_instrumentationTracePath;
+
             /// A blob holding the diagnostic output
         ComPtr<ISlangBlob> m_diagnosticOutputBlob;
 
@@ -2090,11 +2201,15 @@ namespace Slang
     {
         void reset()
         {
-            source = String();
+            source.clear();
+            prelude = String();
             extensionTracker.setNull();
         }
 
-        String source;
+            /// The source, in chunks. Use toString() on it if the source is needed as a single string.
+        ChunkedString source;
+            /// If the source starts with a prelude, the prelude (so the rest of the source is the code following it)
+        String prelude;
         // Must be cast to a specific extension tracker such as GLSLExtensionTracker
         RefPtr<RefObject> extensionTracker;
     };
@@ -2271,6 +2386,10 @@ namespace Slang
 
         int m_downstreamCompilerInitialized = 0;                                        
 
+            /// Guards loading of downstream compilers and shared library functions, which can happen on any
+            /// thread compiling with the session. Recursive as loading a compiler can load others.
+        std::recursive_mutex m_downstreamCompilerMutex;
+
         RefPtr<DownstreamCompilerSet> m_downstreamCompilerSet;                                  ///< Information about all available downstream compilers.
         RefPtr<DownstreamCompiler> m_downstreamCompilers[int(PassThroughMode::CountOf)];        ///< A downstream compiler for a pass through
         DownstreamCompilerLocatorFunc m_downstreamCompilerLocators[int(PassThroughMode::CountOf)];
@@ -2279,6 +2398,10 @@ namespace Slang
 
         SlangResult _readBuiltinModule(ISlangFileSystem* fileSystem, Scope* scope, String moduleName);
 
+            /// Compute anything that would otherwise be computed lazily (and so modify the module) when a
+            /// builtin module is first used, as builtin modules are shared between threads.
+        void _prepareBuiltinModuleForSharing(Module* module);
+
         SlangResult _loadRequest(EndToEndCompileRequest* request, const void* data, size_t size);
 
             /// Linkage used for all built-in (stdlib) code.
@@ -405,6 +405,7 @@ void DiagnosticSink::diagnoseImpl(SourceLoc const& pos, DiagnosticInfo const& in
     diagnostic.loc = pos;
     diagnostic.severity = info.severity;
 
+    m_diagnosticCount++;
     if (diagnostic.severity >= Severity::Error)
     {
         m_errorCount++;
@@ -444,6 +445,7 @@ void DiagnosticSink::diagnoseRaw(
     Severity    severity,
     const UnownedStringSlice& message)
 {
+    m_diagnosticCount++;
     if (severity >= Severity::Error)
     {
         m_errorCount++;
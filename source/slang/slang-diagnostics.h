@@ -152,6 +152,8 @@ namespace Slang
 
             /// Get the total amount of errors that have taken place on this DiagnosticSink
         SLANG_FORCE_INLINE int getErrorCount() { return m_errorCount; }
+            /// Get the total amount of diagnostics (of any severity) that have taken place on this DiagnosticSink
+        SLANG_FORCE_INLINE int getDiagnosticCount() { return m_diagnosticCount; }
 
         void diagnoseDispatch(SourceLoc const& pos, DiagnosticInfo const& info)
         {
@@ -243,6 +245,7 @@ namespace Slang
         void diagnoseImpl(SourceLoc const& pos, DiagnosticInfo const& info, int argCount, DiagnosticArg const* const* args);
 
         int m_errorCount = 0;
+        int m_diagnosticCount = 0;
         int m_internalErrorLocsNoted = 0;
 
         Flags m_flags = 0;
@@ -160,7 +160,7 @@ namespace Slang
         SLANG_RETURN_ON_FAIL(emitEntryPointSource(compileRequest, entryPointIndex,
             targetReq, CodeGenTarget::HLSL, endToEndReq, source));
 
-        const auto& hlslCode = source.source;
+        const String hlslCode = source.source.toString();
 
         maybeDumpIntermediate(compileRequest, hlslCode.getBuffer(), CodeGenTarget::HLSL);
 
@@ -133,6 +133,7 @@ CLikeSourceEmitter::CLikeSourceEmitter(const Desc& desc)
 
     m_target = desc.target;
     m_targetCaps = desc.targetCaps;
+    m_targetFlags = desc.targetFlags;
 
     m_compileRequest = desc.compileRequest;
     m_entryPointStage = desc.entryPointStage;
@@ -36,6 +36,9 @@ public:
             /// The capabilities of the target
         CapabilitySet targetCaps;
 
+            /// Flags controlling code generation for the target (SLANG_TARGET_FLAG_...)
+        SlangTargetFlags targetFlags = 0;
+
         SourceWriter* sourceWriter = nullptr;
     };
 
@@ -405,6 +408,9 @@ public:
         /// The capabilities of the target
     CapabilitySet m_targetCaps;
 
+        /// Flags controlling code generation for the target (SLANG_TARGET_FLAG_...)
+    SlangTargetFlags m_targetFlags = 0;
+
     // Source language (based on the more nuanced m_target)
     SourceLanguage m_sourceLanguage;
 
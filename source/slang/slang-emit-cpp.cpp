@@ -703,6 +703,59 @@ static bool _isOperator(const UnownedStringSlice& funcName)
     return false;
 }
 
+    /// Returns the name of the prelude function (in slang-cpp-vector-intrinsics.h) that implements the vector
+    /// arithmetic specOp, or an empty slice if there isn't one.
+    /// The prelude functions have SIMD implementations for the common vector types, so are used in preference
+    /// to emitting the operation per element.
+static UnownedStringSlice _getPreludeVectorFuncName(const HLSLIntrinsic* specOp)
+{
+    typedef HLSLIntrinsic::Op Op;
+
+    UnownedStringSlice funcName;
+    switch (specOp->op)
+    {
+        case Op::Add:   funcName = UnownedStringSlice::fromLiteral("slang_vector_add"); break;
+        case Op::Sub:   funcName = UnownedStringSlice::fromLiteral("slang_vector_sub"); break;
+        case Op::Mul:   funcName = UnownedStringSlice::fromLiteral("slang_vector_mul"); break;
+        case Op::Div:   funcName = UnownedStringSlice::fromLiteral("slang_vector_div"); break;
+        default:        return UnownedStringSlice();
+    }
+
+    // The result must be a vector, and each parameter either the same vector type, or its element type
+    auto vectorType = as<IRVectorType>(specOp->returnType);
+    if (!vectorType)
+    {
+        return UnownedStringSlice();
+    }
+    IRType* elementType = vectorType->getElementType();
+    switch (elementType->getOp())
+    {
+        case kIROp_FloatType:
+        case kIROp_DoubleType:
+        case kIROp_IntType:
+        case kIROp_UIntType:
+        {
+            break;
+        }
+        default: return UnownedStringSlice();
+    }
+
+    IRFuncType* funcType = specOp->signatureType;
+    if (funcType->getParamCount() != 2)
+    {
+        return UnownedStringSlice();
+    }
+    for (UInt i = 0; i < 2; ++i)
+    {
+        IRType* paramType = funcType->getParamType(i);
+        if (paramType != vectorType && paramType != elementType)
+        {
+            return UnownedStringSlice();
+        }
+    }
+    return funcName;
+}
+
 void CPPSourceEmitter::_emitAryDefinition(const HLSLIntrinsic* specOp)
 {
     auto info = HLSLIntrinsic::getInfo(specOp->op);
@@ -750,6 +803,19 @@ void CPPSourceEmitter::_emitAryDefinition(const HLSLIntrinsic* specOp)
     writer->emit("\n{\n");
     writer->indent();
 
+    // CUDA has its own vector types and operations, so only use the prelude functions for C++
+    const UnownedStringSlice preludeFuncName = (getSourceLanguage() == SourceLanguage::CPP) ? _getPreludeVectorFuncName(specOp) : UnownedStringSlice();
+    if (preludeFuncName.getLength() > 0)
+    {
+        writer->emit("return ");
+        writer->emit(preludeFuncName);
+        writer->emit("(a, b);\n");
+
+        writer->dedent();
+        writer->emit("}\n\n");
+        return;
+    }
+
     const bool hasReturnType = retType->getOp() != kIROp_VoidType;
 
     TypeDimension calcDim;
@@ -1867,6 +1933,13 @@ void CPPSourceEmitter::emitSimpleFuncImpl(IRFunc* func)
         // Because the workhorse function doesn't have the right signature to service
         // general-purpose calls, it is being emitted with a `_` prefix.
         //
+        // When the group threads are run as lanes, the body has to be inlined into the lane loop for
+        // the loop to be vectorized.
+        if (m_targetFlags & SLANG_TARGET_FLAG_CPU_GROUP_AS_LANES)
+        {
+            m_writer->emit("SLANG_PRELUDE_FORCE_INLINE ");
+        }
+
         StringBuilder prefixName;
         prefixName << "_" << name;
         emitType(resultType, prefixName);
@@ -2467,6 +2540,74 @@ void CPPSourceEmitter::_emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroup
     }
 }
 
+void CPPSourceEmitter::_emitEntryPointGroupAsLanes(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
+{
+    List<AxisWithSize> axes;
+    _calcAxisOrder(sizeAlongAxis, false, axes);
+
+    StringBuilder builder;
+
+    m_writer->emit("const uint3 groupID = varyingInput->startGroupID;\n");
+
+    // The dispatch thread ID (groupID * size + groupThreadID) has to fit in 32 bits. Telling the downstream
+    // compiler means it doesn't have to allow for the index calculation wrapping, which otherwise stops it
+    // from vectorizing accesses indexed by the dispatch thread ID.
+    for (const auto& axis : axes)
+    {
+        builder.Clear();
+        builder << "SLANG_PRELUDE_ASSUME(groupID." << s_elemNames[axis.axis] << " < 0xffffffffu / " << axis.size << ");\n";
+        m_writer->emit(builder);
+    }
+
+    // Open all the loops. The inner most loop is over the lanes.
+    for (Index i = 0; i < axes.getCount(); ++i)
+    {
+        const auto& axis = axes[i];
+        builder.Clear();
+        const char elem[2] = { s_elemNames[axis.axis], 0 };
+        if (i == axes.getCount() - 1)
+        {
+            builder << "SLANG_PRELUDE_LANES_LOOP\n";
+        }
+        builder << "for (uint32_t " << elem << " = 0; " << elem << " < " << axis.size << "; ++" << elem << ")\n{\n";
+        m_writer->emit(builder);
+        m_writer->indent();
+    }
+
+    // Each lane has its own input, so the downstream compiler can see the lanes are independent.
+    // Axes that aren't looped over are 0.
+    builder.Clear();
+    builder << "ComputeThreadVaryingInput threadInput = { groupID, { ";
+    for (int i = 0; i < kThreadGroupAxisCount; ++i)
+    {
+        if (i > 0)
+        {
+            builder << ", ";
+        }
+        if (sizeAlongAxis[i] > 1)
+        {
+            builder << s_elemNames[i];
+        }
+        else
+        {
+            builder << "0";
+        }
+    }
+    builder << " } };\n";
+    m_writer->emit(builder);
+
+    m_writer->emit("_");
+    m_writer->emit(funcName);
+    m_writer->emit("(&threadInput, entryPointParams, globalParams);\n");
+
+    // Close all the loops
+    for (Index i = Index(axes.getCount() - 1); i >= 0; --i)
+    {
+        m_writer->dedent();
+        m_writer->emit("}\n");
+    }
+}
+
 void CPPSourceEmitter::_emitEntryPointGroupRange(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
 {
     List<AxisWithSize> axes;
@@ -2743,10 +2884,17 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
 
                     _emitEntryPointDefinitionStart(func, groupFuncName, UnownedStringSlice::fromLiteral("ComputeVaryingInput"));
 
-                    m_writer->emit("ComputeThreadVaryingInput threadInput = {};\n");
-                    m_writer->emit("threadInput.groupID = varyingInput->startGroupID;\n");
+                    if (m_targetFlags & SLANG_TARGET_FLAG_CPU_GROUP_AS_LANES)
+                    {
+                        _emitEntryPointGroupAsLanes(groupThreadSize, funcName);
+                    }
+                    else
+                    {
+                        m_writer->emit("ComputeThreadVaryingInput threadInput = {};\n");
+                        m_writer->emit("threadInput.groupID = varyingInput->startGroupID;\n");
 
-                    _emitEntryPointGroup(groupThreadSize, funcName);
+                        _emitEntryPointGroup(groupThreadSize, funcName);
+                    }
                     _emitEntryPointDefinitionEnd(func);
                 }
 
@@ -112,6 +112,9 @@ protected:
     void _emitEntryPointDefinitionStart(IRFunc* func, const String& funcName, const UnownedStringSlice& varyingTypeName);
     void _emitEntryPointDefinitionEnd(IRFunc* func);
     void _emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
+        /// Emit the body of the group function such that each thread of the group is a lane of the inner loop,
+        /// in a form the downstream compiler can vectorize. Used when SLANG_TARGET_FLAG_CPU_GROUP_AS_LANES is set.
+    void _emitEntryPointGroupAsLanes(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
     void _emitEntryPointGroupRange(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
 
     void _emitInitAxisValues(const Int sizeAlongAxis[kThreadGroupAxisCount], const UnownedStringSlice& mulName, const UnownedStringSlice& addName);
@@ -22,6 +22,18 @@ SourceWriter::SourceWriter(SourceManager* sourceManager, LineDirectiveMode lineD
     this->m_sourceManager = sourceManager;
 }
 
+String SourceWriter::getContent()
+{
+    if (m_content.getLength() == 0)
+    {
+        return m_builder.ProduceString();
+    }
+
+    ChunkedString content(m_content);
+    content.append(m_builder);
+    return content.toString();
+}
+
 String SourceWriter::getContentAndClear()
 {
     String content(getContent());
@@ -29,10 +41,33 @@ String SourceWriter::getContentAndClear()
     return content;
 }
 
+void SourceWriter::appendContentAndClear(ChunkedString& ioContent)
+{
+    _flushBuilder();
+    ioContent.append(m_content);
+    m_content.clear();
+}
+
+void SourceWriter::_flushBuilder()
+{
+    if (m_builder.getLength() > 0)
+    {
+        m_content.append(m_builder);
+        m_builder.Clear();
+    }
+}
+
 void SourceWriter::emitRawTextSpan(char const* textBegin, char const* textEnd)
 {
     // TODO(tfoley): Need to make "corelib" not use `int` for pointer-sized things...
     auto len = textEnd - textBegin;
+
+    // Rather than growing the buffer past the chunk size (which copies everything in it), start a new chunk
+    if (m_builder.getLength() > 0 && m_builder.getLength() + len > kChunkSize)
+    {
+        _flushBuilder();
+        m_builder.EnsureCapacity(kChunkSize);
+    }
     m_builder.Append(textBegin, len);
 }
 
@@ -137,7 +172,38 @@ void SourceWriter::emit(char const* text)
 
 void SourceWriter::emit(const String& text)
 {
-    emit(text.begin(), text.end());
+    // Large text (such as a prelude) that doesn't need indenting becomes a chunk of its own, so it isn't copied
+    const Index length = text.getLength();
+    if (length < kChunkSize || m_indentLevel != 0)
+    {
+        emit(text.begin(), text.end());
+        return;
+    }
+
+    _flushSourceLocationChange();
+    _flushBuilder();
+    m_content.append(text);
+
+    // Update our logical position, as emitting the text a line at a time would
+    const char* chars = text.getBuffer();
+    Index lineStartIndex = -1;
+    for (Index i = 0; i < length; ++i)
+    {
+        if (chars[i] == '\n')
+        {
+            m_loc.line++;
+            lineStartIndex = i + 1;
+        }
+    }
+    if (lineStartIndex >= 0)
+    {
+        m_loc.column = 1 + (length - lineStartIndex);
+    }
+    else
+    {
+        m_loc.column += length;
+    }
+    m_isAtStartOfLine = (chars[length - 1] == '\n');
 }
 
 void SourceWriter::emit(const UnownedStringSlice& text)
@@ -3,6 +3,7 @@
 #define SLANG_EMIT_SOURCE_WRITER_H
 
 #include "../core/slang-basic.h"
+#include "../core/slang-chunked-string.h"
 
 #include "slang-compiler.h"
 
@@ -11,7 +12,9 @@ namespace Slang
 
 /* Class that encapsulates a stream of source. Facilities provided...
 
-* Management of the buffer that holds the source content as it is constructed
+* Management of the buffer that holds the source content as it is constructed. The content is held in chunks,
+  so emitting large amounts of source never copies what has already been emitted, and it can be taken as a
+  ChunkedString without being made contiguous.
 * output line directives
   + Supports GLSL as well as C/CPP/HLSL style directives
 * Support for line indention */
@@ -58,11 +61,15 @@ public:
     void advanceToSourceLocation(const HumaneSourceLoc& sourceLocation);
 
         /// Get the content as a string
-    String getContent() { return m_builder.ProduceString(); }
+    String getContent();
+        /// Get the length of the content
+    Index getContentLength() const { return m_content.getLength() + m_builder.getLength(); }
         /// Clear the content
-    void clearContent() { m_builder.Clear(); }
+    void clearContent() { m_content.clear(); m_builder.Clear(); }
         /// Get the content as a string and clear the internal representation
     String getContentAndClear();
+        /// Append the content to ioContent (without copying it) and clear the internal representation
+    void appendContentAndClear(ChunkedString& ioContent);
 
         /// Get the line directive mode used
     LineDirectiveMode getLineDirectiveMode() const { return m_lineDirectiveMode; }
@@ -74,6 +81,8 @@ public:
 
 protected:
     void _emitTextSpan(char const* textBegin, char const* textEnd);
+        // Move the text in m_builder into a chunk of m_content
+    void _flushBuilder();
     void _flushSourceLocationChange();
 
         // Emit a `#line` directive to the output, and also
@@ -87,11 +96,14 @@ protected:
         // Doesn't update state of source-location tracking.
     void _emitLineDirective(const HumaneSourceLoc& sourceLocation);
 
-    // The string of code we've built so far.
-    // TODO(JS): We could store the text in chunks, and then only sew together into one buffer
-    // when we are done. Doing so would not require copies/reallocs until the full buffer has been
-    // produced. A downside to doing this is that it won't be so simple to debug by trying to
-    // look at the current contents of the buffer
+    // Once m_builder holds at least this many chars it becomes a chunk of m_content, so the cost of
+    // growing the buffer being appended to doesn't depend on how much code has been emitted
+    static const Index kChunkSize = 64 * 1024;
+
+    // The code we've built so far is the chunks in m_content followed by the text in m_builder.
+    // Strings that are at least kChunkSize long are added as chunks directly, without being copied.
+    // NOTE! To see the current contents when debugging, look at the last chunk and m_builder
+    ChunkedString m_content;
     StringBuilder m_builder;
 
     // Current source position for tracking purposes...
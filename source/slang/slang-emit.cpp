@@ -13,14 +13,19 @@
 #include "slang-ir-explicit-global-context.h"
 #include "slang-ir-explicit-global-init.h"
 #include "slang-ir-glsl-legalize.h"
+#include "slang-ir-gvn.h"
+#include "slang-ir-inline.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-legalize-varying-params.h"
 #include "slang-ir-link.h"
+#include "slang-ir-loop-opt.h"
+#include "slang-ir-pass-manager.h"
 #include "slang-ir-lower-generics.h"
 #include "slang-ir-lower-tuple-types.h"
 #include "slang-ir-lower-bit-cast.h"
 #include "slang-ir-restructure.h"
 #include "slang-ir-restructure-scoping.h"
+#include "slang-ir-sccp.h"
 #include "slang-ir-specialize.h"
 #include "slang-ir-specialize-arrays.h"
 #include "slang-ir-specialize-resources.h"
@@ -140,6 +145,55 @@ static void dumpIRIfEnabled(
     }
 }
 
+    /// Get the cost model used to inline functions at the optimization `level`.
+    /// Returns false if functions shouldn't be inlined at that level.
+static bool _getInliningOptions(OptimizationLevel level, IRInliningOptions& outOptions)
+{
+    switch (level)
+    {
+        case OptimizationLevel::High:
+        {
+            outOptions.smallCalleeSize = 16;
+            outOptions.singleCallCalleeSize = 128;
+            outOptions.constantArgumentSizeBonus = 2;
+            return true;
+        }
+        case OptimizationLevel::Maximal:
+        {
+            outOptions.smallCalleeSize = 48;
+            outOptions.singleCallCalleeSize = 1024;
+            outOptions.constantArgumentSizeBonus = 4;
+            return true;
+        }
+        default: return false;
+    }
+}
+
+    /// Returns true if loops should be optimized in the IR for `target`.
+    ///
+    /// Downstream compilers for GPU targets do this themselves, whereas the
+    /// C/C++ and CUDA targets may be compiled by toolchains that do less.
+static bool _shouldOptimizeLoops(Linkage* linkage, CodeGenTarget target, TargetRequest* targetRequest)
+{
+    if (targetRequest->getTargetFlags() & SLANG_TARGET_FLAG_LOOP_OPTIMIZATIONS)
+    {
+        return true;
+    }
+    if (linkage->optimizationLevel < OptimizationLevel::High)
+    {
+        return false;
+    }
+    switch (target)
+    {
+        case CodeGenTarget::CSource:
+        case CodeGenTarget::CPPSource:
+        case CodeGenTarget::CUDASource:
+            return true;
+        default:
+            return false;
+    }
+}
+
 struct LinkingAndOptimizationOptions
 {
     bool shouldLegalizeExistentialAndResourceTypes = true;
@@ -154,6 +208,9 @@ Result linkAndOptimizeIR(
     LinkingAndOptimizationOptions const&    options,
     LinkedIR&                               outLinkedIR)
 {
+    CompileInstrumentation* instrumentation = compileRequest->getLinkage()->getInstrumentation();
+    CompileInstrumentation::PhaseScope phaseScope(instrumentation, CompilePhase::LinkAndOptimize);
+
     auto sink = compileRequest->getSink();
     auto program = compileRequest->getProgram();
     auto targetProgram = program->getTargetProgram(targetRequest);
@@ -168,14 +225,21 @@ Result linkAndOptimizeIR(
     // modules, and also select between the definitions of
     // any "profile-overloaded" symbols.
     //
-    outLinkedIR = linkIR(
-        compileRequest,
-        entryPointIndices,
-        target,
-        targetProgram);
+    {
+        CompileInstrumentation::PassScope passScope(instrumentation, "link-ir");
+        outLinkedIR = linkIR(
+            compileRequest,
+            entryPointIndices,
+            target,
+            targetProgram);
+    }
     auto irModule = outLinkedIR.module;
     auto irEntryPoints = outLinkedIR.entryPoints;
 
+    // The passes that follow are run by a pass manager, which times each of them, and caches
+    // the analyses of the IR they use.
+    IRPassManager passManager(irModule, instrumentation);
+
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "LINKED");
 #endif
@@ -189,7 +253,10 @@ Result linkAndOptimizeIR(
 
     // Replace any global constants with their values.
     //
-    replaceGlobalConstants(irModule);
+    {
+        IRPassManager::ModulePassScope passScope(&passManager, "replace-global-constants");
+        replaceGlobalConstants(irModule);
+    }
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "GLOBAL CONSTANTS REPLACED");
 #endif
@@ -203,7 +270,10 @@ Result linkAndOptimizeIR(
     // shader parameters for those slots, to be wired up to
     // use sites.
     //
-    bindExistentialSlots(irModule, sink);
+    {
+        IRPassManager::ModulePassScope passScope(&passManager, "bind-existential-slots");
+        bindExistentialSlots(irModule, sink);
+    }
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "EXISTENTIALS BOUND");
 #endif
@@ -227,7 +297,10 @@ Result linkAndOptimizeIR(
     // can assume that all ordinary/uniform data is strictly
     // passed using constant buffers.
     //
-    collectGlobalUniformParameters(irModule, outLinkedIR.globalScopeVarLayout);
+    {
+        IRPassManager::ModulePassScope passScope(&passManager, "collect-global-uniform-parameters");
+        collectGlobalUniformParameters(irModule, outLinkedIR.globalScopeVarLayout);
+    }
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "GLOBAL UNIFORMS COLLECTED");
 #endif
@@ -250,7 +323,10 @@ Result linkAndOptimizeIR(
         case CodeGenTarget::CPPSource:
             passOptions.alwaysCreateCollectedParam = true;
         default:
-            collectEntryPointUniformParams(irModule, passOptions);
+            {
+                IRPassManager::ModulePassScope passScope(&passManager, "collect-entry-point-uniform-params");
+                collectEntryPointUniformParams(irModule, passOptions);
+            }
         #if 0
             dumpIRIfEnabled(compileRequest, irModule, "ENTRY POINT UNIFORMS COLLECTED");
         #endif
@@ -262,7 +338,10 @@ Result linkAndOptimizeIR(
     switch( target )
     {
     default:
-        moveEntryPointUniformParamsToGlobalScope(irModule);
+        {
+            IRPassManager::ModulePassScope passScope(&passManager, "move-entry-point-uniform-params-to-global-scope");
+            moveEntryPointUniformParamsToGlobalScope(irModule);
+        }
     #if 0
         dumpIRIfEnabled(compileRequest, irModule, "ENTRY POINT UNIFORMS MOVED");
     #endif
@@ -278,7 +357,10 @@ Result linkAndOptimizeIR(
     // Desguar any union types, since these will be illegal on
     // various targets.
     //
-    desugarUnionTypes(irModule);
+    {
+        IRPassManager::ModulePassScope passScope(&passManager, "desugar-union-types");
+        desugarUnionTypes(irModule);
+    }
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "UNIONS DESUGARED");
 #endif
@@ -304,21 +386,33 @@ Result linkAndOptimizeIR(
     // values that need to be compile-time constants.
     //
     if (!compileRequest->disableSpecialization)
+    {
+        IRPassManager::ModulePassScope passScope(&passManager, "specialize");
         specializeModule(irModule);
+    }
 
-    eliminateDeadCode(irModule);
+    {
+        IRPassManager::ModulePassScope passScope(&passManager, "eliminate-dead-code");
+        eliminateDeadCode(irModule);
+    }
 
     // For targets that supports dynamic dispatch, we need to lower the
     // generics / interface types to ordinary functions and types using
     // function pointers.
     dumpIRIfEnabled(compileRequest, irModule, "BEFORE-LOWER-GENERICS");
-    lowerGenerics(targetRequest, irModule, sink);
+    {
+        IRPassManager::ModulePassScope passScope(&passManager, "lower-generics");
+        lowerGenerics(targetRequest, irModule, sink);
+    }
     dumpIRIfEnabled(compileRequest, irModule, "LOWER-GENERICS");
 
     if (sink->getErrorCount() != 0)
         return SLANG_FAIL;
 
-    lowerTuples(irModule, sink);
+    {
+        IRPassManager::ModulePassScope passScope(&passManager, "lower-tuples");
+        lowerTuples(irModule, sink);
+    }
     if (sink->getErrorCount() != 0)
         return SLANG_FAIL;
 
@@ -338,7 +432,10 @@ Result linkAndOptimizeIR(
     // TODO: Are there other cleanup optimizations we should
     // apply at this point?
     //
-    eliminateDeadCode(irModule);
+    {
+        IRPassManager::ModulePassScope passScope(&passManager, "eliminate-dead-code");
+        eliminateDeadCode(irModule);
+    }
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "AFTER DCE");
 #endif
@@ -373,10 +470,16 @@ Result linkAndOptimizeIR(
         //  we need to replace it with just an `X`, after which we
         //  will have (more) legal shader code.
         //
-        legalizeExistentialTypeLayout(
-            irModule,
-            sink);
-        eliminateDeadCode(irModule);
+        {
+            IRPassManager::ModulePassScope passScope(&passManager, "legalize-existential-type-layout");
+            legalizeExistentialTypeLayout(
+                irModule,
+                sink);
+        }
+        {
+            IRPassManager::ModulePassScope passScope(&passManager, "eliminate-dead-code");
+            eliminateDeadCode(irModule);
+        }
 
 #if 0
         dumpIRIfEnabled(compileRequest, irModule, "EXISTENTIALS LEGALIZED");
@@ -394,10 +497,16 @@ Result linkAndOptimizeIR(
         // What used to be individual variables/parameters/arguments/etc.
         // then become multiple variables/parameters/arguments/etc.
         //
-        legalizeResourceTypes(
-            irModule,
-            sink);
-        eliminateDeadCode(irModule);
+        {
+            IRPassManager::ModulePassScope passScope(&passManager, "legalize-resource-types");
+            legalizeResourceTypes(
+                irModule,
+                sink);
+        }
+        {
+            IRPassManager::ModulePassScope passScope(&passManager, "eliminate-dead-code");
+            eliminateDeadCode(irModule);
+        }
 
         //  Debugging output of legalization
     #if 0
@@ -411,7 +520,10 @@ Result linkAndOptimizeIR(
     // to see if we can clean up any temporaries created by legalization.
     // (e.g., things that used to be aggregated might now be split up,
     // so that we can work with the individual fields).
-    constructSSA(irModule);
+    {
+        ConstructSSAPass constructSSAPass;
+        passManager.runFunctionPass(&constructSSAPass);
+    }
 
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "AFTER SSA");
@@ -439,14 +551,18 @@ Result linkAndOptimizeIR(
     // for D3D targets that are not okay for Vulkan), we
     // pass down the target request along with the IR.
     //
-    specializeResourceOutputs(compileRequest, targetRequest, irModule);
-    specializeResourceParameters(compileRequest, targetRequest, irModule);
+    {
+        IRPassManager::ModulePassScope passScope(&passManager, "specialize-resource-usage");
+        specializeResourceOutputs(compileRequest, targetRequest, irModule);
+        specializeResourceParameters(compileRequest, targetRequest, irModule);
+    }
 
     // For GLSL targets, we also want to specialize calls to functions that
     // takes array parameters if possible, to avoid performance issues on
     // those platforms.
     if (isKhronosTarget(targetRequest))
     {
+        IRPassManager::ModulePassScope passScope(&passManager, "specialize-array-parameters");
         specializeArrayParameters(compileRequest, targetRequest, irModule);
     }
 
@@ -456,6 +572,83 @@ Result linkAndOptimizeIR(
 
     validateIRModuleIfEnabled(compileRequest, irModule);
 
+    // At higher optimization levels we inline functions where a cost model expects it
+    // to pay off. Downstream compilers for GPU targets will typically inline anyway, but
+    // the C++ and CUDA targets would otherwise pay for each call, and see none of the
+    // arguments that are constant at the call site.
+    //
+    // Inlining leaves behind loads and stores of what were the arguments, constants
+    // that can be propagated through the inlined code, and functions that are no longer
+    // called, so we follow it with SSA construction, SCCP and DCE.
+    //
+    IRInliningOptions inliningOptions;
+    if (_getInliningOptions(compileRequest->getLinkage()->optimizationLevel, inliningOptions))
+    {
+        Index inlinedCount = 0;
+        {
+            IRPassManager::ModulePassScope passScope(&passManager, "inline");
+            passScope.setInvalidatesChangedFuncs();
+            inlinedCount = performCostModelInlining(&passManager, inliningOptions);
+        }
+
+        if (inlinedCount)
+        {
+            {
+                ConstructSSAPass constructSSAPass;
+                passManager.runFunctionPass(&constructSSAPass);
+            }
+            {
+                IRPassManager::ModulePassScope passScope(&passManager, "sccp");
+                applySparseConditionalConstantPropagation(irModule);
+            }
+            {
+                IRPassManager::ModulePassScope passScope(&passManager, "eliminate-dead-code");
+                eliminateDeadCode(irModule);
+            }
+        }
+
+#if 0
+        dumpIRIfEnabled(compileRequest, irModule, "AFTER INLINING");
+#endif
+        validateIRModuleIfEnabled(compileRequest, irModule);
+    }
+
+    // Loop invariant code motion takes address math (and other computations that
+    // don't change between iterations) out of loops. It comes before unrolling, so
+    // that the invariant code isn't copied into each unrolled iteration.
+    //
+    // Unrolling leaves behind the (now constant) value of the loop counter in each
+    // iteration, so is followed by SCCP and DCE.
+    //
+    if (_shouldOptimizeLoops(compileRequest->getLinkage(), target, targetRequest))
+    {
+        {
+            LoopInvariantCodeMotionPass loopInvariantCodeMotionPass;
+            passManager.runFunctionPass(&loopInvariantCodeMotionPass);
+        }
+
+        IRLoopUnrollingOptions unrollingOptions;
+        UnrollLoopsPass unrollLoopsPass(unrollingOptions);
+        passManager.runFunctionPass(&unrollLoopsPass);
+
+        if (unrollLoopsPass.getUnrolledLoopCount())
+        {
+            {
+                IRPassManager::ModulePassScope passScope(&passManager, "sccp");
+                applySparseConditionalConstantPropagation(irModule);
+            }
+            {
+                IRPassManager::ModulePassScope passScope(&passManager, "eliminate-dead-code");
+                eliminateDeadCode(irModule);
+            }
+        }
+
+#if 0
+        dumpIRIfEnabled(compileRequest, irModule, "AFTER LOOP OPTIMIZATIONS");
+#endif
+        validateIRModuleIfEnabled(compileRequest, irModule);
+    }
+
     // For HLSL (and fxc/dxc) only, we need to "wrap" any
     // structured buffers defined over matrix types so
     // that they instead use an intermediate `struct`.
@@ -467,6 +660,7 @@ Result linkAndOptimizeIR(
     {
     case CodeGenTarget::HLSL:
         {
+            IRPassManager::ModulePassScope passScope(&passManager, "wrap-structured-buffers-of-matrices");
             wrapStructuredBuffersOfMatrices(irModule);
 #if 0
                 dumpIRIfEnabled(compileRequest, irModule, "STRUCTURED BUFFERS WRAPPED");
@@ -564,7 +758,10 @@ Result linkAndOptimizeIR(
             break;
         }
 
-        legalizeByteAddressBufferOps(session, targetRequest, irModule, byteAddressBufferOptions);
+        {
+            IRPassManager::ModulePassScope passScope(&passManager, "legalize-byte-address-buffer-ops");
+            legalizeByteAddressBufferOps(session, targetRequest, irModule, byteAddressBufferOptions);
+        }
     }
 
     // For CUDA targets only, we will need to turn operations
@@ -576,6 +773,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CUDASource:
     case CodeGenTarget::PTX:
         {
+            IRPassManager::ModulePassScope passScope(&passManager, "synthesize-active-mask");
             synthesizeActiveMask(
                 irModule,
                 compileRequest->getSink());
@@ -605,12 +803,15 @@ Result linkAndOptimizeIR(
     {
         auto glslExtensionTracker = as<GLSLExtensionTracker>(options.sourceEmitter->getExtensionTracker());
 
-        legalizeEntryPointsForGLSL(
-            session,
-            irModule,
-            irEntryPoints,
-            compileRequest->getSink(),
-            glslExtensionTracker);
+        {
+            IRPassManager::ModulePassScope passScope(&passManager, "legalize-entry-points");
+            legalizeEntryPointsForGLSL(
+                session,
+                irModule,
+                irEntryPoints,
+                compileRequest->getSink(),
+                glslExtensionTracker);
+        }
 
 #if 0
             dumpIRIfEnabled(compileRequest, irModule, "GLSL LEGALIZED");
@@ -622,12 +823,14 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CSource:
     case CodeGenTarget::CPPSource:
         {
+            IRPassManager::ModulePassScope passScope(&passManager, "legalize-entry-points");
             legalizeEntryPointVaryingParamsForCPU(irModule, compileRequest->getSink());
         }
         break;
 
     case CodeGenTarget::CUDASource:
         {
+            IRPassManager::ModulePassScope passScope(&passManager, "legalize-entry-points");
             legalizeEntryPointVaryingParamsForCUDA(irModule, compileRequest->getSink());
         }
         break;
@@ -644,11 +847,14 @@ Result linkAndOptimizeIR(
 
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::CUDASource:
-        moveGlobalVarInitializationToEntryPoints(irModule);
-        introduceExplicitGlobalContext(irModule, target);
-        if(target == CodeGenTarget::CPPSource)
         {
-            convertEntryPointPtrParamsToRawPtrs(irModule);
+            IRPassManager::ModulePassScope passScope(&passManager, "introduce-explicit-global-context");
+            moveGlobalVarInitializationToEntryPoints(irModule);
+            introduceExplicitGlobalContext(irModule, target);
+            if(target == CodeGenTarget::CPPSource)
+            {
+                convertEntryPointPtrParamsToRawPtrs(irModule);
+            }
         }
     #if 0
         dumpIRIfEnabled(compileRequest, irModule, "EXPLICIT GLOBAL CONTEXT INTRODUCED");
@@ -660,7 +866,10 @@ Result linkAndOptimizeIR(
     // TODO: our current dynamic dispatch pass will remove all uses of witness tables.
     // If we are going to support function-pointer based, "real" modular dynamic dispatch,
     // we will need to disable this pass.
-    stripWitnessTables(irModule);
+    {
+        IRPassManager::ModulePassScope passScope(&passManager, "strip-witness-tables");
+        stripWitnessTables(irModule);
+    }
 
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "AFTER STRIP WITNESS TABLES");
@@ -677,7 +886,10 @@ Result linkAndOptimizeIR(
     // dead-code-elimination (DCE) pass that only retains
     // whatever code is "live."
     //
-    eliminateDeadCode(irModule);
+    {
+        IRPassManager::ModulePassScope passScope(&passManager, "eliminate-dead-code");
+        eliminateDeadCode(irModule);
+    }
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "AFTER DCE");
 #endif
@@ -685,10 +897,37 @@ Result linkAndOptimizeIR(
 
     // Lower all bit_cast operations on complex types into leaf-level
     // bit_cast on basic types.
-    lowerBitCast(targetRequest, irModule);
-    eliminateDeadCode(irModule);
+    {
+        IRPassManager::ModulePassScope passScope(&passManager, "lower-bit-cast");
+        lowerBitCast(targetRequest, irModule);
+    }
+    {
+        IRPassManager::ModulePassScope passScope(&passManager, "eliminate-dead-code");
+        eliminateDeadCode(irModule);
+    }
     validateIRModuleIfEnabled(compileRequest, irModule);
 
+    // Specialization, type legalization and the lowering passes above
+    // routinely leave behind repeated field extracts, address computations
+    // and calls of side effect free intrinsics. Global value numbering
+    // removes those that are dominated by an identical instruction, so
+    // they are computed once in the emitted code.
+    //
+    // It is done for every target at higher optimization levels, and can
+    // be enabled for a specific target with a target flag.
+    //
+    if (compileRequest->getLinkage()->optimizationLevel >= OptimizationLevel::High ||
+        (targetRequest->getTargetFlags() & SLANG_TARGET_FLAG_GLOBAL_VALUE_NUMBERING))
+    {
+        GlobalValueNumberingPass globalValueNumberingPass;
+        passManager.runFunctionPass(&globalValueNumberingPass);
+
+#if 0
+        dumpIRIfEnabled(compileRequest, irModule, "AFTER GVN");
+#endif
+        validateIRModuleIfEnabled(compileRequest, irModule);
+    }
+
     return SLANG_OK;
 }
 
@@ -699,6 +938,8 @@ SlangResult emitEntryPointsSourceFromIR(
     TargetRequest*          targetRequest,
     SourceResult&           outSource)
 {
+    CompileInstrumentation::PhaseScope phaseScope(compileRequest->getLinkage()->getInstrumentation(), CompilePhase::Emit);
+
     outSource.reset();
 
     auto sink = compileRequest->getSink();
@@ -735,6 +976,7 @@ SlangResult emitEntryPointsSourceFromIR(
         desc.effectiveProfile = targetRequest->getTargetProfile();
     }
     desc.targetCaps = targetRequest->getTargetCaps();
+    desc.targetFlags = targetRequest->getTargetFlags();
     desc.sourceWriter = &sourceWriter;
 
     // Define here, because must be in scope longer than the sourceEmitter, as sourceEmitter might reference
@@ -816,8 +1058,8 @@ SlangResult emitEntryPointsSourceFromIR(
         sourceEmitter->emitModule(irModule, sink);
     }
 
-    String code = sourceWriter.getContent();
-    sourceWriter.clearContent();
+    ChunkedString code;
+    sourceWriter.appendContentAndClear(code);
 
     // Now that we've emitted the code for all the declarations in the file,
     // it is time to stitch together the final output.
@@ -829,7 +1071,12 @@ SlangResult emitEntryPointsSourceFromIR(
         const auto& prelude = compileRequest->getSession()->getPreludeForLanguage(sourceLanguage);
         if (prelude.getLength() > 0)
         {
-            sourceWriter.emit(prelude.getUnownedSlice());
+            // If nothing comes before it, the prelude can be compiled separately from the code that follows
+            if (sourceWriter.getContentLength() == 0)
+            {
+                outSource.prelude = prelude;
+            }
+            sourceWriter.emit(prelude);
         }
     }
 
@@ -847,15 +1094,9 @@ SlangResult emitEntryPointsSourceFromIR(
 
     sourceEmitter->emitLayoutDirectives(targetRequest);
 
-    String prefix = sourceWriter.getContent();
-    
-    StringBuilder finalResultBuilder;
-    finalResultBuilder << prefix;
-
-    finalResultBuilder << code;
-
-    // Write out the result
-    outSource.source = finalResultBuilder.ProduceString();
+    // Write out the result. The prefix and the code are joined as chunks, so neither is copied.
+    sourceWriter.appendContentAndClear(outSource.source);
+    outSource.source.append(code);
     outSource.extensionTracker = extensionTracker;
 
     return SLANG_OK;
@@ -873,6 +1114,8 @@ SlangResult emitSPIRVForEntryPointsDirectly(
     TargetRequest*          targetRequest,
     List<uint8_t>&          spirvOut)
 {
+    CompileInstrumentation::PhaseScope phaseScope(compileRequest->getLinkage()->getInstrumentation(), CompilePhase::Emit);
+
     auto sink = compileRequest->getSink();
     auto program = compileRequest->getProgram();
     auto targetProgram = program->getTargetProgram(targetRequest);
@@ -86,6 +86,7 @@ static SlangResult _calcCombinedPath(SlangPathType fromPathType, const char* fro
 /* static */OSFileSystem OSFileSystem::g_load(FileSystemStyle::Load);
 /* static */OSFileSystem OSFileSystem::g_ext(FileSystemStyle::Ext);
 /* static */OSFileSystem OSFileSystem::g_mutable(FileSystemStyle::Mutable);
+/* static */OSFileSystem OSFileSystem::g_mapped(FileSystemStyle::Ext, true);
 
 ISlangUnknown* OSFileSystem::getInterface(const Guid& guid)
 {
@@ -160,6 +161,21 @@ SlangResult OSFileSystem::loadFile(char const* pathIn, ISlangBlob** outBlob)
         return SLANG_E_NOT_FOUND;
     }
 
+    // NOTE! By default files are read into memory rather than mapped, even though that copies them.
+    // The blobs can be held for the life of a session (for example by CacheFileSystem), and source
+    // files may be edited or rewritten in place whilst they are. A mapping would see the new contents,
+    // or raise SIGBUS if the file was truncated. Mapping is only used if it has been asked for.
+    if (m_mapFiles)
+    {
+        ComPtr<ISlangBlob> mappedBlob;
+        if (SLANG_SUCCEEDED(File::mapAllBytes(path, kMinMemoryMappedFileSize, mappedBlob)))
+        {
+            *outBlob = mappedBlob.detach();
+            return SLANG_OK;
+        }
+        // Otherwise the file is too small to be worth mapping (or can't be), so read it
+    }
+
     ScopedAllocation alloc;
     SLANG_RETURN_ON_FAIL(File::readAllBytes(path, alloc));
     *outBlob = RawBlob::moveCreate(alloc).detach();
@@ -47,16 +47,26 @@ public:
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL remove(const char* path) SLANG_OVERRIDE;
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL createDirectory(const char* path) SLANG_OVERRIDE;
 
+        /// Files at least this size are loaded by mapping them into memory by the mapped instance (see getMappedSingleton).
+        /// Mapping a file has a higher fixed cost than reading it, so small files are still read.
+    static const size_t kMinMemoryMappedFileSize = 64 * 1024;
+
         /// Get a default instance
     static ISlangFileSystem* getLoadSingleton() { return &g_load; }
     static ISlangFileSystemExt* getExtSingleton() { return &g_ext; }
     static ISlangMutableFileSystem* getMutableSingleton() { return &g_mutable; }
 
+        /// Get an instance that loads large files by mapping them into memory, so their contents aren't copied.
+        /// The mapping is held as long as the blob is, so only use it when files won't be rewritten or truncated
+        /// during that time (such as generated or installed files).
+    static ISlangFileSystemExt* getMappedSingleton() { return &g_mapped; }
+
 private:
 
     /// Make so not constructible
-    OSFileSystem(FileSystemStyle style):
-        m_style(style)
+    OSFileSystem(FileSystemStyle style, bool mapFiles = false):
+        m_style(style),
+        m_mapFiles(mapFiles)
     {}
 
     virtual ~OSFileSystem() {}
@@ -64,10 +74,12 @@ private:
     ISlangUnknown* getInterface(const Guid& guid);
 
     FileSystemStyle m_style;
+    bool m_mapFiles;                    ///< If set, files of at least kMinMemoryMappedFileSize are mapped rather than read
 
     static OSFileSystem g_load;
     static OSFileSystem g_ext;
     static OSFileSystem g_mutable;
+    static OSFileSystem g_mapped;
 };
 
  #define SLANG_UUID_CacheFileSystem { 0x2f4d1d03, 0xa0d1, 0x434b, { 0x87, 0x7a, 0x65, 0x5, 0xa4, 0xa0, 0x9a, 0x3b } };
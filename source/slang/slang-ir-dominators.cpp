@@ -257,7 +257,8 @@ struct DepthFirstSearchContext
         preVisit(block);
         for(auto succ : block->getSuccessors())
         {
-            if(!visited.Contains(succ))
+            // A `switch` may have a null label (for example a `default` that can never be taken)
+            if(succ && !visited.Contains(succ))
             {
                 walk(succ);
             }
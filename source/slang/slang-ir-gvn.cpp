@@ -0,0 +1,168 @@
+// slang-ir-gvn.cpp
+#include "slang-ir-gvn.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+// This file implements a dominator-based Global Value Numbering (GVN) pass.
+//
+// The IR is in SSA form by the time this pass runs, so two instructions with
+// the same opcode, type and operands compute the same value if neither of them
+// depends on state outside of its operands. If one of them dominates the other,
+// the dominated one can be replaced by it.
+//
+// The instructions that only depend on their operands are listed explicitly,
+// so that anything not considered here is left alone.
+//
+bool isValueNumberable(IRInst* inst)
+{
+    switch( inst->getOp() )
+    {
+    default:
+        return false;
+
+    case kIROp_Call:
+        {
+            // A call of a `[__readNone]` function depends only on its arguments,
+            // so like other instructions without side effects it can be numbered.
+            // Any other call could read (or write) memory, or a resource.
+            //
+            auto call = cast<IRCall>(inst);
+            auto callee = getResolvedInstForDecorations(call->getCallee());
+            return callee->findDecoration<IRReadNoneDecoration>() != nullptr;
+        }
+
+    case kIROp_Construct:
+    case kIROp_makeUInt64:
+    case kIROp_makeVector:
+    case kIROp_MakeMatrix:
+    case kIROp_makeArray:
+    case kIROp_makeStruct:
+    case kIROp_FieldExtract:
+    case kIROp_FieldAddress:
+    case kIROp_getElement:
+    case kIROp_getElementPtr:
+    case kIROp_constructVectorFromScalar:
+    case kIROp_swizzle:
+    case kIROp_Add:
+    case kIROp_Sub:
+    case kIROp_Mul:
+    case kIROp_Div:
+    case kIROp_IRem:
+    case kIROp_FRem:
+    case kIROp_Lsh:
+    case kIROp_Rsh:
+    case kIROp_Eql:
+    case kIROp_Neq:
+    case kIROp_Greater:
+    case kIROp_Less:
+    case kIROp_Geq:
+    case kIROp_Leq:
+    case kIROp_BitAnd:
+    case kIROp_BitXor:
+    case kIROp_BitOr:
+    case kIROp_And:
+    case kIROp_Or:
+    case kIROp_Neg:
+    case kIROp_Not:
+    case kIROp_BitNot:
+    case kIROp_Select:
+    case kIROp_Dot:
+    case kIROp_BitCast:
+        return true;
+    }
+}
+
+// We find redundant instructions by walking the dominator tree of a function
+// from its entry block, and keeping a table of the instructions that are
+// available in the current block (those in the block itself, or in a block that
+// dominates it). The entries added for a block are removed again once the blocks
+// it dominates have been visited.
+//
+struct GlobalValueNumberingContext
+{
+    IRDominatorTree* m_dominatorTree;
+
+        /// The instructions available at the current point of the walk, by opcode, type and operands
+    Dictionary<IRInstKey, IRInst*> m_availableInsts;
+
+    Index m_removedCount = 0;
+
+        /// Number the instructions of `block`, and then of the blocks it dominates
+    void processBlock(IRBlock* block)
+    {
+        // The keys added for this block, to be removed once the
+        // blocks it dominates have been processed
+        List<IRInstKey> addedKeys;
+
+        IRInst* nextInst = nullptr;
+        for( IRInst* inst = block->getFirstOrdinaryInst(); inst; inst = nextInst )
+        {
+            nextInst = inst->getNextInst();
+
+            if( !isValueNumberable(inst) )
+                continue;
+
+            // An instruction marked `[precise]` must be computed as written,
+            // so it neither replaces nor is replaced by anything else.
+            //
+            if( inst->findDecoration<IRPreciseDecoration>() )
+                continue;
+
+            IRInstKey key = { inst };
+            if( IRInst** existing = m_availableInsts.TryGetValue(key) )
+            {
+                inst->replaceUsesWith(*existing);
+                inst->removeAndDeallocate();
+                m_removedCount++;
+            }
+            else
+            {
+                m_availableInsts.Add(key, inst);
+                addedKeys.add(key);
+            }
+        }
+
+        for( auto dominatedBlock : m_dominatorTree->getImmediatelyDominatedBlocks(block) )
+        {
+            processBlock(dominatedBlock);
+        }
+
+        for( auto& key : addedKeys )
+        {
+            m_availableInsts.Remove(key);
+        }
+    }
+};
+
+bool applyGlobalValueNumbering(IRDominatorTree* dominatorTree, IRGlobalValueWithCode* code)
+{
+    auto entryBlock = code->getFirstBlock();
+    if( !entryBlock )
+        return false;
+
+    GlobalValueNumberingContext context;
+    context.m_dominatorTree = dominatorTree;
+    context.processBlock(entryBlock);
+
+    CompileInstrumentation::addCount(CompileCounter::ValueNumberedInsts, context.m_removedCount);
+    return context.m_removedCount != 0;
+}
+
+bool GlobalValueNumberingPass::runOnFunction(IRPassManager* passManager, IRGlobalValueWithCode* code)
+{
+    switch (code->getOp())
+    {
+    case kIROp_Func:
+    case kIROp_GlobalVar:
+        return applyGlobalValueNumbering(passManager->getDominatorTree(code), code);
+
+    default:
+        return false;
+    }
+}
+
+}
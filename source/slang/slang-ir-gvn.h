@@ -0,0 +1,38 @@
+// slang-ir-gvn.h
+#pragma once
+
+#include "slang-ir-pass-manager.h"
+
+namespace Slang
+{
+    struct IRGlobalValueWithCode;
+    struct IRInst;
+
+        /// Returns true if `inst` computes its value from its operands alone, so another instruction with the
+        /// same opcode, type and operands is known to have the same value.
+    bool isValueNumberable(IRInst* inst);
+
+        /// Apply Global Value Numbering (GVN) to `code`, removing instructions that compute the same value
+        /// as an instruction that dominates them.
+        ///
+        /// Only instructions that compute a value from their operands alone (arithmetic, field and element
+        /// extracts, address computations, vector/struct construction, and calls of `[__readNone]` functions)
+        /// are considered. Loads, stores, resource operations and other calls are left alone, as their
+        /// results depend on (or change) state outside of their operands.
+        ///
+        /// Returns true if `code` was changed.
+    bool applyGlobalValueNumbering(IRDominatorTree* dominatorTree, IRGlobalValueWithCode* code);
+
+        /// Runs `applyGlobalValueNumbering` on each function (and global variable with an initializer)
+    class GlobalValueNumberingPass : public IRFunctionPass
+    {
+    public:
+        virtual bool runOnFunction(IRPassManager* passManager, IRGlobalValueWithCode* code) SLANG_OVERRIDE;
+
+            /// Only instructions within blocks are removed, so the control flow graph is unchanged
+        GlobalValueNumberingPass():
+            IRFunctionPass("global-value-numbering", IRAnalysisFlag::DominatorTree, IRAnalysisFlag::DominatorTree)
+        {
+        }
+    };
+}
@@ -17,6 +17,7 @@
 #include "slang-ir.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-pass-manager.h"
 
 namespace Slang
 {
@@ -26,6 +27,9 @@ struct InliningPassBase
         /// The module that we are optimizing/transforming
     IRModule* m_module = nullptr;
 
+        /// If set, inlined instructions take the source location of the call site (if it has one) rather than their own
+    bool m_preferCallSiteSourceLoc = true;
+
         /// Initialize an inlining pass to operate on the given `module`
     InliningPassBase(IRModule* module)
         : m_module(module)
@@ -92,8 +96,8 @@ struct InliningPassBase
     // With `CallSiteInfo` defined, we can now understand the
     // basic proces of considering a call site for inlining.
 
-        /// Consider the given `call` site, and possibly inline it.
-    void considerCallSite(IRCall* call)
+        /// Consider the given `call` site, and possibly inline it. Returns true if it was inlined.
+    bool considerCallSite(IRCall* call)
     {
         // We start by checking if inlining would even be possible,
         // since doing so collects information about the call site
@@ -104,7 +108,7 @@ struct InliningPassBase
         //
         CallSiteInfo callSite;
         if(!canInline(call, callSite))
-            return;
+            return false;
 
         // If we've decided that we *can* inline the given call
         // site, we next need to check if we *should*. The rules
@@ -112,13 +116,14 @@ struct InliningPassBase
         // so `shouldInline` is a virtual method.
         //
         if(!shouldInline(callSite))
-            return;
+            return false;
 
         // Finally, if we both *can* and *should* inline the
         // given call site, we hand off the a worker routine
         // that does the meat of the work.
         //
         inlineCallSite(callSite);
+        return true;
     }
 
     // Every subclas of `InliningPassBase` should provide its own
@@ -204,6 +209,32 @@ struct InliningPassBase
         if(!isDefinition(calleeFunc))
             return false;
 
+        // The arguments at the call site replace the parameters of
+        // the callee, so there must be one for each parameter.
+        //
+        UInt paramCount = 0;
+        for( auto param : calleeFunc->getParams() )
+        {
+            SLANG_UNUSED(param);
+            paramCount++;
+        }
+        if(paramCount != call->getArgCount())
+            return false;
+
+        // A call of a function returning `void` has no value to
+        // replace its uses with, although legalization can leave
+        // such values in use (as arguments that are ignored).
+        //
+        if(call->firstUse && as<IRVoidType>(calleeFunc->getResultType()))
+            return false;
+
+        // Finally, the body of the callee must be something
+        // we know how to inline without breaking the structured
+        // control flow the emitters rely on.
+        //
+        if(!isTrivialFunc(calleeFunc) && !findSingleTopLevelReturn(calleeFunc))
+            return false;
+
         return true;
     }
 
@@ -315,9 +346,10 @@ struct InliningPassBase
             SLANG_ASSERT(argCounter == (Int)call->getArgCount());
         }
 
-        // For now, our inlining pass only handles the case where
-        // the callee is a "trivial" function, which can support
-        // a very simple approach to inlining.
+        // A "trivial" function can have its body cloned directly
+        // in place of the call. Anything else needs the block
+        // containing the call to be split, so that the inlined
+        // blocks can branch to the code after the call.
         //
         if( isTrivialFunc(callee) )
         {
@@ -325,10 +357,7 @@ struct InliningPassBase
         }
         else
         {
-            // Running into any non-trivial function to be inlined
-            // is currently an internal compiler error.
-            //
-            SLANG_UNIMPLEMENTED_X("general case of inlining");
+            inlineFuncBody(callSite, &env, &builder);
         }
     }
 
@@ -349,12 +378,76 @@ struct InliningPassBase
         // If the body block terminates in something other than a `return` then the function is non-trivial.
         //
         auto terminator = firstBlock->getTerminator();
-        if( !as<IRReturn>(terminator) )
+        if( !isReturn(terminator) )
             return false;
 
         return true;
     }
 
+    static bool isReturn(IRInst* inst)
+    {
+        switch( inst->getOp() )
+        {
+        case kIROp_ReturnVal:
+        case kIROp_ReturnVoid:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+        /// Find the `return` of `func` if it is the only one, and it isn't nested within a loop, `if` or `switch`.
+        ///
+        /// Such a `return` can be replaced with a branch to the code after the call site without
+        /// breaking the structured control flow of the caller. Returns nullptr otherwise.
+        ///
+    IRInst* findSingleTopLevelReturn(IRFunc* func)
+    {
+        IRInst* returnInst = nullptr;
+        for( auto block : func->getBlocks() )
+        {
+            auto terminator = block->getTerminator();
+            if( !terminator || !isReturn(terminator) )
+                continue;
+            if( returnInst )
+                return nullptr;
+            returnInst = terminator;
+        }
+        if( !returnInst )
+            return nullptr;
+
+        // The blocks at the top level of the function are found by
+        // following each structured control flow construct to the
+        // block that comes after it.
+        //
+        HashSet<IRBlock*> visitedBlocks;
+        for( IRBlock* block = func->getFirstBlock(); block && visitedBlocks.Add(block); )
+        {
+            auto terminator = block->getTerminator();
+            if( terminator == returnInst )
+                return returnInst;
+
+            switch( terminator->getOp() )
+            {
+            case kIROp_unconditionalBranch:
+                block = as<IRUnconditionalBranch>(terminator)->getTargetBlock();
+                break;
+            case kIROp_loop:
+                block = as<IRLoop>(terminator)->getBreakBlock();
+                break;
+            case kIROp_ifElse:
+                block = as<IRIfElse>(terminator)->getAfterBlock();
+                break;
+            case kIROp_Switch:
+                block = as<IRSwitch>(terminator)->getBreakLabel();
+                break;
+            default:
+                return nullptr;
+            }
+        }
+        return nullptr;
+    }
+
         // When instructions are cloned, with cloneInst no sourceLoc information is copied over by default.
         // Here we attempt some policy about copying sourceLocs when inlining.
         //
@@ -377,7 +470,10 @@ struct InliningPassBase
         // serialization.
         // 
         // For now this punts on this, and just assumes [__unsafeForceInlineEarly] is not in user code.
-    static IRInst* _cloneInstWithSourceLoc(CallSiteInfo const& callSite,
+        //
+        // Passes that inline user code (where the callee's own locations are the useful ones, for example
+        // in diagnostics from a downstream compiler) can turn this off with `m_preferCallSiteSourceLoc`.
+    IRInst* _cloneInstWithSourceLoc(CallSiteInfo const& callSite,
         IRCloneEnv*     env,
         IRBuilder*      builder,
         IRInst*         inst)
@@ -386,7 +482,11 @@ struct InliningPassBase
 
         SourceLoc sourceLoc;
 
-        if (callSite.call->sourceLoc.isValid())
+        if (!m_preferCallSiteSourceLoc && inst->sourceLoc.isValid())
+        {
+            sourceLoc = inst->sourceLoc;
+        }
+        else if (callSite.call->sourceLoc.isValid())
         {
             // Default to using the source loc at the call site
             sourceLoc = callSite.call->sourceLoc;
@@ -469,6 +569,93 @@ struct InliningPassBase
         //
         call->removeAndDeallocate();
     }
+
+        /// Inline the body of the callee for `callSite`, where the callee has a `return` found by `findSingleTopLevelReturn`
+    void inlineFuncBody(CallSiteInfo const& callSite, IRCloneEnv* env, IRBuilder* builder)
+    {
+        auto call = callSite.call;
+        auto callee = callSite.callee;
+        auto callBlock = as<IRBlock>(call->getParent());
+
+        // The instructions after the call are moved to a new block,
+        // which takes the place of the `return` in the inlined code.
+        // Because the `return` is at the top level of the callee, the
+        // inlined blocks form a structured region that is entered from
+        // `callBlock` and always leaves to `afterBlock`.
+        //
+        IRBlock* afterBlock = builder->createBlock();
+        afterBlock->insertAfter(callBlock);
+        while( auto inst = call->getNextInst() )
+        {
+            inst->insertAtEnd(afterBlock);
+        }
+
+        // Branches can refer to blocks later in the callee, so the
+        // clone of every block is created up front.
+        //
+        List<IRBlock*> clonedBlocks;
+        for( auto block : callee->getBlocks() )
+        {
+            IRBlock* clonedBlock = builder->createBlock();
+            clonedBlock->insertBefore(afterBlock);
+            env->mapOldValToNew.Add(block, clonedBlock);
+            clonedBlocks.add(clonedBlock);
+        }
+
+        IRBlock* entryBlock = callee->getFirstBlock();
+        IRInst* returnedValue = nullptr;
+
+        Index blockIndex = 0;
+        for( auto block : callee->getBlocks() )
+        {
+            builder->setInsertInto(clonedBlocks[blockIndex++]);
+
+            for( auto inst : block->getChildren() )
+            {
+                switch( inst->getOp() )
+                {
+                default:
+                    _cloneInstWithSourceLoc(callSite, env, builder, inst);
+                    break;
+
+                case kIROp_Param:
+                    // The parameters of the entry block are the parameters of
+                    // the function, which have been replaced via `env`. The
+                    // parameters of any other block are "phi nodes", and are
+                    // cloned as usual.
+                    //
+                    if( block != entryBlock )
+                    {
+                        _cloneInstWithSourceLoc(callSite, env, builder, inst);
+                    }
+                    break;
+
+                case kIROp_ReturnVal:
+                    // The value returned is defined on every path to the one and only
+                    // `return`, so it can directly replace the uses of the call.
+                    //
+                    returnedValue = findCloneForOperand(env, inst->getOperand(0));
+                    builder->emitBranch(afterBlock);
+                    break;
+
+                case kIROp_ReturnVoid:
+                    builder->emitBranch(afterBlock);
+                    break;
+                }
+            }
+        }
+
+        if( returnedValue )
+        {
+            call->replaceUsesWith(returnedValue);
+        }
+
+        // Finally the `call` is replaced with a branch into the inlined code.
+        //
+        call->removeAndDeallocate();
+        builder->setInsertInto(callBlock);
+        builder->emitBranch(clonedBlocks[0]);
+    }
 };
 
     /// An inlining pass that inlines calls to `[unsafeForceInlineEarly]` functions
@@ -495,4 +682,156 @@ void performMandatoryEarlyInlining(IRModule* module)
     pass.considerAllCallSites();
 }
 
+    /// An inlining pass that inlines calls where a size/benefit cost model expects it to pay off
+struct CostModelInliningPass : InliningPassBase
+{
+    typedef InliningPassBase Super;
+
+    CostModelInliningPass(IRPassManager* passManager, IRInliningOptions const& options)
+        : Super(passManager->getModule())
+        , m_passManager(passManager)
+        , m_options(options)
+    {
+        m_preferCallSiteSourceLoc = false;
+    }
+
+    IRPassManager* m_passManager;
+    IRInliningOptions m_options;
+
+        /// The size of each function considered so far. Removed when a function is changed.
+    Dictionary<IRFunc*, Index> m_sizes;
+
+    Index getSize(IRFunc* func)
+    {
+        if( auto size = m_sizes.TryGetValue(func) )
+            return *size;
+
+        Index size = 0;
+        for( auto block : func->getBlocks() )
+        {
+            for( auto inst : block->getChildren() )
+            {
+                SLANG_UNUSED(inst);
+                size++;
+            }
+        }
+        m_sizes.Add(func, size);
+        return size;
+    }
+
+        /// Returns true if `func` has decorations that are only meaningful on the function itself
+        /// (such as target intrinsics, or required extensions), which would be lost by inlining it
+    static bool hasDecorationPreventingInlining(IRFunc* func)
+    {
+        for( auto decoration : func->getDecorations() )
+        {
+            switch( decoration->getOp() )
+            {
+            case kIROp_NameHintDecoration:
+            case kIROp_HighLevelDeclDecoration:
+            case kIROp_ImportDecoration:
+            case kIROp_ExportDecoration:
+            case kIROp_PublicDecoration:
+            case kIROp_ReadNoneDecoration:
+                break;
+            default:
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool hasSingleUse(IRInst* inst, IRInst* user)
+    {
+        IRUse* use = inst->firstUse;
+        return use && !use->nextUse && use->getUser() == user;
+    }
+
+        /// Returns true if the only use of the callee of `callSite` is the call itself,
+        /// so that it will be removed as dead code once inlined
+    static bool isOnlyUse(CallSiteInfo const& callSite)
+    {
+        if( auto specialize = callSite.specialize )
+        {
+            return hasSingleUse(callSite.generic, specialize) && hasSingleUse(specialize, callSite.call);
+        }
+        return hasSingleUse(callSite.callee, callSite.call);
+    }
+
+    bool shouldInline(CallSiteInfo const& callSite) SLANG_OVERRIDE
+    {
+        IRFunc* callee = callSite.callee;
+
+        // Recursive calls are never inlined
+        if( callee == getParentFunc(callSite.call) )
+            return false;
+
+        if( hasDecorationPreventingInlining(callee) )
+            return false;
+
+        Index size = getSize(callee);
+        const UInt argCount = callSite.call->getArgCount();
+        for( UInt i = 0; i < argCount; ++i )
+        {
+            if( as<IRConstant>(callSite.call->getArg(i)) )
+            {
+                size -= m_options.constantArgumentSizeBonus;
+            }
+        }
+
+        if( size <= m_options.smallCalleeSize )
+            return true;
+        return size <= m_options.singleCallCalleeSize && isOnlyUse(callSite);
+    }
+
+    static IRFunc* getParentFunc(IRInst* inst)
+    {
+        for( auto parent = inst->getParent(); parent; parent = parent->getParent() )
+        {
+            if( auto func = as<IRFunc>(parent) )
+                return func;
+        }
+        return nullptr;
+    }
+
+    Index considerAllFuncs()
+    {
+        Index inlinedCount = 0;
+
+        // The order (and the call sites of each function) are copied, as inlining changes them
+        IRCallGraph* callGraph = m_passManager->getCallGraph();
+        List<IRFunc*> funcs = callGraph->getBottomUpOrder();
+        for( auto func : funcs )
+        {
+            List<IRCall*> callSites = callGraph->getCallSites(func);
+
+            Index funcInlinedCount = 0;
+            for( auto call : callSites )
+            {
+                if( considerCallSite(call) )
+                {
+                    funcInlinedCount++;
+                }
+            }
+
+            if( funcInlinedCount )
+            {
+                m_sizes.Remove(func);
+                m_passManager->invalidate(func);
+                inlinedCount += funcInlinedCount;
+            }
+        }
+        return inlinedCount;
+    }
+};
+
+Index performCostModelInlining(IRPassManager* passManager, IRInliningOptions const& options)
+{
+    CostModelInliningPass pass(passManager, options);
+    const Index inlinedCount = pass.considerAllFuncs();
+
+    CompileInstrumentation::addCount(CompileCounter::InlinedCallSites, inlinedCount);
+    return inlinedCount;
+}
+
 } // namespace Slang
@@ -1,10 +1,39 @@
 // slang-ir-inline.h
 #pragma once
 
+#include "../core/slang-basic.h"
+
 namespace Slang
 {
     struct IRModule;
+    class IRPassManager;
 
         /// Inline any call sites to functions marked `[unsafeForceInlineEarly]`
     void performMandatoryEarlyInlining(IRModule* module);
+
+        /// The cost model used by `performCostModelInlining`.
+        ///
+        /// The size of a function is the number of instructions in its body.
+        ///
+    struct IRInliningOptions
+    {
+            /// Calls of functions of at most this size are inlined
+        Index smallCalleeSize = 0;
+            /// A function that is only used by a single call is inlined (and then removed as dead code) if
+            /// it is at most this size
+        Index singleCallCalleeSize = 0;
+            /// The amount the size of a callee is reduced by for each argument that is a constant at the
+            /// call site, as constant propagation is likely to simplify the inlined code
+        Index constantArgumentSizeBonus = 0;
+    };
+
+        /// Inline the call sites the cost model of `options` expects to benefit from it.
+        ///
+        /// Functions are visited bottom-up in the call graph, so a callee has had the calls within it
+        /// inlined before it is considered for inlining itself. Only callees whose control flow stays
+        /// structured once inlined (those with a single block, or with a single `return` that isn't
+        /// nested within a loop, `if` or `switch`) are inlined.
+        ///
+        /// The functions changed are invalidated in `passManager`. Returns the number of call sites inlined.
+    Index performCostModelInlining(IRPassManager* passManager, IRInliningOptions const& options);
 }
@@ -50,6 +50,14 @@ struct IRSharedSpecContext
     typedef Dictionary<String, RefPtr<IRSpecSymbol>> SymbolDictionary;
     SymbolDictionary symbols;
 
+    // Modules whose global values are only read (and added to `symbols`)
+    // when a symbol with their name is looked up.
+    List<IRLazyModule*> lazyModules;
+
+    // The names that have been looked up in `lazyModules`. All of the values
+    // with a name are read by the first look up, so it is only done once.
+    HashSet<String> lazyModulesLookedUpNames;
+
     SharedIRBuilder sharedBuilderStorage;
     IRBuilder builderStorage;
 
@@ -67,6 +75,9 @@ struct IRSpecContextBase
 
     IRSharedSpecContext::SymbolDictionary& getSymbols() { return getShared()->symbols; }
 
+        /// Find the global values with `mangledName`, in any of the modules being linked
+    bool findSymbol(String const& mangledName, RefPtr<IRSpecSymbol>& outSymbol);
+
     // The current specialization environment to use.
     IRSpecEnv* env = nullptr;
     IRSpecEnv* getEnv()
@@ -819,11 +830,11 @@ IRFunc* specializeIRForEntryPoint(
     // not the same as the mangled name of the decl.
     //
     RefPtr<IRSpecSymbol> sym;
-    if (!context->getSymbols().TryGetValue(mangledName, sym))
+    if (!context->findSymbol(mangledName, sym))
     {
         String hashedName = getHashedName(mangledName.getUnownedSlice());
 
-        if (!context->getSymbols().TryGetValue(hashedName, sym))
+        if (!context->findSymbol(hashedName, sym))
         {
             SLANG_UNEXPECTED("no matching IR symbol");
             return nullptr;
@@ -1175,7 +1186,7 @@ IRInst* cloneGlobalValueWithLinkage(
 
     auto mangledName = String(originalLinkage->getMangledName());
     RefPtr<IRSpecSymbol> sym;
-    if( !context->getSymbols().TryGetValue(mangledName, sym) )
+    if( !context->findSymbol(mangledName, sym) )
     {
         if(!originalVal)
             return nullptr;
@@ -1274,6 +1285,46 @@ void insertGlobalValueSymbols(
     }
 }
 
+    /// Add the global values read from `lazyModule` since they were last added
+static void insertReadGlobalValueSymbols(
+    IRSharedSpecContext*    sharedContext,
+    IRLazyModule*           lazyModule)
+{
+    List<IRInst*> readValues;
+    lazyModule->takeReadGlobalValues(readValues);
+
+    for (auto value : readValues)
+    {
+        insertGlobalValueSymbol(sharedContext, value);
+    }
+}
+
+bool IRSpecContextBase::findSymbol(String const& mangledName, RefPtr<IRSpecSymbol>& outSymbol)
+{
+    // The values with the name have to be read from each lazily read module
+    // before looking the name up, as there may already be values with the
+    // name from other modules. Reading a value also reads everything it
+    // references, so everything read is added.
+    //
+    auto sharedContext = getShared();
+    if (sharedContext->lazyModules.getCount() == 0 ||
+        !sharedContext->lazyModulesLookedUpNames.Add(mangledName))
+    {
+        return sharedContext->symbols.TryGetValue(mangledName, outSymbol);
+    }
+
+    for (auto lazyModule : sharedContext->lazyModules)
+    {
+        if (SLANG_FAILED(lazyModule->readGlobalValues(mangledName.getUnownedSlice())))
+        {
+            SLANG_UNEXPECTED("unable to read IR from library");
+        }
+        insertReadGlobalValueSymbols(sharedContext, lazyModule);
+    }
+
+    return sharedContext->symbols.TryGetValue(mangledName, outSymbol);
+}
+
 void initializeSharedSpecContext(
     IRSharedSpecContext*    sharedContext,
     Session*                session,
@@ -1372,6 +1423,26 @@ LinkedIR linkIR(
     });
     irModules.addRange(linkage->m_libModules.getBuffer()->readRef(), linkage->m_libModules.getCount());
 
+    // Libraries read lazily only have the values that must always be linked
+    // read up front. The rest are read as they are looked up by name (see
+    // `IRSpecContextBase::findSymbol`), so linking costs time in proportion
+    // to what is used, rather than to the size of the library.
+    //
+    // A module read by an earlier link will also hold what that link read,
+    // which is added to the symbols along with the roots below.
+    //
+    for (IRLazyModule* lazyModule : linkage->m_lazyLibModules)
+    {
+        if (SLANG_FAILED(lazyModule->readRootGlobalValues()))
+        {
+            SLANG_UNEXPECTED("unable to read IR from library");
+        }
+        List<IRInst*> readValues;
+        lazyModule->takeReadGlobalValues(readValues);
+
+        sharedContext->lazyModules.add(lazyModule);
+        irModules.add(lazyModule->getIRModule());
+    }
     
     // Add any modules that were loaded as libraries
     for (IRModule* irModule : irModules)
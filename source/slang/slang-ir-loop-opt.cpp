@@ -0,0 +1,629 @@
+// slang-ir-loop-opt.cpp
+#include "slang-ir-loop-opt.h"
+
+#include "slang-ir.h"
+#include "slang-ir-clone.h"
+#include "slang-ir-gvn.h"
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! LoopInvariantCodeMotionPass !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+    /// Returns true if `inst` could fail for some operands (for example an integer division by zero), so it can't
+    /// be computed in places the loop wouldn't have computed it
+static bool _canFail(IRInst* inst)
+{
+    switch (inst->getOp())
+    {
+        case kIROp_Div:
+        case kIROp_IRem:
+        case kIROp_getElement:
+        case kIROp_Call:
+            return true;
+        default:
+            return false;
+    }
+}
+
+    /// Returns true if `value` is defined outside of `loop`
+static bool _isDefinedOutsideLoop(IRLoopInfo* loopInfo, IRLoopRegion* loop, IRInst* value)
+{
+    if (!value)
+    {
+        return true;
+    }
+    auto block = as<IRBlock>(value->getParent());
+    return !block || !loopInfo->isInLoop(loop, block);
+}
+
+static bool _isLoopInvariant(IRLoopInfo* loopInfo, IRLoopRegion* loop, IRInst* inst)
+{
+    if (!_isDefinedOutsideLoop(loopInfo, loop, inst->getFullType()))
+    {
+        return false;
+    }
+    const UInt operandCount = inst->getOperandCount();
+    for (UInt i = 0; i < operandCount; ++i)
+    {
+        if (!_isDefinedOutsideLoop(loopInfo, loop, inst->getOperand(i)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+    /// Returns true if all of the uses of `inst` are in blocks dominated by `block`, so `inst` can be moved there
+static bool _dominatesUses(IRDominatorTree* dominatorTree, IRBlock* block, IRInst* inst)
+{
+    for (IRUse* use = inst->firstUse; use; use = use->nextUse)
+    {
+        IRInst* user = use->getUser();
+        while (user && !as<IRBlock>(user->getParent()))
+        {
+            user = user->getParent();
+        }
+        if (!user || !dominatorTree->dominates(block, as<IRBlock>(user->getParent())))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LoopInvariantCodeMotionPass::runOnFunction(IRPassManager* passManager, IRGlobalValueWithCode* code)
+{
+    IRDominatorTree* dominatorTree = passManager->getDominatorTree(code);
+    IRLoopInfo* loopInfo = passManager->getLoopInfo(code);
+
+    // Inner loops come first, so an instruction moved out of an inner loop (to its preheader, which is within
+    // the outer loop) can then be moved out of the outer loop too.
+    Index movedCount = 0;
+    for (auto loop : loopInfo->getLoops())
+    {
+        IRLoop* loopInst = loop->loopInst;
+        IRBlock* preheader = loop->getPreheader();
+        IRBlock* header = loop->getHeader();
+
+        // Moving an instruction can make the instructions that use it invariant, so repeat until nothing moves
+        for (bool moved = true; moved; )
+        {
+            moved = false;
+            for (auto block : loop->blocks)
+            {
+                // The preheader is never one of the blocks of its loop, but nothing is gained by moving within it
+                if (block == preheader)
+                {
+                    continue;
+                }
+
+                IRInst* nextInst = nullptr;
+                for (IRInst* inst = block->getFirstOrdinaryInst(); inst; inst = nextInst)
+                {
+                    nextInst = inst->getNextInst();
+
+                    if (!isValueNumberable(inst) || !_isLoopInvariant(loopInfo, loop, inst))
+                    {
+                        continue;
+                    }
+                    if ((_canFail(inst) && block != header) || !_dominatesUses(dominatorTree, preheader, inst))
+                    {
+                        continue;
+                    }
+
+                    inst->insertBefore(loopInst);
+                    moved = true;
+                    movedCount++;
+                }
+            }
+        }
+    }
+
+    CompileInstrumentation::addCount(CompileCounter::LoopInvariantInstsMoved, movedCount);
+    return movedCount != 0;
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! UnrollLoopsPass !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+struct LoopUnrollingContext
+{
+    IRModule* m_module;
+    IRLoopUnrollingOptions m_options;
+
+        /// What is known about a loop that can be unrolled
+    struct UnrollInfo
+    {
+        IRLoopRegion* loop = nullptr;
+            /// The block at the end of the body, that branches back to the header
+        IRBlock* latch = nullptr;
+            /// The number of times the body of the loop runs
+        Index tripCount = 0;
+    };
+
+        /// Evaluate the comparison `op` of `a` and `b`. Returns false if `op` isn't a comparison.
+    static bool _evalComparison(IROp op, IRIntegerValue a, IRIntegerValue b, bool& outResult)
+    {
+        switch (op)
+        {
+            case kIROp_Less:    outResult = a < b; return true;
+            case kIROp_Leq:     outResult = a <= b; return true;
+            case kIROp_Greater: outResult = a > b; return true;
+            case kIROp_Geq:     outResult = a >= b; return true;
+            case kIROp_Eql:     outResult = a == b; return true;
+            case kIROp_Neq:     outResult = a != b; return true;
+            default:            return false;
+        }
+    }
+
+        /// The comparison `op` with its operands swapped
+    static IROp _getSwappedComparison(IROp op)
+    {
+        switch (op)
+        {
+            case kIROp_Less:    return kIROp_Greater;
+            case kIROp_Leq:     return kIROp_Geq;
+            case kIROp_Greater: return kIROp_Less;
+            case kIROp_Geq:     return kIROp_Leq;
+            default:            return op;
+        }
+    }
+
+        /// Find the number of iterations of `loop`, where its header ends with `test` and the back edge is from `latch`
+    bool _findTripCount(IRLoopRegion* loop, IRIfElse* test, IRBlock* latch, Index& outTripCount)
+    {
+        IRBlock* header = loop->getHeader();
+
+        // The condition must compare a parameter of the header (the counter) with a constant
+        auto condition = test->getCondition();
+        if (condition->getOperandCount() != 2)
+        {
+            return false;
+        }
+        IROp op = condition->getOp();
+        IRInst* counter = condition->getOperand(0);
+        auto bound = as<IRIntLit>(condition->getOperand(1));
+        if (!bound)
+        {
+            counter = condition->getOperand(1);
+            bound = as<IRIntLit>(condition->getOperand(0));
+            op = _getSwappedComparison(op);
+        }
+        if (!bound || counter->getParent() != header || !as<IRParam>(counter))
+        {
+            return false;
+        }
+
+        // Only 32 bit integers are handled, so we know where they would wrap around
+        IRIntegerValue minValue = 0;
+        IRIntegerValue maxValue = 0;
+        switch (counter->getDataType()->getOp())
+        {
+            case kIROp_IntType:
+                minValue = IRIntegerValue(INT32_MIN);
+                maxValue = IRIntegerValue(INT32_MAX);
+                break;
+            case kIROp_UIntType:
+                maxValue = IRIntegerValue(UINT32_MAX);
+                break;
+            default:
+                return false;
+        }
+
+        // The arguments of the `loop` and of the branch back to the header are the values of the header's
+        // parameters for the first, and each following, iteration
+        UInt paramIndex = 0;
+        for (auto param : header->getParams())
+        {
+            if (param == counter)
+            {
+                break;
+            }
+            paramIndex++;
+        }
+        auto backEdge = as<IRUnconditionalBranch>(latch->getTerminator());
+        if (paramIndex >= loop->loopInst->getArgCount() || paramIndex >= backEdge->getArgCount())
+        {
+            return false;
+        }
+
+        auto initialValue = as<IRIntLit>(loop->loopInst->getArg(paramIndex));
+        if (!initialValue)
+        {
+            return false;
+        }
+
+        IRInst* nextValue = backEdge->getArg(paramIndex);
+        IRIntegerValue step = 0;
+        if (nextValue->getOperandCount() != 2)
+        {
+            return false;
+        }
+        auto stepOperand0 = as<IRIntLit>(nextValue->getOperand(0));
+        auto stepOperand1 = as<IRIntLit>(nextValue->getOperand(1));
+        switch (nextValue->getOp())
+        {
+            case kIROp_Add:
+                if (nextValue->getOperand(0) == counter && stepOperand1)
+                {
+                    step = stepOperand1->getValue();
+                }
+                else if (nextValue->getOperand(1) == counter && stepOperand0)
+                {
+                    step = stepOperand0->getValue();
+                }
+                break;
+            case kIROp_Sub:
+                if (nextValue->getOperand(0) == counter && stepOperand1)
+                {
+                    step = -stepOperand1->getValue();
+                }
+                break;
+            default:
+                break;
+        }
+        if (step == 0)
+        {
+            return false;
+        }
+
+        // Run the loop on the counter alone
+        Index tripCount = 0;
+        for (IRIntegerValue value = initialValue->getValue(); ; value += step)
+        {
+            if (value < minValue || value > maxValue)
+            {
+                return false;
+            }
+
+            bool result = false;
+            if (!_evalComparison(op, value, bound->getValue(), result))
+            {
+                return false;
+            }
+            if (!result)
+            {
+                break;
+            }
+            if (++tripCount > m_options.maxTripCount)
+            {
+                return false;
+            }
+        }
+
+        outTripCount = tripCount;
+        return true;
+    }
+
+        /// Returns true if the control flow from `block` reaches `latch` without entering (rather than passing
+        /// over) any structured control flow construct, so that `latch` is at the top level of the body of `loop`
+    static bool _isTopLevelPath(IRLoopInfo* loopInfo, IRLoopRegion* loop, IRBlock* block, IRBlock* latch)
+    {
+        HashSet<IRBlock*> visited;
+        while (block != latch)
+        {
+            if (!block || !visited.Add(block) || !loopInfo->isInLoop(loop, block))
+            {
+                return false;
+            }
+
+            auto terminator = block->getTerminator();
+            if (!terminator)
+            {
+                return false;
+            }
+            switch (terminator->getOp())
+            {
+                case kIROp_unconditionalBranch:
+                    block = as<IRUnconditionalBranch>(terminator)->getTargetBlock();
+                    break;
+                case kIROp_loop:
+                    block = as<IRLoop>(terminator)->getBreakBlock();
+                    break;
+                case kIROp_ifElse:
+                    block = as<IRIfElse>(terminator)->getAfterBlock();
+                    break;
+                case kIROp_Switch:
+                    block = as<IRSwitch>(terminator)->getBreakLabel();
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+
+        /// Returns true if `loop` can be unrolled, with what is needed to unroll it in `outInfo`
+    bool canUnroll(IRLoopInfo* loopInfo, IRLoopRegion* loop, UnrollInfo& outInfo)
+    {
+        IRLoop* loopInst = loop->loopInst;
+        auto loopControl = loopInst->findDecoration<IRLoopControlDecoration>();
+        if (!loopControl || loopControl->getMode() != kIRLoopControl_Unroll)
+        {
+            return false;
+        }
+
+        IRBlock* preheader = loop->getPreheader();
+        IRBlock* header = loop->getHeader();
+        IRBlock* breakBlock = loop->getBreakBlock();
+
+        // The header must test whether to run the body or leave the loop
+        auto test = as<IRIfElse>(header->getTerminator());
+        if (!test || test->getFalseBlock() != breakBlock || test->getTrueBlock() == breakBlock)
+        {
+            return false;
+        }
+
+        // The header is entered from the preheader, and from a single back edge
+        IRBlock* latch = nullptr;
+        for (auto predecessor : header->getPredecessors())
+        {
+            if (predecessor == preheader)
+            {
+                continue;
+            }
+            if (latch || !loopInfo->isInLoop(loop, predecessor))
+            {
+                return false;
+            }
+            latch = predecessor;
+        }
+        auto latchTerminator = latch ? latch->getTerminator() : nullptr;
+        if (!latchTerminator || latchTerminator->getOp() != kIROp_unconditionalBranch)
+        {
+            return false;
+        }
+
+        // The loop is only left from the header (so there is no `break`)...
+        if (breakBlock->getPredecessors().getCount() != 1)
+        {
+            return false;
+        }
+
+        // ...and a `continue` can only be at the end of the body, so each unrolled iteration
+        // can simply be followed by the next
+        IRBlock* continueBlock = loop->getContinueBlock();
+        if (continueBlock != header && continueBlock->getPredecessors().getCount() != 1)
+        {
+            return false;
+        }
+        if (!_isTopLevelPath(loopInfo, loop, test->getTrueBlock(), latch))
+        {
+            return false;
+        }
+
+        Index tripCount = 0;
+        if (!_findTripCount(loop, test, latch, tripCount))
+        {
+            return false;
+        }
+
+        Index instCount = 0;
+        for (auto block : loop->blocks)
+        {
+            for (auto inst : block->getChildren())
+            {
+                SLANG_UNUSED(inst);
+                instCount++;
+            }
+        }
+        if (tripCount * instCount > m_options.maxUnrolledInstCount)
+        {
+            return false;
+        }
+
+        outInfo.loop = loop;
+        outInfo.latch = latch;
+        outInfo.tripCount = tripCount;
+        return true;
+    }
+
+        /// Clone `inst` using `env`, keeping its source location
+    static IRInst* _cloneInst(IRCloneEnv* env, IRBuilder* builder, IRInst* inst)
+    {
+        IRInst* clonedInst = cloneInst(env, builder, inst);
+        clonedInst->sourceLoc = inst->sourceLoc;
+        return clonedInst;
+    }
+
+        /// Replace the loop described by `info` with a copy of its body for each iteration
+    void unroll(UnrollInfo const& info)
+    {
+        IRLoopRegion* loop = info.loop;
+        IRLoop* loopInst = loop->loopInst;
+        IRBlock* header = loop->getHeader();
+        IRBlock* breakBlock = loop->getBreakBlock();
+        IRBlock* latch = info.latch;
+        auto test = as<IRIfElse>(header->getTerminator());
+
+        SharedIRBuilder sharedBuilder;
+        sharedBuilder.session = m_module->getSession();
+        sharedBuilder.module = m_module;
+        IRBuilder builder;
+        builder.sharedBuilder = &sharedBuilder;
+
+        // The values of the header's parameters for the current iteration
+        List<IRInst*> paramValues;
+        for (UInt i = 0; i < loopInst->getArgCount(); ++i)
+        {
+            paramValues.add(loopInst->getArg(i));
+        }
+
+        // Each iteration starts with a copy of the header, and all of the copies are
+        // placed before the break block, in order.
+        IRBlock* clonedHeader = builder.createBlock();
+        clonedHeader->insertBefore(breakBlock);
+
+        builder.setInsertBefore(loopInst);
+        builder.emitBranch(clonedHeader);
+
+        for (Index iteration = 0; ; ++iteration)
+        {
+            IRCloneEnv env;
+            {
+                Index paramIndex = 0;
+                for (auto param : header->getParams())
+                {
+                    env.mapOldValToNew.Add(param, paramValues[paramIndex++]);
+                }
+            }
+            env.mapOldValToNew.Add(header, clonedHeader);
+
+            // After the last iteration the header's test fails, so the last copy of
+            // the header branches to the break block. The instructions in the header are
+            // the only ones of the loop that can be used after it, so they are replaced by
+            // the values they have at that point.
+            //
+            if (iteration == info.tripCount)
+            {
+                builder.setInsertInto(clonedHeader);
+                for (auto inst : header->getChildren())
+                {
+                    if (inst == test)
+                    {
+                        builder.emitBranch(breakBlock);
+                    }
+                    else if (!as<IRParam>(inst))
+                    {
+                        _cloneInst(&env, &builder, inst);
+                    }
+                }
+                for (auto inst : header->getChildren())
+                {
+                    if (auto value = lookUp(&env, inst))
+                    {
+                        inst->replaceUsesWith(value);
+                    }
+                }
+                break;
+            }
+
+            // Branches can refer to blocks later in the loop, so the clone of every block is created up front
+            List<IRBlock*> clonedBlocks;
+            clonedBlocks.add(clonedHeader);
+            for (auto block : loop->blocks)
+            {
+                if (block == header)
+                {
+                    continue;
+                }
+                IRBlock* clonedBlock = builder.createBlock();
+                clonedBlock->insertBefore(breakBlock);
+                env.mapOldValToNew.Add(block, clonedBlock);
+                clonedBlocks.add(clonedBlock);
+            }
+
+            IRBlock* nextClonedHeader = builder.createBlock();
+            List<IRInst*> nextParamValues;
+            for (auto block : loop->blocks)
+            {
+                builder.setInsertInto(as<IRBlock>(lookUp(&env, block)));
+                for (auto inst : block->getChildren())
+                {
+                    if (inst == test)
+                    {
+                        // The test passes for this iteration
+                        builder.emitBranch(as<IRBlock>(lookUp(&env, test->getTrueBlock())));
+                    }
+                    else if (block == latch && inst == latch->getTerminator())
+                    {
+                        // The arguments of the back edge are the values of the header's parameters for the next
+                        // iteration. They are looked up once the whole iteration has been cloned.
+                        auto backEdge = as<IRUnconditionalBranch>(inst);
+                        for (UInt i = 0; i < backEdge->getArgCount(); ++i)
+                        {
+                            nextParamValues.add(backEdge->getArg(i));
+                        }
+                        builder.emitBranch(nextClonedHeader);
+                    }
+                    else if (block != header || !as<IRParam>(inst))
+                    {
+                        _cloneInst(&env, &builder, inst);
+                    }
+                }
+            }
+
+            // An instruction can refer to one that comes later in the order of the blocks (such as the
+            // argument of a branch back to the header of a nested loop), which had no clone when it was cloned
+            for (auto clonedBlock : clonedBlocks)
+            {
+                for (auto inst : clonedBlock->getChildren())
+                {
+                    const UInt operandCount = inst->getOperandCount();
+                    for (UInt i = 0; i < operandCount; ++i)
+                    {
+                        if (auto clonedOperand = lookUp(&env, inst->getOperand(i)))
+                        {
+                            inst->setOperand(i, clonedOperand);
+                        }
+                    }
+                }
+            }
+
+            paramValues.clear();
+            for (auto value : nextParamValues)
+            {
+                paramValues.add(findCloneForOperand(&env, value));
+            }
+
+            nextClonedHeader->insertBefore(breakBlock);
+            clonedHeader = nextClonedHeader;
+        }
+
+        // Nothing refers to the blocks of the loop any more, other than each other and the `loop` instruction
+        loopInst->removeAndDeallocate();
+        for (auto block : loop->blocks)
+        {
+            block->removeAndDeallocateAllDecorationsAndChildren();
+        }
+        for (auto block : loop->blocks)
+        {
+            SLANG_ASSERT(!block->hasUses());
+            block->removeAndDeallocate();
+        }
+    }
+};
+
+bool UnrollLoopsPass::runOnFunction(IRPassManager* passManager, IRGlobalValueWithCode* code)
+{
+    LoopUnrollingContext context;
+    context.m_module = passManager->getModule();
+    context.m_options = m_options;
+
+    // Unrolling a loop changes the control flow graph, so the loops are found again (without caching them)
+    // before looking for another loop to unroll. Inner loops come first, so that a loop containing them
+    // is measured after they have been unrolled.
+    IRLoopInfo* loopInfo = passManager->getLoopInfo(code);
+    RefPtr<IRLoopInfo> updatedLoopInfo;
+
+    Index unrolledCount = 0;
+    for (;;)
+    {
+        LoopUnrollingContext::UnrollInfo unrollInfo;
+        for (auto loop : loopInfo->getLoops())
+        {
+            if (context.canUnroll(loopInfo, loop, unrollInfo))
+            {
+                break;
+            }
+        }
+        if (!unrollInfo.loop)
+        {
+            break;
+        }
+
+        context.unroll(unrollInfo);
+        unrolledCount++;
+
+        RefPtr<IRDominatorTree> dominatorTree = computeDominatorTree(code);
+        updatedLoopInfo = computeLoopInfo(code, dominatorTree);
+        loopInfo = updatedLoopInfo;
+    }
+
+    m_unrolledLoopCount += unrolledCount;
+    CompileInstrumentation::addCount(CompileCounter::UnrolledLoops, unrolledCount);
+    return unrolledCount != 0;
+}
+
+}
@@ -0,0 +1,70 @@
+// slang-ir-loop-opt.h
+#pragma once
+
+#include "slang-ir-pass-manager.h"
+
+namespace Slang
+{
+        /// Moves instructions out of loops, when they compute the same value on every iteration
+        /// (Loop Invariant Code Motion).
+        ///
+        /// Instructions are only moved if they compute their value from their operands alone (see
+        /// `isValueNumberable`), and all of the operands are defined outside of the loop. They are placed
+        /// before the `loop` instruction, so they are computed once even if the loop runs no iterations.
+        /// Instructions that could fail (such as integer division) are only moved from the header of the
+        /// loop, which always runs before the loop is left.
+        ///
+    class LoopInvariantCodeMotionPass : public IRFunctionPass
+    {
+    public:
+        virtual bool runOnFunction(IRPassManager* passManager, IRGlobalValueWithCode* code) SLANG_OVERRIDE;
+
+            /// Instructions are only moved between blocks, so the control flow graph (and its dominator tree) is
+            /// unchanged. The loops are still found again by the passes that follow, rather than relying on
+            /// ones found before the function was changed.
+        LoopInvariantCodeMotionPass():
+            IRFunctionPass("loop-invariant-code-motion", IRAnalysisFlag::DominatorTree | IRAnalysisFlag::Loops, IRAnalysisFlag::DominatorTree)
+        {
+        }
+    };
+
+        /// The limits on the loops unrolled by `UnrollLoopsPass`
+    struct IRLoopUnrollingOptions
+    {
+            /// Loops that run more iterations than this are not unrolled
+        Index maxTripCount = 32;
+            /// Loops whose unrolled body (the number of instructions in the loop times the number of
+            /// iterations) would be larger than this are not unrolled
+        Index maxUnrolledInstCount = 1024;
+    };
+
+        /// Fully unrolls loops marked `[unroll]` that run a number of iterations known at compile time.
+        ///
+        /// The number of iterations is found for loops that test a counter against a constant in their
+        /// header, where the counter starts from a constant and is incremented (or decremented) by a
+        /// constant on each iteration. So that the unrolled code still has structured control flow, the
+        /// loop must only be left from its header (so has no `break`), and a `continue` can only be at the
+        /// end of the body.
+        ///
+        /// The unrolled iterations leave behind constants to propagate, so the pass should be followed
+        /// by SCCP and DCE.
+        ///
+    class UnrollLoopsPass : public IRFunctionPass
+    {
+    public:
+        virtual bool runOnFunction(IRPassManager* passManager, IRGlobalValueWithCode* code) SLANG_OVERRIDE;
+
+            /// The number of loops unrolled by the pass so far
+        Index getUnrolledLoopCount() const { return m_unrolledLoopCount; }
+
+        UnrollLoopsPass(IRLoopUnrollingOptions const& options):
+            IRFunctionPass("unroll-loops", IRAnalysisFlag::Loops, IRAnalysisFlag::None),
+            m_options(options)
+        {
+        }
+
+    protected:
+        IRLoopUnrollingOptions m_options;
+        Index m_unrolledLoopCount = 0;
+    };
+}
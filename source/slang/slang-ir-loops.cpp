@@ -0,0 +1,132 @@
+// slang-ir-loops.cpp
+#include "slang-ir-loops.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-dominators.h"
+
+namespace Slang
+{
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRLoopRegion !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+IRBlock* IRLoopRegion::getPreheader()
+{
+    return as<IRBlock>(loopInst->getParent());
+}
+
+IRBlock* IRLoopRegion::getHeader()
+{
+    return loopInst->getTargetBlock();
+}
+
+IRBlock* IRLoopRegion::getBreakBlock()
+{
+    return loopInst->getBreakBlock();
+}
+
+IRBlock* IRLoopRegion::getContinueBlock()
+{
+    return loopInst->getContinueBlock();
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRLoopInfo !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+IRLoopRegion* IRLoopInfo::getLoopForBlock(IRBlock* block)
+{
+    IRLoopRegion** loop = m_mapBlockToLoop.TryGetValue(block);
+    return loop ? *loop : nullptr;
+}
+
+bool IRLoopInfo::isInLoop(IRLoopRegion* loop, IRBlock* block)
+{
+    for (IRLoopRegion* blockLoop = getLoopForBlock(block); blockLoop; blockLoop = blockLoop->parent)
+    {
+        if (blockLoop == loop)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+RefPtr<IRLoopInfo> computeLoopInfo(IRGlobalValueWithCode* code, IRDominatorTree* dominatorTree)
+{
+    RefPtr<IRLoopInfo> loopInfo = new IRLoopInfo;
+
+    // The index of each block in the function, so the blocks of a loop can be put in the same order
+    Dictionary<IRBlock*, Index> blockIndices;
+    List<RefPtr<IRLoopRegion>> loops;
+    for (auto block : code->getBlocks())
+    {
+        blockIndices.Add(block, Index(blockIndices.Count()));
+
+        // The op is checked, as `as<IRLoop>` would also accept any other unconditional branch
+        auto terminator = block->getTerminator();
+        if (!terminator || terminator->getOp() != kIROp_loop || dominatorTree->isUnreachable(block))
+        {
+            continue;
+        }
+
+        RefPtr<IRLoopRegion> loop = new IRLoopRegion;
+        loop->loopInst = static_cast<IRLoop*>(terminator);
+        loops.add(loop);
+    }
+
+    for (auto loop : loops)
+    {
+        // The blocks of the loop are found by following the control flow from the header, up to the break block.
+        // As the control flow is structured they are all dominated by the header, which is checked so that
+        // malformed IR can't make a loop escape into the rest of the function. The preheader is never part
+        // of the loop, as instructions are moved out of the loop into it.
+        IRBlock* preheader = loop->getPreheader();
+        IRBlock* header = loop->getHeader();
+        IRBlock* breakBlock = loop->getBreakBlock();
+
+        HashSet<IRBlock*> visited;
+        List<IRBlock*> workList;
+        visited.Add(header);
+        workList.add(header);
+        while (workList.getCount())
+        {
+            IRBlock* block = workList.getLast();
+            workList.removeLast();
+            loop->blocks.add(block);
+
+            for (auto successor : block->getSuccessors())
+            {
+                if (!successor || successor == breakBlock || successor == preheader || !dominatorTree->dominates(header, successor))
+                {
+                    continue;
+                }
+                if (visited.Add(successor))
+                {
+                    workList.add(successor);
+                }
+            }
+        }
+
+        loop->blocks.sort([&](IRBlock* a, IRBlock* b) { return blockIndices[a] < blockIndices[b]; });
+    }
+
+    // A loop that contains another has more blocks, so visiting the loops from largest to smallest visits
+    // a loop after any that contain it. The innermost loop of each block is then the last one seen.
+    loops.sort([](const RefPtr<IRLoopRegion>& a, const RefPtr<IRLoopRegion>& b) { return a->blocks.getCount() > b->blocks.getCount(); });
+    for (auto loop : loops)
+    {
+        loop->parent = loopInfo->getLoopForBlock(loop->getHeader());
+        for (auto block : loop->blocks)
+        {
+            loopInfo->m_mapBlockToLoop[block] = loop;
+        }
+    }
+
+    for (Index i = loops.getCount() - 1; i >= 0; --i)
+    {
+        loopInfo->m_loops.add(loops[i]);
+    }
+
+    return loopInfo;
+}
+
+}
@@ -0,0 +1,60 @@
+// slang-ir-loops.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+    struct IRBlock;
+    struct IRDominatorTree;
+    struct IRGlobalValueWithCode;
+    struct IRLoop;
+
+        /// A loop in an IR control flow graph, as introduced by a `loop` instruction.
+        ///
+        /// The blocks of the loop are those reachable from its header without passing through the
+        /// break block (or back through the header). The header dominates them all.
+        ///
+    struct IRLoopRegion : public RefObject
+    {
+            /// The `loop` instruction that enters the loop. It is the terminator of the preheader.
+        IRLoop* loopInst = nullptr;
+
+            /// The innermost loop that contains this one, or nullptr
+        IRLoopRegion* parent = nullptr;
+
+            /// The blocks of the loop, in the order they appear in the function. The header is first.
+        List<IRBlock*> blocks;
+
+            /// The block that ends with `loopInst`. It is not part of the loop.
+        IRBlock* getPreheader();
+            /// The block that starts each iteration of the loop
+        IRBlock* getHeader();
+            /// The block after the loop, targeted by a `break`
+        IRBlock* getBreakBlock();
+            /// The block targeted by a `continue`. This is the header for a `while` loop.
+        IRBlock* getContinueBlock();
+    };
+
+        /// The loops of a function (or other value with code), and how they are nested.
+    struct IRLoopInfo : public RefObject
+    {
+            /// The loops, ordered so that a loop comes before any loop that contains it
+        const List<RefPtr<IRLoopRegion>>& getLoops() const { return m_loops; }
+
+            /// Get the innermost loop containing `block`, or nullptr if it isn't within a loop
+        IRLoopRegion* getLoopForBlock(IRBlock* block);
+
+            /// Is `block` one of the blocks of `loop` (including those of loops nested within it)?
+        bool isInLoop(IRLoopRegion* loop, IRBlock* block);
+
+    protected:
+        friend RefPtr<IRLoopInfo> computeLoopInfo(IRGlobalValueWithCode* code, IRDominatorTree* dominatorTree);
+
+        List<RefPtr<IRLoopRegion>> m_loops;
+        Dictionary<IRBlock*, IRLoopRegion*> m_mapBlockToLoop;
+    };
+
+        /// Find the loops of `code`. `dominatorTree` must be the dominator tree of `code`.
+    RefPtr<IRLoopInfo> computeLoopInfo(IRGlobalValueWithCode* code, IRDominatorTree* dominatorTree);
+}
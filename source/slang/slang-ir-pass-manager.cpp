@@ -0,0 +1,364 @@
+// slang-ir-pass-manager.cpp
+#include "slang-ir-pass-manager.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+RefPtr<IRUseCounts> computeUseCounts(IRGlobalValueWithCode* code)
+{
+    RefPtr<IRUseCounts> useCounts = new IRUseCounts;
+    for (auto block : code->getBlocks())
+    {
+        // The children of a block are its parameters followed by its ordinary instructions
+        for (auto inst : block->getChildren())
+        {
+            Index count = 0;
+            for (IRUse* use = inst->firstUse; use; use = use->nextUse)
+            {
+                count++;
+            }
+            useCounts->counts.Add(inst, count);
+        }
+    }
+    return useCounts;
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRCallGraph !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+const List<IRCall*>& IRCallGraph::getCallSites(IRGlobalValueWithCode* code)
+{
+    return m_passManager->_getCallSites(code);
+}
+
+const List<IRCall*>& IRCallGraph::getCallers(IRFunc* func)
+{
+    const List<IRCall*>* callers = m_callers.TryGetValue(func);
+    return callers ? *callers : m_emptyCalls;
+}
+
+void IRCallGraph::_addBottomUpOrderRec(IRFunc* func, HashSet<IRFunc*>& visited)
+{
+    if (!visited.Add(func))
+    {
+        return;
+    }
+    for (auto call : getCallSites(func))
+    {
+        if (auto callee = as<IRFunc>(call->getCallee()))
+        {
+            _addBottomUpOrderRec(callee, visited);
+        }
+    }
+    m_bottomUpOrder.add(func);
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRPassManager !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+IRPassManager::ModulePassScope::ModulePassScope(IRPassManager* passManager, const char* name, IRAnalysisFlags preservedAnalyses):
+    m_passManager(passManager),
+    m_preservedAnalyses(preservedAnalyses),
+    m_instCount(passManager->_countInsts()),
+    m_passScope(passManager->m_instrumentation, name)
+{
+}
+
+IRPassManager::ModulePassScope::~ModulePassScope()
+{
+    // Counting the instructions isn't part of the pass
+    m_passScope.end();
+
+    if (auto instrumentation = m_passManager->m_instrumentation)
+    {
+        if (instrumentation->getFlags() & CompileInstrumentation::Flag::IRSize)
+        {
+            instrumentation->addPassIRInstDelta(m_passScope, m_passManager->_countInsts() - m_instCount);
+        }
+    }
+
+    if (!m_invalidatesChangedFuncs)
+    {
+        m_passManager->invalidateAll(m_preservedAnalyses);
+    }
+}
+
+IRPassManager::IRPassManager(IRModule* module, CompileInstrumentation* instrumentation):
+    m_module(module),
+    m_instrumentation(instrumentation)
+{
+    m_callGraph.m_passManager = this;
+}
+
+Index IRPassManager::_countInsts() const
+{
+    // Only count when the change in size will be recorded, as it requires visiting the whole module
+    if (!m_instrumentation || (m_instrumentation->getFlags() & CompileInstrumentation::Flag::IRSize) == 0)
+    {
+        return 0;
+    }
+
+    Index count = 0;
+    List<IRInst*> workList;
+    workList.add(m_module->getModuleInst());
+    while (workList.getCount())
+    {
+        IRInst* inst = workList.getLast();
+        workList.removeLast();
+
+        count++;
+        for (auto child : inst->getDecorationsAndChildren())
+        {
+            workList.add(child);
+        }
+    }
+    return count;
+}
+
+bool IRPassManager::_isRequired(IRAnalysisFlags analyses) const
+{
+    return (m_availableAnalyses & analyses) == analyses;
+}
+
+IRPassManager::FuncAnalyses& IRPassManager::_getFuncAnalyses(IRGlobalValueWithCode* code)
+{
+    FuncAnalyses* analyses = m_funcAnalyses.TryGetValue(code);
+    if (!analyses)
+    {
+        m_funcAnalyses.Add(code, FuncAnalyses());
+        analyses = m_funcAnalyses.TryGetValue(code);
+    }
+    return *analyses;
+}
+
+Index IRPassManager::_getVersion(IRGlobalValueWithCode* code)
+{
+    const FuncAnalyses* analyses = m_funcAnalyses.TryGetValue(code);
+    return (analyses && analyses->version > m_moduleVersion) ? analyses->version : m_moduleVersion;
+}
+
+const List<IRCall*>& IRPassManager::_getCallSites(IRGlobalValueWithCode* code)
+{
+    FuncAnalyses& analyses = _getFuncAnalyses(code);
+    if (!analyses.hasCallSites)
+    {
+        analyses.callSites.clear();
+        for (auto block : code->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                if (auto call = as<IRCall>(inst))
+                {
+                    analyses.callSites.add(call);
+                }
+            }
+        }
+        analyses.hasCallSites = true;
+    }
+    return analyses.callSites;
+}
+
+IRDominatorTree* IRPassManager::getDominatorTree(IRGlobalValueWithCode* code)
+{
+    SLANG_ASSERT(_isRequired(IRAnalysisFlag::DominatorTree));
+
+    FuncAnalyses& analyses = _getFuncAnalyses(code);
+    if (!analyses.dominatorTree)
+    {
+        analyses.dominatorTree = computeDominatorTree(code);
+    }
+    return analyses.dominatorTree;
+}
+
+IRLoopInfo* IRPassManager::getLoopInfo(IRGlobalValueWithCode* code)
+{
+    SLANG_ASSERT(_isRequired(IRAnalysisFlag::Loops));
+
+    FuncAnalyses& analyses = _getFuncAnalyses(code);
+    if (!analyses.loopInfo)
+    {
+        // The loops are found from the dominator tree, which is cached too (even if the pass doesn't require it)
+        if (!analyses.dominatorTree)
+        {
+            analyses.dominatorTree = computeDominatorTree(code);
+        }
+        analyses.loopInfo = computeLoopInfo(code, analyses.dominatorTree);
+    }
+    return analyses.loopInfo;
+}
+
+IRUseCounts* IRPassManager::getUseCounts(IRGlobalValueWithCode* code)
+{
+    SLANG_ASSERT(_isRequired(IRAnalysisFlag::UseCounts));
+
+    FuncAnalyses& analyses = _getFuncAnalyses(code);
+    if (!analyses.useCounts)
+    {
+        analyses.useCounts = computeUseCounts(code);
+    }
+    return analyses.useCounts;
+}
+
+IRCallGraph* IRPassManager::getCallGraph()
+{
+    SLANG_ASSERT(_isRequired(IRAnalysisFlag::CallGraph));
+
+    if (!m_isCallGraphValid)
+    {
+        // The call sites of functions that haven't changed are still cached, so only the changed functions
+        // are visited again
+        m_callGraph.m_callers.Clear();
+        m_callGraph.m_bottomUpOrder.clear();
+
+        for (auto inst : m_module->getGlobalInsts())
+        {
+            auto code = as<IRGlobalValueWithCode>(inst);
+            if (!code)
+            {
+                continue;
+            }
+            for (auto call : _getCallSites(code))
+            {
+                if (auto callee = as<IRFunc>(call->getCallee()))
+                {
+                    List<IRCall*>* callers = m_callGraph.m_callers.TryGetValue(callee);
+                    if (!callers)
+                    {
+                        m_callGraph.m_callers.Add(callee, List<IRCall*>());
+                        callers = m_callGraph.m_callers.TryGetValue(callee);
+                    }
+                    callers->add(call);
+                }
+            }
+        }
+
+        HashSet<IRFunc*> visited;
+        for (auto inst : m_module->getGlobalInsts())
+        {
+            if (auto func = as<IRFunc>(inst))
+            {
+                m_callGraph._addBottomUpOrderRec(func, visited);
+            }
+        }
+
+        m_isCallGraphValid = true;
+    }
+    return &m_callGraph;
+}
+
+void IRPassManager::invalidate(IRGlobalValueWithCode* code, IRAnalysisFlags preservedAnalyses)
+{
+    FuncAnalyses& analyses = _getFuncAnalyses(code);
+    if ((preservedAnalyses & IRAnalysisFlag::DominatorTree) == 0)
+    {
+        analyses.dominatorTree.setNull();
+    }
+    if ((preservedAnalyses & IRAnalysisFlag::UseCounts) == 0)
+    {
+        analyses.useCounts.setNull();
+    }
+    // The loops are found from the dominator tree, so they are invalidated along with it
+    if ((preservedAnalyses & IRAnalysisFlag::Loops) == 0 || !analyses.dominatorTree)
+    {
+        analyses.loopInfo.setNull();
+    }
+    if ((preservedAnalyses & IRAnalysisFlag::CallGraph) == 0)
+    {
+        analyses.hasCallSites = false;
+        m_isCallGraphValid = false;
+    }
+    analyses.version = m_nextVersion++;
+}
+
+void IRPassManager::invalidateAll(IRAnalysisFlags preservedAnalyses)
+{
+    if (preservedAnalyses == IRAnalysisFlag::None)
+    {
+        m_funcAnalyses.Clear();
+        m_isCallGraphValid = false;
+    }
+    else
+    {
+        for (auto& pair : m_funcAnalyses)
+        {
+            invalidate(pair.Key, preservedAnalyses);
+        }
+    }
+    m_moduleVersion = m_nextVersion++;
+}
+
+void IRPassManager::runFunctionPass(IRFunctionPass* pass)
+{
+    const Index instCount = _countInsts();
+    CompileInstrumentation::PassScope passScope(m_instrumentation, pass->getName());
+
+    m_availableAnalyses = pass->getRequiredAnalyses();
+
+    // Functions can be added by the pass, but they are not visited
+    List<IRGlobalValueWithCode*> codes;
+    for (auto inst : m_module->getGlobalInsts())
+    {
+        if (auto code = as<IRGlobalValueWithCode>(inst))
+        {
+            codes.add(code);
+        }
+    }
+
+    for (auto code : codes)
+    {
+        // There is nothing to transform in a declaration
+        if (!code->getFirstBlock())
+        {
+            continue;
+        }
+
+        // If the pass left the function unchanged, and nothing has changed it since, the pass would do nothing
+        const Index version = _getVersion(code);
+        Index* unchangedVersion = pass->m_unchangedVersions.TryGetValue(code);
+        if (unchangedVersion && *unchangedVersion == version)
+        {
+            continue;
+        }
+
+        // The required analyses are computed before the pass runs, so they are of the function before it
+        // is changed by the pass
+        const IRAnalysisFlags requiredAnalyses = pass->getRequiredAnalyses();
+        if (requiredAnalyses & IRAnalysisFlag::DominatorTree)
+        {
+            getDominatorTree(code);
+        }
+        if (requiredAnalyses & IRAnalysisFlag::UseCounts)
+        {
+            getUseCounts(code);
+        }
+        if (requiredAnalyses & IRAnalysisFlag::Loops)
+        {
+            getLoopInfo(code);
+        }
+        if (requiredAnalyses & IRAnalysisFlag::CallGraph)
+        {
+            getCallGraph();
+        }
+
+        if (pass->runOnFunction(this, code))
+        {
+            invalidate(code, pass->getPreservedAnalyses());
+            pass->m_unchangedVersions.Remove(code);
+        }
+        else
+        {
+            pass->m_unchangedVersions[code] = version;
+        }
+    }
+
+    m_availableAnalyses = IRAnalysisFlag::All;
+
+    passScope.end();
+    if (m_instrumentation && (m_instrumentation->getFlags() & CompileInstrumentation::Flag::IRSize))
+    {
+        m_instrumentation->addPassIRInstDelta(passScope, _countInsts() - instCount);
+    }
+}
+
+}
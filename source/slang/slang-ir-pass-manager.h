@@ -0,0 +1,209 @@
+// slang-ir-pass-manager.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+#include "slang-compile-instrumentation.h"
+#include "slang-ir-dominators.h"
+#include "slang-ir-loops.h"
+
+namespace Slang
+{
+    struct IRCall;
+    struct IRFunc;
+    struct IRGlobalValueWithCode;
+    struct IRInst;
+    struct IRModule;
+
+    class IRPassManager;
+
+        /// The analyses of the IR that are cached by an `IRPassManager`
+    typedef uint32_t IRAnalysisFlags;
+    struct IRAnalysisFlag
+    {
+        enum Enum : IRAnalysisFlags
+        {
+            None            = 0,
+            DominatorTree   = 0x1,      ///< The dominator tree of each function, see `IRDominatorTree`
+            UseCounts       = 0x2,      ///< The number of uses of each instruction of each function, see `IRUseCounts`
+            CallGraph       = 0x4,      ///< The calls made by each function, and the calls of each function, see `IRCallGraph`
+            Loops           = 0x8,      ///< The loops of each function, see `IRLoopInfo`. Built on the dominator tree.
+            All             = 0xf,
+        };
+    };
+
+        /// The number of uses of each instruction (including parameters) of a function
+    struct IRUseCounts : public RefObject
+    {
+            /// The number of uses of `inst`. Zero if it isn't an instruction of the function.
+        Index getUseCount(IRInst* inst) const
+        {
+            const Index* count = counts.TryGetValue(inst);
+            return count ? *count : 0;
+        }
+
+        Dictionary<IRInst*, Index> counts;
+    };
+
+    RefPtr<IRUseCounts> computeUseCounts(IRGlobalValueWithCode* code);
+
+        /// The direct calls between the functions of a module.
+        ///
+        /// Only calls whose callee is an `IRFunc` are included, so calls through witness tables,
+        /// of intrinsics and of unspecialized generics have no edge.
+        ///
+    struct IRCallGraph
+    {
+            /// The calls made in `code`, in order
+        const List<IRCall*>& getCallSites(IRGlobalValueWithCode* code);
+
+            /// The calls of `func`
+        const List<IRCall*>& getCallers(IRFunc* func);
+
+            /// The functions of the module, ordered so that (except for recursive calls) a function
+            /// comes after all of the functions it calls
+        const List<IRFunc*>& getBottomUpOrder() { return m_bottomUpOrder; }
+
+    protected:
+        friend class IRPassManager;
+
+        void _addBottomUpOrderRec(IRFunc* func, HashSet<IRFunc*>& visited);
+
+        IRPassManager* m_passManager = nullptr;
+
+        Dictionary<IRFunc*, List<IRCall*>> m_callers;
+        List<IRFunc*> m_bottomUpOrder;
+
+        List<IRCall*> m_emptyCalls;
+    };
+
+        /// A pass that transforms one function at a time, run by an `IRPassManager`.
+        ///
+        /// The analyses the pass uses are declared as `requiredAnalyses`, and are computed (or found in the
+        /// cache) before the pass runs on each function. The analyses a pass doesn't invalidate when it changes a
+        /// function are declared as `preservedAnalyses`.
+        ///
+        /// A pass is expected to reach a fixed point, so running it again on a function it left unchanged,
+        /// that nothing has changed since, is skipped.
+        ///
+    class IRFunctionPass
+    {
+    public:
+            /// Run the pass on `code`. Returns true if the function was changed.
+        virtual bool runOnFunction(IRPassManager* passManager, IRGlobalValueWithCode* code) = 0;
+
+        IRFunctionPass(const char* name, IRAnalysisFlags requiredAnalyses, IRAnalysisFlags preservedAnalyses):
+            m_name(name),
+            m_requiredAnalyses(requiredAnalyses),
+            m_preservedAnalyses(preservedAnalyses)
+        {
+        }
+        virtual ~IRFunctionPass() {}
+
+        const char* getName() const { return m_name; }
+        IRAnalysisFlags getRequiredAnalyses() const { return m_requiredAnalyses; }
+        IRAnalysisFlags getPreservedAnalyses() const { return m_preservedAnalyses; }
+
+    protected:
+        friend class IRPassManager;
+
+        const char* m_name;
+        IRAnalysisFlags m_requiredAnalyses;
+        IRAnalysisFlags m_preservedAnalyses;
+
+            /// For each function the pass last left unchanged, the version of the function at the time
+        Dictionary<IRGlobalValueWithCode*, Index> m_unchangedVersions;
+    };
+
+        /// Runs passes over an IR module, and caches the analyses they use.
+        ///
+        /// Analyses are cached per function, so when a function pass changes a function only the analyses of
+        /// that function (that the pass doesn't preserve) are invalidated.
+        ///
+        /// Passes that work on the whole module (such as `eliminateDeadCode`) are run within a `ModulePassScope`,
+        /// and are assumed to change every function.
+        ///
+        /// Each pass is timed by the `CompileInstrumentation` (if there is one). If it has
+        /// `CompileInstrumentation::Flag::IRSize` set, the number of instructions in the module is also counted
+        /// before and after each pass, so the change in size can be reported.
+        ///
+    class IRPassManager
+    {
+    public:
+            /// Runs a pass that transforms the whole module for the lifetime of the scope
+        struct ModulePassScope
+        {
+            ModulePassScope(IRPassManager* passManager, const char* name, IRAnalysisFlags preservedAnalyses = IRAnalysisFlag::None);
+            ~ModulePassScope();
+
+                /// The pass invalidates the functions it changes itself (with `IRPassManager::invalidate`), so the
+                /// other functions are left valid at the end of the scope
+            void setInvalidatesChangedFuncs() { m_invalidatesChangedFuncs = true; }
+
+            IRPassManager* m_passManager;
+            IRAnalysisFlags m_preservedAnalyses;
+            Index m_instCount = 0;
+            bool m_invalidatesChangedFuncs = false;
+            CompileInstrumentation::PassScope m_passScope;
+        };
+
+            /// Run `pass` on each function (and other value with code) in the module
+        void runFunctionPass(IRFunctionPass* pass);
+
+            /// Get the dominator tree of `code`. The current pass must require `IRAnalysisFlag::DominatorTree`.
+        IRDominatorTree* getDominatorTree(IRGlobalValueWithCode* code);
+            /// Get the use counts of `code`. The current pass must require `IRAnalysisFlag::UseCounts`.
+        IRUseCounts* getUseCounts(IRGlobalValueWithCode* code);
+            /// Get the call graph of the module. The current pass must require `IRAnalysisFlag::CallGraph`.
+        IRCallGraph* getCallGraph();
+            /// Get the loops of `code`. The current pass must require `IRAnalysisFlag::Loops`.
+        IRLoopInfo* getLoopInfo(IRGlobalValueWithCode* code);
+
+            /// Invalidate the analyses of `code` other than `preservedAnalyses`, because it has been changed
+        void invalidate(IRGlobalValueWithCode* code, IRAnalysisFlags preservedAnalyses = IRAnalysisFlag::None);
+            /// Invalidate the analyses of every function other than `preservedAnalyses`
+        void invalidateAll(IRAnalysisFlags preservedAnalyses = IRAnalysisFlag::None);
+
+        IRModule* getModule() const { return m_module; }
+        CompileInstrumentation* getInstrumentation() const { return m_instrumentation; }
+
+            /// Ctor. `instrumentation` can be nullptr.
+        IRPassManager(IRModule* module, CompileInstrumentation* instrumentation);
+
+    protected:
+        friend struct IRCallGraph;
+
+        struct FuncAnalyses
+        {
+            RefPtr<IRDominatorTree> dominatorTree;
+            RefPtr<IRUseCounts> useCounts;
+            RefPtr<IRLoopInfo> loopInfo;
+            List<IRCall*> callSites;
+            bool hasCallSites = false;
+
+                /// Set to a new value each time the function is changed
+            Index version = 0;
+        };
+
+        FuncAnalyses& _getFuncAnalyses(IRGlobalValueWithCode* code);
+        Index _getVersion(IRGlobalValueWithCode* code);
+        const List<IRCall*>& _getCallSites(IRGlobalValueWithCode* code);
+        bool _isRequired(IRAnalysisFlags analyses) const;
+        Index _countInsts() const;
+
+        IRModule* m_module;
+        CompileInstrumentation* m_instrumentation;
+
+        Dictionary<IRGlobalValueWithCode*, FuncAnalyses> m_funcAnalyses;
+
+            /// The version of every function after the last pass that changed the whole module
+        Index m_moduleVersion = 0;
+        Index m_nextVersion = 1;
+
+        IRCallGraph m_callGraph;
+        bool m_isCallGraphValid = false;
+
+            /// The analyses the currently running pass can use
+        IRAnalysisFlags m_availableAnalyses = IRAnalysisFlag::All;
+    };
+}
@@ -497,7 +497,13 @@ struct SCCPContext
                         // Whatever single block we decided will get executed,
                         // we need to make sure it gets processed and then bail.
                         //
-                        cfgWorkList.add(target);
+                        // Note: a `switch` created for dynamic dispatch over
+                        // no types at all has no `default` label.
+                        //
+                        if( target )
+                        {
+                            cfgWorkList.add(target);
+                        }
                         return;
                     }
                 }
@@ -509,7 +515,10 @@ struct SCCPContext
                 {
                     cfgWorkList.add(switchInst->getCaseLabel(cc));
                 }
-                cfgWorkList.add(switchInst->getDefaultLabel());
+                if( auto defaultLabel = switchInst->getDefaultLabel() )
+                {
+                    cfgWorkList.add(defaultLabel);
+                }
             }
 
             // There are other cases of terminator instructions not handled
@@ -783,9 +792,12 @@ struct SCCPContext
                     // branch to it before the old terminator, and then remove
                     // the old terminator instruction.
                     //
-                    builder->setInsertBefore(terminator);
-                    builder->emitBranch(target);
-                    terminator->removeAndDeallocate();
+                    if( target )
+                    {
+                        builder->setInsertBefore(terminator);
+                        builder->emitBranch(target);
+                        terminator->removeAndDeallocate();
+                    }
                 }
             }
             else if(auto condBranchInst = as<IRConditionalBranch>(terminator))
@@ -4,6 +4,7 @@
 #include "slang-ir.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
+#include "slang-compile-instrumentation.h"
 
 namespace Slang
 {
@@ -1007,6 +1008,7 @@ struct SpecializationContext
             // will go ahead and create one, and then register it in our cache.
             //
             specializedCallee = createExistentialSpecializedFunc(inst, calleeFunc);
+            CompileInstrumentation::addCount(CompileCounter::Specializations);
             existentialSpecializedFuncs.Add(key, specializedCallee);
         }
 
@@ -2096,6 +2098,8 @@ IRInst* specializeGenericImpl(
     // the concrete arguments that were provided
     // by the `specialize(...)` instruction.
     //
+    CompileInstrumentation::addCount(CompileCounter::Specializations);
+
     IRCloneEnv      env;
 
     // We will walk through the parameters of the generic and
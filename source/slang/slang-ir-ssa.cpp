@@ -993,7 +993,8 @@ bool IREdge::isCritical() const
     return true;
 }
 
-static void breakCriticalEdges(
+    /// Break the critical edges of the CFG. Returns true if there were any.
+static bool breakCriticalEdges(
     ConstructSSAContext*    context)
 {
     auto globalVal = context->globalVal;
@@ -1037,23 +1038,24 @@ static void breakCriticalEdges(
     {
         context->sharedBuilder.insertBlockAlongEdge(edge);
     }
+    return criticalEdges.getCount() != 0;
 }
 
 // Construct SSA form for a global value with code
-void constructSSA(ConstructSSAContext* context)
+bool constructSSA(ConstructSSAContext* context)
 {
     // First, detect and and break any critical edges in the CFG,
     // because our representation of SSA form doesn't allow for them.
-    breakCriticalEdges(context);
+    const bool brokeCriticalEdges = breakCriticalEdges(context);
 
     // Figure out what variables we can promote to
     // SSA temporaries.
     identifyPromotableVars(context);
 
     // If none of the variables are promote-able,
-    // then we can exit without making any changes
+    // then we can exit without making any further changes
     if (context->promotableVars.getCount() == 0)
-        return;
+        return brokeCriticalEdges;
 
     // We are going to walk the blocks in order,
     // and try to process each, by replacing loads
@@ -1185,10 +1187,11 @@ void constructSSA(ConstructSSAContext* context)
     {
         var->removeAndDeallocate();
     }
+    return true;
 }
 
 // Construct SSA form for a global value with code
-void constructSSA(IRModule* module, IRGlobalValueWithCode* globalVal)
+bool constructSSA(IRModule* module, IRGlobalValueWithCode* globalVal)
 {
     ConstructSSAContext context;
     context.globalVal = globalVal;
@@ -1199,7 +1202,7 @@ void constructSSA(IRModule* module, IRGlobalValueWithCode* globalVal)
     context.builder.sharedBuilder = &context.sharedBuilder;
     context.builder.setInsertInto(module->moduleInst);
 
-    constructSSA(&context);
+    return constructSSA(&context);
 }
 
 void constructSSA(IRModule* module, IRInst* globalVal)
@@ -1223,4 +1226,17 @@ void constructSSA(IRModule* module)
     }
 }
 
+bool ConstructSSAPass::runOnFunction(IRPassManager* passManager, IRGlobalValueWithCode* code)
+{
+    switch (code->getOp())
+    {
+    case kIROp_Func:
+    case kIROp_GlobalVar:
+        return constructSSA(passManager->getModule(), code);
+
+    default:
+        return false;
+    }
+}
+
 }
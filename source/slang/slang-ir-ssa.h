@@ -1,9 +1,29 @@
 // slang-ir-ssa.h
 #pragma once
 
+#include "slang-ir-pass-manager.h"
+
 namespace Slang
 {
+    struct IRGlobalValueWithCode;
     struct IRModule;
 
+        /// Promote the local variables of `globalVal` to SSA temporaries where possible.
+        /// Returns true if `globalVal` was changed.
+    bool constructSSA(IRModule* module, IRGlobalValueWithCode* globalVal);
+
     void constructSSA(IRModule* module);
+
+        /// Runs `constructSSA` on each function (and global variable with an initializer)
+    class ConstructSSAPass : public IRFunctionPass
+    {
+    public:
+        virtual bool runOnFunction(IRPassManager* passManager, IRGlobalValueWithCode* code) SLANG_OVERRIDE;
+
+            /// Breaking critical edges changes the control flow graph, but calls are left alone
+        ConstructSSAPass():
+            IRFunctionPass("construct-ssa", IRAnalysisFlag::None, IRAnalysisFlag::CallGraph)
+        {
+        }
+    };
 }
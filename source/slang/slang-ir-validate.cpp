@@ -60,7 +60,7 @@ namespace Slang
             // We need to check the integrity of the parent/next/prev links of
             // all of our instructions
             validate(context, child->parent == parent,  child, "parent link");
-            validate(context, child->prev == prevChild, child, "next/prev link");
+            validate(context, child->getPrevInst() == prevChild, child, "next/prev link");
 
             // Recursively validate the instruction itself.
             validateIRInst(context, child);
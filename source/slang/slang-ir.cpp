@@ -5,6 +5,7 @@
 #include "../core/slang-basic.h"
 
 #include "slang-mangle.h"
+#include "slang-compile-instrumentation.h"
 
 namespace Slang
 {
@@ -1322,6 +1323,7 @@ namespace Slang
 
         SLANG_ASSERT(module);
         IRInst* inst = (IRInst*)module->memoryArena.allocateAndZero(size);
+        CompileInstrumentation::addCount(CompileCounter::IRInstsCreated);
 
         inst->operandCount = uint32_t(totalArgCount);
         inst->m_op = op;
@@ -1338,6 +1340,7 @@ namespace Slang
 
         SLANG_ASSERT(module);
         IRInst* inst = (IRInst*)module->memoryArena.allocateAndZero(totalSizeInBytes);
+        CompileInstrumentation::addCount(CompileCounter::IRInstsCreated);
 
         inst->operandCount = 0;
         inst->m_op = op;
@@ -1618,6 +1621,7 @@ namespace Slang
 
         SLANG_ASSERT(module);
         T* inst = (T*)module->memoryArena.allocateAndZero(size);
+        CompileInstrumentation::addCount(CompileCounter::IRInstsCreated);
 
         // TODO: Do we need to run ctor after zeroing?
         new(inst)T();
@@ -1672,6 +1676,7 @@ namespace Slang
     {
         auto module = builder->getModule();
         IRInst* inst = (IRInst*)module->memoryArena.allocate(sizeInBytes);
+        CompileInstrumentation::addCount(CompileCounter::IRInstsCreated);
         // Zero only the 'type'
         memset(inst, 0, sizeof(IRInst));
         // TODO: Do we need to run ctor after zeroing?
@@ -5420,25 +5425,36 @@ namespace Slang
         SLANG_ASSERT(!inPrev || (inPrev->getNextInst() == inNext) && (inPrev->getParent() == inParent));
         SLANG_ASSERT(!inNext || (inNext->getPrevInst() == inPrev) && (inNext->getParent() == inParent));
 
-        if( inPrev )
+        // NOTE! The `prev` link of the first child refers to the last child, so that
+        // the parent doesn't need to store it.
+        if (inNext)
         {
-            inPrev->next = this;
+            // We take over the `prev` link of `inNext`, which is either `inPrev`,
+            // or if `inNext` was the first child, the last child.
+            this->prev = inNext->prev;
+            inNext->prev = this;
+        }
+        else if (auto first = inParent->m_firstDecorationOrChild)
+        {
+            // We are the new last child
+            this->prev = inPrev;
+            first->prev = this;
         }
         else
         {
-            inParent->m_decorationsAndChildren.first = this;
+            // We are the only child, so also the last child
+            this->prev = this;
         }
 
-        if (inNext)
+        if( inPrev )
         {
-            inNext->prev = this;
+            inPrev->next = this;
         }
         else
         {
-            inParent->m_decorationsAndChildren.last = this;
+            inParent->m_firstDecorationOrChild = this;
         }
 
-        this->prev = inPrev;
         this->next = inNext;
         this->parent = inParent;
     }
@@ -5485,17 +5501,20 @@ namespace Slang
         }
         else
         {
-            oldParent->m_decorationsAndChildren.first = nn;
+            oldParent->m_firstDecorationOrChild = nn;
         }
 
         if(nn)
         {
             SLANG_ASSERT(nn->getParent() == oldParent);
-            nn->prev = pp;
+            // If we were the first child, our `prev` link refers to the last child,
+            // and `nn` is the new first child, so it takes it over.
+            nn->prev = prev;
         }
-        else
+        else if (auto first = oldParent->m_firstDecorationOrChild)
         {
-            oldParent->m_decorationsAndChildren.last = pp;
+            // We were the last child, so the first child's `prev` link must refer to the new last child
+            first->prev = pp;
         }
 
         prev = nullptr;
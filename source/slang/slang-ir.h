@@ -390,12 +390,22 @@ struct IRInst
 
     IRInst* getParent() { return parent; }
 
-    // The next and previous instructions with the same parent
+    // The next and previous instructions with the same parent.
+    //
+    // To save having to store a pointer to the last child in every instruction,
+    // the `prev` link of the *first* child of a parent points to the *last* child
+    // (so the list of `prev` links is circular, whilst the `next` links are null terminated).
+    // Use `getPrevInst` rather than accessing `prev` directly, as it takes this into account.
     IRInst*         next;
     IRInst*         prev;
 
     IRInst* getNextInst() { return next; }
-    IRInst* getPrevInst() { return prev; }
+    IRInst* getPrevInst()
+    {
+        // Only the last child has a null `next`, so if our `prev` link refers to it
+        // we must be the first child, and there is no previous instruction.
+        return (prev && prev->next) ? prev : nullptr;
+    }
 
     // An instruction can have zero or more children, although
     // only certain instruction opcodes are allowed to have
@@ -414,22 +424,24 @@ struct IRInst
             getLastChild());
     }
 
-        /// A doubly-linked list containing any decorations and then any children of this instruction.
+        /// The first of a doubly-linked list containing any decorations and then any children of this instruction.
         ///
         /// We store both the decorations and children of an instruction
         /// in the same list, to conserve space in the instruction itself
         /// (rather than storing distinct lists for decorations and children).
+        /// For the same reason only the first entry is stored - the last is
+        /// reached via the first entry's `prev` link.
         ///
         // Note: This field is *not* being declared `private` because doing so could
         // mess with our required memory layout, where `typeUse` below is assumed
         // to be the last field in `IRInst` and to come right before any additional
         // `IRUse` values that represent operands.
         //
-    IRInstListBase m_decorationsAndChildren;
+    IRInst* m_firstDecorationOrChild;
 
-    IRInst* getFirstDecorationOrChild() { return m_decorationsAndChildren.first; }
-    IRInst* getLastDecorationOrChild()  { return m_decorationsAndChildren.last;  }
-    IRInstListBase getDecorationsAndChildren() { return m_decorationsAndChildren; }
+    IRInst* getFirstDecorationOrChild() { return m_firstDecorationOrChild; }
+    IRInst* getLastDecorationOrChild()  { return m_firstDecorationOrChild ? m_firstDecorationOrChild->prev : nullptr; }
+    IRInstListBase getDecorationsAndChildren() { return IRInstListBase(getFirstDecorationOrChild(), getLastDecorationOrChild()); }
 
     void removeAndDeallocateAllDecorationsAndChildren();
 
@@ -0,0 +1,364 @@
+// slang-module-cache.cpp
+#include "slang-module-cache.h"
+
+#include "../core/slang-blob.h"
+#include "../core/slang-hash.h"
+#include "../core/slang-io.h"
+#include "../core/slang-riff.h"
+#include "../core/slang-stream.h"
+
+#include "slang-lexer.h"
+#include "slang-serialize-container.h"
+
+namespace Slang
+{
+
+// Bump if the layout of the key (or of entries) changes, so that old entries can never be hit
+static const char kCacheVersionText[] = "slang-module-cache 1";
+
+static const UnownedStringSlice kDependencyPrefix = UnownedStringSlice::fromLiteral("dependency: ");
+static const UnownedStringSlice kImportPrefix = UnownedStringSlice::fromLiteral("import: ");
+
+ModuleCache::ModuleCache(const String& directoryPath):
+    m_directoryPath(directoryPath),
+    m_hitCount(0),
+    m_missCount(0)
+{
+    SlangPathType pathType;
+    if (SLANG_FAILED(Path::getPathType(directoryPath, &pathType)))
+    {
+        Path::createDirectory(directoryPath);
+    }
+}
+
+static void _appendLengthPrefixed(const UnownedStringSlice& text, StringBuilder& out)
+{
+    // Prefixing with the length means there is no way for one field to be confused with the next
+    out << text.getLength() << ":" << text << "\n";
+}
+
+static SlangResult _readLengthPrefixed(const char*& ioCursor, const char* end, UnownedStringSlice& outText)
+{
+    const char* cursor = ioCursor;
+
+    Index length = 0;
+    for (; cursor < end && *cursor >= '0' && *cursor <= '9'; ++cursor)
+    {
+        length = length * 10 + (*cursor - '0');
+    }
+    if (cursor >= end || *cursor != ':' || end - (cursor + 1) < length + 1 || cursor[1 + length] != '\n')
+    {
+        return SLANG_FAIL;
+    }
+
+    outText = UnownedStringSlice(cursor + 1, length);
+    ioCursor = cursor + 1 + length + 1;
+    return SLANG_OK;
+}
+
+static String _calcContentsHash(ISlangBlob* blob)
+{
+    StringBuilder builder;
+    builder << String(UInt64(getStableHashCode64((const char*)blob->getBufferPointer(), blob->getBufferSize())), 16);
+    builder << " " << UInt64(blob->getBufferSize());
+    return builder.ProduceString();
+}
+
+/* static */void ModuleCache::calcKey(Linkage* linkage, Name* name, const PathInfo& pathInfo, ISlangBlob* sourceBlob, StringBuilder& outKey)
+{
+    outKey << kCacheVersionText << "\n";
+
+    outKey << "build: ";
+    _appendLengthPrefixed(UnownedStringSlice(linkage->getSessionImpl()->getBuildTagString()), outKey);
+
+    outKey << "module: ";
+    _appendLengthPrefixed(getText(name).getUnownedSlice(), outKey);
+
+    // The path is used for the source locations in the AST and IR, and imports and includes are relative to it
+    outKey << "path: ";
+    _appendLengthPrefixed(pathInfo.foundPath.getUnownedSlice(), outKey);
+
+    outKey << "source: " << _calcContentsHash(sourceBlob) << "\n";
+
+    {
+        // Dictionary order isn't stable, so sort the definitions
+        List<KeyValuePair<String, String>> definitions;
+        for (const auto& pair : linkage->preprocessorDefinitions)
+        {
+            definitions.add(pair);
+        }
+        definitions.sort([](const KeyValuePair<String, String>& a, const KeyValuePair<String, String>& b) { return a.Key < b.Key; });
+
+        for (const auto& definition : definitions)
+        {
+            outKey << "define: ";
+            _appendLengthPrefixed(definition.Key.getUnownedSlice(), outKey);
+            outKey << "value: ";
+            _appendLengthPrefixed(definition.Value.getUnownedSlice(), outKey);
+        }
+    }
+
+    for (SearchDirectoryList* searchDirectories = &linkage->searchDirectories; searchDirectories; searchDirectories = searchDirectories->parent)
+    {
+        for (const auto& searchDirectory : searchDirectories->searchDirectories)
+        {
+            outKey << "searchDirectory: ";
+            _appendLengthPrefixed(searchDirectory.path.getUnownedSlice(), outKey);
+        }
+    }
+
+    outKey << "matrixLayoutMode: " << Index(linkage->getDefaultMatrixLayoutMode()) << "\n";
+    outKey << "obfuscateCode: " << Index(linkage->m_obfuscateCode) << "\n";
+    outKey << "falcorSharedSemantics: " << Index(linkage->m_useFalcorCustomSharedKeywordSemantics) << "\n";
+}
+
+void ModuleCache::_calcEntryPaths(const UnownedStringSlice& key, String& outModulePath, String& outDependenciesPath)
+{
+    StringBuilder entryName;
+    entryName << String(UInt64(getStableHashCode64(key.begin(), key.getLength())), 16);
+
+    {
+        StringBuilder builder;
+        Path::combineIntoBuilder(m_directoryPath.getUnownedSlice(), entryName.getUnownedSlice(), builder);
+        builder << ".slang-module";
+        outModulePath = builder.ProduceString();
+    }
+    {
+        StringBuilder builder;
+        Path::combineIntoBuilder(m_directoryPath.getUnownedSlice(), entryName.getUnownedSlice(), builder);
+        builder << ".deps";
+        outDependenciesPath = builder.ProduceString();
+    }
+}
+
+SlangResult ModuleCache::_findEntry(Linkage* linkage, const UnownedStringSlice& key, Entry& outEntry)
+{
+    String modulePath, dependenciesPath;
+    _calcEntryPaths(key, modulePath, dependenciesPath);
+
+    // The dependencies are written after the module, so if they are there, the module is too
+    ScopedAllocation dependencies;
+    SLANG_RETURN_ON_FAIL(File::readAllBytes(dependenciesPath, dependencies));
+
+    const char* cursor = (const char*)dependencies.getData();
+    const char* end = cursor + dependencies.getSizeInBytes();
+
+    if (UnownedStringSlice(cursor, end).startsWith(key) == false)
+    {
+        // Hash collision
+        return SLANG_E_NOT_FOUND;
+    }
+    cursor += key.getLength();
+
+    ISlangFileSystemExt* fileSystem = linkage->getFileSystemExt();
+    NamePool* namePool = linkage->getNamePool();
+
+    while (cursor < end)
+    {
+        UnownedStringSlice remaining(cursor, end);
+        if (remaining.startsWith(kDependencyPrefix))
+        {
+            cursor += kDependencyPrefix.getLength();
+
+            UnownedStringSlice path, storedHash;
+            SLANG_RETURN_ON_FAIL(_readLengthPrefixed(cursor, end, path));
+            SLANG_RETURN_ON_FAIL(_readLengthPrefixed(cursor, end, storedHash));
+
+            // The dependency must still have the contents it had when the module was checked
+            String dependencyPath(path);
+
+            ComPtr<ISlangBlob> contents;
+            SLANG_RETURN_ON_FAIL(fileSystem->loadFile(dependencyPath.getBuffer(), contents.writeRef()));
+
+            if (_calcContentsHash(contents).getUnownedSlice() != storedHash)
+            {
+                return SLANG_E_NOT_FOUND;
+            }
+
+            outEntry.dependencyPaths.add(dependencyPath);
+        }
+        else if (remaining.startsWith(kImportPrefix))
+        {
+            cursor += kImportPrefix.getLength();
+
+            UnownedStringSlice importName;
+            SLANG_RETURN_ON_FAIL(_readLengthPrefixed(cursor, end, importName));
+            outEntry.importNames.add(namePool->getName(String(importName)));
+        }
+        else
+        {
+            return SLANG_FAIL;
+        }
+    }
+
+    // Entries are only ever written by writing a new file and renaming it over the old one, so the contents
+    // of a file never change once it's in place, and it can be used through a mapping.
+    if (SLANG_SUCCEEDED(File::mapAllBytes(modulePath, kMinMemoryMappedFileSize, outEntry.moduleBlob)))
+    {
+        return SLANG_OK;
+    }
+
+    ScopedAllocation moduleData;
+    SLANG_RETURN_ON_FAIL(File::readAllBytes(modulePath, moduleData));
+    outEntry.moduleBlob = RawBlob::moveCreate(moduleData);
+    return SLANG_OK;
+}
+
+SlangResult ModuleCache::_readModule(Linkage* linkage, const PathInfo& pathInfo, ISlangBlob* sourceBlob, const Entry& entry, SourceLoc loc, DiagnosticSink* sink, RefPtr<Module>& outModule)
+{
+    // Import the modules this module imports first, from within the module's source, so that they are found
+    // the same way as they are when the module is checked. Symbols from them are then found by name when
+    // the module is read.
+    SourceManager* sourceManager = linkage->getSourceManager();
+    SourceFile* sourceFile = sourceManager->createSourceFileWithBlob(pathInfo, sourceBlob);
+    SourceView* sourceView = sourceManager->createSourceView(sourceFile, nullptr, loc);
+    const SourceLoc moduleLoc = sourceView->getRange().begin;
+
+    List<RefPtr<Module>> importedModules;
+    for (Name* importName : entry.importNames)
+    {
+        RefPtr<Module> importedModule = linkage->findOrImportModule(importName, moduleLoc, sink);
+        if (!importedModule)
+        {
+            return SLANG_FAIL;
+        }
+        importedModules.add(importedModule);
+    }
+
+    RiffContainer riffContainer;
+    {
+        MemoryStreamBase stream(FileAccess::Read, entry.moduleBlob->getBufferPointer(), entry.moduleBlob->getBufferSize());
+        SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, riffContainer));
+    }
+
+    // Problems reading an entry just mean it can't be used, so aren't reported
+    DiagnosticSink readSink(sourceManager, Lexer::sourceLocationLexer);
+
+    SerialContainerUtil::ReadOptions options;
+    options.session = linkage->getSessionImpl();
+    options.sourceManager = sourceManager;
+    options.namePool = linkage->getNamePool();
+    options.sharedASTBuilder = linkage->getASTBuilder()->getSharedASTBuilder();
+    options.linkage = linkage;
+    options.sink = &readSink;
+
+    SerialContainerData containerData;
+    SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(&riffContainer, options, containerData));
+
+    if (containerData.modules.getCount() != 1)
+    {
+        return SLANG_FAIL;
+    }
+    auto& srcModule = containerData.modules[0];
+
+    ModuleDecl* moduleDecl = as<ModuleDecl>(srcModule.astRootNode);
+    if (!moduleDecl || !srcModule.irModule)
+    {
+        return SLANG_FAIL;
+    }
+
+    RefPtr<Module> module(new Module(linkage, srcModule.astBuilder));
+
+    moduleDecl->module = module;
+    module->setModuleDecl(moduleDecl);
+    for (const auto& exportSymbol : srcModule.exportSymbols)
+    {
+        module->addExportSymbol(exportSymbol.mangledName.getUnownedSlice(), exportSymbol.symbol);
+    }
+    module->setIRModule(srcModule.irModule);
+
+    for (auto importedModule : importedModules)
+    {
+        module->addModuleDependency(importedModule);
+    }
+    for (const auto& dependencyPath : entry.dependencyPaths)
+    {
+        module->addFilePathDependency(dependencyPath);
+    }
+
+    module->_collectShaderParams();
+    module->_discoverEntryPoints(sink);
+
+    outModule = module;
+    return SLANG_OK;
+}
+
+RefPtr<Module> ModuleCache::findModule(Linkage* linkage, Name* name, const PathInfo& pathInfo, ISlangBlob* sourceBlob, SourceLoc loc, DiagnosticSink* sink)
+{
+    StringBuilder key;
+    calcKey(linkage, name, pathInfo, sourceBlob, key);
+
+    Entry entry;
+    RefPtr<Module> module;
+    if (SLANG_FAILED(_findEntry(linkage, key.getUnownedSlice(), entry)) ||
+        SLANG_FAILED(_readModule(linkage, pathInfo, sourceBlob, entry, loc, sink, module)))
+    {
+        m_missCount++;
+        CompileInstrumentation::addCount(CompileCounter::ModuleCacheMisses);
+        return nullptr;
+    }
+
+    m_hitCount++;
+    CompileInstrumentation::addCount(CompileCounter::ModuleCacheHits);
+    return module;
+}
+
+void ModuleCache::addModule(Linkage* linkage, Name* name, Module* module, const PathInfo& pathInfo, ISlangBlob* sourceBlob)
+{
+    ModuleDecl* moduleDecl = module->getModuleDecl();
+    if (!moduleDecl || !module->getIRModule())
+    {
+        return;
+    }
+
+    StringBuilder key;
+    calcKey(linkage, name, pathInfo, sourceBlob, key);
+
+    StringBuilder dependencies;
+    dependencies << key;
+
+    ISlangFileSystemExt* fileSystem = linkage->getFileSystemExt();
+    for (const auto& dependencyPath : module->getFilePathDependencyList())
+    {
+        // Loaded through the linkage's file system, so these will typically be the contents that were checked
+        ComPtr<ISlangBlob> contents;
+        if (SLANG_FAILED(fileSystem->loadFile(dependencyPath.getBuffer(), contents.writeRef())))
+        {
+            return;
+        }
+
+        dependencies << kDependencyPrefix;
+        _appendLengthPrefixed(dependencyPath.getUnownedSlice(), dependencies);
+        _appendLengthPrefixed(_calcContentsHash(contents).getUnownedSlice(), dependencies);
+    }
+
+    for (auto importDecl : moduleDecl->getMembersOfType<ImportDecl>())
+    {
+        dependencies << kImportPrefix;
+        _appendLengthPrefixed(getText(importDecl->moduleNameAndLoc.name).getUnownedSlice(), dependencies);
+    }
+
+    SerialContainerUtil::WriteOptions options;
+    options.compressionType = linkage->serialCompressionType;
+    // Source locations are kept, so diagnostics that refer to the module are the same as when it's checked
+    options.optionFlags |= SerialOptionFlag::SourceLocation;
+    options.sourceManager = linkage->getSourceManager();
+
+    OwnedMemoryStream stream(FileAccess::Write);
+    if (SLANG_FAILED(SerialContainerUtil::write(module, options, &stream)))
+    {
+        return;
+    }
+
+    String modulePath, dependenciesPath;
+    _calcEntryPaths(key.getUnownedSlice(), modulePath, dependenciesPath);
+
+    // The module must be complete before the dependencies appear, as they are used to detect an entry
+    const auto& contents = stream.getContents();
+    if (SLANG_SUCCEEDED(File::writeAllBytesAndRename(modulePath, contents.getBuffer(), contents.getCount())))
+    {
+        File::writeAllBytesAndRename(dependenciesPath, dependencies.getBuffer(), dependencies.getLength());
+    }
+}
+
+}
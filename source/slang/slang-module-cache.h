@@ -0,0 +1,84 @@
+// slang-module-cache.h
+#ifndef SLANG_MODULE_CACHE_H
+#define SLANG_MODULE_CACHE_H
+
+#include "../core/slang-basic.h"
+
+#include "slang-compiler.h"
+
+#include <atomic>
+
+namespace Slang
+{
+
+/* A persistent cache of checked modules, held in a directory on the file system.
+
+When a module is imported (via Linkage::loadModule), its checked AST and IR are stored in the cache, serialized with
+the slang-serialize-ast and slang-serialize-ir machinery. When a later Linkage (in the same or another process)
+imports the same module, the stored AST and IR are read back instead of parsing, checking and lowering the module
+again.
+
+An entry is found by a key made from the build of Slang, the module name and path, the contents of the module source,
+and the Linkage options that can change the result of checking or lowering (preprocessor definitions, search
+directories, matrix layout etc). Stored alongside each entry is the full key, so a hash collision of the entry name
+is a miss, and the module's transitive file dependencies (everything it #includes or imports, directly or
+indirectly) with a hash of each file's contents. An entry is only used if every dependency still has the same
+contents, so editing any file a module depends on causes it to be checked again.
+
+Only modules that are checked without any diagnostics are stored, so a hit never has to reproduce diagnostics.
+
+NOTE! A file that didn't exist when a module was stored, but would now be found first on a search path is not detected.
+If a Slang build is replaced with one with the same build tag, the cache directory should be cleared.
+
+Multiple threads (and processes) can use the same cache directory at the same time. Files are written to a
+temporary file and then renamed into place, so a reader never sees a partially written entry. */
+class ModuleCache : public RefObject
+{
+public:
+        /// Find module name (with source sourceBlob found at pathInfo) in the cache, and if found read it into
+        /// linkage. Modules imported by the module are imported into the linkage first (from loc).
+        /// Returns nullptr if there is no entry, or if any of its dependencies have changed.
+    RefPtr<Module> findModule(Linkage* linkage, Name* name, const PathInfo& pathInfo, ISlangBlob* sourceBlob, SourceLoc loc, DiagnosticSink* sink);
+
+        /// Store module (which must have been checked without any diagnostics) in the cache
+    void addModule(Linkage* linkage, Name* name, Module* module, const PathInfo& pathInfo, ISlangBlob* sourceBlob);
+
+        /// Calculate the key for the module name with source sourceBlob found at pathInfo
+    static void calcKey(Linkage* linkage, Name* name, const PathInfo& pathInfo, ISlangBlob* sourceBlob, StringBuilder& outKey);
+
+        /// Get the directory that holds the cache
+    const String& getDirectoryPath() const { return m_directoryPath; }
+
+        /// The number of modules found in the cache
+    Index getHitCount() const { return m_hitCount.load(); }
+        /// The number of modules that were not found in the cache (or whose dependencies had changed)
+    Index getMissCount() const { return m_missCount.load(); }
+
+        /// Ctor. The directory will be created if it doesn't exist.
+    ModuleCache(const String& directoryPath);
+
+        /// Serialized modules at least this size are loaded by mapping them into memory, rather than by reading them.
+        /// Mapping a file has a higher fixed cost than reading it, so small files are still read.
+    static const size_t kMinMemoryMappedFileSize = 64 * 1024;
+
+protected:
+    struct Entry
+    {
+        List<Name*> importNames;            ///< The names of the modules imported by the module
+        List<String> dependencyPaths;       ///< The paths of all of the files the module depends on
+        ComPtr<ISlangBlob> moduleBlob;      ///< The serialized module
+    };
+
+    void _calcEntryPaths(const UnownedStringSlice& key, String& outModulePath, String& outDependenciesPath);
+    SlangResult _findEntry(Linkage* linkage, const UnownedStringSlice& key, Entry& outEntry);
+    SlangResult _readModule(Linkage* linkage, const PathInfo& pathInfo, ISlangBlob* sourceBlob, const Entry& entry, SourceLoc loc, DiagnosticSink* sink, RefPtr<Module>& outModule);
+
+    String m_directoryPath;
+
+    std::atomic<Index> m_hitCount;
+    std::atomic<Index> m_missCount;
+};
+
+}
+
+#endif
@@ -19,24 +19,144 @@ const char* getCstr(Name* name)
     return name ? name->text.getBuffer() : nullptr;
 }
 
-Name* NamePool::getName(String const& text)
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!! RootNamePool !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+RootNamePool::RootNamePool()
+{
+    m_arena.init(16 * 1024);
+
+    Table* table = _createTable(1024);
+    m_table.store(table, std::memory_order_relaxed);
+}
+
+RootNamePool::~RootNamePool()
+{
+    // The names and tables are in the arena, so only the names need destructing
+    Table* table = m_table.load(std::memory_order_relaxed);
+    for (Index i = 0; i < table->capacity; ++i)
+    {
+        if (Name* name = table->slots[i].load(std::memory_order_relaxed))
+        {
+            name->~Name();
+        }
+    }
+}
+
+RootNamePool::Table* RootNamePool::_createTable(Index capacity)
+{
+    SLANG_ASSERT((capacity & (capacity - 1)) == 0);
+
+    Table* table = new (m_arena.allocateAligned(sizeof(Table), SLANG_ALIGN_OF(Table))) Table;
+    table->capacity = capacity;
+    table->slots = (std::atomic<Name*>*)m_arena.allocateAligned(sizeof(std::atomic<Name*>) * capacity, SLANG_ALIGN_OF(std::atomic<Name*>));
+    for (Index i = 0; i < capacity; ++i)
+    {
+        new (&table->slots[i]) std::atomic<Name*>(nullptr);
+    }
+
+    return table;
+}
+
+/* static */Name* RootNamePool::_find(const Table* table, const UnownedStringSlice& text, HashCode hash)
+{
+    const Index mask = table->capacity - 1;
+    for (Index i = Index(hash) & mask; ; i = (i + 1) & mask)
+    {
+        Name* name = table->slots[i].load(std::memory_order_acquire);
+        if (!name)
+        {
+            return nullptr;
+        }
+        if (name->hashCode == hash && name->text.getUnownedSlice() == text)
+        {
+            return name;
+        }
+    }
+}
+
+/* static */void RootNamePool::_insert(Table* table, Name* name)
+{
+    const Index mask = table->capacity - 1;
+    for (Index i = Index(name->hashCode) & mask; ; i = (i + 1) & mask)
+    {
+        if (table->slots[i].load(std::memory_order_relaxed) == nullptr)
+        {
+            // Release so a reader that sees the pointer sees a fully constructed name
+            table->slots[i].store(name, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+Name* RootNamePool::tryGetName(const UnownedStringSlice& text)
 {
-    RefPtr<Name> name;
-    if (rootPool->names.TryGetValue(text, name))
+    const HashCode hash = text.getHashCode();
+
+    Table* table = m_table.load(std::memory_order_acquire);
+    for (;;)
+    {
+        if (Name* name = _find(table, text, hash))
+        {
+            return name;
+        }
+
+        // If the table was replaced whilst searching, the name might have been added to the new table only
+        Table* currentTable = m_table.load(std::memory_order_acquire);
+        if (currentTable == table)
+        {
+            return nullptr;
+        }
+        table = currentTable;
+    }
+}
+
+Name* RootNamePool::getName(const UnownedStringSlice& text)
+{
+    if (Name* name = tryGetName(text))
+    {
+        return name;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Look again, as another thread may have added it
+    const HashCode hash = text.getHashCode();
+    Table* table = m_table.load(std::memory_order_relaxed);
+    if (Name* name = _find(table, text, hash))
+    {
         return name;
+    }
 
-    name = new Name();
-    name->text = text;
-    rootPool->names.Add(text, name);
+    // Keep the load factor at or below 1/2, so probe sequences stay short
+    if ((m_count + 1) * 2 > table->capacity)
+    {
+        Table* newTable = _createTable(table->capacity * 2);
+        for (Index i = 0; i < table->capacity; ++i)
+        {
+            if (Name* name = table->slots[i].load(std::memory_order_relaxed))
+            {
+                _insert(newTable, name);
+            }
+        }
+        m_table.store(newTable, std::memory_order_release);
+        table = newTable;
+    }
+
+    Name* name = new (m_arena.allocateAligned(sizeof(Name), SLANG_ALIGN_OF(Name))) Name;
+    name->text = String(text);
+    name->hashCode = hash;
+    // The pool holds a reference, so a name is never freed by a RefPtr
+    name->addReference();
+
+    _insert(table, name);
+    m_count++;
     return name;
 }
 
-Name* NamePool::tryGetName(String const& text)
+Index RootNamePool::getCount()
 {
-    RefPtr<Name> name;
-    if (rootPool->names.TryGetValue(text, name))
-        return name;
-    return nullptr;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_count;
 }
 
 } // namespace Slang
@@ -6,6 +6,10 @@
 // the name of types, variables, etc. in the AST.
 
 #include "../core/slang-basic.h"
+#include "../core/slang-memory-arena.h"
+
+#include <atomic>
+#include <mutex>
 
 namespace Slang {
 
@@ -30,6 +34,9 @@ public:
     // of name than "simple" names, and so this might change to a structured
     // ADT instead of a simple string.
     String text;
+
+    // The hash of `text`, as used by the `RootNamePool` that owns the name
+    HashCode hashCode = 0;
 };
 
 // Get the textual string representation of a name
@@ -47,10 +54,62 @@ const char* getCstr(Name* name);
 // get equivalent names for a string like `"Foo"`, then they need to use
 // the same root name pool (directly or indirectly).
 //
-struct RootNamePool
+// The root name pool of a global session is shared by all of the sessions
+// and compile requests created from it, so it can be used from multiple
+// threads at the same time.
+//
+// Names are held in an open addressing hash table of `Name` pointers,
+// with the hash of each name's text stored in the `Name`. Lookups take a
+// string slice, so finding an existing name (for example when lexing an
+// identifier) doesn't allocate, and don't take a lock. Adding a name takes
+// a mutex. `Name`s are allocated from an arena and are never moved or freed
+// until the pool is destroyed.
+//
+// When the table grows a new table is published, and the old one is kept
+// until the pool is destroyed, as readers may still be probing it. A reader
+// that fails to find a name checks whether the table was replaced whilst it
+// was searching, and if so searches the current table (still without a
+// lock), so never misses a name that was added before the lookup.
+//
+class RootNamePool
 {
-    // The mapping from text strings to the corresponding name.
-    Dictionary<String, RefPtr<Name> > names;
+public:
+        /// Find or create the `Name` that represents `text`
+    Name* getName(const UnownedStringSlice& text);
+        /// Find the `Name` that represents `text`, or return nullptr if there isn't one
+    Name* tryGetName(const UnownedStringSlice& text);
+
+        /// Get the number of names in the pool
+    Index getCount();
+
+    RootNamePool();
+    ~RootNamePool();
+
+protected:
+    struct Table
+    {
+        Index capacity;                     ///< Always a power of 2
+        std::atomic<Name*>* slots;          ///< nullptr for an empty slot. Slots are only ever set once.
+    };
+
+    static Name* _find(const Table* table, const UnownedStringSlice& text, HashCode hash);
+    static void _insert(Table* table, Name* name);
+    Table* _createTable(Index capacity);
+
+        /// The current table, which holds every name
+    std::atomic<Table*> m_table;
+
+        /// Guards adding names, and everything below
+    std::mutex m_mutex;
+
+    Index m_count = 0;
+        /// Backing memory for the `Name`s and the tables. Old tables are kept, as readers can still be using them.
+    MemoryArena m_arena;
+
+private:
+    // Disable
+    RootNamePool(const RootNamePool&) = delete;
+    void operator=(const RootNamePool&) = delete;
 };
 
 // A `NamePool` is effectively a way of storing a subset of the
@@ -68,10 +127,12 @@ struct RootNamePool
 struct NamePool
 {
     // Find or create the `Name` that represents the given `text`.
-    Name* getName(String const& text);
+    Name* getName(const UnownedStringSlice& text) { return rootPool->getName(text); }
+    Name* getName(String const& text) { return rootPool->getName(text.getUnownedSlice()); }
     // Try find the `Name` that represents the given `text`.
     // If the name does not exist, return nullptr
-    Name* tryGetName(String const& text);
+    Name* tryGetName(const UnownedStringSlice& text) { return rootPool->tryGetName(text); }
+    Name* tryGetName(String const& text) { return rootPool->tryGetName(text.getUnownedSlice()); }
     // Set the parent name pool to use for lookup
     void setRootNamePool(RootNamePool* rootNamePool)
     {
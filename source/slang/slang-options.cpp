@@ -540,6 +540,11 @@ struct OptionsParser
                 {
                     requestImpl->m_dumpReproOnError = true;
                 }
+                else if (argStr == "-compile-trace")
+                {
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, requestImpl->m_instrumentationTracePath));
+                    compileRequest->setInstrumentationFlags(SLANG_INSTRUMENTATION_FLAG_ENABLE | SLANG_INSTRUMENTATION_FLAG_TRACE);
+                }
                 else if (argStr == "-extract-repro")
                 {
                     String reproName;
@@ -627,6 +632,28 @@ struct OptionsParser
                 {
                     requestImpl->getBackEndReq()->disableDynamicDispatch = true;
                 }
+                else if (argStr == "-parallel-codegen")
+                {
+                    String threadCountText;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, threadCountText));
+                    requestImpl->getBackEndReq()->parallelCodeGenThreadCount = StringToInt(threadCountText);
+                }
+                else if (argStr == "-downstream-cache-path")
+                {
+                    String cachePath;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, cachePath));
+                    requestImpl->getBackEndReq()->downstreamCompileCache = new DownstreamCompileCache(cachePath);
+                }
+                else if (argStr == "-precompiled-prelude")
+                {
+                    requestImpl->getBackEndReq()->usePrecompiledPrelude = true;
+                }
+                else if (argStr == "-module-cache-path")
+                {
+                    String cachePath;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, cachePath));
+                    requestImpl->setModuleCachePath(cachePath.getBuffer());
+                }
                 else if (argStr == "-verbose-paths")
                 {
                     requestImpl->getSink()->setFlag(DiagnosticSink::Flag::VerbosePath);
@@ -648,6 +675,18 @@ struct OptionsParser
                 {
                     getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_PARAMETER_BLOCKS_USE_REGISTER_SPACES;
                 }
+                else if (argStr == "-cpu-group-as-lanes")
+                {
+                    getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_CPU_GROUP_AS_LANES;
+                }
+                else if (argStr == "-global-value-numbering")
+                {
+                    getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_GLOBAL_VALUE_NUMBERING;
+                }
+                else if (argStr == "-loop-optimizations")
+                {
+                    getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_LOOP_OPTIMIZATIONS;
+                }
                 else if (argStr == "-ir-compression")
                 {
                     String name;
@@ -1010,6 +1049,11 @@ struct OptionsParser
                         // 'Immutable' implements the ISlangFileSystemExt interface - and will be used directly
                         compileRequest->setFileSystem(OSFileSystem::getExtSingleton());
                     }
+                    else if (name == "os-mapped")
+                    {
+                        // As 'os', but large files are mapped into memory rather than read
+                        compileRequest->setFileSystem(OSFileSystem::getMappedSingleton());
+                    }
                     else
                     {
                         sink->diagnose(SourceLoc(), Diagnostics::unknownFileSystemOption, name);
@@ -1595,6 +1639,17 @@ struct OptionsParser
                     case CodeGenTarget::CPPSource:
                         rawOutput.isWholeProgram = true;
                         break;
+                    case CodeGenTarget::SharedLibrary:
+                    case CodeGenTarget::HostCallable:
+                        // When there are multiple entry points they are all output together, compiled as a single
+                        // translation unit with a single invocation of the downstream compiler
+                        if (rawEntryPoints.getCount() > 1)
+                        {
+                            rawOutput.isWholeProgram = true;
+                            break;
+                        }
+                        sink->diagnose(SourceLoc(), Diagnostics::cannotMatchOutputFileToEntryPoint, rawOutput.path);
+                        break;
                     default:
                         sink->diagnose(SourceLoc(), Diagnostics::cannotMatchOutputFileToEntryPoint, rawOutput.path);
                         break;
@@ -58,11 +58,50 @@ struct UsedRanges
     // as used, and anything not in such an interval is implicitly
     // free.
     //
-    // TODO: if it ever starts to matter for performance, we
-    // could encode this information as a tree instead of an array.
+    // Because the ranges are sorted and don't overlap, both their
+    // `begin` and `end` values are in increasing order, so the
+    // ranges that a query could touch can be found with a binary
+    // search, rather than by visiting every range.
     //
     List<UsedRange> ranges;
 
+    // For each `count` that has been allocated, a value such
+    // that every free entry before it is in a gap between ranges
+    // that is too small to hold `count` entries.
+    //
+    // Ranges are only ever added, so gaps only ever shrink, and
+    // so the next allocation of the same `count` can start its
+    // search from there. Parameters are mostly allocated one
+    // after another with a few different counts, so this skips
+    // nearly all of the ranges.
+    //
+    Dictionary<UInt, UInt> allocateSearchStarts;
+
+    // Find the index of the first range whose `end` is greater
+    // than `value`, or the count of ranges if there is none.
+    //
+    // That is the first range that could contain `value`, or any
+    // value after it.
+    //
+    Index _findFirstEndAfter(UInt value) const
+    {
+        Index lo = 0;
+        Index hi = ranges.getCount();
+        while (lo < hi)
+        {
+            const Index mid = lo + ((hi - lo) >> 1);
+            if (ranges[mid].end > value)
+            {
+                hi = mid;
+            }
+            else
+            {
+                lo = mid + 1;
+            }
+        }
+        return lo;
+    }
+
     // Add a range to the set, either by extending
     // existing range(s), or by adding a new one.
     //
@@ -91,37 +130,38 @@ struct UsedRanges
         VarLayout* newParam = range.parameter;
         VarLayout* existingParam = nullptr;
 
-        // A clever algorithm might use a binary
-        // search to identify the first entry in `ranges`
-        // that might overlap `range`, but we are going
-        // to settle for being less clever for now, in
-        // the hopes that we can at least be correct.
+        // Every range before the first one that ends after
+        // `range.begin` ends at or before `range.begin`, so
+        // can't intersect `range`. We can start looking for
+        // overlaps from there.
         //
         // Note: we are going to iterate over `ranges`
-        // using indices, because we may actually modify
-        // the array as we go.
+        // using indices, because we insert into the
+        // array as we go.
         //
-        Int rangeCount = ranges.getCount();
-        for(Int rr = 0; rr < rangeCount; ++rr)
+        Index rr = _findFirstEndAfter(range.begin);
+        for(; rr < ranges.getCount(); ++rr)
         {
             auto existingRange = ranges[rr];
 
             // The invariant on entry to each loop
             // iteration will be that `range` does
             // *not* intersect any preceding entry
-            // in the array.
+            // in the array, and that `range` begins
+            // before `existingRange` ends.
             //
             // Note that this invariant might be
             // true only because we modified
             // `range` along the way.
             //
-            // If `range` does not intertsect `existingRange`
-            // then our invariant will be trivially
-            // true for the next iteration.
+            // If `existingRange` begins at or after the
+            // end of `range`, then so do all of the ranges
+            // after it, and there is nothing left to
+            // intersect.
             //
             if(!rangesOverlap(existingRange, range))
             {
-                continue;
+                break;
             }
 
             // We now know that `range` and `existingRange`
@@ -156,6 +196,8 @@ struct UsedRanges
             // intersect with any range already in the `ranges` array,
             // because it comes strictly before `existingRange`, and our
             // invariant says there is no intersection with preceding ranges.
+            // It goes immediately before `existingRange` to keep the
+            // array sorted.
             //
             if(range.begin < existingRange.begin)
             {
@@ -163,7 +205,8 @@ struct UsedRanges
                 prefix.begin = range.begin;
                 prefix.end = existingRange.begin;
                 prefix.parameter = range.parameter;
-                ranges.add(prefix);
+                ranges.insert(rr, prefix);
+                ++rr;
             }
             //
             // Now we know that the interval `[range.begin, existingRange.begin)`
@@ -193,19 +236,17 @@ struct UsedRanges
         // adding some new entries.
         //
         // If the `range` we are left with is still non-empty,
-        // then we should go ahead and add it.
+        // then we should go ahead and add it. Every range
+        // before index `rr` ends at or before `range.begin`,
+        // and every range from `rr` on begins at or after
+        // `range.end`, so inserting it at `rr` keeps the
+        // array sorted.
         //
         if(range.begin < range.end)
         {
-            ranges.add(range);
+            ranges.insert(rr, range);
         }
 
-        // Any ranges that got added along the way might not
-        // be in the proper sorted order, so we'll need to
-        // sort the array to restore our global invariant.
-        //
-        ranges.sort();
-
         // We end by returning an overlapping parameter that
         // we found along the way, if any.
         //
@@ -232,28 +273,34 @@ struct UsedRanges
 
     bool contains(UInt index)
     {
-        for (auto rr : ranges)
-        {
-            if (index < rr.begin)
-                return false;
-
-            if (index >= rr.end)
-                continue;
-
-            return true;
-        }
-
-        return false;
+        const Index rr = _findFirstEndAfter(index);
+        return rr < ranges.getCount() && ranges[rr].begin <= index;
     }
 
 
     // Try to find space for `count` entries
     UInt Allocate(VarLayout* param, UInt count)
     {
+        // Find the first gap that could hold `count` entries, and
+        // the value it begins at. Nothing fits in a gap before
+        // the search start, so we begin from there (or after the
+        // range that contains it).
+        //
         UInt begin = 0;
+        if (count)
+        {
+            allocateSearchStarts.TryGetValue(count, begin);
+        }
+
+        Index rangeCount = ranges.getCount();
+        Index rr = _findFirstEndAfter(begin);
+        if (rr < rangeCount && ranges[rr].begin <= begin)
+        {
+            begin = ranges[rr].end;
+            ++rr;
+        }
 
-        UInt rangeCount = ranges.getCount();
-        for (UInt rr = 0; rr < rangeCount; ++rr)
+        for (; rr < rangeCount; ++rr)
         {
             // try to fit in before this range...
 
@@ -262,9 +309,7 @@ struct UsedRanges
             // If there is enough space...
             if (end >= begin + count)
             {
-                // ... then claim it and be done
-                Add(param, begin, begin + count);
-                return begin;
+                break;
             }
 
             // ... otherwise, we need to look at the
@@ -272,9 +317,15 @@ struct UsedRanges
             begin = ranges[rr].end;
         }
 
-        // We've run out of ranges to check, so we
-        // can safely go after the last one!
+        // Either we found space before range `rr`, or we've
+        // run out of ranges to check, so we can safely go
+        // after the last one!
+        //
         Add(param, begin, begin + count);
+        if (count)
+        {
+            allocateSearchStarts[count] = begin + count;
+        }
         return begin;
     }
 };
@@ -1,6 +1,7 @@
 // slang-preprocessor.cpp
 #include "slang-preprocessor.h"
 
+#include "slang-compile-instrumentation.h"
 #include "slang-compiler.h"
 #include "slang-diagnostics.h"
 #include "slang-lexer.h"
@@ -107,9 +108,18 @@ struct PrimaryInputStream : PreprocessorInputStream
     // The deepest preprocessor conditional active for this stream.
     PreprocessorConditional*        conditional;
 
-    // The lexer state that will provide input
+    // The lexer state that will provide input, unless the tokens are read from `cacheEntry`
     Lexer lexer;
 
+    // If set, the tokens of the file were found in the token cache, and are read from it instead of being lexed
+    PreprocessorTokenCache::Entry* cacheEntry = nullptr;
+
+    // The index of the next token to read from `cacheEntry`
+    Index cacheTokenIndex = 0;
+
+    // The view of the file the tokens are from
+    SourceView* sourceView = nullptr;
+
     // One token of lookahead
     Token token;
 };
@@ -232,6 +242,9 @@ struct Preprocessor
         /// Source maanger to use when loading source files
     SourceManager*                          sourceManager = nullptr;
 
+        /// Cache of the tokens of `#include`d files (if set)
+    PreprocessorTokenCache*                 tokenCache = nullptr;
+
     NamePool* getNamePool() { return namePool; }
     SourceManager* getSourceManager() { return sourceManager; }
 };
@@ -277,20 +290,49 @@ static void destroyInputStream(Preprocessor* /*preprocessor*/, PreprocessorInput
     delete inputStream;
 }
 
+// Read the next token of a primary input stream, either from the token cache or by lexing it with `lexerFlags`
+static Token lexPrimaryToken(PrimaryInputStream* primaryStream, LexerFlags lexerFlags)
+{
+    if (auto cacheEntry = primaryStream->cacheEntry)
+    {
+        Token token = cacheEntry->tokens[primaryStream->cacheTokenIndex];
+
+        // Like the lexer, keep producing the end of file token once it is reached
+        if (token.type != TokenType::EndOfFile)
+        {
+            primaryStream->cacheTokenIndex++;
+        }
+
+        // The cached locs are offsets from the start of the file, so make them relative to this view of it
+        token.loc = primaryStream->sourceView->getRange().begin + Int(token.loc.getRaw());
+        return token;
+    }
+
+    return primaryStream->lexer.lexToken(lexerFlags);
+}
+
 // Create an input stream to represent a pre-tokenized input file.
+// If `cacheEntry` is set, the tokens are read from it rather than lexed.
 // TODO(tfoley): pre-tokenizing files isn't going to work in the long run.
 static PreprocessorInputStream* CreateInputStreamForSource(
-    Preprocessor*   preprocessor,
-    SourceView*     sourceView)
+    Preprocessor*                   preprocessor,
+    SourceView*                     sourceView,
+    PreprocessorTokenCache::Entry*  cacheEntry = nullptr)
 {
-    MemoryArena* memoryArena = sourceView->getSourceManager()->getMemoryArena();
-
     PrimaryInputStream* inputStream = new PrimaryInputStream();
     initializePrimaryInputStream(preprocessor, inputStream);
 
-    // initialize the embedded lexer so that it can generate a token stream
-    inputStream->lexer.initialize(sourceView, GetSink(preprocessor), preprocessor->getNamePool(), memoryArena);
-    inputStream->token = inputStream->lexer.lexToken();
+    inputStream->sourceView = sourceView;
+    inputStream->cacheEntry = cacheEntry;
+
+    if (!cacheEntry)
+    {
+        MemoryArena* memoryArena = sourceView->getSourceManager()->getMemoryArena();
+
+        // initialize the embedded lexer so that it can generate a token stream
+        inputStream->lexer.initialize(sourceView, GetSink(preprocessor), preprocessor->getNamePool(), memoryArena);
+    }
+    inputStream->token = lexPrimaryToken(inputStream, 0);
 
     return inputStream;
 }
@@ -343,7 +385,7 @@ static Token AdvanceRawToken(PreprocessorInputStream* inputStream, LexerFlags le
     if( auto primaryStream = asPrimaryInputStream(inputStream) )
     {
         auto result = primaryStream->token;
-        primaryStream->token = primaryStream->lexer.lexToken(lexerFlags);
+        primaryStream->token = lexPrimaryToken(primaryStream, lexerFlags);
         return result;
     }
     else
@@ -1858,6 +1900,17 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    auto tokenCache = context->preprocessor->tokenCache;
+    PreprocessorTokenCache::Entry* cacheEntry = tokenCache ? tokenCache->findEntry(filePathInfo.uniqueIdentity) : nullptr;
+
+    // If the whole file is within an include guard whose macro is defined, including it would produce no
+    // tokens, so there is no need to open it again
+    if (cacheEntry && cacheEntry->includeGuardName && LookupMacro(context->preprocessor, cacheEntry->includeGuardName))
+    {
+        CompileInstrumentation::addCount(CompileCounter::IncludeGuardSkips);
+        return;
+    }
+
     // Simplify the path
     filePathInfo.foundPath = includeSystem->simplifyPath(filePathInfo.foundPath);
 
@@ -1882,10 +1935,25 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         sourceManager->addSourceFile(filePathInfo.uniqueIdentity, sourceFile);
     }
 
+    if (tokenCache && !cacheEntry)
+    {
+        cacheEntry = tokenCache->addEntry(filePathInfo.uniqueIdentity, sourceFile);
+    }
+    else if (cacheEntry && cacheEntry->tokens.getCount())
+    {
+        CompileInstrumentation::addCount(CompileCounter::TokenCacheHits);
+    }
+
+    // If the file couldn't be cached, it has to be lexed
+    if (cacheEntry && cacheEntry->tokens.getCount() == 0)
+    {
+        cacheEntry = nullptr;
+    }
+
     // This is a new parse (even if it's a pre-existing source file), so create a new SourceView
     SourceView* sourceView = sourceManager->createSourceView(sourceFile, &filePathInfo, directiveLoc);
 
-    PreprocessorInputStream* inputStream = CreateInputStreamForSource(context->preprocessor, sourceView);
+    PreprocessorInputStream* inputStream = CreateInputStreamForSource(context->preprocessor, sourceView, cacheEntry);
     inputStream->parent = context->preprocessor->inputStream;
     context->preprocessor->inputStream = inputStream;
 }
@@ -2048,7 +2116,7 @@ static void HandleLineDirective(PreprocessorDirectiveContext* context)
         AdvanceToken(context);
 
         // Stop overriding source locations.
-        auto sourceView = inputStream->primaryStream->lexer.m_sourceView;
+        auto sourceView = inputStream->primaryStream->sourceView;
         sourceView->addDefaultLineDirective(directiveLoc);
         return;
     }
@@ -2085,7 +2153,7 @@ static void HandleLineDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
-    auto sourceView = inputStream->primaryStream->lexer.m_sourceView;
+    auto sourceView = inputStream->primaryStream->sourceView;
     sourceView->addLineDirective(directiveLoc, file, line);
 }
 
@@ -2491,6 +2559,153 @@ Result findMacroValue(
     return SLANG_OK;
 }
 
+PreprocessorTokenCache::PreprocessorTokenCache(SourceManager* sourceManager, NamePool* namePool):
+    m_sourceManager(sourceManager),
+    m_namePool(namePool)
+{
+}
+
+PreprocessorTokenCache::Entry* PreprocessorTokenCache::findEntry(const String& uniqueIdentity)
+{
+    RefPtr<Entry>* entry = m_entries.TryGetValue(uniqueIdentity);
+    return entry ? *entry : nullptr;
+}
+
+PreprocessorTokenCache::Entry* PreprocessorTokenCache::addEntry(const String& uniqueIdentity, SourceFile* sourceFile)
+{
+    // The tokens can reference memory owned by the source manager, so only cache files that live as long as it does
+    if (sourceFile->getSourceManager() != m_sourceManager)
+    {
+        return nullptr;
+    }
+
+    RefPtr<Entry> entry = new Entry;
+    entry->sourceFile = sourceFile;
+
+    SourceView* sourceView = m_sourceManager->createSourceView(sourceFile, nullptr, SourceLoc::fromRaw(0));
+    const SourceLoc startLoc = sourceView->getRange().begin;
+
+    // Diagnostics are written to a sink of our own. If there are any the tokens aren't cached, so they are reported
+    // (with the right include stack) by lexing the file each time it is included.
+    DiagnosticSink sink(m_sourceManager, nullptr);
+
+    Lexer lexer;
+    lexer.initialize(sourceView, &sink, m_namePool, m_sourceManager->getMemoryArena());
+
+    // The lexer is told how to lex some tokens by the preprocessor directive they are in, so do the same here.
+    // The directive name follows a `#` at the start of a line, and the flags apply to the token after it.
+    List<Token>& tokens = entry->tokens;
+    LexerFlags lexerFlags = 0;
+    for (;;)
+    {
+        Token token = lexer.lexToken(lexerFlags);
+        lexerFlags = 0;
+
+        const Index count = tokens.getCount();
+        if (count && token.type == TokenType::Identifier)
+        {
+            const Token& prevToken = tokens[count - 1];
+            if (prevToken.type == TokenType::Pound && (prevToken.flags & TokenFlag::AtStartOfLine))
+            {
+                const String& directiveName = token.getName()->text;
+                if (directiveName == "include")
+                {
+                    lexerFlags = kLexerFlag_ExpectFileName;
+                }
+                else if (directiveName == "warning" || directiveName == "error")
+                {
+                    lexerFlags = kLexerFlag_ExpectDirectiveMessage;
+                }
+            }
+        }
+
+        token.loc = SourceLoc::fromRaw(SourceLoc::RawValue(token.loc.getRaw() - startLoc.getRaw()));
+        tokens.add(token);
+
+        if (token.type == TokenType::EndOfFile)
+        {
+            break;
+        }
+    }
+
+    if (sink.getDiagnosticCount())
+    {
+        tokens.clear();
+    }
+    else
+    {
+        entry->includeGuardName = _findIncludeGuardName(tokens);
+    }
+
+    m_entries.Add(uniqueIdentity, entry);
+    return entry;
+}
+
+/* static */Name* PreprocessorTokenCache::_findIncludeGuardName(const List<Token>& tokens)
+{
+    // A file is guarded by X if it starts with `#ifndef X`, and the `#endif` that ends that conditional is the
+    // last thing in the file. Whether `#define X` follows doesn't matter - when X isn't defined the file is
+    // included as normal.
+    //
+    // The conditional directives are processed even in code that is skipped, so which `#endif` ends the
+    // conditional doesn't depend on the macros that are defined when the file is included.
+    const Index count = tokens.getCount();
+
+    auto getDirectiveName = [&](Index index) -> Name*
+    {
+        const Token& token = tokens[index];
+        if (token.type == TokenType::Pound && (token.flags & TokenFlag::AtStartOfLine) &&
+            index + 1 < count && tokens[index + 1].type == TokenType::Identifier)
+        {
+            return tokens[index + 1].getName();
+        }
+        return nullptr;
+    };
+
+    Name* directiveName = getDirectiveName(0);
+    if (!directiveName || directiveName->text != "ifndef" ||
+        count < 4 || tokens[2].type != TokenType::Identifier || tokens[3].type != TokenType::EndOfDirective)
+    {
+        return nullptr;
+    }
+    Name* guardName = tokens[2].getName();
+
+    Index depth = 1;
+    for (Index i = 4; i < count; ++i)
+    {
+        directiveName = getDirectiveName(i);
+        if (!directiveName)
+        {
+            continue;
+        }
+
+        const String& text = directiveName->text;
+        if (text == "if" || text == "ifdef" || text == "ifndef")
+        {
+            depth++;
+        }
+        else if (text == "else" || text == "elif")
+        {
+            // Part of the file is included when X is defined
+            if (depth == 1)
+            {
+                return nullptr;
+            }
+        }
+        else if (text == "endif")
+        {
+            if (--depth == 0)
+            {
+                const bool isAtEnd = i + 3 < count &&
+                    tokens[i + 2].type == TokenType::EndOfDirective &&
+                    tokens[i + 3].type == TokenType::EndOfFile;
+                return isAtEnd ? guardName : nullptr;
+            }
+        }
+    }
+    return nullptr;
+}
+
 void PreprocessorHandler::handleEndOfFile(Preprocessor* preprocessor)
 {
     SLANG_UNUSED(preprocessor);
@@ -2520,6 +2735,7 @@ TokenList preprocessSource(
     desc.fileSystem     = linkage->getFileSystemExt();
     desc.namePool       = linkage->getNamePool();
     desc.sourceManager  = linkage->getSourceManager();
+    desc.tokenCache     = linkage->getPreprocessorTokenCache();
 
     return preprocessSource(file, desc);
 }
@@ -2542,6 +2758,14 @@ TokenList preprocessSource(
     auto handler = desc.handler;
     preprocessor.handler = handler;
 
+    // The cached tokens are only valid for files from the source manager, with names from the name pool, they were
+    // lexed with
+    auto tokenCache = desc.tokenCache;
+    if (tokenCache && tokenCache->getSourceManager() == sourceManager && tokenCache->getNamePool() == desc.namePool)
+    {
+        preprocessor.tokenCache = tokenCache;
+    }
+
     if(desc.defines)
     {
         for (auto p : *desc.defines)
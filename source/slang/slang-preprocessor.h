@@ -27,6 +27,50 @@ struct PreprocessorHandler
     virtual void handleFileDependency(String const& path);
 };
 
+    /// A cache of the tokens lexed from `#include`d files, so a file that is included many times (by one or by many
+    /// translation units) is only lexed once.
+    ///
+    /// It also records which files are entirely within an include guard (`#ifndef X` ... `#endif`), so that when X
+    /// is already defined including the file again can be skipped without reopening it.
+    ///
+    /// A cache is held by a `Linkage` (and so shared by all of its translation units and imported modules), and is only
+    /// used for files loaded by the source manager it was created with. It is not thread safe.
+class PreprocessorTokenCache : public RefObject
+{
+public:
+    class Entry : public RefObject
+    {
+    public:
+            /// The file the tokens were lexed from
+        SourceFile* sourceFile = nullptr;
+            /// The macro of the include guard around the whole file, or nullptr if the file doesn't have one
+        Name* includeGuardName = nullptr;
+            /// The tokens of the file ending with the EndOfFile token. The loc of each token is the offset from the
+            /// start of the file. Empty if lexing the file produced diagnostics, in which case it is lexed each
+            /// time it is included so they are reported.
+        List<Token> tokens;
+    };
+
+        /// Find the entry for the file with uniqueIdentity. Returns nullptr if there isn't one.
+    Entry* findEntry(const String& uniqueIdentity);
+        /// Lex sourceFile (with uniqueIdentity) and add an entry for it.
+        /// Returns nullptr if the file wasn't loaded by the cache's source manager.
+    Entry* addEntry(const String& uniqueIdentity, SourceFile* sourceFile);
+
+    SourceManager* getSourceManager() const { return m_sourceManager; }
+    NamePool* getNamePool() const { return m_namePool; }
+
+        /// Ctor. Tokens are lexed with names from namePool, for files loaded by sourceManager.
+    PreprocessorTokenCache(SourceManager* sourceManager, NamePool* namePool);
+
+protected:
+    static Name* _findIncludeGuardName(const List<Token>& tokens);
+
+    SourceManager* m_sourceManager;
+    NamePool* m_namePool;
+    Dictionary<String, RefPtr<Entry>> m_entries;
+};
+
     /// Description of a preprocessor options/dependencies
 struct PreprocessorDesc
 {
@@ -50,6 +94,9 @@ struct PreprocessorDesc
 
         /// Optional: handler for callbacks invoked during preprocessing
     PreprocessorHandler* handler = nullptr;
+
+        /// Optional: cache of the tokens of `#include`d files. Only used if it has the same source manager and name pool.
+    PreprocessorTokenCache* tokenCache = nullptr;
 };
 
     /// Take a source `file` and preprocess it into a list of tokens.
@@ -1267,6 +1267,18 @@ static SlangResult _calcCommandLine(OffsetBase& base, ReproUtil::RequestState* r
             {
                 cmd.addArg("-parameter-blocks-use-register-spaces");
             }
+            if (src.targetFlags & SLANG_TARGET_FLAG_CPU_GROUP_AS_LANES)
+            {
+                cmd.addArg("-cpu-group-as-lanes");
+            }
+            if (src.targetFlags & SLANG_TARGET_FLAG_GLOBAL_VALUE_NUMBERING)
+            {
+                cmd.addArg("-global-value-numbering");
+            }
+            if (src.targetFlags & SLANG_TARGET_FLAG_LOOP_OPTIMIZATIONS)
+            {
+                cmd.addArg("-loop-optimizations");
+            }
 
             switch (src.floatingPointMode)
             {
@@ -23,6 +23,14 @@ struct ASTSerialBinary
     static const FourCC kSlangASTModuleFourCC = SLANG_FOUR_CC('S', 'A', 'm', 'l');
         /// AST module data 
     static const FourCC kSlangASTModuleDataFourCC = SLANG_FOUR_CC('S', 'A', 'm', 'd');
+        /// The symbols exported by the AST module. An array of ExportSymbol.
+    static const FourCC kSlangASTModuleExportsFourCC = SLANG_FOUR_CC('S', 'A', 'm', 'x');
+
+    struct ExportSymbol
+    {
+        uint32_t mangledName;           ///< Index of the string in the AST module data
+        uint32_t symbol;                ///< Index of the node in the AST module data
+    };
 };
 
 class ModuleSerialFilter : public SerialFilter
@@ -73,6 +73,17 @@ namespace Slang {
             SLANG_ASSERT(moduleDecl);
 
             dstModule.astRootNode = moduleDecl;
+
+            // Save the exports, so a reader doesn't have to find them by mangling the name of every decl
+            const Index exportCount = module->getExportSymbolCount();
+            for (Index i = 0; i < exportCount; ++i)
+            {
+                SerialContainerData::ExportSymbol exportSymbol;
+                UnownedStringSlice mangledName;
+                exportSymbol.symbol = module->getExportSymbol(i, mangledName);
+                exportSymbol.mangledName = mangledName;
+                dstModule.exportSymbols.add(exportSymbol);
+            }
         }
         if (options.optionFlags & SerialOptionFlag::IRModule)
         {
@@ -220,9 +231,22 @@ namespace Slang {
                     // Add the module and everything that isn't filtered out in the filter.
                     writer.addPointer(moduleDecl);
 
+                    List<ASTSerialBinary::ExportSymbol> exportSymbols;
+                    for (const auto& srcExportSymbol : module.exportSymbols)
+                    {
+                        ASTSerialBinary::ExportSymbol exportSymbol;
+                        exportSymbol.mangledName = uint32_t(writer.addString(srcExportSymbol.mangledName));
+                        exportSymbol.symbol = uint32_t(writer.addPointer(srcExportSymbol.symbol));
+                        exportSymbols.add(exportSymbol);
+                    }
 
                     // We can now serialize it into the riff container.
                     SLANG_RETURN_ON_FAIL(writer.writeIntoContainer(ASTSerialBinary::kSlangASTModuleDataFourCC, container));
+
+                    if (exportSymbols.getCount())
+                    {
+                        container->addDataChunk(ASTSerialBinary::kSlangASTModuleExportsFourCC, exportSymbols.getBuffer(), exportSymbols.getCount() * sizeof(ASTSerialBinary::ExportSymbol));
+                    }
                 }
             }
         }
@@ -287,6 +311,33 @@ namespace Slang {
 }
 
 
+namespace { // anonymous
+
+// Reads an IR module from its serialized data when it is first needed
+class SerialIRModuleLoader : public IRModuleLoader
+{
+public:
+    virtual SlangResult loadIRModule(RefPtr<IRModule>& outIRModule) SLANG_OVERRIDE
+    {
+        IRSerialReader reader;
+        return reader.read(m_serialData, m_session, m_sourceLocReader, outIRModule);
+    }
+
+    SerialIRModuleLoader(Session* session, SerialSourceLocReader* sourceLocReader):
+        m_session(session),
+        m_sourceLocReader(sourceLocReader)
+    {
+    }
+
+    IRSerialData m_serialData;
+
+protected:
+    Session* m_session;
+    RefPtr<SerialSourceLocReader> m_sourceLocReader;
+};
+
+} // anonymous
+
 static List<ExtensionDecl*>& _getCandidateExtensionList(
     AggTypeDecl* typeDecl,
     Dictionary<AggTypeDecl*, RefPtr<CandidateExtensionList>>& mapTypeToCandidateExtensions)
@@ -354,15 +405,50 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
             NodeBase* astRootNode = nullptr;
             RefPtr<IRModule> irModule;
 
+            RefPtr<IRModuleLoader> irModuleLoader;
+            RefPtr<IRLazyModule> irLazyModule;
+            List<SerialContainerData::ExportSymbol> exportSymbols;
+
             if (auto irChunk = as<RiffContainer::ListChunk>(chunk, IRSerialBinary::kIRModuleFourCc))
             {
-                IRSerialData serialData;
+                if (options.readIRGlobalValuesLazily)
+                {
+                    RefPtr<IRSerialLazyModule> lazyModule = new IRSerialLazyModule;
+                    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &lazyModule->m_serialData));
+
+                    const SlangResult res = lazyModule->init(options.session, sourceLocReader);
+                    if (SLANG_SUCCEEDED(res))
+                    {
+                        irLazyModule = lazyModule;
+                    }
+                    else if (res == SLANG_E_NOT_AVAILABLE)
+                    {
+                        // There isn't an index, so it has to be read in full
+                        IRSerialReader reader;
+                        SLANG_RETURN_ON_FAIL(reader.read(lazyModule->m_serialData, options.session, sourceLocReader, irModule));
+                    }
+                    else
+                    {
+                        return res;
+                    }
+                }
+                else if (options.readIRLazily)
+                {
+                    // Only decode the data, the module is constructed from it when first needed
+                    RefPtr<SerialIRModuleLoader> loader = new SerialIRModuleLoader(options.session, sourceLocReader);
+                    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &loader->m_serialData));
+                    irModuleLoader = loader;
+                }
+                else
+                {
+                    IRSerialData serialData;
 
-                SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &serialData));
+                    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(irChunk, containerCompressionType, &serialData));
 
-                // Read IR back from serialData
-                IRSerialReader reader;
-                SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                    // Read IR back from serialData
+                    IRSerialReader reader;
+                    SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                }
 
                 // Onto next chunk
                 chunk = chunk->m_next;
@@ -491,6 +577,20 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                     // Get the root node. It's at index 1 (0 is the null value).
                     astRootNode = reader.getPointer(SerialIndex(1)).dynamicCast<NodeBase>();
 
+                    if (RiffContainer::Data* exportsData = astChunk->findContainedData(ASTSerialBinary::kSlangASTModuleExportsFourCC))
+                    {
+                        const auto srcExportSymbols = (const ASTSerialBinary::ExportSymbol*)exportsData->getPayload();
+                        const Index exportCount = Index(exportsData->getSize() / sizeof(ASTSerialBinary::ExportSymbol));
+
+                        exportSymbols.setCount(exportCount);
+                        for (Index i = 0; i < exportCount; ++i)
+                        {
+                            auto& dstExportSymbol = exportSymbols[i];
+                            dstExportSymbol.mangledName = reader.getStringSlice(SerialIndex(srcExportSymbols[i].mangledName));
+                            dstExportSymbol.symbol = reader.getPointer(SerialIndex(srcExportSymbols[i].symbol)).dynamicCast<NodeBase>();
+                        }
+                    }
+
                     // 2) Add the extensions to the module mapTypeToCandidateExtensions cache
                     // 3) We need to fix the callback pointers for parsing
 
@@ -571,13 +671,16 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                 chunk = chunk->m_next;
             }
 
-            if (astBuilder || irModule)
+            if (astBuilder || irModule || irModuleLoader || irLazyModule)
             {
                 SerialContainerData::Module module;
 
                 module.astBuilder = astBuilder;
                 module.astRootNode = astRootNode;
                 module.irModule = irModule;
+                module.irModuleLoader = irModuleLoader;
+                module.irLazyModule = irLazyModule;
+                module.exportSymbols.swapWith(exportSymbols);
 
                 out.modules.add(module);
             }
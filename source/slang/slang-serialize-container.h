@@ -48,11 +48,20 @@ struct SerialContainerData
         RefPtr<IRModule> irModule;
     };
 
+    struct ExportSymbol
+    {
+        String mangledName;
+        NodeBase* symbol = nullptr;
+    };
+
     struct Module
     {
         RefPtr<IRModule> irModule;              ///< The IR for the module
+        RefPtr<IRModuleLoader> irModuleLoader;  ///< Set instead of irModule if the IR is read lazily (see ReadOptions::readIRLazily)
+        RefPtr<IRLazyModule> irLazyModule;      ///< Set instead of irModule if global values are read lazily (see ReadOptions::readIRGlobalValuesLazily)
         RefPtr<ASTBuilder> astBuilder;          ///< The astBuilder that owns the astRootNode
         NodeBase* astRootNode = nullptr;        ///< The module decl
+        List<ExportSymbol> exportSymbols;       ///< The symbols exported from the AST module. If empty they have to be found from the AST. 
     };
 
     struct EntryPoint
@@ -91,6 +100,11 @@ struct SerialContainerUtil
         SharedASTBuilder* sharedASTBuilder = nullptr;
         Linkage* linkage = nullptr;
         DiagnosticSink* sink = nullptr;
+            /// If set, a module's IR isn't read, instead Module::irModuleLoader is set to read it when needed
+        bool readIRLazily = false;
+            /// If set, and a module's IR has a global symbol index, Module::irLazyModule is set to read
+            /// global values from it as they are needed by linking. Takes precedence over readIRLazily.
+        bool readIRGlobalValuesLazily = false;
     };
 
         /// Add module to outData
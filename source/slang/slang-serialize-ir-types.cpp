@@ -40,6 +40,7 @@ bother to check if it's correct, and just casts it.
 SLANG_COMPILE_TIME_ASSERT(SLANG_FOUR_CC_GET_FIRST_CHAR(IRSerialBinary::kInstFourCc) == 'S');
 SLANG_COMPILE_TIME_ASSERT(SLANG_FOUR_CC_GET_FIRST_CHAR(IRSerialBinary::kChildRunFourCc) == 'S');
 SLANG_COMPILE_TIME_ASSERT(SLANG_FOUR_CC_GET_FIRST_CHAR(IRSerialBinary::kExternalOperandsFourCc) == 'S');
+SLANG_COMPILE_TIME_ASSERT(SLANG_FOUR_CC_GET_FIRST_CHAR(IRSerialBinary::kGlobalSymbolFourCc) == 'S');
 
 // Compressed version starts with 's'
 SLANG_COMPILE_TIME_ASSERT(SLANG_FOUR_CC_GET_FIRST_CHAR(SLANG_MAKE_COMPRESSED_FOUR_CC(IRSerialBinary::kInstFourCc)) == 's');
@@ -64,7 +65,9 @@ size_t IRSerialData::calcSizeInBytes() const
         /* Raw source locs */
         _calcArraySize(m_rawSourceLocs) +
         /* Debug */
-        _calcArraySize(m_debugSourceLocRuns);
+        _calcArraySize(m_debugSourceLocRuns) +
+        /* Global symbol index */
+        _calcArraySize(m_globalSymbols);
 }
 
 IRSerialData::IRSerialData()
@@ -85,6 +88,8 @@ void IRSerialData::clear()
     m_stringTable.clear();
     
     m_debugSourceLocRuns.clear();
+
+    m_globalSymbols.clear();
 }
 
 bool IRSerialData::operator==(const ThisType& rhs) const
@@ -96,7 +101,8 @@ bool IRSerialData::operator==(const ThisType& rhs) const
         SerialListUtil::isEqual(m_rawSourceLocs, rhs.m_rawSourceLocs) &&
         SerialListUtil::isEqual(m_stringTable, rhs.m_stringTable) &&
         /* Debug */
-        SerialListUtil::isEqual(m_debugSourceLocRuns, rhs.m_debugSourceLocRuns));
+        SerialListUtil::isEqual(m_debugSourceLocRuns, rhs.m_debugSourceLocRuns) &&
+        SerialListUtil::isEqual(m_globalSymbols, rhs.m_globalSymbols));
 }
 
 } // namespace Slang
@@ -39,6 +39,9 @@ struct IRSerialBinary
 
         /// Debug information is held elsewhere, but if this optional section exists, it maps instructions to locs
     static const FourCC kDebugSourceLocRunFourCc = SLANG_FOUR_CC('S', 'd', 's', 'r');
+
+        /// Index of the module level instructions by mangled name. If it exists, global values can be read individually.
+    static const FourCC kGlobalSymbolFourCc = SLANG_FOUR_CC('S', 'g', 's', 'y');
 };
 
 struct IRSerialData
@@ -84,6 +87,23 @@ struct IRSerialData
         SizeType m_numInst;                 ///< The number of children
     };
 
+        /// An entry in the index of module level instructions.
+        ///
+        /// Entries are sorted by the text of the mangled name (and then by instruction index), so all the values
+        /// with a name are contiguous, and can be found with a binary search. An entry with a null name is a 'root' -
+        /// a value the linker includes whether or not it is referenced (such as a module decoration, or a value
+        /// marked [public]). Roots come first.
+    struct GlobalSymbol
+    {
+        typedef GlobalSymbol ThisType;
+
+        bool operator==(const ThisType& rhs) const { return m_mangledName == rhs.m_mangledName && m_instIndex == rhs.m_instIndex; }
+        bool operator!=(const ThisType& rhs) const { return !(*this == rhs); }
+
+        StringIndex m_mangledName;          ///< The mangled name from the linkage decoration, or kNullStringIndex for a root
+        InstIndex m_instIndex;              ///< The module level instruction
+    };
+
     struct PayloadInfo
     {
         uint8_t m_numOperands;
@@ -190,6 +210,8 @@ struct IRSerialData
 
     List<SourceLocRun> m_debugSourceLocRuns;    ///< Runs of instructions that use a source loc
 
+    List<GlobalSymbol> m_globalSymbols;         ///< Index of the module level instructions (empty if not written)
+
     static const PayloadInfo s_payloadInfos[int(Inst::PayloadType::CountOf)];
 };
 
@@ -5,6 +5,7 @@
 #include "../core/slang-byte-encode-util.h"
 
 #include "slang-ir-insts.h"
+#include "slang-compile-instrumentation.h"
 
 #include "../core/slang-math.h"
 
@@ -22,6 +23,21 @@ static bool _isConstant(IROp opIn)
     return op >= kIROp_FirstConstant && op <= kIROp_LastConstant;
 }
 
+// Orders names in the global symbol index. The null name (of roots) is empty, and so is ordered first.
+static int _compareMangledNames(const UnownedStringSlice& a, const UnownedStringSlice& b)
+{
+    const Index aLength = a.getLength();
+    const Index bLength = b.getLength();
+    const Index minLength = Math::Min(aLength, bLength);
+
+    const int diff = minLength ? memcmp(a.begin(), b.begin(), size_t(minLength)) : 0;
+    if (diff)
+    {
+        return diff;
+    }
+    return (aLength < bLength) ? -1 : ((aLength > bLength) ? 1 : 0);
+}
+
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSerialWriter !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
 void IRSerialWriter::_addInstruction(IRInst* inst)
@@ -104,6 +120,56 @@ Result IRSerialWriter::_calcDebugInfo(SerialSourceLocWriter* sourceLocWriter)
     return SLANG_OK;
 }
 
+void IRSerialWriter::_calcGlobalSymbols(IRModule* module)
+{
+    auto& globalSymbols = m_serialData->m_globalSymbols;
+
+    for (IRInst* inst : module->getModuleInst()->getDecorationsAndChildren())
+    {
+        const Ser::InstIndex instIndex = getInstIndex(inst);
+
+        // Roots are the values linkIR includes without them being referenced
+        bool isRoot = false;
+        switch (inst->getOp())
+        {
+            case kIROp_BindGlobalGenericParam:
+            case kIROp_GlobalHashedStringLiterals:
+            {
+                isRoot = true;
+                break;
+            }
+            default:
+            {
+                isRoot = as<IRDecoration>(inst) || inst->findDecoration<IRPublicDecoration>();
+                break;
+            }
+        }
+
+        if (isRoot)
+        {
+            Ser::GlobalSymbol symbol;
+            symbol.m_mangledName = SerialStringData::kNullStringIndex;
+            symbol.m_instIndex = instIndex;
+            globalSymbols.add(symbol);
+        }
+
+        if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+        {
+            Ser::GlobalSymbol symbol;
+            symbol.m_mangledName = getStringIndex(linkage->getMangledName());
+            symbol.m_instIndex = instIndex;
+            globalSymbols.add(symbol);
+        }
+    }
+
+    // Sort by name, so the reader can binary search the index without having to add all the names to a pool
+    globalSymbols.sort([&](const Ser::GlobalSymbol& a, const Ser::GlobalSymbol& b) -> bool
+    {
+        const int diff = _compareMangledNames(getStringSlice(a.m_mangledName), getStringSlice(b.m_mangledName));
+        return diff < 0 || (diff == 0 && a.m_instIndex < b.m_instIndex);
+    });
+}
+
 Result IRSerialWriter::write(IRModule* module, SerialSourceLocWriter* sourceLocWriter, SerialOptionFlags options, IRSerialData* serialData)
 {
     typedef Ser::Inst::PayloadType PayloadType;
@@ -286,6 +352,9 @@ Result IRSerialWriter::write(IRModule* module, SerialSourceLocWriter* sourceLocW
         }
     }
 
+    // Must be before the string table is produced, as it adds the mangled names
+    _calcGlobalSymbols(module);
+
     // Convert strings into a string table
     {
         SerialStringTableUtil::encodeStringTable(m_stringSlicePool, serialData->m_stringTable);
@@ -464,6 +533,8 @@ Result _writeInstArrayChunk(SerialCompressionType compressionType, FourCC chunkI
         SerialRiffUtil::writeArrayChunk(compressionType, Bin::kDebugSourceLocRunFourCc, data.m_debugSourceLocRuns, container);
     }
 
+    SLANG_RETURN_ON_FAIL(SerialRiffUtil::writeArrayChunk(compressionType, Bin::kGlobalSymbolFourCc, data.m_globalSymbols, container));
+
     return SLANG_OK;
 }
 
@@ -661,6 +732,12 @@ static Result _readInstArrayChunk(SerialCompressionType containerCompressionType
                 SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(containerCompressionType, dataChunk, outData->m_debugSourceLocRuns));
                 break;
             }
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kGlobalSymbolFourCc):
+            case Bin::kGlobalSymbolFourCc:
+            {
+                SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(containerCompressionType, dataChunk, outData->m_globalSymbols));
+                break;
+            }
             default:
             {
                 break;
@@ -671,10 +748,146 @@ static Result _readInstArrayChunk(SerialCompressionType containerCompressionType
     return SLANG_OK;
 }
 
-Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule)
+    /// Create the instruction for srcInst, without its type, operands or parent
+static Result _createInst(IRModule* module, const IRSerialData::Inst& srcInst, const List<UnownedStringSlice>& strings, IRInst*& outInst)
 {
-    typedef Ser::Inst::PayloadType PayloadType;
+    typedef IRSerialData::Inst::PayloadType PayloadType;
+
+    const IROp op((IROp)srcInst.m_op);
+
+    if (_isConstant(op))
+    {
+        // Handling of constants
+
+        // Calculate the minimum object size (ie not including the payload of value)    
+        const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
+
+        IRConstant* irConst = nullptr;
+        switch (op)
+        {                    
+            case kIROp_BoolLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::UInt32);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue)));
+                irConst->value.intVal = srcInst.m_payload.m_uint32 != 0;
+                break;
+            }
+            case kIROp_IntLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue)));
+                irConst->value.intVal = srcInst.m_payload.m_int64; 
+                break;
+            }
+            case kIROp_PtrLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(void*)));
+                irConst->value.ptrVal = (void*) (intptr_t) srcInst.m_payload.m_int64; 
+                break;
+            }
+            case kIROp_FloatLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Float64);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op,  prefixSize + sizeof(IRFloatingPointValue)));
+                irConst->value.floatVal = srcInst.m_payload.m_float64;
+                break;
+            }
+            case kIROp_StringLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::String_1);
+
+                const UnownedStringSlice slice = strings[Index(srcInst.m_payload.m_stringIndices[0])];
+                    
+                const size_t sliceSize = slice.getLength();
+                const size_t instSize = prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) + sliceSize;
 
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, instSize));
+
+                IRConstant::StringValue& dstString = irConst->value.stringVal;
+
+                dstString.numChars = uint32_t(sliceSize);
+                // Turn into pointer to avoid warning of array overrun
+                char* dstChars = dstString.chars;
+                // Copy the chars
+                memcpy(dstChars, slice.begin(), sliceSize);
+                break;
+            }
+            default:
+            {
+                SLANG_ASSERT(!"Unknown constant type");
+                return SLANG_FAIL;
+            }
+        }
+
+        outInst = irConst;
+    }
+    else if (_isTextureTypeBase(op))
+    {
+        IRTextureTypeBase* inst = static_cast<IRTextureTypeBase*>(createEmptyInst(module, op, 1));
+        SLANG_ASSERT(srcInst.m_payloadType == PayloadType::OperandAndUInt32);
+
+        // Reintroduce the texture type bits into the the
+        const uint32_t other = srcInst.m_payload.m_operandAndUInt32.m_uint32;
+        inst->m_op = IROp(uint32_t(inst->getOp()) | (other << kIROpMeta_OtherShift));
+
+        outInst = inst;
+    }
+    else
+    {
+        int numOperands = srcInst.getNumOperands();
+        outInst = createEmptyInst(module, op, numOperands);
+    }
+
+    return SLANG_OK;
+}
+
+    /// Create the IRModuleInst for module, from the instruction at index 1
+static IRModuleInst* _createModuleInst(const IRSerialData& data, IRModule* module)
+{
+    typedef IRSerialData::Inst::PayloadType PayloadType;
+
+    // Check that insts[1] is the module inst
+    const IRSerialData::Inst& srcInst = data.m_insts[1];
+    SLANG_RELEASE_ASSERT(srcInst.m_op == kIROp_Module);
+    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Empty);
+    SLANG_UNUSED(srcInst);
+
+    auto moduleInst = static_cast<IRModuleInst*>(createEmptyInstWithSize(module, kIROp_Module, sizeof(IRModuleInst)));
+    module->moduleInst = moduleInst;
+    moduleInst->module = module;
+    return moduleInst;
+}
+
+    /// Set the type and operands of dstInst (created from srcInst). insts maps instruction indices to created instructions.
+static void _setTypeAndOperands(const IRSerialData& data, const IRSerialData::Inst& srcInst, IRInst* const* insts, IRInst* dstInst)
+{
+    typedef IRSerialData Ser;
+
+    // Set the result type
+    if (srcInst.m_resultTypeIndex != Ser::InstIndex(0))
+    {
+        IRInst* resultInst = insts[int(srcInst.m_resultTypeIndex)];
+        // NOTE! Counter intuitively the IRType* paramter may not be IRType* derived for example 
+        // IRGlobalGenericParam is valid, but isn't IRType* derived
+
+        //SLANG_RELEASE_ASSERT(as<IRType>(resultInst));
+        dstInst->setFullType(static_cast<IRType*>(resultInst));
+    }
+
+    const Ser::InstIndex* srcOperandIndices;
+    const int numOperands = data.getOperands(srcInst, &srcOperandIndices);
+
+    auto dstOperands = dstInst->getOperands();
+
+    for (int j = 0; j < numOperands; j++)
+    {
+        dstOperands[j].init(dstInst, insts[int(srcOperandIndices[j])]);
+    }
+}
+
+Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule)
+{
     m_serialData = &data;
  
     auto module = new IRModule();
@@ -698,143 +911,17 @@ Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSo
 
     // 0 holds null
     // 1 holds the IRModuleInst
-    {
-        // Check that insts[1] is the module inst
-        const Ser::Inst& srcInst = data.m_insts[1];
-        SLANG_RELEASE_ASSERT(srcInst.m_op == kIROp_Module);
-        SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Empty);
-
-        // Create the module inst
-        auto moduleInst = static_cast<IRModuleInst*>(createEmptyInstWithSize(module, kIROp_Module, sizeof(IRModuleInst)));
-        module->moduleInst = moduleInst;
-        moduleInst->module = module;
-
-        // Set the IRModuleInst
-        insts[1] = moduleInst; 
-    }
+    insts[1] = _createModuleInst(data, module);
 
     for (Index i = 2; i < numInsts; ++i)
     {
-        const Ser::Inst& srcInst = data.m_insts[i];
-
-        const IROp op((IROp)srcInst.m_op);
-
-        if (_isConstant(op))
-        {
-            // Handling of constants
-
-            // Calculate the minimum object size (ie not including the payload of value)    
-            const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
-
-            IRConstant* irConst = nullptr;
-            switch (op)
-            {                    
-                case kIROp_BoolLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::UInt32);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue)));
-                    irConst->value.intVal = srcInst.m_payload.m_uint32 != 0;
-                    break;
-                }
-                case kIROp_IntLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue)));
-                    irConst->value.intVal = srcInst.m_payload.m_int64; 
-                    break;
-                }
-                case kIROp_PtrLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(void*)));
-                    irConst->value.ptrVal = (void*) (intptr_t) srcInst.m_payload.m_int64; 
-                    break;
-                }
-                case kIROp_FloatLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Float64);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op,  prefixSize + sizeof(IRFloatingPointValue)));
-                    irConst->value.floatVal = srcInst.m_payload.m_float64;
-                    break;
-                }
-                case kIROp_StringLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::String_1);
-
-                    const UnownedStringSlice slice = m_stringTable.getSlice(StringSlicePool::Handle(srcInst.m_payload.m_stringIndices[0]));
-                        
-                    const size_t sliceSize = slice.getLength();
-                    const size_t instSize = prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) + sliceSize;
-
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, instSize));
-
-                    IRConstant::StringValue& dstString = irConst->value.stringVal;
-
-                    dstString.numChars = uint32_t(sliceSize);
-                    // Turn into pointer to avoid warning of array overrun
-                    char* dstChars = dstString.chars;
-                    // Copy the chars
-                    memcpy(dstChars, slice.begin(), sliceSize);
-                    break;
-                }
-                default:
-                {
-                    SLANG_ASSERT(!"Unknown constant type");
-                    return SLANG_FAIL;
-                }
-            }
-
-            insts[i] = irConst;
-        }
-        else if (_isTextureTypeBase(op))
-        {
-            IRTextureTypeBase* inst = static_cast<IRTextureTypeBase*>(createEmptyInst(module, op, 1));
-            SLANG_ASSERT(srcInst.m_payloadType == PayloadType::OperandAndUInt32);
-
-            // Reintroduce the texture type bits into the the
-            const uint32_t other = srcInst.m_payload.m_operandAndUInt32.m_uint32;
-            inst->m_op = IROp(uint32_t(inst->getOp()) | (other << kIROpMeta_OtherShift));
-
-            insts[i] = inst;
-        }
-        else
-        {
-            int numOperands = srcInst.getNumOperands();
-            insts[i] = createEmptyInst(module, op, numOperands);
-        }
+        SLANG_RETURN_ON_FAIL(_createInst(module, data.m_insts[i], m_stringTable.getSlices(), insts[i]));
     }
 
     // Patch up the operands
     for (Index i = 1; i < numInsts; ++i)
     {
-        const Ser::Inst& srcInst = data.m_insts[i];
-        const IROp op((IROp)srcInst.m_op);
-
-        IRInst* dstInst = insts[i];
-
-        // Set the result type
-        if (srcInst.m_resultTypeIndex != Ser::InstIndex(0))
-        {
-            IRInst* resultInst = insts[int(srcInst.m_resultTypeIndex)];
-            // NOTE! Counter intuitively the IRType* paramter may not be IRType* derived for example 
-            // IRGlobalGenericParam is valid, but isn't IRType* derived
-
-            //SLANG_RELEASE_ASSERT(as<IRType>(resultInst));
-            dstInst->setFullType(static_cast<IRType*>(resultInst));
-        }
-       
-        //if (!isParentDerived(op))
-        {
-            const Ser::InstIndex* srcOperandIndices;
-            const int numOperands = data.getOperands(srcInst, &srcOperandIndices);
-
-            auto dstOperands = dstInst->getOperands();
-
-            for (int j = 0; j < numOperands; j++)
-            {
-                dstOperands[j].init(dstInst, insts[int(srcOperandIndices[j])]);
-            }
-        }
+        _setTypeAndOperands(data, data.m_insts[i], insts.getBuffer(), insts[i]);
     }
     
     // Patch up the children
@@ -909,4 +996,384 @@ Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSo
     return SLANG_OK;
 }
 
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSerialLazyModule !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+SlangResult IRSerialLazyModule::init(Session* session, SerialSourceLocReader* sourceLocReader)
+{
+    const IRSerialData& data = m_serialData;
+
+    if (data.m_globalSymbols.getCount() == 0)
+    {
+        // Written without an index (or with nothing in the module to index)
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    const Index numInsts = data.m_insts.getCount();
+    if (numInsts < 2)
+    {
+        return SLANG_FAIL;
+    }
+
+    m_module = new IRModule();
+    m_module->session = session;
+
+    m_sourceLocReader = sourceLocReader;
+
+    // Only the strings are found, they aren't added to a pool
+    SerialStringTableUtil::decodeStringTable(data.m_stringTable.getBuffer(), data.m_stringTable.getCount(), m_strings);
+
+    m_insts.setCount(numInsts);
+    memset(m_insts.getBuffer(), 0, sizeof(IRInst*) * numInsts);
+
+    // 0 holds null
+    // 1 holds the IRModuleInst
+    m_insts[1] = _createModuleInst(data, m_module);
+
+    const auto& runs = data.m_childRuns;
+    if (runs.getCount() == 0)
+    {
+        return SLANG_OK;
+    }
+
+    // The first run holds the module's children. As instructions are written depth first (with the last child first),
+    // the runs for the descendants of each module child follow in a contiguous block.
+    const auto& moduleRun = runs[0];
+    if (moduleRun.m_parentIndex != Ser::InstIndex(1))
+    {
+        return SLANG_FAIL;
+    }
+
+    m_firstGlobalIndex = Index(moduleRun.m_startInstIndex);
+    m_globals.setCount(Index(moduleRun.m_numChildren));
+
+    Index currentGlobal = -1;
+    for (Index i = 1; i < runs.getCount(); ++i)
+    {
+        const Index globalIndex = Index(runs[i].m_parentIndex) - m_firstGlobalIndex;
+        if (globalIndex >= 0 && globalIndex < m_globals.getCount())
+        {
+            currentGlobal = globalIndex;
+            m_globals[globalIndex].startRun = i;
+            m_globalsInRunOrder.add(globalIndex);
+        }
+        else if (currentGlobal < 0)
+        {
+            return SLANG_FAIL;
+        }
+        m_globals[currentGlobal].endRun = i + 1;
+    }
+
+    if (sourceLocReader && data.m_debugSourceLocRuns.getCount())
+    {
+        // In instruction order, so the runs for a range of instructions can be found with a binary search
+        m_debugSourceLocRuns = data.m_debugSourceLocRuns;
+        m_debugSourceLocRuns.sort([](const Ser::SourceLocRun& a, const Ser::SourceLocRun& b) -> bool { return a.m_startInstIndex < b.m_startInstIndex; });
+    }
+
+    return SLANG_OK;
+}
+
+SlangResult IRSerialLazyModule::readGlobalValues(const UnownedStringSlice& mangledName)
+{
+    // An empty name would match the roots
+    if (mangledName.getLength() == 0)
+    {
+        return SLANG_OK;
+    }
+
+    const auto& symbols = m_serialData.m_globalSymbols;
+    const Index numSymbols = symbols.getCount();
+
+    // Find the first entry with the name
+    Index start = 0;
+    Index end = numSymbols;
+    while (start < end)
+    {
+        const Index mid = start + ((end - start) >> 1);
+        if (_compareMangledNames(_getString(symbols[mid].m_mangledName), mangledName) < 0)
+        {
+            start = mid + 1;
+        }
+        else
+        {
+            end = mid;
+        }
+    }
+
+    for (Index i = start; i < numSymbols && _getString(symbols[i].m_mangledName) == mangledName; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(_requireInst(symbols[i].m_instIndex));
+    }
+
+    return _completeCreatedGlobals();
+}
+
+SlangResult IRSerialLazyModule::readRootGlobalValues()
+{
+    if (m_haveReadRoots)
+    {
+        return SLANG_OK;
+    }
+    m_haveReadRoots = true;
+
+    // Roots have the null name, so are ordered first
+    for (const auto& symbol : m_serialData.m_globalSymbols)
+    {
+        if (_getString(symbol.m_mangledName).getLength() != 0)
+        {
+            break;
+        }
+        if (symbol.m_mangledName == SerialStringData::kNullStringIndex)
+        {
+            SLANG_RETURN_ON_FAIL(_requireInst(symbol.m_instIndex));
+        }
+    }
+
+    return _completeCreatedGlobals();
+}
+
+void IRSerialLazyModule::takeReadGlobalValues(List<IRInst*>& outValues)
+{
+    outValues.addRange(m_readGlobalValues);
+    m_readGlobalValues.clear();
+}
+
+void IRSerialLazyModule::_getDescendantRange(Index globalIndex, Index& outStart, Index& outEnd) const
+{
+    const GlobalRuns& globalRuns = m_globals[globalIndex];
+    if (globalRuns.startRun == globalRuns.endRun)
+    {
+        outStart = outEnd = 0;
+        return;
+    }
+
+    const auto& runs = m_serialData.m_childRuns;
+    const auto& lastRun = runs[globalRuns.endRun - 1];
+
+    outStart = Index(runs[globalRuns.startRun].m_startInstIndex);
+    outEnd = Index(lastRun.m_startInstIndex) + Index(lastRun.m_numChildren);
+}
+
+SlangResult IRSerialLazyModule::_requireInst(Ser::InstIndex instIndex)
+{
+    const Index index = Index(instIndex);
+    if (index >= m_insts.getCount())
+    {
+        return SLANG_FAIL;
+    }
+    // Index 0 is null
+    if (index == 0 || m_insts[index])
+    {
+        return SLANG_OK;
+    }
+
+    Index globalIndex = index - m_firstGlobalIndex;
+    if (globalIndex >= m_globals.getCount())
+    {
+        // It's a descendant of a global. Descendant ranges are increasing in run order, so find the last global
+        // whose range starts at or before the index.
+        Index start = 0;
+        Index end = m_globalsInRunOrder.getCount();
+        while (start < end)
+        {
+            const Index mid = start + ((end - start) >> 1);
+
+            Index descendantStart, descendantEnd;
+            _getDescendantRange(m_globalsInRunOrder[mid], descendantStart, descendantEnd);
+
+            if (descendantStart <= index)
+            {
+                start = mid + 1;
+            }
+            else
+            {
+                end = mid;
+            }
+        }
+        if (start == 0)
+        {
+            return SLANG_FAIL;
+        }
+        globalIndex = m_globalsInRunOrder[start - 1];
+    }
+    else if (globalIndex < 0)
+    {
+        return SLANG_FAIL;
+    }
+
+    return _createGlobal(globalIndex);
+}
+
+SlangResult IRSerialLazyModule::_createGlobal(Index globalIndex)
+{
+    const Index instIndex = m_firstGlobalIndex + globalIndex;
+    SLANG_ASSERT(m_insts[instIndex] == nullptr);
+
+    SLANG_RETURN_ON_FAIL(_createInst(m_module, m_serialData.m_insts[instIndex], m_strings, m_insts[instIndex]));
+
+    Index descendantStart, descendantEnd;
+    _getDescendantRange(globalIndex, descendantStart, descendantEnd);
+    for (Index i = descendantStart; i < descendantEnd; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(_createInst(m_module, m_serialData.m_insts[i], m_strings, m_insts[i]));
+    }
+
+    // The types and operands are set once everything that is needed has been created
+    m_pendingGlobals.add(globalIndex);
+    return SLANG_OK;
+}
+
+SlangResult IRSerialLazyModule::_completeInst(Index instIndex)
+{
+    const Ser::Inst& srcInst = m_serialData.m_insts[instIndex];
+
+    SLANG_RETURN_ON_FAIL(_requireInst(srcInst.m_resultTypeIndex));
+
+    const Ser::InstIndex* srcOperandIndices;
+    const int numOperands = m_serialData.getOperands(srcInst, &srcOperandIndices);
+    for (int i = 0; i < numOperands; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(_requireInst(srcOperandIndices[i]));
+    }
+
+    _setTypeAndOperands(m_serialData, srcInst, m_insts.getBuffer(), m_insts[instIndex]);
+    return SLANG_OK;
+}
+
+SlangResult IRSerialLazyModule::_completeCreatedGlobals()
+{
+    const auto& runs = m_serialData.m_childRuns;
+    const bool hasRawSourceLocs = m_serialData.m_rawSourceLocs.getCount() == m_insts.getCount();
+
+    IRModuleInst* moduleInst = m_module->getModuleInst();
+
+    // Completing a global can create more globals (that it references), so keep going until there are none left
+    while (m_pendingGlobals.getCount())
+    {
+        const Index globalIndex = m_pendingGlobals.getLast();
+        m_pendingGlobals.removeLast();
+
+        const Index instIndex = m_firstGlobalIndex + globalIndex;
+        IRInst* inst = m_insts[instIndex];
+
+        Index descendantStart, descendantEnd;
+        _getDescendantRange(globalIndex, descendantStart, descendantEnd);
+
+        SLANG_RETURN_ON_FAIL(_completeInst(instIndex));
+        for (Index i = descendantStart; i < descendantEnd; ++i)
+        {
+            SLANG_RETURN_ON_FAIL(_completeInst(i));
+        }
+
+        // Patch up the children
+        const GlobalRuns& globalRuns = m_globals[globalIndex];
+        for (Index i = globalRuns.startRun; i < globalRuns.endRun; ++i)
+        {
+            const auto& run = runs[i];
+            IRInst* parent = m_insts[Index(run.m_parentIndex)];
+
+            for (Index j = 0; j < Index(run.m_numChildren); ++j)
+            {
+                IRInst* child = m_insts[Index(run.m_startInstIndex) + j];
+                SLANG_ASSERT(child->parent == nullptr);
+                child->insertAtEnd(parent);
+            }
+        }
+
+        // Decorations of the module have to be before its children
+        if (as<IRDecoration>(inst))
+        {
+            if (m_lastModuleDecoration)
+            {
+                inst->insertAfter(m_lastModuleDecoration);
+            }
+            else
+            {
+                inst->insertAtStart(moduleInst);
+            }
+            m_lastModuleDecoration = inst;
+        }
+        else
+        {
+            inst->insertAtEnd(moduleInst);
+        }
+
+        // Re-add source locations, if they are defined
+        if (hasRawSourceLocs)
+        {
+            const Ser::RawSourceLoc* srcLocs = m_serialData.m_rawSourceLocs.begin();
+
+            inst->sourceLoc.setRaw(Slang::SourceLoc::RawValue(srcLocs[instIndex]));
+            for (Index i = descendantStart; i < descendantEnd; ++i)
+            {
+                m_insts[i]->sourceLoc.setRaw(Slang::SourceLoc::RawValue(srcLocs[i]));
+            }
+        }
+        _setDebugSourceLocs(instIndex, instIndex + 1);
+        _setDebugSourceLocs(descendantStart, descendantEnd);
+
+        if (inst->findDecoration<IRLinkageDecoration>())
+        {
+            m_readGlobalValues.add(inst);
+        }
+        m_readGlobalCount++;
+        CompileInstrumentation::addCount(CompileCounter::LazyIRGlobalsRead);
+    }
+
+    return SLANG_OK;
+}
+
+void IRSerialLazyModule::_setDebugSourceLocs(Index startIndex, Index endIndex)
+{
+    const Index numRuns = m_debugSourceLocRuns.getCount();
+    if (numRuns == 0 || startIndex >= endIndex)
+    {
+        return;
+    }
+
+    // Runs don't overlap, so are in order of where they end too. Find the first that ends after startIndex.
+    Index start = 0;
+    Index end = numRuns;
+    while (start < end)
+    {
+        const Index mid = start + ((end - start) >> 1);
+        const auto& run = m_debugSourceLocRuns[mid];
+        if (Index(run.m_startInstIndex) + Index(run.m_numInst) <= startIndex)
+        {
+            start = mid + 1;
+        }
+        else
+        {
+            end = mid;
+        }
+    }
+
+    for (Index i = start; i < numRuns; ++i)
+    {
+        const auto& run = m_debugSourceLocRuns[i];
+
+        const Index runStart = Index(run.m_startInstIndex);
+        if (runStart >= endIndex)
+        {
+            break;
+        }
+        const Index runEnd = runStart + Index(run.m_numInst);
+
+        // Work out the fixed source location
+        SourceLoc sourceLoc;
+        if (run.m_sourceLoc)
+        {
+            SerialSourceLocData::SourceRange range = SerialSourceLocData::SourceRange::getInvalid();
+            const int fix = m_sourceLocReader->calcFixSourceLoc(run.m_sourceLoc, range);
+            sourceLoc = m_sourceLocReader->calcFixedLoc(run.m_sourceLoc, fix, range);
+        }
+
+        const Index instEnd = Math::Min(runEnd, endIndex);
+        for (Index j = Math::Max(runStart, startIndex); j < instEnd; ++j)
+        {
+            m_insts[j]->sourceLoc = sourceLoc;
+        }
+    }
+}
+
 } // namespace Slang
@@ -52,6 +52,8 @@ protected:
     
     void _addInstruction(IRInst* inst);
     Result _calcDebugInfo(SerialSourceLocWriter* sourceLocWriter);
+        /// Index the module level instructions into m_serialData->m_globalSymbols
+    void _calcGlobalSymbols(IRModule* module);
     
     List<IRInst*> m_insts;                              ///< Instructions in same order as stored in the 
 
@@ -89,6 +91,78 @@ struct IRSerialReader
     IRModule* m_module;
 };
 
+    /// Reads an IR module from serial data a module level instruction at a time, as they are asked for.
+    ///
+    /// Uses the global symbol index written with the module to find the instructions with a mangled name. When an
+    /// instruction is read, so are its children, and (transitively) the module level instructions they reference.
+    /// Instructions are added to the module in the order they are read, not the order they were written.
+class IRSerialLazyModule : public IRLazyModule
+{
+public:
+    typedef IRSerialData Ser;
+
+    // IRLazyModule
+    virtual IRModule* getIRModule() SLANG_OVERRIDE { return m_module; }
+    virtual SlangResult readGlobalValues(const UnownedStringSlice& mangledName) SLANG_OVERRIDE;
+    virtual SlangResult readRootGlobalValues() SLANG_OVERRIDE;
+    virtual void takeReadGlobalValues(List<IRInst*>& outValues) SLANG_OVERRIDE;
+
+        /// Set up to read from m_serialData. Only the module instruction is created.
+        /// Returns SLANG_E_NOT_AVAILABLE if the data doesn't have a global symbol index, in which case it can only be read
+        /// with IRSerialReader.
+    SlangResult init(Session* session, SerialSourceLocReader* sourceLocReader);
+
+        /// Get the total amount of module level instructions
+    Index getGlobalInstCount() const { return m_globals.getCount(); }
+        /// Get the amount of module level instructions read so far
+    Index getReadGlobalInstCount() const { return m_readGlobalCount; }
+
+    IRSerialData m_serialData;
+
+protected:
+        /// The children of a module level instruction, and all of their descendants, are in a contiguous
+        /// range of child runs (and so of instructions)
+    struct GlobalRuns
+    {
+        Index startRun = 0;
+        Index endRun = 0;
+    };
+
+        /// Create the module level instruction at globalIndex (relative to the first module child) and its descendants
+    SlangResult _createGlobal(Index globalIndex);
+        /// Make sure the instruction at instIndex has been created
+    SlangResult _requireInst(Ser::InstIndex instIndex);
+        /// Set the type and operands of the instruction at instIndex, creating the globals they are in if needed
+    SlangResult _completeInst(Index instIndex);
+        /// Set types, operands, children and source locs for all of the created globals that haven't had them set yet
+    SlangResult _completeCreatedGlobals();
+        /// Get the range of instruction indices of all the descendants of a module child. Empty if it has no children.
+    void _getDescendantRange(Index globalIndex, Index& outStart, Index& outEnd) const;
+        /// Get the string at index
+    UnownedStringSlice _getString(SerialStringData::StringIndex index) const { return m_strings[Index(index)]; }
+        /// Set the source locs from the debug information for the instructions [startIndex, endIndex)
+    void _setDebugSourceLocs(Index startIndex, Index endIndex);
+
+    RefPtr<IRModule> m_module;
+    RefPtr<SerialSourceLocReader> m_sourceLocReader;
+
+    List<UnownedStringSlice> m_strings;             ///< All strings, indexed by string index
+
+    List<IRInst*> m_insts;                          ///< Created instructions, indexed by instruction index. nullptr if not created.
+
+    Index m_firstGlobalIndex = 0;                   ///< Instruction index of the first module child
+    List<GlobalRuns> m_globals;                     ///< The child runs of each module child
+    List<Index> m_globalsInRunOrder;                ///< Module children (with children) in order of their child runs, and so descendant instruction indices
+
+    List<Ser::SourceLocRun> m_debugSourceLocRuns;   ///< Debug source loc runs sorted by instruction index
+
+    List<Index> m_pendingGlobals;                   ///< Globals created, but not completed
+    List<IRInst*> m_readGlobalValues;               ///< Globals with linkage read since last takeReadGlobalValues
+    IRInst* m_lastModuleDecoration = nullptr;       ///< Decorations of the module are kept before its children
+    Index m_readGlobalCount = 0;
+    bool m_haveReadRoots = false;
+};
+
 } // namespace Slang
 
 #endif
@@ -805,8 +805,7 @@ Name* SerialReader::getName(SerialIndex index)
     }
 
     UnownedStringSlice slice = getStringSlice(index);
-    String string(slice);
-    Name* name = m_namePool->getName(string);
+    Name* name = m_namePool->getName(slice);
     // Don't need to add to scope, because scoped on the pool
     m_objects[Index(index)] = name;
     return name;
@@ -6,6 +6,7 @@
 #include "../core/slang-archive-file-system.h"
 
 #include "slang-check.h"
+#include "slang-lookup.h"
 #include "slang-parameter-binding.h"
 #include "slang-lower-to-ir.h"
 #include "slang-mangle.h"
@@ -31,6 +32,7 @@
 #include "slang-serialize-container.h"
 
 #include "slang-check-impl.h"
+#include "slang-module-cache.h"
 
 #include "../../slang-tag-version.h"
 
@@ -358,6 +360,9 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
     // Hmm - don't have a suitable sink yet, so attempt to just not have one
     options.sink = nullptr;
 
+    // Most uses only need a small part of the stdlib IR (if any), so only read it when it's used
+    options.readIRLazily = true;
+
     SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(&riffContainer, options, containerData));
 
     for (auto& srcModule : containerData.modules)
@@ -376,9 +381,21 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
             }
             
             module->setModuleDecl(moduleDecl);
+
+            for (const auto& exportSymbol : srcModule.exportSymbols)
+            {
+                module->addExportSymbol(exportSymbol.mangledName.getUnownedSlice(), exportSymbol.symbol);
+            }
         }
 
-        module->setIRModule(srcModule.irModule);
+        if (srcModule.irModuleLoader)
+        {
+            module->setIRModuleLoader(srcModule.irModuleLoader);
+        }
+        else
+        {
+            module->setIRModule(srcModule.irModule);
+        }
 
         // Put in the loaded module map
         linkage->mapNameToLoadedModules.Add(sessionNamePool->getName(moduleName), module);
@@ -401,11 +418,42 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
         // We need to retain this AST so that we can use it in other code
         // (Note that the `Scope` type does not retain the AST it points to)
         stdlibModules.add(module);
+
+        _prepareBuiltinModuleForSharing(module);
     }
 
     return SLANG_OK;
 }
 
+static void _buildMemberDictionariesRec(ContainerDecl* containerDecl)
+{
+    buildMemberDictionary(containerDecl);
+    for (auto member : containerDecl->members)
+    {
+        if (auto childContainerDecl = as<ContainerDecl>(member))
+        {
+            _buildMemberDictionariesRec(childContainerDecl);
+        }
+    }
+}
+
+void Session::_prepareBuiltinModuleForSharing(Module* module)
+{
+    // Once loaded a builtin module is never changed. The exceptions are values that are normally computed
+    // when first used, so they are computed here before the module can be used from other threads.
+    if (auto moduleDecl = module->getModuleDecl())
+    {
+        _buildMemberDictionariesRec(moduleDecl);
+    }
+
+    m_sharedASTBuilder->initLazyTypes();
+
+    for (auto sourceFile : builtinSourceManager.getSourceFiles())
+    {
+        sourceFile->getLineBreakOffsets();
+    }
+}
+
 ISlangUnknown* Session::getInterface(const Guid& guid)
 {
     if(guid == IID_ISlangUnknown || guid == IID_IGlobalSession)
@@ -696,6 +744,7 @@ Linkage::Linkage(Session* session, ASTBuilder* astBuilder, Linkage* builtinLinka
     getNamePool()->setRootNamePool(session->getRootNamePool());
 
     m_defaultSourceManager.initialize(session->getBuiltinSourceManager(), nullptr);
+    m_preprocessorTokenCache = new PreprocessorTokenCache(&m_defaultSourceManager, getNamePool());
 
     setFileSystem(nullptr);
 
@@ -722,6 +771,11 @@ Linkage::~Linkage()
     destroyTypeCheckingCache();
 }
 
+void Linkage::setModuleCache(ModuleCache* moduleCache)
+{
+    m_moduleCache = moduleCache;
+}
+
 TypeCheckingCache* Linkage::getTypeCheckingCache()
 {
     if (!m_typeCheckingCache)
@@ -1596,27 +1650,36 @@ void FrontEndCompileRequest::parseTranslationUnit(
     //
     FrontEndPreprocessorHandler preprocessorHandler(module, astBuilder, getSink());
 
+    CompileInstrumentation* instrumentation = linkage->getInstrumentation();
+
     for (auto sourceFile : translationUnit->getSourceFiles())
     {
-        auto tokens = preprocessSource(
-            sourceFile,
-            getSink(),
-            &includeSystem,
-            combinedPreprocessorDefinitions,
-            getLinkage(),
-            &preprocessorHandler);
+        TokenList tokens;
+        {
+            CompileInstrumentation::PhaseScope phaseScope(instrumentation, CompilePhase::Preprocess);
+            tokens = preprocessSource(
+                sourceFile,
+                getSink(),
+                &includeSystem,
+                combinedPreprocessorDefinitions,
+                getLinkage(),
+                &preprocessorHandler);
+        }
 
         if (outputIncludes)
         {
             _outputIncludes(translationUnit->getSourceFiles(), getSink()->getSourceManager(), getSink());
         }
 
-        parseSourceFile(
-            astBuilder,
-            translationUnit,
-            tokens,
-            getSink(),
-            languageScope);
+        {
+            CompileInstrumentation::PhaseScope phaseScope(instrumentation, CompilePhase::Parse);
+            parseSourceFile(
+                astBuilder,
+                translationUnit,
+                tokens,
+                getSink(),
+                languageScope);
+        }
 
         // Let's try dumping
 
@@ -1663,6 +1726,8 @@ RefPtr<ComponentType> createSpecializedGlobalAndEntryPointsComponentType(
 
 void FrontEndCompileRequest::checkAllTranslationUnits()
 {
+    CompileInstrumentation::PhaseScope phaseScope(getLinkage()->getInstrumentation(), CompilePhase::Check);
+
     // Iterate over all translation units and
     // apply the semantic checking logic.
     for( auto& translationUnit : translationUnits )
@@ -1692,7 +1757,11 @@ void FrontEndCompileRequest::generateIR()
         /// Generate IR for translation unit.
         /// TODO(JS): Use the linkage ASTBuilder, because it seems possible that cross module constructs are possible in
         /// ir lowering.
-        RefPtr<IRModule> irModule(generateIRForTranslationUnit(getLinkage()->getASTBuilder(), translationUnit));
+        RefPtr<IRModule> irModule;
+        {
+            CompileInstrumentation::PhaseScope phaseScope(getLinkage()->getInstrumentation(), CompilePhase::LowerToIR);
+            irModule = generateIRForTranslationUnit(getLinkage()->getASTBuilder(), translationUnit);
+        }
 
         if (verifyDebugSerialization)
         {
@@ -2193,6 +2262,7 @@ void Linkage::loadParsedModule(
         // If we didn't run into any errors, then try to generate
         // IR code for the imported module.
         SLANG_ASSERT(errorCountAfter == 0);
+        CompileInstrumentation::PhaseScope phaseScope(m_instrumentation, CompilePhase::LowerToIR);
         loadedModule->setIRModule(generateIRForTranslationUnit(getASTBuilder(), translationUnit));
     }
     loadedModulesList.add(loadedModule);
@@ -2219,6 +2289,17 @@ RefPtr<Module> Linkage::loadModule(
     SourceLoc const&    srcLoc,
     DiagnosticSink*     sink)
 {
+    if (m_moduleCache)
+    {
+        if (RefPtr<Module> cachedModule = m_moduleCache->findModule(this, name, filePathInfo, sourceBlob, srcLoc, sink))
+        {
+            mapPathToLoadedModule.Add(filePathInfo.getMostUniqueIdentity(), cachedModule);
+            mapNameToLoadedModules.Add(name, cachedModule);
+            loadedModulesList.add(cachedModule);
+            return cachedModule;
+        }
+    }
+
     RefPtr<FrontEndCompileRequest> frontEndReq = new FrontEndCompileRequest(this, sink);
 
     RefPtr<TranslationUnitRequest> translationUnit = new TranslationUnitRequest(frontEndReq);
@@ -2240,6 +2321,7 @@ RefPtr<Module> Linkage::loadModule(
     translationUnit->addSourceFile(sourceFile);
 
     int errorCountBefore = sink->getErrorCount();
+    const int diagnosticCountBefore = sink->getDiagnosticCount();
     frontEndReq->parseTranslationUnit(translationUnit);
     int errorCountAfter = sink->getErrorCount();
 
@@ -2268,6 +2350,12 @@ RefPtr<Module> Linkage::loadModule(
         return nullptr;
     }
 
+    // Only modules without any diagnostics are stored, as a module read from the cache doesn't reproduce them
+    if (m_moduleCache && sink->getDiagnosticCount() == diagnosticCountBefore)
+    {
+        m_moduleCache->addModule(this, name, module, filePathInfo, sourceBlob);
+    }
+
     return module;
 }
 
@@ -2562,7 +2650,7 @@ void Module::_processFindDeclsExportSymbolsRec(Decl* decl)
     }
 }
 
-NodeBase* Module::findExportFromMangledName(const UnownedStringSlice& slice)
+void Module::_findExportSymbols()
 {
     // Will be non zero if has been previously attempted
     if (m_mangledExportSymbols.getCount() == 0)
@@ -2576,9 +2664,77 @@ NodeBase* Module::findExportFromMangledName(const UnownedStringSlice& slice)
             m_mangledExportSymbols.add(nullptr);
         }        
     }
+}
+
+NodeBase* Module::findExportFromMangledName(const UnownedStringSlice& slice)
+{
+    _findExportSymbols();
 
     const Index index = m_mangledExportPool.findIndex(slice);
-    return (index >= 0) ? m_mangledExportSymbols[index] : nullptr;
+    if (index >= 0)
+    {
+        return m_mangledExportSymbols[index];
+    }
+
+    // The module decl isn't an export symbol, but can be referred to from another module (by an `import`)
+    ModuleDecl* moduleDecl = getModuleDecl();
+    if (moduleDecl && getMangledName(getASTBuilder(), moduleDecl).getUnownedSlice() == slice)
+    {
+        return moduleDecl;
+    }
+    return nullptr;
+}
+
+Index Module::getExportSymbolCount()
+{
+    _findExportSymbols();
+    // If there are no exports, there is a single nullptr entry (which has no name in the pool)
+    return m_mangledExportPool.getSlicesCount();
+}
+
+NodeBase* Module::getExportSymbol(Index index, UnownedStringSlice& outMangledName)
+{
+    outMangledName = m_mangledExportPool.getSlice(StringSlicePool::Handle(index));
+    return m_mangledExportSymbols[index];
+}
+
+void Module::addExportSymbol(const UnownedStringSlice& mangledName, NodeBase* symbol)
+{
+    const Index index = Index(m_mangledExportPool.add(mangledName));
+    if (index == m_mangledExportSymbols.getCount())
+    {
+        m_mangledExportSymbols.add(symbol);
+    }
+}
+
+void Module::_loadIRModule()
+{
+    // Builtin modules are shared between threads, and loaders for modules read from the same container share
+    // state, so all loads are serialized. Loading only happens once per module, so contention doesn't matter.
+    static std::mutex loadMutex;
+    std::lock_guard<std::mutex> lock(loadMutex);
+
+    if (!m_isIRModuleLoadPending.load(std::memory_order_relaxed))
+    {
+        // Another thread loaded it whilst this one was waiting
+        return;
+    }
+
+    RefPtr<IRModuleLoader> loader = m_irModuleLoader;
+    m_irModuleLoader.setNull();
+
+    RefPtr<IRModule> irModule;
+    if (SLANG_SUCCEEDED(loader->loadIRModule(irModule)))
+    {
+        m_irModule = irModule;
+    }
+    else
+    {
+        SLANG_ASSERT(!"Unable to load IR module");
+    }
+
+    // Clear even on failure, so a failure doesn't lead to repeated attempts
+    m_isIRModuleLoadPending.store(false, std::memory_order_release);
 }
 
 // ComponentType
@@ -3634,6 +3790,8 @@ void Session::addBuiltinSource(
     // We need to retain this AST so that we can use it in other code
     // (Note that the `Scope` type does not retain the AST it points to)
     stdlibModules.add(module);
+
+    _prepareBuiltinModuleForSharing(module);
 }
 
 Session::~Session()
@@ -3834,6 +3992,9 @@ SlangResult _addLibraryReference(EndToEndCompileRequest* req, Stream* stream)
         options.linkage = req->getLinkage();
         options.sink = req->getSink();
 
+        // Linking typically only uses a small part of a library, so only read the global values it uses
+        options.readIRGlobalValuesLazily = true;
+
         SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(&riffContainer, options, containerData));
 
         for (const auto& module : containerData.modules)
@@ -3843,6 +4004,10 @@ SlangResult _addLibraryReference(EndToEndCompileRequest* req, Stream* stream)
             {
                 linkage->m_libModules.add(module.irModule);
             }
+            else if (module.irLazyModule)
+            {
+                linkage->m_lazyLibModules.add(module.irLazyModule);
+            }
         }
 
         FrontEndCompileRequest* frontEndRequest = req->getFrontEndReq();
@@ -3977,6 +4142,15 @@ SlangResult EndToEndCompileRequest::EndToEndCompileRequest::compile()
 {
     SlangResult res = SLANG_FAIL;
 
+    // Instrumentation measures the most recent compile. The scope makes it current on this thread for the whole
+    // compile, so that counters are attributed to it whatever the phase.
+    CompileInstrumentation* instrumentation = getLinkage()->getInstrumentation();
+    if (instrumentation)
+    {
+        instrumentation->reset();
+    }
+    CompileInstrumentation::PhaseScope phaseScope(instrumentation, CompilePhase::Other);
+
 #if !defined(SLANG_DEBUG_INTERNAL_ERROR)
     // By default we'd like to catch as many internal errors as possible,
     // and report them to the user nicely (rather than just crash their
@@ -4024,6 +4198,21 @@ SlangResult EndToEndCompileRequest::EndToEndCompileRequest::compile()
     }
 #endif
 
+    if (instrumentation)
+    {
+        instrumentation->update();
+
+        if (m_instrumentationTracePath.getLength())
+        {
+            StringBuilder trace;
+            instrumentation->writeTrace(trace);
+            if (SLANG_FAILED(File::writeAllBytes(m_instrumentationTracePath, trace.getBuffer(), size_t(trace.getLength()))))
+            {
+                getSink()->diagnose(SourceLoc(), Diagnostics::cannotWriteOutputFile, m_instrumentationTracePath);
+            }
+        }
+    }
+
     // Repro dump handling
     {
         if (m_dumpRepro.getLength())
@@ -4331,6 +4520,105 @@ SlangResult EndToEndCompileRequest::getProgramWithEntryPoints(slang::IComponentT
     return SLANG_OK;
 }
 
+void EndToEndCompileRequest::setInstrumentationFlags(SlangInstrumentationFlags flags)
+{
+    Linkage* linkage = getLinkage();
+    if ((flags & (SLANG_INSTRUMENTATION_FLAG_ENABLE | SLANG_INSTRUMENTATION_FLAG_TRACE | SLANG_INSTRUMENTATION_FLAG_IR_SIZE)) == 0)
+    {
+        linkage->setInstrumentation(nullptr);
+        return;
+    }
+
+    CompileInstrumentation* instrumentation = linkage->getInstrumentation();
+    if (!instrumentation)
+    {
+        instrumentation = new CompileInstrumentation;
+        linkage->setInstrumentation(instrumentation);
+    }
+    CompileInstrumentation::Flags instrumentationFlags = 0;
+    if (flags & SLANG_INSTRUMENTATION_FLAG_TRACE)
+    {
+        instrumentationFlags |= CompileInstrumentation::Flag::Trace;
+    }
+    if (flags & SLANG_INSTRUMENTATION_FLAG_IR_SIZE)
+    {
+        instrumentationFlags |= CompileInstrumentation::Flag::IRSize;
+    }
+    instrumentation->setFlags(instrumentationFlags);
+}
+
+SlangInt EndToEndCompileRequest::getInstrumentationEntryCount()
+{
+    CompileInstrumentation* instrumentation = getLinkage()->getInstrumentation();
+    if (!instrumentation)
+    {
+        return 0;
+    }
+    return Index(CompilePhase::CountOf) + Index(CompileCounter::CountOf) + instrumentation->getPasses().getCount();
+}
+
+SlangResult EndToEndCompileRequest::getInstrumentationEntry(SlangInt index, SlangInstrumentationEntry* outEntry)
+{
+    CompileInstrumentation* instrumentation = getLinkage()->getInstrumentation();
+    if (!instrumentation || index < 0 || index >= getInstrumentationEntryCount())
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    // The entries are the phases, then the counters, then the passes
+    if (index < Index(CompilePhase::CountOf))
+    {
+        const CompilePhase phase = CompilePhase(index);
+        outEntry->name = CompileInstrumentation::getPhaseName(phase).begin();
+        outEntry->kind = SLANG_INSTRUMENTATION_ENTRY_KIND_PHASE;
+        outEntry->seconds = instrumentation->getSeconds(phase);
+        outEntry->count = SlangUInt(instrumentation->getEnterCount(phase));
+        outEntry->irInstDelta = 0;
+        return SLANG_OK;
+    }
+    index -= Index(CompilePhase::CountOf);
+
+    if (index < Index(CompileCounter::CountOf))
+    {
+        const CompileCounter counter = CompileCounter(index);
+        outEntry->name = CompileInstrumentation::getCounterName(counter).begin();
+        outEntry->kind = SLANG_INSTRUMENTATION_ENTRY_KIND_COUNTER;
+        outEntry->seconds = 0.0;
+        outEntry->count = SlangUInt(instrumentation->getCount(counter));
+        outEntry->irInstDelta = 0;
+        return SLANG_OK;
+    }
+    index -= Index(CompileCounter::CountOf);
+
+    const auto& pass = instrumentation->getPasses()[Index(index)];
+    outEntry->name = pass.name;
+    outEntry->kind = SLANG_INSTRUMENTATION_ENTRY_KIND_PASS;
+    outEntry->seconds = instrumentation->getPassSeconds(pass);
+    outEntry->count = SlangUInt(pass.runCount);
+    outEntry->irInstDelta = SlangInt(pass.irInstDelta);
+    return SLANG_OK;
+}
+
+SlangResult EndToEndCompileRequest::getInstrumentationTrace(ISlangBlob** outBlob)
+{
+    CompileInstrumentation* instrumentation = getLinkage()->getInstrumentation();
+    if (!instrumentation || (instrumentation->getFlags() & CompileInstrumentation::Flag::Trace) == 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    StringBuilder trace;
+    instrumentation->writeTrace(trace);
+
+    *outBlob = StringUtil::createStringBlob(trace).detach();
+    return SLANG_OK;
+}
+
+void EndToEndCompileRequest::setModuleCachePath(const char* path)
+{
+    getLinkage()->setModuleCache(path ? new ModuleCache(path) : nullptr);
+}
+
 SlangResult EndToEndCompileRequest::getModule(SlangInt translationUnitIndex, slang::IModule** outModule)
 {
     auto module = getFrontEndReq()->getTranslationUnit(translationUnitIndex)->getModule();
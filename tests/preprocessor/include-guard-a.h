@@ -0,0 +1,11 @@
+// include-guard-a.h
+#ifndef INCLUDE_GUARD_A_H
+#define INCLUDE_GUARD_A_H
+
+#if 0
+#else
+#endif
+
+float a(float x) { return x; }
+
+#endif // INCLUDE_GUARD_A_H
@@ -0,0 +1,6 @@
+// include-guard-b.h
+#ifndef INCLUDE_GUARD_B_H
+#define INCLUDE_GUARD_B_H
+#endif
+
+float B_FUNC(float x) { return x; }
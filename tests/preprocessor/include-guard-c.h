@@ -0,0 +1,7 @@
+// include-guard-c.h
+#ifndef INCLUDE_GUARD_C_H
+#define INCLUDE_GUARD_C_H
+float c0(float x) { return x; }
+#else
+float c1(float x) { return x; }
+#endif
@@ -0,0 +1,7 @@
+// include-guard-d.h
+#ifndef INCLUDE_GUARD_D_H
+#define INCLUDE_GUARD_D_H
+
+float D_FUNC(float x) { return x; }
+
+#endif
@@ -11,6 +11,8 @@
 
 #define SLANG_PRELUDE_NAMESPACE CPPPrelude
 #include "../../prelude/slang-cpp-types.h"
+#include "../../prelude/slang-cpp-dispatch.h"
+#include "../../prelude/slang-cpp-texture.h"
 
 struct UniformState;
 
@@ -45,44 +47,21 @@ CPPPrelude::TextureDimensions _calcMipDims(int mipLevel, const CPPPrelude::Textu
 }
 
 template <int COUNT>
-struct ValueTexture : public CPUComputeUtil::Resource, public CPPPrelude::ITexture
+struct ReadTexture : public CPUComputeUtil::Resource, public CPPPrelude::TiledTexture<COUNT>
 {
-    // ITexture interface
-    virtual CPPPrelude::TextureDimensions GetDimensions(int mipLevel) SLANG_OVERRIDE
-    {
-        return _calcMipDims(mipLevel, m_dims);
-    }
-    virtual void Load(const int32_t* loc, void* out) SLANG_OVERRIDE
-    {
-        _set(out);
-    }
-    virtual void Sample(CPPPrelude::SamplerState samplerState, const float* loc, void* out) SLANG_OVERRIDE
-    {
-        _set(out);
-    }
-    virtual void SampleLevel(CPPPrelude::SamplerState samplerState, const float* loc, float level, void* out) SLANG_OVERRIDE
-    {
-        _set(out);
-    }
+    typedef CPPPrelude::TiledTexture<COUNT> Super;
 
-    ValueTexture(const CPPPrelude::TextureDimensions& dims, float value) :
-        m_value(value),
-        m_dims(dims)
+    ReadTexture(const CPPPrelude::TextureDimensions& dims, float value) :
+        Super(dims)
     {
-        m_interface = static_cast<CPPPrelude::ITexture*>(this);
-    }
-
-    void _set(void* out)
-    {
-        float* dst = (float*)out;
+        float texel[COUNT];
         for (int i = 0; i < COUNT; ++i)
         {
-            dst[i] = m_value;
+            texel[i] = value;
         }
+        Super::fill(texel);
+        m_interface = static_cast<CPPPrelude::ITexture*>(this);
     }
-
-    float m_value;
-    CPPPrelude::TextureDimensions m_dims;
 };
 
 class FloatTextureData
@@ -308,10 +287,10 @@ static CPUComputeUtil::Resource* _newReadTexture(int elemCount, const CPPPrelude
 {
     switch (elemCount)
     {
-        case 1: return new ValueTexture<1>(dims, initialValue);
-        case 2: return new ValueTexture<2>(dims, initialValue);
-        case 3: return new ValueTexture<3>(dims, initialValue);
-        case 4: return new ValueTexture<4>(dims, initialValue);
+        case 1: return new ReadTexture<1>(dims, initialValue);
+        case 2: return new ReadTexture<2>(dims, initialValue);
+        case 3: return new ReadTexture<3>(dims, initialValue);
+        case 4: return new ReadTexture<4>(dims, initialValue);
         default: break;
     }
     return nullptr;
@@ -723,6 +702,7 @@ SlangResult CPUComputeUtil::fillRuntimeHandleInBuffers(
             break;
         }
         case ExecuteStyle::GroupRange:
+        case ExecuteStyle::ParallelGroupRange:
         {
             CPPPrelude::ComputeFunc groupRangeFunc = nullptr;
             groupRangeFunc = (CPPPrelude::ComputeFunc)sharedLib->findFuncByName(entryPointName);
@@ -802,6 +782,18 @@ SlangResult CPUComputeUtil::fillRuntimeHandleInBuffers(
             groupRangeFunc(&varying, uniformEntryPointParams, uniformState);
             break;
         }
+        case ExecuteStyle::ParallelGroupRange:
+        {
+            if (!info.m_threadPool)
+            {
+                return SLANG_FAIL;
+            }
+            CPPPrelude::ComputeFunc groupRangeFunc = (CPPPrelude::ComputeFunc)info.m_func;
+            const CPPPrelude::uint3 groupCount = { info.m_dispatchSize[0], info.m_dispatchSize[1], info.m_dispatchSize[2] };
+
+            info.m_threadPool->dispatch(groupRangeFunc, groupCount, uniformEntryPointParams, uniformState, info.m_grainSize);
+            break;
+        }
         case ExecuteStyle::Thread:
         {
             CPPPrelude::ComputeThreadFunc threadFunc = (CPPPrelude::ComputeThreadFunc)info.m_func;
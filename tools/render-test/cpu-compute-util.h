@@ -8,6 +8,10 @@
 
 #include "../../source/core/slang-basic.h"
 
+namespace CPPPrelude {
+class ComputeDispatchThreadPool;
+}
+
 namespace renderer_test {
 
 struct CPUComputeUtil
@@ -18,6 +22,7 @@ struct CPUComputeUtil
         Thread,
         Group,
         GroupRange,
+        ParallelGroupRange,         ///< Like GroupRange, but with the range split across the threads of m_threadPool
     };
 
     struct Resource : public Slang::RefObject
@@ -50,6 +55,10 @@ struct CPUComputeUtil
 
         void* m_uniformState;
         void* m_uniformEntryPointParams;
+
+            /// Used by ParallelGroupRange
+        CPPPrelude::ComputeDispatchThreadPool* m_threadPool = nullptr;
+        uint32_t m_grainSize = 0;
     };
 
         /// True if this feature is available on CPU
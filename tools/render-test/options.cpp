@@ -218,6 +218,32 @@ static SlangResult _setRendererType(RendererType type, const char* arg, Slang::W
                 outOptions.computeDispatchSize[i] = v;
             }
         }
+        else if (strcmp(arg, "-cpu-threads") == 0 || strcmp(arg, "-cpu-grain-size") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expecting an integer for '%s'\n", arg);
+                return SLANG_FAIL;
+            }
+            const int value = StringToInt(String(*argCursor++));
+            if (value < 0)
+            {
+                stdError.print("error: expecting a non negative integer for '%s'\n", arg);
+                return SLANG_FAIL;
+            }
+            if (strcmp(arg, "-cpu-threads") == 0)
+            {
+                outOptions.cpuThreadCount = value;
+            }
+            else
+            {
+                outOptions.cpuGrainSize = uint32_t(value);
+            }
+        }
+        else if (strcmp(arg, "-cpu-group-as-lanes") == 0)
+        {
+            outOptions.cpuGroupAsLanes = true;
+        }
         else if (strcmp(arg, "-source-language") == 0)
         {
             if (argCursor == argEnd)
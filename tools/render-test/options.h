@@ -81,6 +81,13 @@ struct Options
 
     uint32_t computeDispatchSize[3] = { 1, 1, 1 };
 
+        /// The number of threads used to execute a compute dispatch on CPU. 0 means use all of the hardware threads.
+    int cpuThreadCount = 1;
+        /// The number of groups in each chunk of work split between CPU threads. 0 chooses a size automatically.
+    uint32_t cpuGrainSize = 0;
+        /// If set, C++ for compute entry points runs the threads of a group as lanes of a vectorizable loop
+    bool cpuGroupAsLanes = false;
+
     Slang::String nvapiExtnSlot;                               ///< The nvapiRegister to use.
 
     static SlangResult parse(int argc, const char*const* argv, Slang::WriterHelper stdError, Options& outOptions);
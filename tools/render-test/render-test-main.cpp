@@ -19,6 +19,7 @@
 #include "shader-input-layout.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <memory>
 
 #include "window.h"
 
@@ -26,6 +27,10 @@
 
 #include "cpu-compute-util.h"
 
+#define SLANG_PRELUDE_NAMESPACE CPPPrelude
+#include "../../prelude/slang-cpp-types.h"
+#include "../../prelude/slang-cpp-dispatch.h"
+
 #if RENDER_TEST_CUDA
 #   include "cuda/cuda-compute-util.h"
 #endif
@@ -1207,9 +1212,19 @@ static SlangResult _innerMain(Slang::StdWriters* stdWriters, SlangSession* sessi
             SLANG_RETURN_ON_FAIL(CPUComputeUtil::fillRuntimeHandleInBuffers(compilationAndLayout, context, sharedLibrary.get()));
             SLANG_RETURN_ON_FAIL(CPUComputeUtil::calcBindings(compilationAndLayout, context));
 
+            // If more than one thread is requested, split the dispatch across a thread pool
+            std::unique_ptr<CPPPrelude::ComputeDispatchThreadPool> threadPool;
+            if (options.cpuThreadCount != 1)
+            {
+                threadPool.reset(new CPPPrelude::ComputeDispatchThreadPool(options.cpuThreadCount));
+            }
+            const auto executeStyle = threadPool ? CPUComputeUtil::ExecuteStyle::ParallelGroupRange : CPUComputeUtil::ExecuteStyle::GroupRange;
+
             // Get the execution info from the lib
             CPUComputeUtil::ExecuteInfo info;
-            SLANG_RETURN_ON_FAIL(CPUComputeUtil::calcExecuteInfo(CPUComputeUtil::ExecuteStyle::GroupRange, sharedLibrary, options.computeDispatchSize, compilationAndLayout, context, info));
+            SLANG_RETURN_ON_FAIL(CPUComputeUtil::calcExecuteInfo(executeStyle, sharedLibrary, options.computeDispatchSize, compilationAndLayout, context, info));
+            info.m_threadPool = threadPool.get();
+            info.m_grainSize = options.cpuGrainSize;
 
             const uint64_t startTicks = ProcessUtil::getClockTick();
 
@@ -109,6 +109,10 @@ void ShaderCompilerUtil::Output::reset()
 
     spSetCodeGenTarget(slangRequest, input.target);
     spSetTargetProfile(slangRequest, 0, spFindProfile(session, input.profile));
+    if (request.targetFlags)
+    {
+        spSetTargetFlags(slangRequest, 0, request.targetFlags);
+    }
 
     // Define a macro so that shader code in a test can detect what language we
     // are nominally working with.
@@ -406,6 +410,11 @@ void ShaderCompilerUtil::Output::reset()
 
     compileRequest.compileArgs = compileArgs;
 
+    if (options.cpuGroupAsLanes)
+    {
+        compileRequest.targetFlags |= SLANG_TARGET_FLAG_CPU_GROUP_AS_LANES;
+    }
+
     compileRequest.source = sourceInfo;
 
     // Now we will add the "default" entry point names/stages that
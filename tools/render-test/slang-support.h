@@ -40,6 +40,9 @@ struct ShaderCompileRequest
     Slang::List<Slang::String> entryPointSpecializationArgs;
 
     Slang::List<Slang::CommandLine::Arg> compileArgs;
+
+        /// Flags for the target (SLANG_TARGET_FLAG_...)
+    SlangTargetFlags targetFlags = 0;
 };
 
 
@@ -0,0 +1,642 @@
+// slang-profile-compile.cpp
+#include "slang-profile-compile.h"
+
+#include "slang-profile-memory.h"
+
+#include "../../source/core/slang-char-util.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string-util.h"
+#include "../../source/core/slang-type-text-util.h"
+
+#include "../../source/slang/slang-compiler.h"
+
+#include <stdio.h>
+
+namespace Slang
+{
+
+namespace { // anonymous
+
+struct EntryPointDesc
+{
+    String name;
+    SlangStage stage;
+};
+
+struct PhaseResult
+{
+    double seconds = 0;
+    AllocationStats allocationStats;
+};
+
+struct FileResult
+{
+    double getTotalSeconds() const
+    {
+        double seconds = 0;
+        for (const auto& phase : phases)
+        {
+            seconds += phase.seconds;
+        }
+        return seconds;
+    }
+
+    PhaseResult phases[Index(CompilePhase::CountOf)];
+};
+
+struct TargetResult
+{
+    String targetName;
+    Index fileCount = 0;                ///< The number of files that compiled, and are included in the phase results
+    Index failedCount = 0;              ///< The number of files that failed to compile
+    FileResult total;                   ///< Times and allocations are summed over the files, peak is the maximum
+};
+
+/* Just enough of a JSON reader to read back the results written by _writeJSON. On an error, hasError is set and
+reading stops. */
+class JSONReader
+{
+public:
+        /// Read an object, calling readField with the key of each field, with the reader at the field's value
+    template <typename ReadField>
+    void readObject(const ReadField& readField)
+    {
+        _expect('{');
+        while (!m_hasError && !_tryRead('}'))
+        {
+            const String key = readString();
+            _expect(':');
+            if (m_hasError)
+            {
+                return;
+            }
+            readField(key);
+            _tryRead(',');
+        }
+    }
+        /// Read an array, calling readElement with the reader at each element
+    template <typename ReadElement>
+    void readArray(const ReadElement& readElement)
+    {
+        _expect('[');
+        while (!m_hasError && !_tryRead(']'))
+        {
+            readElement();
+            _tryRead(',');
+        }
+    }
+        /// Read a string. Escapes are not handled other than to keep the escaped character.
+    String readString()
+    {
+        _expect('"');
+        StringBuilder builder;
+        while (!m_hasError)
+        {
+            if (m_cursor >= m_end)
+            {
+                m_hasError = true;
+                break;
+            }
+            char c = *m_cursor++;
+            if (c == '"')
+            {
+                break;
+            }
+            if (c == '\\' && m_cursor < m_end)
+            {
+                c = *m_cursor++;
+            }
+            builder.append(c);
+        }
+        return builder.ProduceString();
+    }
+    double readNumber()
+    {
+        _skipWhitespace();
+        // The text is held in a String, so is zero terminated
+        char* numberEnd = nullptr;
+        const double value = strtod(m_cursor, &numberEnd);
+        if (numberEnd == m_cursor || numberEnd > m_end)
+        {
+            m_hasError = true;
+            return 0.0;
+        }
+        m_cursor = numberEnd;
+        return value;
+    }
+    void skipValue()
+    {
+        _skipWhitespace();
+        const char c = (m_cursor < m_end) ? *m_cursor : 0;
+        switch (c)
+        {
+            case '{':   readObject([&](const String&) { skipValue(); }); break;
+            case '[':   readArray([&]() { skipValue(); }); break;
+            case '"':   readString(); break;
+            case 't':   m_cursor += (m_end - m_cursor >= 4) ? 4 : 0; break;
+            case 'f':   m_cursor += (m_end - m_cursor >= 5) ? 5 : 0; break;
+            case 'n':   m_cursor += (m_end - m_cursor >= 4) ? 4 : 0; break;
+            default:    readNumber(); break;
+        }
+    }
+
+    bool hasError() const { return m_hasError; }
+
+    JSONReader(const UnownedStringSlice& text):
+        m_cursor(text.begin()),
+        m_end(text.end())
+    {
+    }
+
+protected:
+    void _skipWhitespace()
+    {
+        while (m_cursor < m_end && (*m_cursor == ' ' || *m_cursor == '\t' || *m_cursor == '\r' || *m_cursor == '\n'))
+        {
+            m_cursor++;
+        }
+    }
+    bool _tryRead(char c)
+    {
+        _skipWhitespace();
+        if (m_cursor < m_end && *m_cursor == c)
+        {
+            m_cursor++;
+            return true;
+        }
+        return false;
+    }
+    void _expect(char c)
+    {
+        if (!_tryRead(c))
+        {
+            m_hasError = true;
+        }
+    }
+
+    const char* m_cursor;
+    const char* m_end;
+    bool m_hasError = false;
+};
+
+} // anonymous
+
+static const double kMinRegressionSeconds = 0.001;
+
+    /// Find the entry points to compile a test with from its '//TEST' lines. The first line that names entry
+    /// points (with -entry, and -stage or a -profile that implies a stage) is used.
+    /// If there isn't one, functions marked with [shader(...)] are used, and failing that computeMain (the entry point
+    /// render-test uses by default) if the source contains it.
+static void _findEntryPoints(const String& source, List<EntryPointDesc>& outEntryPoints)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(source.getUnownedSlice(), lines);
+
+    for (const auto& line : lines)
+    {
+        if (!line.startsWith("//TEST"))
+        {
+            continue;
+        }
+
+        List<UnownedStringSlice> args;
+        StringUtil::split(line, ' ', args);
+
+        String entryPointName;
+        Stage stage = Stage::Unknown;
+        for (Index i = 0; i + 1 < args.getCount(); ++i)
+        {
+            const auto& arg = args[i];
+            const auto& value = args[i + 1];
+            if (arg == "-entry")
+            {
+                entryPointName = String(value);
+            }
+            else if (arg == "-stage")
+            {
+                stage = findStageByName(String(value));
+            }
+            else if (arg == "-profile" && stage == Stage::Unknown)
+            {
+                stage = Profile::lookUp(value).getStage();
+            }
+
+            if (entryPointName.getLength() && stage != Stage::Unknown)
+            {
+                outEntryPoints.add(EntryPointDesc{ entryPointName, SlangStage(stage) });
+                entryPointName = String();
+                stage = Stage::Unknown;
+            }
+        }
+
+        if (outEntryPoints.getCount())
+        {
+            return;
+        }
+    }
+
+    // Functions marked with [shader("stage")]. The name is the identifier in front of the first '(' after the attribute.
+    const UnownedStringSlice attributeStart = UnownedStringSlice::fromLiteral("[shader(\"");
+    const UnownedStringSlice text = source.getUnownedSlice();
+    for (Index index = text.indexOf(attributeStart); index >= 0; )
+    {
+        const UnownedStringSlice rest(text.begin() + index + attributeStart.getLength(), text.end());
+        const Index stageEnd = rest.indexOf('"');
+        const Index nameEnd = rest.indexOf('(');
+        if (stageEnd < 0 || nameEnd < 0)
+        {
+            break;
+        }
+
+        const char* nameStart = rest.begin() + nameEnd;
+        while (nameStart > rest.begin() && (CharUtil::isAlpha(nameStart[-1]) || CharUtil::isDigit(nameStart[-1]) || nameStart[-1] == '_'))
+        {
+            nameStart--;
+        }
+
+        const Stage stage = findStageByName(String(UnownedStringSlice(rest.begin(), rest.begin() + stageEnd)));
+        if (stage != Stage::Unknown && nameStart < rest.begin() + nameEnd)
+        {
+            outEntryPoints.add(EntryPointDesc{ String(UnownedStringSlice(nameStart, rest.begin() + nameEnd)), SlangStage(stage) });
+        }
+
+        const Index nextIndex = rest.indexOf(attributeStart);
+        index = (nextIndex >= 0) ? (index + attributeStart.getLength() + nextIndex) : -1;
+    }
+
+    if (outEntryPoints.getCount() == 0 && source.indexOf("computeMain") >= 0)
+    {
+        outEntryPoints.add(EntryPointDesc{ "computeMain", SLANG_STAGE_COMPUTE });
+    }
+}
+
+static SlangResult _compileFile(
+    slang::IGlobalSession* globalSession,
+    CompileInstrumentation* instrumentation,
+    const String& filePath,
+    const List<EntryPointDesc>& entryPoints,
+    SlangCompileTarget target,
+    FileResult& outResult)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    spSetCodeGenTarget(request, target);
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceFile(request, translationUnitIndex, filePath.getBuffer());
+    for (const auto& entryPoint : entryPoints)
+    {
+        spAddEntryPoint(request, translationUnitIndex, entryPoint.name.getBuffer(), entryPoint.stage);
+    }
+
+    asInternal(request)->getLinkage()->setInstrumentation(instrumentation);
+
+    instrumentation->reset();
+    AllocationTracker::reset();
+
+    const SlangResult res = spCompile(request);
+
+    instrumentation->update();
+    for (Index i = 0; i < Index(CompilePhase::CountOf); ++i)
+    {
+        outResult.phases[i].seconds = instrumentation->getSeconds(CompilePhase(i));
+        outResult.phases[i].allocationStats = AllocationTracker::getStats(CompilePhase(i));
+    }
+
+    // Destroying the request is not included in the results
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+static void _accumulate(const FileResult& result, FileResult& ioTotal)
+{
+    for (Index i = 0; i < Index(CompilePhase::CountOf); ++i)
+    {
+        const PhaseResult& phase = result.phases[i];
+        PhaseResult& total = ioTotal.phases[i];
+
+        total.seconds += phase.seconds;
+        total.allocationStats.allocationCount += phase.allocationStats.allocationCount;
+        total.allocationStats.allocatedBytes += phase.allocationStats.allocatedBytes;
+        if (phase.allocationStats.peakBytes > total.allocationStats.peakBytes)
+        {
+            total.allocationStats.peakBytes = phase.allocationStats.peakBytes;
+        }
+    }
+}
+
+static void _appendJSONString(const UnownedStringSlice& text, StringBuilder& out)
+{
+    out << "\"";
+    for (const char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out << "\\";
+        }
+        out.append(c);
+    }
+    out << "\"";
+}
+
+static void _writeJSON(const ProfileCompileOptions& options, const List<TargetResult>& results, StringBuilder& out)
+{
+    out << "{\n";
+    out << "    \"version\": 1,\n";
+    out << "    \"repeatCount\": " << options.repeatCount << ",\n";
+    out << "    \"allAllocationsTracked\": " << (AllocationTracker::isTrackingAllAllocations() ? "true" : "false") << ",\n";
+
+    out << "    \"corpus\": [";
+    for (Index i = 0; i < options.corpusPaths.getCount(); ++i)
+    {
+        out << (i ? ", " : "");
+        _appendJSONString(options.corpusPaths[i].getUnownedSlice(), out);
+    }
+    out << "],\n";
+
+    out << "    \"targets\": [\n";
+    for (Index i = 0; i < results.getCount(); ++i)
+    {
+        const TargetResult& result = results[i];
+        out << "        {\n";
+        out << "            \"target\": ";
+        _appendJSONString(result.targetName.getUnownedSlice(), out);
+        out << ",\n";
+        out << "            \"fileCount\": " << result.fileCount << ",\n";
+        out << "            \"failedCount\": " << result.failedCount << ",\n";
+        out << "            \"phases\": [\n";
+        for (Index j = 0; j < Index(CompilePhase::CountOf); ++j)
+        {
+            const PhaseResult& phase = result.total.phases[j];
+            out << "                { \"phase\": ";
+            _appendJSONString(CompileInstrumentation::getPhaseName(CompilePhase(j)), out);
+            StringUtil::appendFormat(out, ", \"seconds\": %.6f, \"allocations\": %llu, \"allocatedBytes\": %llu, \"peakBytes\": %llu }",
+                phase.seconds,
+                (unsigned long long)phase.allocationStats.allocationCount,
+                (unsigned long long)phase.allocationStats.allocatedBytes,
+                (unsigned long long)phase.allocationStats.peakBytes);
+            out << ((j + 1 < Index(CompilePhase::CountOf)) ? ",\n" : "\n");
+        }
+        out << "            ]\n";
+        out << "        }" << ((i + 1 < results.getCount()) ? ",\n" : "\n");
+    }
+    out << "    ]\n";
+    out << "}\n";
+}
+
+static CompilePhase _findPhase(const UnownedStringSlice& name)
+{
+    for (Index i = 0; i < Index(CompilePhase::CountOf); ++i)
+    {
+        if (CompileInstrumentation::getPhaseName(CompilePhase(i)) == name)
+        {
+            return CompilePhase(i);
+        }
+    }
+    return CompilePhase::CountOf;
+}
+
+    /// Read results written by _writeJSON
+static SlangResult _readJSON(const String& text, List<TargetResult>& outResults)
+{
+    JSONReader reader(text.getUnownedSlice());
+    reader.readObject([&](const String& key)
+    {
+        if (key != "targets")
+        {
+            reader.skipValue();
+            return;
+        }
+        reader.readArray([&]()
+        {
+            TargetResult result;
+            reader.readObject([&](const String& targetKey)
+            {
+                if (targetKey == "target")
+                {
+                    result.targetName = reader.readString();
+                }
+                else if (targetKey == "fileCount")
+                {
+                    result.fileCount = Index(reader.readNumber());
+                }
+                else if (targetKey == "failedCount")
+                {
+                    result.failedCount = Index(reader.readNumber());
+                }
+                else if (targetKey == "phases")
+                {
+                    reader.readArray([&]()
+                    {
+                        CompilePhase phase = CompilePhase::CountOf;
+                        PhaseResult phaseResult;
+                        reader.readObject([&](const String& phaseKey)
+                        {
+                            if (phaseKey == "phase")
+                            {
+                                phase = _findPhase(reader.readString().getUnownedSlice());
+                            }
+                            else if (phaseKey == "seconds")
+                            {
+                                phaseResult.seconds = reader.readNumber();
+                            }
+                            else if (phaseKey == "allocations")
+                            {
+                                phaseResult.allocationStats.allocationCount = uint64_t(reader.readNumber());
+                            }
+                            else if (phaseKey == "allocatedBytes")
+                            {
+                                phaseResult.allocationStats.allocatedBytes = uint64_t(reader.readNumber());
+                            }
+                            else if (phaseKey == "peakBytes")
+                            {
+                                phaseResult.allocationStats.peakBytes = uint64_t(reader.readNumber());
+                            }
+                            else
+                            {
+                                reader.skipValue();
+                            }
+                        });
+                        // Phases that aren't known (say from a different version) are ignored
+                        if (phase != CompilePhase::CountOf)
+                        {
+                            result.total.phases[Index(phase)] = phaseResult;
+                        }
+                    });
+                }
+                else
+                {
+                    reader.skipValue();
+                }
+            });
+            outResults.add(result);
+        });
+    });
+    return reader.hasError() ? SLANG_FAIL : SLANG_OK;
+}
+
+static double _calcChangePercent(double baseline, double current)
+{
+    return (baseline > 0) ? (current - baseline) * 100.0 / baseline : 0.0;
+}
+
+    /// Print a comparison of the results against the baseline. Returns the number of regressions.
+static Index _compareWithBaseline(const List<TargetResult>& baselineResults, const List<TargetResult>& results, double thresholdPercent)
+{
+    Index regressionCount = 0;
+
+    printf("%-8s %-20s %12s %12s %8s %12s %12s %8s\n", "target", "phase", "base ms", "ms", "change", "base allocs", "allocs", "change");
+    for (const auto& result : results)
+    {
+        const TargetResult* baseline = nullptr;
+        for (const auto& baselineResult : baselineResults)
+        {
+            if (baselineResult.targetName == result.targetName)
+            {
+                baseline = &baselineResult;
+            }
+        }
+        if (!baseline)
+        {
+            printf("%-8s not in baseline\n", result.targetName.getBuffer());
+            continue;
+        }
+        if (baseline->fileCount != result.fileCount)
+        {
+            printf("%-8s compiled %d files, baseline compiled %d - results are not comparable\n",
+                result.targetName.getBuffer(), int(result.fileCount), int(baseline->fileCount));
+        }
+
+        for (Index i = 0; i < Index(CompilePhase::CountOf); ++i)
+        {
+            const PhaseResult& base = baseline->total.phases[i];
+            const PhaseResult& current = result.total.phases[i];
+
+            const double timeChange = _calcChangePercent(base.seconds, current.seconds);
+            const double allocationChange = _calcChangePercent(double(base.allocationStats.allocationCount), double(current.allocationStats.allocationCount));
+
+            // Small absolute changes in time are just noise
+            const bool isRegression =
+                (timeChange > thresholdPercent && current.seconds - base.seconds > kMinRegressionSeconds) ||
+                allocationChange > thresholdPercent;
+            regressionCount += Index(isRegression);
+
+            printf("%-8s %-20s %12.3f %12.3f %+7.1f%% %12llu %12llu %+7.1f%%%s\n",
+                result.targetName.getBuffer(),
+                String(CompileInstrumentation::getPhaseName(CompilePhase(i))).getBuffer(),
+                base.seconds * 1000.0,
+                current.seconds * 1000.0,
+                timeChange,
+                (unsigned long long)base.allocationStats.allocationCount,
+                (unsigned long long)current.allocationStats.allocationCount,
+                allocationChange,
+                isRegression ? "  REGRESSION" : "");
+        }
+    }
+    return regressionCount;
+}
+
+SlangResult profileCompile(slang::IGlobalSession* globalSession, const ProfileCompileOptions& options)
+{
+    List<TargetResult> baselineResults;
+    if (options.baselinePath.getLength())
+    {
+        String baselineText;
+        try
+        {
+            baselineText = File::readAllText(options.baselinePath);
+        }
+        catch (const Exception&)
+        {
+        }
+        if (SLANG_FAILED(_readJSON(baselineText, baselineResults)))
+        {
+            fprintf(stderr, "error: unable to read baseline '%s'\n", options.baselinePath.getBuffer());
+            return SLANG_FAIL;
+        }
+    }
+
+    RefPtr<CompileInstrumentation> instrumentation = new CompileInstrumentation;
+    AllocationTracker::setInstrumentation(instrumentation);
+
+    List<TargetResult> results;
+    for (auto target : options.targets)
+    {
+        TargetResult targetResult;
+        targetResult.targetName = TypeTextUtil::getCompileTargetName(target);
+
+        for (const auto& filePath : options.filePaths)
+        {
+            List<EntryPointDesc> entryPoints;
+            _findEntryPoints(File::readAllText(filePath), entryPoints);
+
+            if (options.verbose)
+            {
+                fprintf(stderr, "%s %s: ", targetResult.targetName.getBuffer(), filePath.getBuffer());
+                fflush(stderr);
+            }
+
+            FileResult best;
+            SlangResult res = SLANG_OK;
+            for (Index i = 0; i < options.repeatCount && SLANG_SUCCEEDED(res); ++i)
+            {
+                FileResult result;
+                res = _compileFile(globalSession, instrumentation, filePath, entryPoints, target, result);
+                if (i == 0 || result.getTotalSeconds() < best.getTotalSeconds())
+                {
+                    best = result;
+                }
+            }
+
+            if (options.verbose)
+            {
+                fprintf(stderr, SLANG_SUCCEEDED(res) ? "%.3f ms\n" : "failed\n", best.getTotalSeconds() * 1000.0);
+            }
+
+            // Many tests are expected to fail (for example diagnostic tests), so they are just counted
+            if (SLANG_FAILED(res))
+            {
+                targetResult.failedCount++;
+                continue;
+            }
+
+            targetResult.fileCount++;
+            _accumulate(best, targetResult.total);
+        }
+
+        results.add(targetResult);
+    }
+
+    AllocationTracker::setInstrumentation(nullptr);
+
+    StringBuilder json;
+    _writeJSON(options, results, json);
+    if (options.outputPath.getLength())
+    {
+        try
+        {
+            File::writeAllText(options.outputPath, json);
+        }
+        catch (const Exception&)
+        {
+            fprintf(stderr, "error: unable to write '%s'\n", options.outputPath.getBuffer());
+            return SLANG_FAIL;
+        }
+    }
+    else
+    {
+        fputs(json.getBuffer(), stdout);
+    }
+
+    if (options.baselinePath.getLength())
+    {
+        const Index regressionCount = _compareWithBaseline(baselineResults, results, options.thresholdPercent);
+        if (regressionCount)
+        {
+            printf("%d regressions (threshold %.1f%%)\n", int(regressionCount), options.thresholdPercent);
+            return SLANG_FAIL;
+        }
+    }
+    return SLANG_OK;
+}
+
+}
@@ -0,0 +1,30 @@
+// slang-profile-compile.h
+#ifndef SLANG_PROFILE_COMPILE_H
+#define SLANG_PROFILE_COMPILE_H
+
+#include "../../slang.h"
+#include "../../source/core/slang-basic.h"
+
+namespace Slang
+{
+
+struct ProfileCompileOptions
+{
+    List<String> corpusPaths;               ///< The paths given for the corpus (recorded in the results)
+    List<String> filePaths;                 ///< The source files found from corpusPaths
+    List<SlangCompileTarget> targets;       ///< Every file is compiled for each target
+    Index repeatCount = 3;                  ///< Each compile is repeated, and the fastest is used
+    String outputPath;                      ///< If set the JSON results are written to this file, otherwise to stdout
+    String baselinePath;                    ///< If set the results are compared against a previous JSON results file
+    double thresholdPercent = 10.0;         ///< An increase over the baseline above this is a regression
+    bool verbose = false;                   ///< If set the time to compile each file is written to stderr
+};
+
+    /// Compiles every file for every target, and reports the time, allocations and peak memory for each phase
+    /// of compilation as JSON.
+    /// If there is a baseline, prints a comparison against it, and returns SLANG_FAIL if there is a regression.
+SlangResult profileCompile(slang::IGlobalSession* globalSession, const ProfileCompileOptions& options);
+
+}
+
+#endif
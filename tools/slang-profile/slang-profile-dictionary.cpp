@@ -0,0 +1,237 @@
+// slang-profile-dictionary.cpp
+#include "slang-profile-dictionary.h"
+
+#include "../../source/core/slang-dictionary.h"
+#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-random-generator.h"
+
+#include <stdio.h>
+
+namespace Slang
+{
+
+namespace { // anonymous
+
+// The Dictionary implementation prior to the switch to control bytes, trimmed to what is needed for the comparison.
+// Linear probing, with the empty/deleted state of each slot held as 2 bits in a UIntSet, and the
+// start position found with a modulo.
+template<typename TKey, typename TValue>
+class LegacyDictionary
+{
+public:
+    bool AddIfNotExists(const TKey& key, const TValue& value)
+    {
+        Rehash();
+        int pos = FindPosition(key, true);
+        if (!IsEmpty(pos) && !IsDeleted(pos))
+        {
+            return false;
+        }
+        m_count++;
+        m_hashMap[pos] = KeyValuePair<TKey, TValue>(key, value);
+        m_marks.add(pos << 1);
+        m_marks.remove((pos << 1) + 1);
+        return true;
+    }
+    TValue* TryGetValue(const TKey& key) const
+    {
+        if (m_bucketSizeMinusOne == -1)
+        {
+            return nullptr;
+        }
+        const int pos = FindPosition(key, false);
+        return pos >= 0 ? &m_hashMap[pos].Value : nullptr;
+    }
+    Index Count() const { return m_count; }
+
+    LegacyDictionary() {}
+    ~LegacyDictionary() { delete[] m_hashMap; }
+
+private:
+    bool IsDeleted(int pos) const { return m_marks.contains((pos << 1) + 1); }
+    bool IsEmpty(int pos) const { return !m_marks.contains(pos << 1); }
+
+        /// Returns the position of the key if found. If not found returns -1, or the insertion position if forInsert
+    int FindPosition(const TKey& key, bool forInsert) const
+    {
+        const unsigned int hash = (unsigned int)getHashCode(const_cast<TKey&>(key));
+        int hashPos = int((hash * 2654435761u) % (unsigned int)(m_bucketSizeMinusOne));
+        int insertPos = -1;
+        for (int numProbes = 0; numProbes <= m_bucketSizeMinusOne; ++numProbes)
+        {
+            if (IsEmpty(hashPos))
+            {
+                return forInsert ? (insertPos == -1 ? hashPos : insertPos) : -1;
+            }
+            else if (IsDeleted(hashPos))
+            {
+                insertPos = (insertPos == -1) ? hashPos : insertPos;
+            }
+            else if (m_hashMap[hashPos].Key == key)
+            {
+                return hashPos;
+            }
+            hashPos = (hashPos + 1) & m_bucketSizeMinusOne;
+        }
+        return forInsert ? insertPos : -1;
+    }
+    void Rehash()
+    {
+        if (m_bucketSizeMinusOne == -1 || m_count >= int(0.7f * m_bucketSizeMinusOne))
+        {
+            const int oldSize = m_bucketSizeMinusOne + 1;
+            const int newSize = oldSize ? oldSize * 2 : 16;
+
+            KeyValuePair<TKey, TValue>* oldHashMap = m_hashMap;
+            UIntSet oldMarks(_Move(m_marks));
+
+            m_bucketSizeMinusOne = newSize - 1;
+            m_hashMap = new KeyValuePair<TKey, TValue>[newSize];
+            m_marks.resizeAndClear(newSize * 2);
+            m_count = 0;
+
+            for (int i = 0; i < oldSize; ++i)
+            {
+                if (oldMarks.contains(i << 1) && !oldMarks.contains((i << 1) + 1))
+                {
+                    AddIfNotExists(oldHashMap[i].Key, oldHashMap[i].Value);
+                }
+            }
+            delete[] oldHashMap;
+        }
+    }
+
+    int m_bucketSizeMinusOne = -1;
+    int m_count = 0;
+    UIntSet m_marks;
+    KeyValuePair<TKey, TValue>* m_hashMap = nullptr;
+};
+
+// Similar to the keys used to deduplicate instructions in the IR
+struct InstKey
+{
+    HashCode getHashCode() const { return combineHash(Slang::getHashCode(op), combineHash(Slang::getHashCode(a), Slang::getHashCode(b))); }
+    bool operator==(const InstKey& rhs) const { return op == rhs.op && a == rhs.a && b == rhs.b; }
+
+    void* op;
+    int a;
+    int b;
+};
+
+struct TimingResult
+{
+    double addSeconds = 0;
+    double findSeconds = 0;
+    double missSeconds = 0;
+};
+
+} // anonymous
+
+static double _getSeconds(uint64_t startTick)
+{
+    return double(ProcessUtil::getClockTick() - startTick) / ProcessUtil::getClockFrequency();
+}
+
+    /// Add all of keys, then find all of them, then find all of missKeys (which are all not present).
+    /// Repeats and returns the fastest time for each.
+template <typename DictionaryType, typename KeyType>
+static TimingResult _timeDictionary(const List<KeyType>& keys, const List<KeyType>& missKeys, Index& ioCheck)
+{
+    TimingResult best;
+    for (Index repeat = 0; repeat < 5; ++repeat)
+    {
+        TimingResult result;
+        DictionaryType dict;
+
+        auto startTick = ProcessUtil::getClockTick();
+        for (Index i = 0; i < keys.getCount(); ++i)
+        {
+            dict.AddIfNotExists(keys[i], int(i));
+        }
+        result.addSeconds = _getSeconds(startTick);
+
+        startTick = ProcessUtil::getClockTick();
+        for (const auto& key : keys)
+        {
+            ioCheck += *dict.TryGetValue(key);
+        }
+        result.findSeconds = _getSeconds(startTick);
+
+        startTick = ProcessUtil::getClockTick();
+        for (const auto& key : missKeys)
+        {
+            ioCheck += (dict.TryGetValue(key) != nullptr);
+        }
+        result.missSeconds = _getSeconds(startTick);
+
+        if (repeat == 0 || result.addSeconds < best.addSeconds) best.addSeconds = result.addSeconds;
+        if (repeat == 0 || result.findSeconds < best.findSeconds) best.findSeconds = result.findSeconds;
+        if (repeat == 0 || result.missSeconds < best.missSeconds) best.missSeconds = result.missSeconds;
+    }
+    return best;
+}
+
+template <typename KeyType>
+static void _compareDictionaries(const char* name, const List<KeyType>& keys, const List<KeyType>& missKeys)
+{
+    Index check = 0;
+    const TimingResult legacy = _timeDictionary<LegacyDictionary<KeyType, int>>(keys, missKeys, check);
+    const TimingResult current = _timeDictionary<Dictionary<KeyType, int>>(keys, missKeys, check);
+
+    const double scale = 1e9 / double(keys.getCount());
+    printf("%-8s %8d keys: add %6.1f -> %6.1f ns, find %6.1f -> %6.1f ns, miss %6.1f -> %6.1f ns (check %d)\n",
+        name, int(keys.getCount()),
+        legacy.addSeconds * scale, current.addSeconds * scale,
+        legacy.findSeconds * scale, current.findSeconds * scale,
+        legacy.missSeconds * scale, current.missSeconds * scale,
+        int(check & 0xff));
+}
+
+SlangResult profileDictionary()
+{
+    RefPtr<RandomGenerator> rand = RandomGenerator::create(0x1234);
+
+    printf("Per key times, previous -> current Dictionary\n");
+
+    const Index counts[] = { 100, 10000, 1000000 };
+    for (auto count : counts)
+    {
+        // Pointers, as used for Name* or IRInst* keys. Spaced like heap allocations.
+        {
+            List<void*> keys, missKeys;
+            for (Index i = 0; i < count; ++i)
+            {
+                keys.add((void*)(size_t(0x10000) + size_t(i) * 48));
+                missKeys.add((void*)(size_t(0x10000) + size_t(i + count) * 48));
+            }
+            _compareDictionaries("pointer", keys, missKeys);
+        }
+
+        // Strings, as used for names of modules, files and so on
+        {
+            List<String> keys, missKeys;
+            for (Index i = 0; i < count; ++i)
+            {
+                keys.add(String("identifier_") + String(rand->nextInt32()));
+                missKeys.add(String("missing_") + String(rand->nextInt32()));
+            }
+            _compareDictionaries("string", keys, missKeys);
+        }
+
+        // Composite keys, as used in IR instruction deduplication
+        {
+            List<InstKey> keys, missKeys;
+            for (Index i = 0; i < count; ++i)
+            {
+                InstKey key = { (void*)(size_t(0x10000) + size_t(i & 31) * 64), int(i), int(i >> 5) };
+                keys.add(key);
+                key.b = -1;
+                missKeys.add(key);
+            }
+            _compareDictionaries("inst", keys, missKeys);
+        }
+    }
+    return SLANG_OK;
+}
+
+}
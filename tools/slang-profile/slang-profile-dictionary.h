@@ -0,0 +1,16 @@
+// slang-profile-dictionary.h
+#ifndef SLANG_PROFILE_DICTIONARY_H
+#define SLANG_PROFILE_DICTIONARY_H
+
+#include "../../slang.h"
+
+namespace Slang
+{
+
+    /// Times inserts and lookups on Dictionary, against the previous (linear probing with a mark bit set) implementation,
+    /// for key types typical of the compiler.
+SlangResult profileDictionary();
+
+}
+
+#endif
@@ -8,13 +8,307 @@
 #include "../../slang-com-helper.h"
 
 #include "../../source/core/slang-string-util.h"
+#include "../../source/core/slang-type-text-util.h"
+
+#include "../../source/slang/slang-compiler.h"
+#include "../../source/slang/slang-ir.h"
+
+#include "slang-profile-compile.h"
+#include "slang-profile-dictionary.h"
+#include "slang-profile-parameter-layout.h"
+#include "slang-profile-stdlib.h"
 
 using namespace Slang;
 
+namespace { // anonymous
+
+class FindSourceFilesVisitor : public Path::Visitor
+{
+public:
+    virtual void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+    {
+        String path = Path::combine(m_directoryPath, filename);
+        if (type == Path::Type::Directory)
+        {
+            m_directoryPaths.add(path);
+        }
+        else if (type == Path::Type::File && Path::getPathExt(filename) == "slang")
+        {
+            m_filePaths.add(path);
+        }
+    }
+
+    String m_directoryPath;
+    List<String> m_directoryPaths;
+    List<String> m_filePaths;
+};
+
+struct IRMemoryStats
+{
+    Index moduleCount = 0;
+    Index instCount = 0;
+    Index operandCount = 0;
+    size_t arenaBytes = 0;
+    double compileSeconds = 0;
+};
+
+} // anonymous
+
+    /// Find all of the .slang files in path. If path is a directory it is searched recursively.
+static void _findSourceFiles(const String& path, List<String>& outFilePaths)
+{
+    SlangPathType pathType;
+    if (SLANG_FAILED(Path::getPathType(path, &pathType)))
+    {
+        return;
+    }
+    if (pathType == SLANG_PATH_TYPE_FILE)
+    {
+        outFilePaths.add(path);
+        return;
+    }
+
+    FindSourceFilesVisitor visitor;
+    visitor.m_directoryPath = path;
+    Path::find(path, nullptr, &visitor);
+
+    // Sort so the output order doesn't depend on the file system
+    visitor.m_filePaths.sort();
+    visitor.m_directoryPaths.sort();
+
+    outFilePaths.addRange(visitor.m_filePaths);
+    for (const auto& directoryPath : visitor.m_directoryPaths)
+    {
+        _findSourceFiles(directoryPath, outFilePaths);
+    }
+}
+
+static void _accumulateInstStats(IRInst* inst, IRMemoryStats& ioStats)
+{
+    ioStats.instCount++;
+    ioStats.operandCount += Index(inst->getOperandCount());
+    for (auto child : inst->getDecorationsAndChildren())
+    {
+        _accumulateInstStats(child, ioStats);
+    }
+}
+
+    /// Compile each file through the front end only (which produces the IR for its module),
+    /// and report the memory used by the IR
+static SlangResult _profileIRMemory(slang::IGlobalSession* globalSession, const List<String>& paths)
+{
+    List<String> filePaths;
+    for (const auto& path : paths)
+    {
+        _findSourceFiles(path, filePaths);
+    }
+
+    IRMemoryStats totalStats;
+    Index failedCount = 0;
+
+    for (const auto& filePath : filePaths)
+    {
+        SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+        spSetCompileFlags(request, SLANG_COMPILE_FLAG_NO_CODEGEN);
+
+        const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+        spAddTranslationUnitSourceFile(request, translationUnitIndex, filePath.getBuffer());
+
+        const auto startTick = ProcessUtil::getClockTick();
+        const SlangResult compileResult = spCompile(request);
+        const auto endTick = ProcessUtil::getClockTick();
+
+        if (SLANG_FAILED(compileResult))
+        {
+            // Many tests are expected to fail (for example diagnostic tests), so just skip them
+            failedCount++;
+            spDestroyCompileRequest(request);
+            continue;
+        }
+
+        IRMemoryStats stats;
+        stats.compileSeconds = double(endTick - startTick) / ProcessUtil::getClockFrequency();
+
+        for (auto translationUnit : asInternal(request)->getFrontEndReq()->translationUnits)
+        {
+            IRModule* irModule = translationUnit->getModule()->getIRModule();
+            if (!irModule)
+            {
+                continue;
+            }
+            stats.moduleCount++;
+            stats.arenaBytes += irModule->memoryArena.calcTotalMemoryUsed();
+            _accumulateInstStats(irModule->getModuleInst(), stats);
+        }
+
+        printf("%s: insts %d, operands %d, bytes %d, bytes/inst %.1f, time %fs\n",
+            filePath.getBuffer(),
+            int(stats.instCount),
+            int(stats.operandCount),
+            int(stats.arenaBytes),
+            stats.instCount ? double(stats.arenaBytes) / double(stats.instCount) : 0.0,
+            stats.compileSeconds);
+
+        totalStats.moduleCount += stats.moduleCount;
+        totalStats.instCount += stats.instCount;
+        totalStats.operandCount += stats.operandCount;
+        totalStats.arenaBytes += stats.arenaBytes;
+        totalStats.compileSeconds += stats.compileSeconds;
+
+        spDestroyCompileRequest(request);
+    }
+
+    printf("\n");
+    printf("sizeof(IRInst) %d, sizeof(IRUse) %d\n", int(sizeof(IRInst)), int(sizeof(IRUse)));
+    printf("Modules %d (%d files failed to compile)\n", int(totalStats.moduleCount), int(failedCount));
+    printf("Total insts %d, operands %d, IR bytes %d\n", int(totalStats.instCount), int(totalStats.operandCount), int(totalStats.arenaBytes));
+    if (totalStats.instCount)
+    {
+        printf("Bytes/inst %.1f (inst+operand bytes/inst %.1f)\n",
+            double(totalStats.arenaBytes) / double(totalStats.instCount),
+            double(totalStats.instCount * sizeof(IRInst) + totalStats.operandCount * sizeof(IRUse)) / double(totalStats.instCount));
+    }
+    printf("Total compile time %fs\n", totalStats.compileSeconds);
+    return SLANG_OK;
+}
+
 SlangResult innerMain(int argc, char** argv)
 {
     auto stdWriters = StdWriters::initDefaultSingleton();
 
+    // Measure the memory used by the IR of all the .slang files found via the paths on the command line
+    // For example: slang-profile -ir-memory tests
+    if (argc >= 2 && strcmp(argv[1], "-ir-memory") == 0)
+    {
+        ComPtr<slang::IGlobalSession> slangSession;
+        slangSession.attach(spCreateSession(nullptr));
+
+        List<String> paths;
+        for (int i = 2; i < argc; ++i)
+        {
+            paths.add(argv[i]);
+        }
+        return _profileIRMemory(slangSession, paths);
+    }
+
+    // Time each phase of compiling all of the .slang files found via the paths on the command line, for each target
+    // For example: slang-profile -compile -target hlsl -target glsl -output results.json tests examples
+    // Other options: -baseline <results.json> -threshold <percent> -repeat <count> -exclude <path substring> -verbose
+    if (argc >= 2 && strcmp(argv[1], "-compile") == 0)
+    {
+        ProfileCompileOptions options;
+        List<String> excludes;
+        for (int i = 2; i < argc; ++i)
+        {
+            const UnownedStringSlice arg(argv[i]);
+            if (arg == "-verbose")
+            {
+                options.verbose = true;
+                continue;
+            }
+            if (arg.startsWith("-") && i + 1 >= argc)
+            {
+                fprintf(stderr, "error: expecting a value for '%s'\n", argv[i]);
+                return SLANG_FAIL;
+            }
+
+            if (arg == "-target")
+            {
+                const SlangCompileTarget target = TypeTextUtil::findCompileTargetFromName(UnownedStringSlice(argv[++i]));
+                if (target == SLANG_TARGET_UNKNOWN)
+                {
+                    fprintf(stderr, "error: unknown target '%s'\n", argv[i]);
+                    return SLANG_FAIL;
+                }
+                options.targets.add(target);
+            }
+            else if (arg == "-repeat")
+            {
+                options.repeatCount = Index(atoi(argv[++i]));
+            }
+            else if (arg == "-output")
+            {
+                options.outputPath = argv[++i];
+            }
+            else if (arg == "-baseline")
+            {
+                options.baselinePath = argv[++i];
+            }
+            else if (arg == "-threshold")
+            {
+                options.thresholdPercent = atof(argv[++i]);
+            }
+            else if (arg == "-exclude")
+            {
+                // Files are compiled in process, so ones that crash the compiler have to be excluded
+                excludes.add(argv[++i]);
+            }
+            else if (arg.startsWith("-"))
+            {
+                fprintf(stderr, "error: unknown option '%s'\n", argv[i]);
+                return SLANG_FAIL;
+            }
+            else
+            {
+                options.corpusPaths.add(argv[i]);
+            }
+        }
+
+        if (options.targets.getCount() == 0)
+        {
+            // Targets that don't need a downstream compiler. C++ isn't included, as many tests are for stages it
+            // doesn't support.
+            options.targets.add(SLANG_HLSL);
+            options.targets.add(SLANG_GLSL);
+        }
+        options.repeatCount = (options.repeatCount > 0) ? options.repeatCount : 1;
+
+        List<String> filePaths;
+        for (const auto& path : options.corpusPaths)
+        {
+            _findSourceFiles(path, filePaths);
+        }
+        for (const auto& filePath : filePaths)
+        {
+            bool isExcluded = false;
+            for (const auto& exclude : excludes)
+            {
+                isExcluded = isExcluded || filePath.indexOf(exclude) >= 0;
+            }
+            if (!isExcluded)
+            {
+                options.filePaths.add(filePath);
+            }
+        }
+
+        ComPtr<slang::IGlobalSession> slangSession;
+        slangSession.attach(spCreateSession(nullptr));
+        return profileCompile(slangSession, options);
+    }
+
+    // Compare the performance of Dictionary against the previous implementation
+    if (argc >= 2 && strcmp(argv[1], "-dictionary") == 0)
+    {
+        return profileDictionary();
+    }
+
+    // Time loading the stdlib from its serialized form
+    if (argc >= 2 && strcmp(argv[1], "-stdlib") == 0)
+    {
+        return profileStdLib();
+    }
+
+    // Time the layout of a shader with many parameters
+    // For example: slang-profile -parameter-layout 20000
+    if (argc >= 2 && strcmp(argv[1], "-parameter-layout") == 0)
+    {
+        const Index parameterCount = (argc >= 3) ? Index(atoi(argv[2])) : 12000;
+
+        ComPtr<slang::IGlobalSession> slangSession;
+        slangSession.attach(spCreateSession(nullptr));
+        return profileParameterLayout(slangSession, parameterCount);
+    }
+
     // Time the creation of the session
     {
         const auto startTick = ProcessUtil::getClockTick();
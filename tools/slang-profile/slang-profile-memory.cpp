@@ -0,0 +1,206 @@
+// slang-profile-memory.cpp
+#include "slang-profile-memory.h"
+
+#include <atomic>
+#include <new>
+
+#include <stdlib.h>
+
+#if defined(__GLIBC__)
+#   include <errno.h>
+#   include <malloc.h>
+#   define SLANG_PROFILE_REPLACE_MALLOC 1
+#else
+#   define SLANG_PROFILE_REPLACE_MALLOC 0
+#endif
+
+namespace Slang
+{
+
+namespace { // anonymous
+
+struct PhaseAllocationStats
+{
+    std::atomic<uint64_t> allocationCount;
+    std::atomic<uint64_t> allocatedBytes;
+    std::atomic<int64_t> peakBytes;
+};
+
+} // anonymous
+
+// Zero initialized before any dynamic initialization, so usable by allocations made during static construction.
+static CompileInstrumentation* g_instrumentation;
+static std::atomic<int64_t> g_allocatedBytes;
+static std::atomic<int64_t> g_resetAllocatedBytes;
+static PhaseAllocationStats g_phaseStats[Index(CompilePhase::CountOf)];
+
+static void _onAllocate(size_t size)
+{
+    const CompileInstrumentation* instrumentation = g_instrumentation;
+    PhaseAllocationStats& stats = g_phaseStats[Index(instrumentation ? instrumentation->getCurrentPhase() : CompilePhase::Other)];
+
+    stats.allocationCount.fetch_add(1, std::memory_order_relaxed);
+    stats.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+    const int64_t bytes = g_allocatedBytes.fetch_add(int64_t(size), std::memory_order_relaxed) + int64_t(size) -
+        g_resetAllocatedBytes.load(std::memory_order_relaxed);
+
+    int64_t peakBytes = stats.peakBytes.load(std::memory_order_relaxed);
+    while (bytes > peakBytes && !stats.peakBytes.compare_exchange_weak(peakBytes, bytes, std::memory_order_relaxed))
+    {
+    }
+}
+
+static void _onFree(size_t size)
+{
+    g_allocatedBytes.fetch_sub(int64_t(size), std::memory_order_relaxed);
+}
+
+/* static */void AllocationTracker::setInstrumentation(CompileInstrumentation* instrumentation)
+{
+    g_instrumentation = instrumentation;
+}
+
+/* static */void AllocationTracker::reset()
+{
+    g_resetAllocatedBytes.store(g_allocatedBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    for (auto& stats : g_phaseStats)
+    {
+        stats.allocationCount.store(0, std::memory_order_relaxed);
+        stats.allocatedBytes.store(0, std::memory_order_relaxed);
+        stats.peakBytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+/* static */AllocationStats AllocationTracker::getStats(CompilePhase phase)
+{
+    const PhaseAllocationStats& phaseStats = g_phaseStats[Index(phase)];
+
+    AllocationStats stats;
+    stats.allocationCount = phaseStats.allocationCount.load(std::memory_order_relaxed);
+    stats.allocatedBytes = phaseStats.allocatedBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = uint64_t(phaseStats.peakBytes.load(std::memory_order_relaxed));
+    return stats;
+}
+
+/* static */bool AllocationTracker::isTrackingAllAllocations()
+{
+    return SLANG_PROFILE_REPLACE_MALLOC != 0;
+}
+
+}
+
+#if SLANG_PROFILE_REPLACE_MALLOC
+
+// glibc exports its implementations under these names, so the functions that replace them can forward to them.
+// operator new and delete use malloc and free, so they are tracked too.
+extern "C"
+{
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+static void* _trackAllocation(void* ptr)
+{
+    if (ptr)
+    {
+        Slang::_onAllocate(malloc_usable_size(ptr));
+    }
+    return ptr;
+}
+
+extern "C" void* malloc(size_t size)
+{
+    return _trackAllocation(__libc_malloc(size));
+}
+
+extern "C" void* calloc(size_t count, size_t size)
+{
+    return _trackAllocation(__libc_calloc(count, size));
+}
+
+extern "C" void* realloc(void* ptr, size_t size)
+{
+    const size_t oldSize = ptr ? malloc_usable_size(ptr) : 0;
+    void* newPtr = __libc_realloc(ptr, size);
+    // If realloc fails the original allocation is left alone
+    if (newPtr || size == 0)
+    {
+        Slang::_onFree(oldSize);
+    }
+    return _trackAllocation(newPtr);
+}
+
+extern "C" void* memalign(size_t alignment, size_t size)
+{
+    return _trackAllocation(__libc_memalign(alignment, size));
+}
+
+extern "C" void* aligned_alloc(size_t alignment, size_t size)
+{
+    return _trackAllocation(__libc_memalign(alignment, size));
+}
+
+extern "C" int posix_memalign(void** outPtr, size_t alignment, size_t size)
+{
+    void* ptr = _trackAllocation(__libc_memalign(alignment, size));
+    if (!ptr)
+    {
+        return ENOMEM;
+    }
+    *outPtr = ptr;
+    return 0;
+}
+
+extern "C" void free(void* ptr)
+{
+    if (ptr)
+    {
+        Slang::_onFree(malloc_usable_size(ptr));
+        __libc_free(ptr);
+    }
+}
+
+#else
+
+// Only operator new and delete can be replaced portably. The size is held in a header in front of the allocation.
+static const size_t kHeaderSize = 16;
+
+static void* _allocate(size_t size)
+{
+    uint8_t* ptr = (uint8_t*)::malloc(size + kHeaderSize);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    *(size_t*)ptr = size;
+    Slang::_onAllocate(size);
+    return ptr + kHeaderSize;
+}
+
+static void _deallocate(void* ptr)
+{
+    if (ptr)
+    {
+        uint8_t* header = (uint8_t*)ptr - kHeaderSize;
+        Slang::_onFree(*(size_t*)header);
+        ::free(header);
+    }
+}
+
+void* operator new(size_t size) { return _allocate(size); }
+void* operator new[](size_t size) { return _allocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { try { return _allocate(size); } catch (...) { return nullptr; } }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { try { return _allocate(size); } catch (...) { return nullptr; } }
+
+void operator delete(void* ptr) noexcept { _deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { _deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { _deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { _deallocate(ptr); }
+void operator delete(void* ptr, size_t) noexcept { _deallocate(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { _deallocate(ptr); }
+
+#endif
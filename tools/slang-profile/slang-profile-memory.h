@@ -0,0 +1,43 @@
+// slang-profile-memory.h
+#ifndef SLANG_PROFILE_MEMORY_H
+#define SLANG_PROFILE_MEMORY_H
+
+#include "../../source/slang/slang-compile-instrumentation.h"
+
+namespace Slang
+{
+
+struct AllocationStats
+{
+    uint64_t allocationCount = 0;   ///< The number of allocations made
+    uint64_t allocatedBytes = 0;    ///< The total size of the allocations made
+    uint64_t peakBytes = 0;         ///< The highest amount of memory allocated since the reset, seen by an allocation
+};
+
+/* Tracks the heap allocations made by the process, and attributes them to the current phase of a
+CompileInstrumentation.
+
+With glibc all allocations are tracked (by replacing malloc and friends). Elsewhere only allocations made with
+operator new are tracked, and containers such as List, and MemoryArena, which use malloc directly, are missed.
+
+Tracking is process wide, so allocations made on other threads are attributed to the instrumentation's current phase
+too. */
+struct AllocationTracker
+{
+        /// Set the instrumentation whose current phase allocations are attributed to. If nullptr allocations are
+        /// attributed to CompilePhase::Other.
+    static void setInstrumentation(CompileInstrumentation* instrumentation);
+
+        /// Zero the stats for all phases. Peak memory is measured relative to the amount allocated at the reset.
+    static void reset();
+
+        /// Get the stats for a phase since the last reset
+    static AllocationStats getStats(CompilePhase phase);
+
+        /// True if all heap allocations are tracked
+    static bool isTrackingAllAllocations();
+};
+
+}
+
+#endif
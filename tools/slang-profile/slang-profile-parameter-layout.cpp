@@ -0,0 +1,123 @@
+// slang-profile-parameter-layout.cpp
+#include "slang-profile-parameter-layout.h"
+
+#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-string.h"
+
+#include <stdio.h>
+
+namespace Slang
+{
+
+static void _appendParameterLayoutSource(Index parameterCount, StringBuilder& out)
+{
+    out << "struct Material { Texture2D albedo; SamplerState sampler; float4 tint; };\n";
+
+    // Explicit registers are placed above where the implicit ones end up, with gaps between them, so that
+    // implicit allocation has to find the free space between used ranges
+    for (Index i = 0; i < parameterCount; ++i)
+    {
+        switch (i % 8)
+        {
+            case 0:
+            case 1:
+            case 2:     out << "Texture2D t" << i << ";\n"; break;
+            case 3:     out << "SamplerState s" << i << ";\n"; break;
+            case 4:     out << "Texture2D ta" << i << "[4];\n"; break;
+            case 5:     out << "Texture2D te" << i << " : register(t" << (parameterCount + i) << ");\n"; break;
+            case 6:     out << "ParameterBlock<Material> pb" << i << ";\n"; break;
+            default:
+            {
+                if ((i / 8) % 8 == 0)
+                {
+                    out << "Texture2D tsp" << i << " : register(t0, space" << (1 + i / 32) << ");\n";
+                }
+                else
+                {
+                    out << "RWStructuredBuffer<float> b" << i << ";\n";
+                }
+                break;
+            }
+        }
+    }
+
+    out << "RWStructuredBuffer<float> output;\n";
+    out << "[numthreads(1, 1, 1)]\n";
+    out << "void computeMain(uint3 dispatchThreadID : SV_DispatchThreadID)\n";
+    out << "{\n";
+    out << "    output[dispatchThreadID.x] = 1.0f;\n";
+    out << "}\n";
+}
+
+static uint64_t _combineHash(uint64_t hash, uint64_t value)
+{
+    // FNV-1a over the 8 bytes of value
+    for (int i = 0; i < 8; ++i)
+    {
+        hash ^= (value >> (i * 8)) & 0xff;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+static uint64_t _calcBindingsHash(slang::ShaderReflection* reflection)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    const unsigned parameterCount = reflection->getParameterCount();
+    for (unsigned i = 0; i < parameterCount; ++i)
+    {
+        slang::VariableLayoutReflection* parameter = reflection->getParameterByIndex(i);
+        const unsigned categoryCount = parameter->getCategoryCount();
+        for (unsigned j = 0; j < categoryCount; ++j)
+        {
+            const SlangParameterCategory category = SlangParameterCategory(parameter->getCategoryByIndex(j));
+            hash = _combineHash(hash, uint64_t(category));
+            hash = _combineHash(hash, uint64_t(parameter->getOffset(category)));
+            hash = _combineHash(hash, uint64_t(parameter->getBindingSpace(category)));
+        }
+    }
+    return hash;
+}
+
+SlangResult profileParameterLayout(slang::IGlobalSession* globalSession, Index parameterCount)
+{
+    StringBuilder source;
+    _appendParameterLayoutSource(parameterCount, source);
+
+    const int repeatCount = 4;
+
+    double bestSeconds = 0;
+    uint64_t bindingsHash = 0;
+    for (int i = 0; i < repeatCount; ++i)
+    {
+        SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+        spSetCompileFlags(request, SLANG_COMPILE_FLAG_NO_CODEGEN);
+        spSetCodeGenTarget(request, SLANG_HLSL);
+        const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+        spAddTranslationUnitSourceString(request, translationUnitIndex, "parameter-layout.slang", source.getBuffer());
+        spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+        const auto startTick = ProcessUtil::getClockTick();
+        const SlangResult res = spCompile(request);
+        const double seconds = double(ProcessUtil::getClockTick() - startTick) / ProcessUtil::getClockFrequency();
+
+        if (SLANG_FAILED(res))
+        {
+            fprintf(stderr, "%s", spGetDiagnosticOutput(request));
+            spDestroyCompileRequest(request);
+            return res;
+        }
+
+        bindingsHash = _calcBindingsHash(slang::ShaderReflection::get(request));
+        bestSeconds = (i == 0 || seconds < bestSeconds) ? seconds : bestSeconds;
+
+        spDestroyCompileRequest(request);
+    }
+
+    printf("Parameters %d\n", int(parameterCount));
+    printf("Compile (front end and layout): %.2f ms\n", bestSeconds * 1000.0);
+    printf("Bindings hash %016llx\n", (unsigned long long)bindingsHash);
+    return SLANG_OK;
+}
+
+}
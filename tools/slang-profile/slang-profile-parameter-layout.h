@@ -0,0 +1,18 @@
+// slang-profile-parameter-layout.h
+#ifndef SLANG_PROFILE_PARAMETER_LAYOUT_H
+#define SLANG_PROFILE_PARAMETER_LAYOUT_H
+
+#include "../../source/core/slang-common.h"
+#include "../../slang.h"
+
+namespace Slang
+{
+
+    /// Times the layout of a generated shader that declares parameterCount global shader parameters (a mix of
+    /// resources with explicit and implicit registers, resource arrays and parameter blocks), and prints a hash of
+    /// the bindings assigned, so that changes to parameter binding can be checked for identical results.
+SlangResult profileParameterLayout(slang::IGlobalSession* globalSession, Index parameterCount);
+
+}
+
+#endif
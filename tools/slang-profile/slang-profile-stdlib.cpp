@@ -0,0 +1,76 @@
+// slang-profile-stdlib.cpp
+#include "slang-profile-stdlib.h"
+
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-process-util.h"
+
+#include <stdio.h>
+
+namespace Slang
+{
+
+static double _getMilliseconds(uint64_t startTick)
+{
+    return double(ProcessUtil::getClockTick() - startTick) * 1000.0 / ProcessUtil::getClockFrequency();
+}
+
+static const char s_shaderSource[] =
+    "RWStructuredBuffer<float> buffer;\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void computeMain(uint3 dispatchThreadID : SV_DispatchThreadID)\n"
+    "{\n"
+    "    buffer[dispatchThreadID.x] = sin(buffer[dispatchThreadID.x]) + max(buffer[dispatchThreadID.x], 1.0f);\n"
+    "}\n";
+
+static SlangResult _compileShader(slang::IGlobalSession* globalSession)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(globalSession);
+    spSetCodeGenTarget(request, SLANG_HLSL);
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "shader.slang", s_shaderSource);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    const SlangResult res = spCompile(request);
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+SlangResult profileStdLib()
+{
+    // Produce the serialized stdlib to load from
+    ComPtr<ISlangBlob> stdLibBlob;
+    {
+        ComPtr<slang::IGlobalSession> globalSession;
+        SLANG_RETURN_ON_FAIL(slang_createGlobalSessionWithoutStdLib(0, globalSession.writeRef()));
+        SLANG_RETURN_ON_FAIL(globalSession->compileStdLib());
+        SLANG_RETURN_ON_FAIL(globalSession->saveStdLib(SLANG_ARCHIVE_TYPE_RIFF, stdLibBlob.writeRef()));
+    }
+
+    const int repeatCount = 16;
+
+    double bestLoad = 0;
+    double bestCompile = 0;
+    for (int i = 0; i < repeatCount; ++i)
+    {
+        ComPtr<slang::IGlobalSession> globalSession;
+
+        auto startTick = ProcessUtil::getClockTick();
+        SLANG_RETURN_ON_FAIL(slang_createGlobalSessionWithoutStdLib(0, globalSession.writeRef()));
+        SLANG_RETURN_ON_FAIL(globalSession->loadStdLib(stdLibBlob->getBufferPointer(), stdLibBlob->getBufferSize()));
+        const double load = _getMilliseconds(startTick);
+
+        startTick = ProcessUtil::getClockTick();
+        SLANG_RETURN_ON_FAIL(_compileShader(globalSession));
+        const double compile = _getMilliseconds(startTick);
+
+        bestLoad = (i == 0 || load < bestLoad) ? load : bestLoad;
+        bestCompile = (i == 0 || compile < bestCompile) ? compile : bestCompile;
+    }
+
+    printf("StdLib %d bytes\n", int(stdLibBlob->getBufferSize()));
+    printf("Create global session and load stdlib: %.2f ms\n", bestLoad);
+    printf("First compile with the session: %.2f ms\n", bestCompile);
+    return SLANG_OK;
+}
+
+}
@@ -0,0 +1,16 @@
+// slang-profile-stdlib.h
+#ifndef SLANG_PROFILE_STDLIB_H
+#define SLANG_PROFILE_STDLIB_H
+
+#include "../../slang.h"
+
+namespace Slang
+{
+
+    /// Times creating a global session from a serialized stdlib, and the first compilation with the session
+    /// (which reads any parts of the stdlib that are loaded on demand).
+SlangResult profileStdLib();
+
+}
+
+#endif
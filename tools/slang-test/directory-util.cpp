@@ -27,3 +27,50 @@ using namespace Slang;
 {
     return findFilesMatchingPattern(directoryPath, nullptr, outPaths);
 }
+
+/* static */SlangResult DirectoryUtil::removeDirectory(const Slang::String& directoryPath)
+{
+    List<String> paths;
+    SLANG_RETURN_ON_FAIL(findDirectories(directoryPath, paths));
+    for (const auto& path : paths)
+    {
+        removeDirectory(path);
+    }
+
+    SLANG_RETURN_ON_FAIL(findFiles(directoryPath, paths));
+    for (const auto& path : paths)
+    {
+        File::remove(path);
+    }
+
+    return File::remove(directoryPath);
+}
+
+SlangResult TemporaryDirectory::init(const Slang::UnownedStringSlice& prefix)
+{
+    remove();
+
+    SLANG_RETURN_ON_FAIL(File::generateTemporary(prefix, m_temporaryPath));
+
+    m_path = m_temporaryPath + "-dir";
+    if (!Path::createDirectory(m_path))
+    {
+        m_path = String();
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+void TemporaryDirectory::remove()
+{
+    if (m_path.getLength())
+    {
+        DirectoryUtil::removeDirectory(m_path);
+        m_path = String();
+    }
+    if (m_temporaryPath.getLength())
+    {
+        File::remove(m_temporaryPath);
+        m_temporaryPath = String();
+    }
+}
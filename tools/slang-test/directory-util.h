@@ -48,6 +48,32 @@ public:
         /// Enumerate files in the given `directoryPath`, storing in outPaths.
         /// @return SLANG_OK on success or SLANG_E_NOT_FOUND if directory is not found.
     static SlangResult findFiles(const Slang::String& directoryPath, Slang::List<Slang::String>& outPaths);
+
+        /// Remove the directory at `directoryPath`, and everything in it.
+    static SlangResult removeDirectory(const Slang::String& directoryPath);
+};
+
+/* A uniquely named directory in the system's temporary directory, for tests to write files to.
+
+File::generateTemporary creates a file to reserve a unique name, so the directory has a name derived from it. The
+directory (with everything in it) and the file are both removed when the TemporaryDirectory is destroyed. */
+class TemporaryDirectory
+{
+public:
+        /// Create the directory, with a name starting with prefix
+    SlangResult init(const Slang::UnownedStringSlice& prefix);
+
+        /// Get the path of the directory
+    const Slang::String& getPath() const { return m_path; }
+
+        /// Remove the directory and the temporary file
+    void remove();
+
+    ~TemporaryDirectory() { remove(); }
+
+protected:
+    Slang::String m_temporaryPath;          ///< The path of the file created by generateTemporary
+    Slang::String m_path;
 };
 
 #endif // SLANG_DIRECTORY_UTIL_H
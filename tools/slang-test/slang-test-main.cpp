@@ -3247,6 +3247,9 @@ SlangResult innerMain(int argc, char** argv)
     auto waveActiveCategory = categorySet.add("wave-active", waveTestCategory);
 
     auto compatibilityIssueCategory = categorySet.add("compatibility-issue", fullTestCategory);
+
+    // Long running tests, that are only run when asked for
+    auto stressTestCategory = categorySet.add("stress", fullTestCategory);
         
 #if SLANG_WINDOWS_FAMILY
     auto windowsCategory = categorySet.add("windows", fullTestCategory);
@@ -3355,6 +3358,12 @@ SlangResult innerMain(int argc, char** argv)
         options.excludeCategories.Add(optixTestCategory, optixTestCategory);
     }
 
+    // Likewise stress tests
+    if( !options.includeCategories.ContainsKey(stressTestCategory) )
+    {
+        options.excludeCategories.Add(stressTestCategory, stressTestCategory);
+    }
+
     // Exclude rendering tests when building under AppVeyor.
     //
     // TODO: this is very ad hoc, and we should do something cleaner.
@@ -3401,6 +3410,13 @@ SlangResult innerMain(int argc, char** argv)
 
                 TestOptions testOptions;
                 testOptions.categories.add(unitTestCatagory);
+                if (cur->m_categoryName)
+                {
+                    if (auto category = categorySet.find(cur->m_categoryName))
+                    {
+                        testOptions.categories.add(category);
+                    }
+                }
                 testOptions.command = filePath;
 
                 if (shouldRunTest(&context, testOptions.command))
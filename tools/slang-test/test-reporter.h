@@ -21,9 +21,10 @@ struct TestRegister
 {
     typedef void (*TestFunc)();
 
-    TestRegister(const char* name, TestFunc func):
+    TestRegister(const char* name, TestFunc func, const char* categoryName = nullptr):
         m_next(s_first),
         m_name(name),
+        m_categoryName(categoryName),
         m_func(func)
     {
         s_first = this;
@@ -31,12 +32,14 @@ struct TestRegister
 
     TestFunc m_func;
     const char* m_name;
+    const char* m_categoryName;         ///< If set the name of a category the test is in, as well as 'unit-test'
     TestRegister* m_next;
 
     static TestRegister* s_first;
 };
 
-#define SLANG_UNIT_TEST(name, func) static TestRegister s_unitTest##__LINE__(name, func)
+#define SLANG_UNIT_TEST(name, func) static TestRegister SLANG_CONCAT(s_unitTest, __LINE__)(name, func)
+#define SLANG_UNIT_TEST_IN_CATEGORY(name, categoryName, func) static TestRegister SLANG_CONCAT(s_unitTest, __LINE__)(name, func, categoryName)
 
 enum class TestOutputMode
 {
@@ -0,0 +1,79 @@
+// unit-test-chunked-string.cpp
+
+#include "../../source/core/slang-chunked-string.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static void chunkedStringUnitTest()
+{
+    const String hello("Hello");
+    const String world(" World");
+
+    {
+        ChunkedString text;
+        SLANG_CHECK(text.getLength() == 0 && text.toString().getLength() == 0);
+
+        // Appending a string shares its contents, and a single chunk is returned without a copy
+        text.append(hello);
+        SLANG_CHECK(text.getChunks().getCount() == 1 && text.getChunks()[0].getBuffer() == hello.getBuffer());
+        SLANG_CHECK(text.toString().getBuffer() == hello.getBuffer());
+
+        // Empty text adds no chunk
+        text.append(String());
+        text.append(UnownedStringSlice());
+        SLANG_CHECK(text.getChunks().getCount() == 1);
+
+        text.append(world);
+        text.append(UnownedStringSlice::fromLiteral("!"));
+        SLANG_CHECK(text.getChunks().getCount() == 3);
+        SLANG_CHECK(text.getLength() == 12);
+        SLANG_CHECK(text.toString() == "Hello World!");
+        SLANG_CHECK(text == UnownedStringSlice::fromLiteral("Hello World!"));
+        SLANG_CHECK(text != UnownedStringSlice::fromLiteral("Hello World?"));
+        SLANG_CHECK(text != UnownedStringSlice::fromLiteral("Hello World"));
+
+        // Prefixes that end within and across chunks
+        SLANG_CHECK(text.startsWith(UnownedStringSlice()));
+        SLANG_CHECK(text.startsWith(UnownedStringSlice::fromLiteral("Hel")));
+        SLANG_CHECK(text.startsWith(UnownedStringSlice::fromLiteral("Hello Wo")));
+        SLANG_CHECK(!text.startsWith(UnownedStringSlice::fromLiteral("Hello Wa")));
+        SLANG_CHECK(!text.startsWith(UnownedStringSlice::fromLiteral("Hello World!!")));
+
+        // Suffixes starting at a chunk boundary share the chunks, ones starting within a chunk copy only that chunk
+        {
+            ChunkedString suffix = text.getSuffix(hello.getLength());
+            SLANG_CHECK(suffix.getChunks().getCount() == 2 && suffix.getChunks()[0].getBuffer() == world.getBuffer());
+            SLANG_CHECK(suffix == UnownedStringSlice::fromLiteral(" World!"));
+
+            suffix = text.getSuffix(3);
+            SLANG_CHECK(suffix.getChunks().getCount() == 3 && suffix.getChunks()[1].getBuffer() == world.getBuffer());
+            SLANG_CHECK(suffix == UnownedStringSlice::fromLiteral("lo World!"));
+
+            SLANG_CHECK(text.getSuffix(0) == UnownedStringSlice::fromLiteral("Hello World!"));
+            SLANG_CHECK(text.getSuffix(text.getLength()).getLength() == 0);
+        }
+
+        // Writing out produces the whole text
+        {
+            OwnedMemoryStream stream(FileAccess::Write);
+            SLANG_CHECK(SLANG_SUCCEEDED(text.writeTo(&stream)));
+            auto contents = stream.getContents();
+            SLANG_CHECK(UnownedStringSlice((const char*)contents.begin(), (const char*)contents.end()) == "Hello World!");
+        }
+
+        // Appending another ChunkedString appends its chunks
+        {
+            ChunkedString other(text);
+            other.append(text);
+            SLANG_CHECK(other.getChunks().getCount() == 6 && other.getLength() == 24);
+            SLANG_CHECK(other.toString() == "Hello World!Hello World!");
+        }
+
+        text.clear();
+        SLANG_CHECK(text.getLength() == 0 && text.getChunks().getCount() == 0);
+    }
+}
+
+SLANG_UNIT_TEST("ChunkedString", chunkedStringUnitTest);
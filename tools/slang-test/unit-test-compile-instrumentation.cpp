@@ -0,0 +1,110 @@
+// unit-test-compile-instrumentation.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../source/core/slang-string.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static bool _findEntry(SlangCompileRequest* request, SlangInstrumentationEntryKind kind, const char* name, SlangInstrumentationEntry& outEntry)
+{
+    const SlangInt count = spGetInstrumentationEntryCount(request);
+    for (SlangInt i = 0; i < count; ++i)
+    {
+        SlangInstrumentationEntry entry;
+        if (SLANG_SUCCEEDED(spGetInstrumentationEntry(request, i, &entry)) && entry.kind == kind && strcmp(entry.name, name) == 0)
+        {
+            outEntry = entry;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void compileInstrumentationTest()
+{
+    const char* testSource =
+        "float twice(float x) { return x * 2; }\n"
+        "int twice(int x) { return x * 2; }\n"
+        "RWStructuredBuffer<float> output;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    output[tid.x] = twice(float(tid.x)) + float(twice(int(tid.y)));\n"
+        "}\n";
+
+    auto session = spCreateSession();
+    auto request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "internalFile", testSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    // Nothing is measured unless instrumentation is enabled
+    SLANG_CHECK(spGetInstrumentationEntryCount(request) == 0);
+
+    spSetInstrumentationFlags(request, SLANG_INSTRUMENTATION_FLAG_ENABLE | SLANG_INSTRUMENTATION_FLAG_TRACE);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(request)));
+
+    SlangInstrumentationEntry entry;
+
+    SLANG_CHECK(_findEntry(request, SLANG_INSTRUMENTATION_ENTRY_KIND_PHASE, "parse", entry) && entry.count > 0);
+    SLANG_CHECK(_findEntry(request, SLANG_INSTRUMENTATION_ENTRY_KIND_PHASE, "check", entry) && entry.count > 0);
+    SLANG_CHECK(_findEntry(request, SLANG_INSTRUMENTATION_ENTRY_KIND_PHASE, "emit", entry) && entry.count > 0 && entry.seconds > 0.0);
+
+    SLANG_CHECK(_findEntry(request, SLANG_INSTRUMENTATION_ENTRY_KIND_PASS, "link-ir", entry) && entry.count == 1);
+    SLANG_CHECK(_findEntry(request, SLANG_INSTRUMENTATION_ENTRY_KIND_PASS, "eliminate-dead-code", entry) && entry.count > 1);
+
+    SLANG_CHECK(_findEntry(request, SLANG_INSTRUMENTATION_ENTRY_KIND_COUNTER, "ir-insts-created", entry) && entry.count > 0);
+    // Both overloads of `twice` are candidates for each call
+    SLANG_CHECK(_findEntry(request, SLANG_INSTRUMENTATION_ENTRY_KIND_COUNTER, "overload-candidates", entry) && entry.count >= 4);
+
+    ISlangBlob* traceBlob = nullptr;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spGetInstrumentationTrace(request, &traceBlob)));
+    {
+        UnownedStringSlice trace((const char*)traceBlob->getBufferPointer(), traceBlob->getBufferSize());
+        SLANG_CHECK(trace.startsWith(UnownedStringSlice::fromLiteral("{")));
+        SLANG_CHECK(trace.indexOf(UnownedStringSlice::fromLiteral("\"traceEvents\"")) >= 0);
+        SLANG_CHECK(trace.indexOf(UnownedStringSlice::fromLiteral("\"name\": \"lower-to-ir\", \"cat\": \"phase\"")) >= 0);
+        SLANG_CHECK(trace.indexOf(UnownedStringSlice::fromLiteral("\"name\": \"construct-ssa\", \"cat\": \"pass\"")) >= 0);
+    }
+    traceBlob->release();
+
+    // Disabling removes the measurements
+    spSetInstrumentationFlags(request, 0);
+    SLANG_CHECK(spGetInstrumentationEntryCount(request) == 0);
+    SLANG_CHECK(spGetInstrumentationTrace(request, &traceBlob) == SLANG_E_NOT_AVAILABLE);
+
+    spDestroyCompileRequest(request);
+
+    // With the IR size recorded, the passes run by the pass manager have the change in size they made
+    request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "internalFile", testSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    spSetInstrumentationFlags(request, SLANG_INSTRUMENTATION_FLAG_IR_SIZE | SLANG_INSTRUMENTATION_FLAG_TRACE);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spCompile(request)));
+
+    // Dead code elimination can only remove instructions, and the passes not run by the pass manager have no size
+    SLANG_CHECK(_findEntry(request, SLANG_INSTRUMENTATION_ENTRY_KIND_PASS, "eliminate-dead-code", entry) && entry.irInstDelta < 0);
+    SLANG_CHECK(_findEntry(request, SLANG_INSTRUMENTATION_ENTRY_KIND_PASS, "link-ir", entry) && entry.irInstDelta == 0);
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(spGetInstrumentationTrace(request, &traceBlob)));
+    {
+        UnownedStringSlice trace((const char*)traceBlob->getBufferPointer(), traceBlob->getBufferSize());
+        SLANG_CHECK(trace.indexOf(UnownedStringSlice::fromLiteral("\"args\": {\"irInstDelta\": ")) >= 0);
+    }
+    traceBlob->release();
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("compileInstrumentation", compileInstrumentationTest);
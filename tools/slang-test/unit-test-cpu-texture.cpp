@@ -0,0 +1,300 @@
+// unit-test-cpu-texture.cpp
+
+#include "../../slang.h"
+
+#include <math.h>
+
+#define SLANG_PRELUDE_NAMESPACE CPPPrelude
+#include "../../prelude/slang-cpp-types.h"
+#include "../../prelude/slang-cpp-texture.h"
+
+#include "test-context.h"
+
+using namespace CPPPrelude;
+
+static bool _isClose(float a, float b)
+{
+    return fabsf(a - b) < 1e-5f;
+}
+
+static TextureDimensions _makeDims(uint32_t shape, uint32_t width, uint32_t height, uint32_t depth, uint32_t arrayElementCount)
+{
+    TextureDimensions dims;
+    dims.reset();
+    dims.shape = shape;
+    dims.width = width;
+    dims.height = height;
+    dims.depth = depth;
+    dims.arrayElementCount = arrayElementCount;
+    return dims;
+}
+
+static void cpuTextureUnitTest()
+{
+    // A 4x4 2D texture, with a texel value of x + 4y, and the full mip chain
+    {
+        TiledTexture<1> texture(_makeDims(SLANG_TEXTURE_2D, 4, 4, 0, 0));
+
+        float data[16];
+        for (int i = 0; i < 16; ++i)
+        {
+            data[i] = float(i);
+        }
+        texture.setLevelData(0, 0, data);
+        texture.generateMips();
+
+        SLANG_CHECK(texture.GetDimensions().numberOfLevels == 3);
+        SLANG_CHECK(texture.GetDimensions(1).width == 2 && texture.GetDimensions(1).height == 2);
+
+        // Load round trips, and is zero out of range
+        {
+            bool allMatch = true;
+            for (int y = 0; y < 4; ++y)
+            {
+                for (int x = 0; x < 4; ++x)
+                {
+                    const int loc[3] = { x, y, 0 };
+                    float value;
+                    texture.Load(loc, &value);
+                    allMatch = allMatch && value == data[x + y * 4];
+                }
+            }
+            SLANG_CHECK(allMatch);
+
+            // The mips are the averages of the texels above
+            const int mipLoc[3] = { 1, 1, 1 };
+            float value;
+            texture.Load(mipLoc, &value);
+            SLANG_CHECK(_isClose(value, (10.0f + 11.0f + 14.0f + 15.0f) / 4.0f));
+
+            const int topLoc[3] = { 0, 0, 2 };
+            texture.Load(topLoc, &value);
+            SLANG_CHECK(_isClose(value, 7.5f));
+
+            const int outLoc[3] = { 4, 0, 0 };
+            texture.Load(outLoc, &value);
+            SLANG_CHECK(value == 0.0f);
+        }
+
+        ISamplerState samplerDesc;
+        SamplerState sampler = { &samplerDesc };
+        float value;
+
+        // Point sampling
+        {
+            samplerDesc.magFilter = TextureFilterMode::Point;
+            const float loc[2] = { 1.5f / 4.0f, 2.5f / 4.0f };
+            texture.Sample(sampler, loc, &value);
+            SLANG_CHECK(value == 9.0f);
+            samplerDesc.magFilter = TextureFilterMode::Linear;
+        }
+
+        // Bilinear filtering between the 4 center texels
+        {
+            const float loc[2] = { 0.5f, 0.5f };
+            texture.Sample(sampler, loc, &value);
+            SLANG_CHECK(_isClose(value, (5.0f + 6.0f + 9.0f + 10.0f) / 4.0f));
+        }
+
+        // Address modes, halfway between texel -1 and 0 on the first row
+        {
+            const float loc[2] = { 0.0f, 0.5f / 4.0f };
+
+            samplerDesc.addressU = TextureAddressMode::Clamp;
+            texture.Sample(sampler, loc, &value);
+            SLANG_CHECK(_isClose(value, 0.0f));
+
+            samplerDesc.addressU = TextureAddressMode::Wrap;
+            texture.Sample(sampler, loc, &value);
+            SLANG_CHECK(_isClose(value, 1.5f));
+
+            samplerDesc.addressU = TextureAddressMode::Mirror;
+            texture.Sample(sampler, loc, &value);
+            SLANG_CHECK(_isClose(value, 0.0f));
+
+            samplerDesc.addressU = TextureAddressMode::Border;
+            texture.Sample(sampler, loc, &value);
+            SLANG_CHECK(_isClose(value, 0.5f));
+
+            samplerDesc.addressU = TextureAddressMode::Clamp;
+        }
+
+        // Huge, infinite and NaN locations address the same texels as a location in range would (NaN is treated as 0).
+        // Huge values are multiples of the texture size, so wrap and mirror to texel 0.
+        {
+            struct AddressCase
+            {
+                TextureAddressMode mode;
+                float u;
+                float expected;
+            };
+            const float v = 2.5f / 4.0f;
+            const AddressCase cases[] =
+            {
+                { TextureAddressMode::Clamp, 1e30f, 11.0f },
+                { TextureAddressMode::Clamp, -1e30f, 8.0f },
+                { TextureAddressMode::Clamp, INFINITY, 11.0f },
+                { TextureAddressMode::Clamp, NAN, 8.0f },
+                { TextureAddressMode::Wrap, 1e30f, 8.0f },
+                { TextureAddressMode::Wrap, -1e30f, 8.0f },
+                { TextureAddressMode::Wrap, INFINITY, 8.0f },
+                { TextureAddressMode::Wrap, NAN, 8.0f },
+                { TextureAddressMode::Wrap, 1048576.375f, 9.0f },
+                { TextureAddressMode::Mirror, 1e30f, 8.0f },
+                { TextureAddressMode::Mirror, -1e30f, 8.0f },
+                { TextureAddressMode::Border, 1e30f, samplerDesc.borderColor[0] },
+                { TextureAddressMode::Border, NAN, 8.0f },
+                { TextureAddressMode::MirrorOnce, -1e30f, 11.0f },
+            };
+
+            samplerDesc.magFilter = TextureFilterMode::Point;
+            bool allMatch = true;
+            for (const auto& addressCase : cases)
+            {
+                samplerDesc.addressU = addressCase.mode;
+                const float loc[2] = { addressCase.u, v };
+                texture.Sample(sampler, loc, &value);
+                allMatch = allMatch && value == addressCase.expected;
+            }
+            SLANG_CHECK(allMatch);
+
+            // With linear filtering, a huge location wraps to halfway between texels 3 and 0 on the row
+            samplerDesc.magFilter = TextureFilterMode::Linear;
+            samplerDesc.addressU = TextureAddressMode::Wrap;
+            const float loc[2] = { 1e30f, v };
+            texture.Sample(sampler, loc, &value);
+            SLANG_CHECK(_isClose(value, (11.0f + 8.0f) / 2.0f));
+
+            // A NaN lod is treated as 0
+            samplerDesc.addressU = TextureAddressMode::Clamp;
+            const float nanLoc[2] = { 1.5f / 4.0f, v };
+            texture.SampleLevel(sampler, nanLoc, NAN, &value);
+            SLANG_CHECK(_isClose(value, 9.0f));
+        }
+
+        // Trilinear filtering between level 0 (exactly texel 0) and level 1 (a blend with the clamped edge)
+        {
+            const float loc[2] = { 0.5f / 4.0f, 0.5f / 4.0f };
+
+            texture.SampleLevel(sampler, loc, 0.5f, &value);
+            SLANG_CHECK(_isClose(value, 0.5f * 0.0f + 0.5f * 2.5f));
+
+            samplerDesc.mipFilter = TextureFilterMode::Point;
+            texture.SampleLevel(sampler, loc, 0.6f, &value);
+            SLANG_CHECK(_isClose(value, 2.5f));
+            texture.SampleLevel(sampler, loc, 0.4f, &value);
+            SLANG_CHECK(_isClose(value, 0.0f));
+            samplerDesc.mipFilter = TextureFilterMode::Linear;
+
+            // The lod is clamped to the levels of the texture, and to the sampler's maxLOD
+            texture.SampleLevel(sampler, loc, 10.0f, &value);
+            SLANG_CHECK(_isClose(value, 7.5f));
+
+            samplerDesc.maxLOD = 1.0f;
+            texture.SampleLevel(sampler, loc, 10.0f, &value);
+            SLANG_CHECK(_isClose(value, 2.5f));
+            samplerDesc.maxLOD = FLT_MAX;
+
+            // A null sampler state uses the defaults
+            SamplerState defaultSampler = { nullptr };
+            texture.SampleLevel(defaultSampler, loc, 0.5f, &value);
+            SLANG_CHECK(_isClose(value, 1.25f));
+        }
+
+        // The batched entry points give the same results as sampling one at a time
+        {
+            Texture2D<float> textureParam = { &texture };
+            samplerDesc.addressU = samplerDesc.addressV = TextureAddressMode::Wrap;
+
+            const float2 locs[4] = { { 0.1f, 0.2f }, { 0.9f, 0.3f }, { -0.4f, 1.7f }, { 0.5f, 0.05f } };
+            const float levels[4] = { 0.0f, 0.3f, 1.2f, 2.0f };
+
+            float results[4];
+            float levelResults[4];
+            textureParam.Sample4(sampler, locs, results);
+            textureParam.SampleLevel4(sampler, locs, levels, levelResults);
+
+            bool allMatch = true;
+            for (int i = 0; i < 4; ++i)
+            {
+                allMatch = allMatch && results[i] == textureParam.Sample(sampler, locs[i]);
+                allMatch = allMatch && levelResults[i] == textureParam.SampleLevel(sampler, locs[i], levels[i]);
+            }
+            SLANG_CHECK(allMatch);
+        }
+    }
+
+    // A 3D texture with a non power of 2 size, which has partially used tiles. Every texel is distinct.
+    {
+        const int width = 5, height = 6, depth = 7;
+        TiledTexture<2> texture(_makeDims(SLANG_TEXTURE_3D, width, height, depth, 0));
+
+        for (int z = 0; z < depth; ++z)
+        for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+        {
+            const float texel[2] = { float(x + (y + z * height) * width), float(-z) };
+            texture.setTexel(0, 0, x, y, z, texel);
+        }
+
+        bool allMatch = true;
+        for (int z = 0; z < depth; ++z)
+        for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+        {
+            const int loc[4] = { x, y, z, 0 };
+            float texel[2];
+            texture.Load(loc, texel);
+            allMatch = allMatch && texel[0] == float(x + (y + z * height) * width) && texel[1] == float(-z);
+        }
+        SLANG_CHECK(allMatch);
+    }
+
+    // A cube map, where each face has the value of its index
+    {
+        TiledTexture<1> texture(_makeDims(SLANG_TEXTURE_CUBE, 2, 2, 0, 0));
+        for (int face = 0; face < 6; ++face)
+        {
+            const float faceData[4] = { float(face), float(face), float(face), float(face) };
+            texture.setLevelData(0, face, faceData);
+        }
+        texture.generateMips();
+
+        const float dirs[6][3] = { { 1, 0.1f, 0 }, { -1, 0, 0.2f }, { 0, 1, 0 }, { 0.3f, -1, 0 }, { 0, 0, 1 }, { -0.1f, 0, -1 } };
+        SamplerState sampler = { nullptr };
+
+        bool allMatch = true;
+        for (int face = 0; face < 6; ++face)
+        {
+            float value;
+            texture.Sample(sampler, dirs[face], &value);
+            allMatch = allMatch && _isClose(value, float(face));
+        }
+        SLANG_CHECK(allMatch);
+    }
+
+    // A 2D texture array, where the array index is rounded and clamped (and NaN is 0)
+    {
+        TiledTexture<1> texture(_makeDims(SLANG_TEXTURE_2D | SLANG_TEXTURE_ARRAY_FLAG, 2, 2, 0, 2));
+        for (int slice = 0; slice < 2; ++slice)
+        {
+            const float sliceData[4] = { float(slice + 1), float(slice + 1), float(slice + 1), float(slice + 1) };
+            texture.setLevelData(0, slice, sliceData);
+        }
+
+        SamplerState sampler = { nullptr };
+        const float locs[][3] = { { 0.5f, 0.5f, 0.4f }, { 0.5f, 0.5f, 0.6f }, { 0.5f, 0.5f, 7.0f }, { 0.5f, 0.5f, 1e30f }, { 0.5f, 0.5f, -1e30f }, { 0.5f, 0.5f, NAN } };
+        const float expected[] = { 1.0f, 2.0f, 2.0f, 2.0f, 1.0f, 1.0f };
+
+        bool allMatch = true;
+        for (size_t i = 0; i < SLANG_COUNT_OF(expected); ++i)
+        {
+            float value;
+            texture.Sample(sampler, locs[i], &value);
+            allMatch = allMatch && value == expected[i];
+        }
+        SLANG_CHECK(allMatch);
+    }
+}
+
+SLANG_UNIT_TEST("CPUTexture", cpuTextureUnitTest);
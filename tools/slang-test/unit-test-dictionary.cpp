@@ -0,0 +1,153 @@
+// unit-test-dictionary.cpp
+
+#include "../../source/core/slang-dictionary.h"
+#include "../../source/core/slang-random-generator.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+// A key whose hash code is very poor, so that many keys share a hash and probing is exercised
+struct CollidingKey
+{
+    HashCode getHashCode() const { return HashCode(value & 3); }
+    bool operator==(const CollidingKey& rhs) const { return value == rhs.value; }
+
+    int value;
+};
+
+} // anonymous
+
+static void _checkDictionary(const Dictionary<int, int>& dict, const List<int>& values)
+{
+    // values[i] holds the value for key i, or -1 if key i is not in the dictionary
+    Index count = 0;
+    for (Index i = 0; i < values.getCount(); ++i)
+    {
+        const int* found = dict.TryGetValue(int(i));
+        if (values[i] < 0)
+        {
+            SLANG_CHECK(found == nullptr);
+        }
+        else
+        {
+            SLANG_CHECK(found && *found == values[i]);
+            count++;
+        }
+    }
+    SLANG_CHECK(dict.Count() == count);
+
+    // Iteration must visit every entry exactly once
+    Index iteratedCount = 0;
+    for (const auto& pair : dict)
+    {
+        SLANG_CHECK(pair.Key >= 0 && pair.Key < values.getCount() && values[pair.Key] == pair.Value);
+        iteratedCount++;
+    }
+    SLANG_CHECK(iteratedCount == count);
+}
+
+static void dictionaryUnitTest()
+{
+    // Random adds, sets and removes, checked against a simple array
+    {
+        RefPtr<RandomGenerator> rand = RandomGenerator::create(0x34234);
+
+        const Index keyCount = 1000;
+        List<int> values;
+        values.setCount(keyCount);
+        for (auto& value : values)
+        {
+            value = -1;
+        }
+
+        Dictionary<int, int> dict;
+        for (Index i = 0; i < 20000; ++i)
+        {
+            const int key = rand->nextInt32InRange(0, int32_t(keyCount));
+            const int op = rand->nextInt32InRange(0, 3);
+            if (op == 0)
+            {
+                dict.Remove(key);
+                values[key] = -1;
+            }
+            else if (op == 1)
+            {
+                const int value = int(i);
+                SLANG_CHECK(dict.AddIfNotExists(key, value) == (values[key] < 0));
+                if (values[key] < 0)
+                {
+                    values[key] = value;
+                }
+            }
+            else
+            {
+                dict[key] = int(i);
+                values[key] = int(i);
+            }
+
+            if ((i % 1000) == 0)
+            {
+                _checkDictionary(dict, values);
+            }
+        }
+        _checkDictionary(dict, values);
+
+        // Copies must be independent
+        Dictionary<int, int> copy(dict);
+        _checkDictionary(copy, values);
+
+        dict.Clear();
+        SLANG_CHECK(dict.Count() == 0 && dict.begin() == dict.end());
+        _checkDictionary(copy, values);
+    }
+
+    // Repeatedly adding and removing must not fill the dictionary with deleted entries
+    {
+        Dictionary<int, int> dict;
+        for (int i = 0; i < 100000; ++i)
+        {
+            dict.Add(i, i);
+            dict.Remove(i);
+        }
+        SLANG_CHECK(dict.Count() == 0);
+    }
+
+    // Keys that all collide
+    {
+        Dictionary<CollidingKey, int> dict;
+        for (int i = 0; i < 200; ++i)
+        {
+            dict.Add(CollidingKey{ i }, i * 2);
+        }
+        for (int i = 0; i < 200; i += 2)
+        {
+            dict.Remove(CollidingKey{ i });
+        }
+        for (int i = 0; i < 200; ++i)
+        {
+            const int* found = dict.TryGetValue(CollidingKey{ i });
+            SLANG_CHECK((i & 1) ? (found && *found == i * 2) : (found == nullptr));
+        }
+        SLANG_CHECK(dict.Count() == 100);
+    }
+
+    // String keys
+    {
+        Dictionary<String, int> dict;
+        for (int i = 0; i < 500; ++i)
+        {
+            dict.Add(String(i), i);
+        }
+        for (int i = 0; i < 500; ++i)
+        {
+            int value = -1;
+            SLANG_CHECK(dict.TryGetValue(String(i), value) && value == i);
+        }
+        SLANG_CHECK(!dict.ContainsKey(String("not-a-key")));
+    }
+}
+
+SLANG_UNIT_TEST("Dictionary", dictionaryUnitTest);
@@ -0,0 +1,131 @@
+// unit-test-downstream-compile-cache.cpp
+
+#include "../../source/core/slang-downstream-compile-cache.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+#include "directory-util.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+// A downstream compiler that 'compiles' by upper casing the source, and counts how many times it is invoked
+class CountingDownstreamCompiler : public DownstreamCompiler
+{
+public:
+    virtual SlangResult compile(const CompileOptions& options, RefPtr<DownstreamCompileResult>& outResult) SLANG_OVERRIDE
+    {
+        m_compileCount++;
+
+        const String sourceContents = options.sourceContents.toString();
+
+        DownstreamDiagnostics diagnostics;
+        diagnostics.result = SLANG_OK;
+        if (sourceContents.indexOf(UnownedStringSlice::fromLiteral("warn")) >= 0)
+        {
+            DownstreamDiagnostics::Diagnostic diagnostic;
+            diagnostic.severity = DownstreamDiagnostics::Diagnostic::Severity::Warning;
+            diagnostic.text = "warning";
+            diagnostics.diagnostics.add(diagnostic);
+        }
+
+        ComPtr<ISlangBlob> blob(new StringBlob(sourceContents.toUpper()));
+        outResult = new BlobDownstreamCompileResult(diagnostics, blob);
+        return SLANG_OK;
+    }
+
+    Index m_compileCount = 0;
+
+    CountingDownstreamCompiler():
+        DownstreamCompiler(Desc(SLANG_PASS_THROUGH_GENERIC_C_CPP, 1, 2))
+    {}
+};
+
+} // anonymous
+
+static String _getBinaryText(DownstreamCompileResult* result)
+{
+    ComPtr<ISlangBlob> blob;
+    if (SLANG_FAILED(result->getBinary(blob)))
+    {
+        return String();
+    }
+    return String((const char*)blob->getBufferPointer(), (const char*)blob->getBufferPointer() + blob->getBufferSize());
+}
+
+static void downstreamCompileCacheUnitTest()
+{
+    typedef DownstreamCompiler::CompileOptions CompileOptions;
+
+    TemporaryDirectory temporaryDirectory;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(temporaryDirectory.init(UnownedStringSlice::fromLiteral("slang-cache"))));
+    // The cache creates its directory if it doesn't exist
+    const String directoryPath = Path::combine(temporaryDirectory.getPath(), "cache");
+
+    {
+        RefPtr<DownstreamCompileCache> cache = new DownstreamCompileCache(directoryPath);
+        CountingDownstreamCompiler compiler;
+
+        CompileOptions options;
+        options.targetType = DownstreamCompiler::TargetType::Object;
+        options.sourceContents = "int main() { return 0; }";
+
+        // The first compile is a miss
+        {
+            RefPtr<DownstreamCompileResult> result;
+            SLANG_CHECK(SLANG_SUCCEEDED(cache->compile(&compiler, options, result)));
+            SLANG_CHECK(compiler.m_compileCount == 1 && cache->getMissCount() == 1 && cache->getHitCount() == 0);
+            SLANG_CHECK(_getBinaryText(result) == "INT MAIN() { RETURN 0; }");
+        }
+
+        // An identical compile is a hit, and produces the same binary
+        {
+            RefPtr<DownstreamCompileResult> result;
+            SLANG_CHECK(SLANG_SUCCEEDED(cache->compile(&compiler, options, result)));
+            SLANG_CHECK(compiler.m_compileCount == 1 && cache->getHitCount() == 1);
+            SLANG_CHECK(_getBinaryText(result) == "INT MAIN() { RETURN 0; }");
+        }
+
+        // Changing an option is a miss
+        {
+            CompileOptions changedOptions(options);
+            changedOptions.optimizationLevel = DownstreamCompiler::OptimizationLevel::Maximal;
+
+            StringBuilder key, changedKey;
+            SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompileCache::calcKey(compiler.getDesc(), options, key)));
+            SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompileCache::calcKey(compiler.getDesc(), changedOptions, changedKey)));
+            SLANG_CHECK(key != changedKey);
+
+            RefPtr<DownstreamCompileResult> result;
+            SLANG_CHECK(SLANG_SUCCEEDED(cache->compile(&compiler, changedOptions, result)));
+            SLANG_CHECK(compiler.m_compileCount == 2);
+        }
+
+        // A new cache on the same directory finds the previous results
+        {
+            RefPtr<DownstreamCompileCache> otherCache = new DownstreamCompileCache(directoryPath);
+
+            RefPtr<DownstreamCompileResult> result;
+            SLANG_CHECK(SLANG_SUCCEEDED(otherCache->compile(&compiler, options, result)));
+            SLANG_CHECK(compiler.m_compileCount == 2 && otherCache->getHitCount() == 1);
+        }
+
+        // Compiles with diagnostics are never stored
+        {
+            CompileOptions warnOptions(options);
+            warnOptions.sourceContents = "warn";
+
+            for (Index i = 0; i < 2; ++i)
+            {
+                RefPtr<DownstreamCompileResult> result;
+                SLANG_CHECK(SLANG_SUCCEEDED(cache->compile(&compiler, warnOptions, result)));
+                SLANG_CHECK(result->getDiagnostics().diagnostics.getCount() == 1);
+            }
+            SLANG_CHECK(compiler.m_compileCount == 4);
+        }
+    }
+}
+
+SLANG_UNIT_TEST("DownstreamCompileCache", downstreamCompileCacheUnitTest);
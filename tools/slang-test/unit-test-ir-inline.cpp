@@ -0,0 +1,94 @@
+// unit-test-ir-inline.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-string.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct InlineOutput
+{
+    SlangResult result = SLANG_OK;
+    String code;
+    SlangUInt inlinedCount = 0;
+};
+
+} // anonymous
+
+static InlineOutput _compile(SlangSession* session, SlangOptimizationLevel level)
+{
+    const char* testSource =
+        "int addOne(int x) { return x + 1; }\n"
+        "int sumTo(int n)\n"
+        "{\n"
+        "    int total = 0;\n"
+        "    for (int i = 0; i < n; ++i) { total += addOne(i); }\n"
+        "    return total;\n"
+        "}\n"
+        "RWStructuredBuffer<int> output;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    output[tid.x] = sumTo(int(tid.x)) + addOne(2);\n"
+        "}\n";
+
+    auto request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_CPP_SOURCE);
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu");
+    spAddTranslationUnitSourceString(request, tuIndex, "internalFile", testSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    spSetOptimizationLevel(request, level);
+    spSetInstrumentationFlags(request, SLANG_INSTRUMENTATION_FLAG_ENABLE);
+
+    InlineOutput output;
+    output.result = spCompile(request);
+    if (SLANG_SUCCEEDED(output.result))
+    {
+        output.code = spGetEntryPointSource(request, 0);
+    }
+
+    const SlangInt count = spGetInstrumentationEntryCount(request);
+    for (SlangInt i = 0; i < count; ++i)
+    {
+        SlangInstrumentationEntry entry;
+        if (SLANG_SUCCEEDED(spGetInstrumentationEntry(request, i, &entry)) && entry.kind == SLANG_INSTRUMENTATION_ENTRY_KIND_COUNTER && strcmp(entry.name, "inlined-call-sites") == 0)
+        {
+            output.inlinedCount = entry.count;
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return output;
+}
+
+static void irInlineUnitTest()
+{
+    auto session = spCreateSession();
+
+    // Nothing is inlined at the default level
+    {
+        InlineOutput output = _compile(session, SLANG_OPTIMIZATION_LEVEL_DEFAULT);
+        SLANG_CHECK(SLANG_SUCCEEDED(output.result));
+        SLANG_CHECK(output.inlinedCount == 0);
+        SLANG_CHECK(output.code.indexOf(UnownedStringSlice::fromLiteral("sumTo")) >= 0);
+        SLANG_CHECK(output.code.indexOf(UnownedStringSlice::fromLiteral("addOne")) >= 0);
+    }
+
+    // `addOne` is small enough to be inlined into both callers, and `sumTo` (which contains a loop) is only
+    // called once. Once inlined the functions are no longer needed, so don't appear in the output.
+    {
+        InlineOutput output = _compile(session, SLANG_OPTIMIZATION_LEVEL_HIGH);
+        SLANG_CHECK(SLANG_SUCCEEDED(output.result));
+        SLANG_CHECK(output.inlinedCount == 3);
+        SLANG_CHECK(output.code.indexOf(UnownedStringSlice::fromLiteral("sumTo")) < 0);
+        SLANG_CHECK(output.code.indexOf(UnownedStringSlice::fromLiteral("addOne")) < 0);
+    }
+
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("irInline", irInlineUnitTest);
@@ -0,0 +1,104 @@
+// unit-test-lazy-library.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static const char* const kLibraryPath = "tests/serialization/lazy-library/lazy-library.slang";
+static const char* const kTestPath = "tests/serialization/lazy-library/lazy-library-test.slang";
+
+static SlangUInt _getCounter(SlangCompileRequest* request, const char* name)
+{
+    const SlangInt count = spGetInstrumentationEntryCount(request);
+    for (SlangInt i = 0; i < count; ++i)
+    {
+        SlangInstrumentationEntry entry;
+        if (SLANG_SUCCEEDED(spGetInstrumentationEntry(request, i, &entry)) && entry.kind == SLANG_INSTRUMENTATION_ENTRY_KIND_COUNTER && strcmp(entry.name, name) == 0)
+        {
+            return entry.count;
+        }
+    }
+    return 0;
+}
+
+static SlangResult _compileLibrary(SlangSession* session, bool withUnused, ComPtr<ISlangBlob>& outContainer)
+{
+    auto request = spCreateCompileRequest(session);
+    spSetCompileFlags(request, SLANG_COMPILE_FLAG_NO_CODEGEN);
+    spSetOutputContainerFormat(request, SLANG_CONTAINER_FORMAT_SLANG_MODULE);
+    spSetDefaultModuleName(request, "module");
+    if (!withUnused)
+    {
+        spAddPreprocessorDefine(request, "LAZY_LIBRARY_WITHOUT_UNUSED", "1");
+    }
+
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceFile(request, tuIndex, kLibraryPath);
+
+    SlangResult res = spCompile(request);
+    if (SLANG_SUCCEEDED(res))
+    {
+        res = spGetContainerCode(request, outContainer.writeRef());
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+    /// Compile the test against the library, returning the number of global values read from it
+static SlangResult _compileTest(SlangSession* session, ISlangBlob* container, SlangUInt& outReadCount)
+{
+    auto request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetDefaultModuleName(request, "module");
+    spSetInstrumentationFlags(request, SLANG_INSTRUMENTATION_FLAG_ENABLE);
+    spAddLibraryReference(request, container->getBufferPointer(), container->getBufferSize());
+
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceFile(request, tuIndex, kTestPath);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SlangResult res = spCompile(request);
+    if (SLANG_SUCCEEDED(res))
+    {
+        outReadCount = _getCounter(request, "lazy-ir-globals-read");
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+static void lazyLibraryUnitTest()
+{
+    if (!File::exists(kLibraryPath))
+    {
+        // The tests are only available when run from the root of the repository
+        return;
+    }
+
+    auto session = spCreateSession();
+
+    ComPtr<ISlangBlob> container;
+    ComPtr<ISlangBlob> containerWithoutUnused;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileLibrary(session, true, container)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileLibrary(session, false, containerWithoutUnused)));
+    SLANG_CHECK(container->getBufferSize() > containerWithoutUnused->getBufferSize());
+
+    // Linking reads what the test uses from the library, and nothing else. So the same number of values are read
+    // whether or not the library has functions the test doesn't use.
+    SlangUInt readCount = 0;
+    SlangUInt readCountWithoutUnused = 0;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileTest(session, container, readCount)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compileTest(session, containerWithoutUnused, readCountWithoutUnused)));
+    SLANG_CHECK(readCount > 0);
+    SLANG_CHECK(readCount == readCountWithoutUnused);
+
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("lazyLibrary", lazyLibraryUnitTest);
@@ -0,0 +1,140 @@
+// unit-test-mapped-file-system.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static const Guid IID_ISlangUnknown = SLANG_UUID_ISlangUnknown;
+static const Guid IID_ISlangFileSystem = SLANG_UUID_ISlangFileSystem;
+
+namespace { // anonymous
+
+/* A file system that loads files by mapping them, and keeps the blobs so a test can see what happens to them. */
+class MappingFileSystem : public ISlangFileSystem
+{
+public:
+    // ISlangUnknown
+    SLANG_NO_THROW SlangResult SLANG_MCALL queryInterface(SlangUUID const& uuid, void** outObject) SLANG_OVERRIDE
+    {
+        if (uuid == IID_ISlangUnknown || uuid == IID_ISlangFileSystem)
+        {
+            *outObject = static_cast<ISlangFileSystem*>(this);
+            return SLANG_OK;
+        }
+        return SLANG_E_NO_INTERFACE;
+    }
+    // Lives on the stack of the test, so isn't reference counted
+    SLANG_NO_THROW uint32_t SLANG_MCALL addRef() SLANG_OVERRIDE { return 1; }
+    SLANG_NO_THROW uint32_t SLANG_MCALL release() SLANG_OVERRIDE { return 1; }
+
+    // ISlangFileSystem
+    SLANG_NO_THROW SlangResult SLANG_MCALL loadFile(char const* path, ISlangBlob** outBlob) SLANG_OVERRIDE
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(File::mapAllBytes(path, 0, blob));
+        m_blobs.add(blob);
+        *outBlob = blob.detach();
+        return SLANG_OK;
+    }
+
+    List<ComPtr<ISlangBlob>> m_blobs;
+};
+
+} // anonymous
+
+static uint32_t _getReferenceCount(ISlangBlob* blob)
+{
+    blob->addRef();
+    return blob->release();
+}
+
+static SlangResult _compile(SlangSession* session, const String& path, ISlangFileSystem* fileSystem, const char* fileSystemOption)
+{
+    auto request = spCreateCompileRequest(session);
+    if (fileSystem)
+    {
+        spSetFileSystem(request, fileSystem);
+    }
+    if (fileSystemOption)
+    {
+        const char* args[] = { "-file-system", fileSystemOption };
+        if (SLANG_FAILED(spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args))))
+        {
+            spDestroyCompileRequest(request);
+            return SLANG_FAIL;
+        }
+    }
+    spAddCodeGenTarget(request, SLANG_HLSL);
+
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceFile(request, tuIndex, path.getBuffer());
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SlangResult res = spCompile(request);
+
+    if (SLANG_SUCCEEDED(res) && fileSystem)
+    {
+        // Whilst the request is alive its source file holds the blob that was loaded (rather than a copy of it),
+        // as well as the file system holding it, and the cache the file system is wrapped in.
+        auto mappingFileSystem = static_cast<MappingFileSystem*>(fileSystem);
+        SLANG_CHECK(mappingFileSystem->m_blobs.getCount() == 1);
+        if (mappingFileSystem->m_blobs.getCount() == 1)
+        {
+            SLANG_CHECK(_getReferenceCount(mappingFileSystem->m_blobs[0]) == 3);
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+static void mappedFileSystemUnitTest()
+{
+    String path;
+    SLANG_CHECK(SLANG_SUCCEEDED(File::generateTemporary(UnownedStringSlice::fromLiteral("slang-mapped-fs"), path)));
+
+    // The source is made larger than 64KiB, the smallest file the file system maps
+    StringBuilder source;
+    source <<
+        "RWStructuredBuffer<int> output;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    output[tid.x] = int(tid.x) * 2;\n"
+        "}\n";
+    while (source.getLength() < 100 * 1024)
+    {
+        source << "// Padding so the source file is large enough to be mapped into memory\n";
+    }
+    File::writeAllText(path, source);
+
+    SlangSession* session = spCreateSession(nullptr);
+
+    // The source file holds the mapped blob, so the contents aren't copied
+    {
+        ComPtr<ISlangBlob> blob;
+        if (File::mapAllBytes(path, 0, blob) != SLANG_E_NOT_IMPLEMENTED)
+        {
+            MappingFileSystem fileSystem;
+            SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, path, &fileSystem, nullptr)));
+
+            // Once the request is destroyed, only the file system holds the blob
+            SLANG_CHECK(fileSystem.m_blobs.getCount() == 1 && _getReferenceCount(fileSystem.m_blobs[0]) == 1);
+        }
+    }
+
+    // Mapping files in the OS file system is opt in
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, path, nullptr, "os-mapped")));
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, path, nullptr, "os")));
+
+    spDestroySession(session);
+    File::remove(path);
+}
+
+SLANG_UNIT_TEST("MappedFileSystem", mappedFileSystemUnitTest);
@@ -0,0 +1,61 @@
+// unit-test-memory-mapped-file.cpp
+
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static void memoryMappedFileUnitTest()
+{
+    String path;
+    SLANG_CHECK(SLANG_SUCCEEDED(File::generateTemporary(UnownedStringSlice::fromLiteral("slang-mapped"), path)));
+
+    // Write a file that spans more than one page
+    List<uint8_t> contents;
+    for (Index i = 0; i < 100 * 1024; ++i)
+    {
+        contents.add(uint8_t(i * 7 + (i >> 8)));
+    }
+    SLANG_CHECK(SLANG_SUCCEEDED(File::writeAllBytes(path, contents.getBuffer(), size_t(contents.getCount()))));
+
+    {
+        ComPtr<ISlangBlob> blob;
+        SlangResult res = File::mapAllBytes(path, 0, blob);
+        if (res != SLANG_E_NOT_IMPLEMENTED)
+        {
+            // The mapping has the same contents as the file
+            SLANG_CHECK(SLANG_SUCCEEDED(res));
+            SLANG_CHECK(blob->getBufferSize() == size_t(contents.getCount()));
+            SLANG_CHECK(::memcmp(blob->getBufferPointer(), contents.getBuffer(), size_t(contents.getCount())) == 0);
+
+            // Files smaller than the minimum size aren't mapped
+            ComPtr<ISlangBlob> smallBlob;
+            SLANG_CHECK(File::mapAllBytes(path, size_t(contents.getCount()) + 1, smallBlob) == SLANG_E_NOT_AVAILABLE);
+            SLANG_CHECK(!smallBlob);
+
+            // The mapping stays valid after the file is removed
+            File::remove(path);
+            const uint8_t* data = (const uint8_t*)blob->getBufferPointer();
+            SLANG_CHECK(data[1000] == contents[1000] && data[contents.getCount() - 1] == contents.getLast());
+        }
+    }
+    File::remove(path);
+
+    // An empty file can't be mapped
+    SLANG_CHECK(SLANG_SUCCEEDED(File::writeAllBytes(path, nullptr, 0)));
+    {
+        ComPtr<ISlangBlob> blob;
+        SlangResult res = File::mapAllBytes(path, 0, blob);
+        SLANG_CHECK(res == SLANG_E_NOT_AVAILABLE || res == SLANG_E_NOT_IMPLEMENTED);
+    }
+    File::remove(path);
+
+    // A file that doesn't exist can't be opened
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK(SLANG_FAILED(File::mapAllBytes(path, 0, blob)));
+    }
+}
+
+SLANG_UNIT_TEST("MemoryMappedFile", memoryMappedFileUnitTest);
@@ -0,0 +1,118 @@
+// unit-test-module-cache.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string.h"
+
+#include "test-context.h"
+#include "directory-util.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct CompileResult
+{
+    SlangUInt hitCount = 0;
+    SlangUInt missCount = 0;
+    String code;
+};
+
+} // anonymous
+
+static SlangUInt _getCounter(SlangCompileRequest* request, const char* name)
+{
+    const SlangInt count = spGetInstrumentationEntryCount(request);
+    for (SlangInt i = 0; i < count; ++i)
+    {
+        SlangInstrumentationEntry entry;
+        if (SLANG_SUCCEEDED(spGetInstrumentationEntry(request, i, &entry)) && entry.kind == SLANG_INSTRUMENTATION_ENTRY_KIND_COUNTER && strcmp(entry.name, name) == 0)
+        {
+            return entry.count;
+        }
+    }
+    return 0;
+}
+
+static SlangResult _compile(SlangSession* session, const String& sourceDirectory, const String& cacheDirectory, CompileResult& outResult)
+{
+    const char* testSource =
+        "import module_cache_shared;\n"
+        "RWStructuredBuffer<float> output;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    output[tid.x] = scale(float(tid.x));\n"
+        "}\n";
+
+    auto request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    spAddSearchPath(request, sourceDirectory.getBuffer());
+    spSetModuleCachePath(request, cacheDirectory.getBuffer());
+    spSetInstrumentationFlags(request, SLANG_INSTRUMENTATION_FLAG_ENABLE);
+
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "internalFile", testSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SlangResult res = spCompile(request);
+    if (SLANG_SUCCEEDED(res))
+    {
+        outResult.hitCount = _getCounter(request, "module-cache-hits");
+        outResult.missCount = _getCounter(request, "module-cache-misses");
+        outResult.code = spGetEntryPointSource(request, 0);
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+static void moduleCacheUnitTest()
+{
+    TemporaryDirectory temporaryDirectory;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(temporaryDirectory.init(UnownedStringSlice::fromLiteral("slang-module-cache"))));
+    const String sourceDirectory = Path::combine(temporaryDirectory.getPath(), "src");
+    const String cacheDirectory = Path::combine(temporaryDirectory.getPath(), "cache");
+    Path::createDirectory(sourceDirectory);
+
+    const String sharedPath = Path::combine(sourceDirectory, "module-cache-shared.slang");
+    const String helperPath = Path::combine(sourceDirectory, "module-cache-helper.slang");
+
+    File::writeAllText(sharedPath,
+        "import module_cache_helper;\n"
+        "float scale(float x) { return helperScale(x) * 2.0f; }\n");
+    File::writeAllText(helperPath,
+        "float helperScale(float x) { return x + 1.0f; }\n");
+
+    auto session = spCreateSession();
+
+    // The first compile checks both imported modules, and stores them
+    CompileResult first;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(session, sourceDirectory, cacheDirectory, first)));
+    SLANG_CHECK(first.missCount == 2 && first.hitCount == 0);
+
+    // A new request reads both from the cache, and produces the same code
+    CompileResult second;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(session, sourceDirectory, cacheDirectory, second)));
+    SLANG_CHECK(second.missCount == 0 && second.hitCount == 2);
+    SLANG_CHECK(second.code == first.code);
+
+    // Changing the module imported by the shared module means both have to be checked again
+    File::writeAllText(helperPath,
+        "float helperScale(float x) { return x + 3.0f; }\n");
+
+    CompileResult third;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(session, sourceDirectory, cacheDirectory, third)));
+    SLANG_CHECK(third.missCount == 2 && third.hitCount == 0);
+    SLANG_CHECK(third.code != first.code);
+
+    CompileResult fourth;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(session, sourceDirectory, cacheDirectory, fourth)));
+    SLANG_CHECK(fourth.missCount == 0 && fourth.hitCount == 2);
+    SLANG_CHECK(fourth.code == third.code);
+
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("moduleCache", moduleCacheUnitTest);
@@ -0,0 +1,97 @@
+// unit-test-precompiled-prelude.cpp
+
+#include "../../source/core/slang-gcc-compiler-util.h"
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+#include "directory-util.h"
+
+using namespace Slang;
+
+static void _checkPrecompiledPrelude(const char* exeName)
+{
+    typedef DownstreamCompiler::CompileOptions CompileOptions;
+
+    // There is nothing to test if the compiler isn't available
+    RefPtr<DownstreamCompiler> downstreamCompiler;
+    if (SLANG_FAILED(GCCDownstreamCompilerUtil::createCompiler(String(), exeName, downstreamCompiler)))
+    {
+        return;
+    }
+    GCCDownstreamCompiler* compiler = static_cast<GCCDownstreamCompiler*>(downstreamCompiler.Ptr());
+
+    TemporaryDirectory temporaryDirectory;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(temporaryDirectory.init(UnownedStringSlice::fromLiteral("slang-prelude"))));
+    const String& directoryPath = temporaryDirectory.getPath();
+
+    {
+        CompileOptions options;
+        options.targetType = DownstreamCompiler::TargetType::Object;
+        options.sourceLanguage = SLANG_SOURCE_LANGUAGE_CPP;
+        options.preludeContents = "static int getPreludeValue() { return 42; }\n";
+        options.precompiledPreludeDirectory = directoryPath;
+
+        String headerPath;
+        SLANG_CHECK(SLANG_SUCCEEDED(compiler->getPrecompiledPrelude(options, headerPath)));
+        SLANG_CHECK(File::exists(headerPath) && File::exists(headerPath + ".gch"));
+
+        // The same options give the same precompiled prelude, and different ones a different one
+        {
+            String sameHeaderPath;
+            SLANG_CHECK(SLANG_SUCCEEDED(compiler->getPrecompiledPrelude(options, sameHeaderPath)));
+            SLANG_CHECK(sameHeaderPath == headerPath);
+
+            CompileOptions changedOptions(options);
+            changedOptions.optimizationLevel = DownstreamCompiler::OptimizationLevel::Maximal;
+
+            String changedHeaderPath;
+            SLANG_CHECK(SLANG_SUCCEEDED(compiler->getPrecompiledPrelude(changedOptions, changedHeaderPath)));
+            SLANG_CHECK(changedHeaderPath != headerPath);
+        }
+
+        // Compilations that use the prelude can see what it declares
+        const char* sources[] =
+        {
+            "int getValue() { return getPreludeValue(); }\n",
+            "int getOtherValue() { return getPreludeValue() + 1; }\n",
+        };
+        for (auto source : sources)
+        {
+            CompileOptions compileOptions(options);
+            compileOptions.sourceContents = source;
+
+            RefPtr<DownstreamCompileResult> result;
+            SLANG_CHECK(SLANG_SUCCEEDED(compiler->compile(compileOptions, result)));
+            SLANG_CHECK(result && !result->getDiagnostics().has(DownstreamDiagnostic::Severity::Error));
+        }
+
+        // Another compiler (as in a later process) finds the precompiled prelude in the directory, and can use it
+        // once the compiler that made it, and anything it made outside of the directory, is gone
+        downstreamCompiler.setNull();
+        {
+            RefPtr<DownstreamCompiler> otherDownstreamCompiler;
+            SLANG_CHECK_ABORT(SLANG_SUCCEEDED(GCCDownstreamCompilerUtil::createCompiler(String(), exeName, otherDownstreamCompiler)));
+            GCCDownstreamCompiler* otherCompiler = static_cast<GCCDownstreamCompiler*>(otherDownstreamCompiler.Ptr());
+
+            String otherHeaderPath;
+            SLANG_CHECK(SLANG_SUCCEEDED(otherCompiler->getPrecompiledPrelude(options, otherHeaderPath)));
+            SLANG_CHECK(otherHeaderPath == headerPath);
+
+            CompileOptions compileOptions(options);
+            compileOptions.sourceContents = sources[0];
+
+            RefPtr<DownstreamCompileResult> result;
+            SLANG_CHECK(SLANG_SUCCEEDED(otherCompiler->compile(compileOptions, result)));
+            SLANG_CHECK(result && !result->getDiagnostics().has(DownstreamDiagnostic::Severity::Error));
+        }
+    }
+}
+
+static void precompiledPreludeUnitTest()
+{
+    // Precompiled preludes need a gcc family compiler. They differ in how a precompiled header records its header.
+    _checkPrecompiledPrelude("g++");
+    _checkPrecompiledPrelude("clang");
+}
+
+SLANG_UNIT_TEST("PrecompiledPrelude", precompiledPreludeUnitTest);
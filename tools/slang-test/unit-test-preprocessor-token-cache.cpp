@@ -0,0 +1,92 @@
+// unit-test-preprocessor-token-cache.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string.h"
+
+#include "test-context.h"
+#include "directory-util.h"
+
+using namespace Slang;
+
+static SlangUInt _getCounter(SlangCompileRequest* request, const char* name)
+{
+    const SlangInt count = spGetInstrumentationEntryCount(request);
+    for (SlangInt i = 0; i < count; ++i)
+    {
+        SlangInstrumentationEntry entry;
+        if (SLANG_SUCCEEDED(spGetInstrumentationEntry(request, i, &entry)) && entry.kind == SLANG_INSTRUMENTATION_ENTRY_KIND_COUNTER && strcmp(entry.name, name) == 0)
+        {
+            return entry.count;
+        }
+    }
+    return 0;
+}
+
+static void preprocessorTokenCacheUnitTest()
+{
+    TemporaryDirectory temporaryDirectory;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(temporaryDirectory.init(UnownedStringSlice::fromLiteral("slang-token-cache"))));
+    const String& directory = temporaryDirectory.getPath();
+
+    const String guardedPath = Path::combine(directory, "guarded.h");
+    const String unguardedPath = Path::combine(directory, "unguarded.h");
+
+    File::writeAllText(guardedPath,
+        "#ifndef GUARDED_H\n"
+        "#define GUARDED_H\n"
+        "float scale(float x) { return x * 2.0f; }\n"
+        "#endif\n");
+    // Defines a function named by FUNC, so it must be included each time
+    File::writeAllText(unguardedPath,
+        "float FUNC(float x) { return x + 1.0f; }\n");
+
+    const char* source0 =
+        "#include \"guarded.h\"\n"
+        "#include \"guarded.h\"\n"
+        "#define FUNC offset0\n"
+        "#include \"unguarded.h\"\n"
+        "RWStructuredBuffer<float> output;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    output[tid.x] = scale(offset0(float(tid.x)));\n"
+        "}\n";
+    const char* source1 =
+        "#include \"guarded.h\"\n"
+        "#include \"guarded.h\"\n"
+        "#define FUNC offset1\n"
+        "#include \"unguarded.h\"\n"
+        "#undef FUNC\n"
+        "#define FUNC offset2\n"
+        "#include \"unguarded.h\"\n"
+        "float test(float x) { return scale(offset1(x)) + offset2(x); }\n";
+
+    auto session = spCreateSession();
+
+    auto request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    spAddSearchPath(request, directory.getBuffer());
+    spSetInstrumentationFlags(request, SLANG_INSTRUMENTATION_FLAG_ENABLE);
+
+    // Both translation units are in the same linkage, so share the token cache
+    int tuIndex0 = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu0");
+    spAddTranslationUnitSourceString(request, tuIndex0, "tu0.slang", source0);
+    spAddEntryPoint(request, tuIndex0, "computeMain", SLANG_STAGE_COMPUTE);
+
+    int tuIndex1 = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex1, "tu1.slang", source1);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+
+    // The second include of guarded.h in each translation unit is skipped. The first include in the second
+    // translation unit, and the second and third includes of unguarded.h read the cached tokens.
+    SLANG_CHECK(_getCounter(request, "include-guard-skips") == 2);
+    SLANG_CHECK(_getCounter(request, "token-cache-hits") == 3);
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("preprocessorTokenCache", preprocessorTokenCacheUnitTest);
@@ -0,0 +1,187 @@
+// unit-test-session-threads.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string.h"
+
+#include "test-context.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct CompileOutput
+{
+    bool operator==(const CompileOutput& rhs) const { return result == rhs.result && diagnostics == rhs.diagnostics && code == rhs.code; }
+    bool operator!=(const CompileOutput& rhs) const { return !(*this == rhs); }
+
+    SlangResult result = SLANG_OK;
+    String diagnostics;
+    String code;
+};
+
+class FindSourceVisitor : public Path::Visitor
+{
+public:
+    virtual void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+    {
+        const String path = Path::combine(m_directoryPath, filename);
+        if (type == Path::Type::Directory)
+        {
+            FindSourceVisitor visitor(path, m_paths);
+            Path::find(path, nullptr, &visitor);
+        }
+        else if (type == Path::Type::File && Path::getPathExt(filename) == "slang")
+        {
+            m_paths.add(path);
+        }
+    }
+    FindSourceVisitor(const String& directoryPath, List<String>& paths): m_directoryPath(directoryPath), m_paths(paths) {}
+
+    String m_directoryPath;
+    List<String>& m_paths;
+};
+
+} // anonymous
+
+static CompileOutput _compile(SlangSession* session, const String& path, const String& source)
+{
+    auto request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    spAddSearchPath(request, Path::getParentDirectory(path).getBuffer());
+
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, tuIndex, path.getBuffer(), source.getBuffer());
+
+    // Files without the entry point are still checked and lowered to IR
+    const bool hasEntryPoint = source.indexOf("computeMain") >= 0;
+    if (hasEntryPoint)
+    {
+        spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    }
+
+    CompileOutput output;
+    output.result = spCompile(request);
+    output.diagnostics = spGetDiagnosticOutput(request);
+    if (SLANG_SUCCEEDED(output.result) && hasEntryPoint)
+    {
+        output.code = spGetEntryPointSource(request, 0);
+    }
+
+    spDestroyCompileRequest(request);
+    return output;
+}
+
+static void _checkCompilesOnThreads(const List<String>& paths, Index repeatCount)
+{
+    List<String> sources;
+    for (const auto& path : paths)
+    {
+        sources.add(File::readAllText(path));
+    }
+
+    const Index pathCount = paths.getCount();
+
+    List<CompileOutput> expectedOutputs;
+    {
+        auto session = spCreateSession();
+        for (Index i = 0; i < pathCount; ++i)
+        {
+            expectedOutputs.add(_compile(session, paths[i], sources[i]));
+        }
+        spDestroySession(session);
+    }
+
+    // Use a new session, so that anything the global session (or the stdlib) computes when first used is
+    // computed whilst other threads are using it
+    auto session = spCreateSession();
+
+    const Index threadCount = 4;
+
+    // Each thread takes the next file to compile from a shared index, so different files are being
+    // compiled by each thread at the same time. Each file is compiled repeatCount times.
+    const Index count = pathCount * repeatCount;
+    std::atomic<Index> nextIndex(0);
+    List<CompileOutput> outputs;
+    outputs.setCount(count);
+
+    List<std::thread> threads;
+    for (Index i = 0; i < threadCount; ++i)
+    {
+        threads.add(std::thread([&]()
+            {
+                for (Index index = nextIndex++; index < count; index = nextIndex++)
+                {
+                    const Index pathIndex = index % pathCount;
+                    outputs[index] = _compile(session, paths[pathIndex], sources[pathIndex]);
+                }
+            }));
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (Index i = 0; i < count; ++i)
+    {
+        SLANG_CHECK(outputs[i] == expectedOutputs[i % pathCount]);
+    }
+
+    spDestroySession(session);
+}
+
+static void sessionThreadsUnitTest()
+{
+    // Compile a small set of modules covering generics, interfaces, dynamic dispatch, resources and imports on one
+    // thread, then with a single global session on multiple threads at the same time, and check the outputs are
+    // the same.
+    const char* const testPaths[] =
+    {
+        "tests/compute/simple.slang",
+        "tests/compute/generics-simple.slang",
+        "tests/compute/generic-interface-method.slang",
+        "tests/compute/assoctype-complex.slang",
+        "tests/compute/dynamic-dispatch-1.slang",
+        "tests/compute/matrix-layout-structured-buffer.slang",
+        "tests/compute/rw-texture-simple.slang",
+        "tests/compute/global-type-param-array.slang",
+    };
+
+    List<String> paths;
+    for (auto testPath : testPaths)
+    {
+        if (!File::exists(testPath))
+        {
+            // The tests are only available when run from the root of the repository
+            return;
+        }
+        paths.add(testPath);
+    }
+
+    _checkCompilesOnThreads(paths, 4);
+}
+
+static void sessionThreadsStressUnitTest()
+{
+    // As sessionThreadsUnitTest, but over the whole test corpus. This takes a while, so is in the opt-in
+    // 'stress' category.
+    List<String> paths;
+    {
+        FindSourceVisitor visitor("tests", paths);
+        Path::find("tests", nullptr, &visitor);
+    }
+    if (paths.getCount() == 0)
+    {
+        // The corpus is only available when run from the root of the repository
+        return;
+    }
+
+    _checkCompilesOnThreads(paths, 1);
+}
+
+SLANG_UNIT_TEST("sessionThreads", sessionThreadsUnitTest);
+SLANG_UNIT_TEST_IN_CATEGORY("sessionThreadsStress", "stress", sessionThreadsStressUnitTest);
@@ -0,0 +1,85 @@
+// unit-test-shared-library-output.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string.h"
+
+#include "test-context.h"
+#include "directory-util.h"
+
+using namespace Slang;
+
+static const char kSource[] =
+    "RWStructuredBuffer<int> outputBuffer;\n"
+    "[numthreads(4, 1, 1)] void first(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = 1; }\n"
+    "[numthreads(4, 1, 1)] void second(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = 2; }\n";
+
+    /// Process the command line, and compile if that succeeds
+template <size_t COUNT>
+static SlangResult _compile(SlangCompileRequest* request, const char* const (&args)[COUNT])
+{
+    SLANG_RETURN_ON_FAIL(spProcessCommandLineArguments(request, args, int(COUNT)));
+    return spCompile(request);
+}
+
+static void sharedLibraryOutputUnitTest()
+{
+    TemporaryDirectory temporaryDirectory;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(temporaryDirectory.init(UnownedStringSlice::fromLiteral("slang-shared-library"))));
+
+    const String sourcePath = Path::combine(temporaryDirectory.getPath(), "kernels.slang");
+    const String outputPath = Path::combine(temporaryDirectory.getPath(), "kernels.so");
+    File::writeAllText(sourcePath, kSource);
+
+    auto session = spCreateSession();
+
+    // Without an entry point a '-o' for a library can't be associated with anything, as before
+    {
+        auto request = spCreateCompileRequest(session);
+        const char* const args[] = { sourcePath.getBuffer(), "-target", "host-callable", "-o", outputPath.getBuffer() };
+        SLANG_CHECK(SLANG_FAILED(_compile(request, args)));
+        spDestroyCompileRequest(request);
+    }
+
+    // Everything else needs a C++ compiler to produce the library
+    if (SLANG_FAILED(spSessionCheckPassThroughSupport(session, SLANG_PASS_THROUGH_GENERIC_C_CPP)))
+    {
+        spDestroySession(session);
+        return;
+    }
+
+    // With a single entry point, the output is for that entry point
+    {
+        auto request = spCreateCompileRequest(session);
+        const char* const args[] = { sourcePath.getBuffer(), "-target", "host-callable", "-o", outputPath.getBuffer(), "-entry", "first", "-stage", "compute" };
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(request, args)));
+
+        ComPtr<ISlangSharedLibrary> sharedLibrary;
+        SLANG_CHECK(SLANG_SUCCEEDED(spGetEntryPointHostCallable(request, 0, 0, sharedLibrary.writeRef())));
+        SLANG_CHECK(sharedLibrary && sharedLibrary->findFuncByName("first"));
+
+        ComPtr<ISlangSharedLibrary> wholeSharedLibrary;
+        SLANG_CHECK(SLANG_FAILED(spGetTargetHostCallable(request, 0, wholeSharedLibrary.writeRef())));
+
+        spDestroyCompileRequest(request);
+    }
+
+    // With multiple entry points, a '-o' not associated with any of them outputs them all in one library
+    {
+        auto request = spCreateCompileRequest(session);
+        const char* const args[] = { sourcePath.getBuffer(), "-target", "host-callable", "-o", outputPath.getBuffer(), "-entry", "first", "-stage", "compute", "-entry", "second", "-stage", "compute" };
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_compile(request, args)));
+
+        ComPtr<ISlangSharedLibrary> sharedLibrary;
+        SLANG_CHECK(SLANG_SUCCEEDED(spGetTargetHostCallable(request, 0, sharedLibrary.writeRef())));
+        SLANG_CHECK(sharedLibrary && sharedLibrary->findFuncByName("first") && sharedLibrary->findFuncByName("second"));
+
+        spDestroyCompileRequest(request);
+    }
+
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("sharedLibraryOutput", sharedLibraryOutputUnitTest);
@@ -0,0 +1,39 @@
+// unit-test-thread-pool.cpp
+
+#include "../../source/core/slang-thread-pool.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static void threadPoolUnitTest()
+{
+    const Index threadCounts[] = { 1, 2, 4, 0 };
+    for (auto threadCount : threadCounts)
+    {
+        RefPtr<ThreadPool> threadPool = new ThreadPool(threadCount);
+        SLANG_CHECK(threadPool->getThreadCount() >= 1);
+
+        // Run a variety of batch sizes, including empty and single item batches.
+        for (Index count = 0; count < 300; count += 7)
+        {
+            List<Index> values;
+            values.setCount(count);
+            for (auto& value : values)
+            {
+                value = -1;
+            }
+
+            auto func = [&](Index index) { values[index] = index * 3; };
+            threadPool->parallelFor(count, func);
+
+            // Every item must have been executed exactly once
+            for (Index i = 0; i < count; ++i)
+            {
+                SLANG_CHECK(values[i] == i * 3);
+            }
+        }
+    }
+}
+
+SLANG_UNIT_TEST("ThreadPool", threadPoolUnitTest);